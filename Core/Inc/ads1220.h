@@ -37,16 +37,19 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "grid_config.h"
 
 /* Exported defines ----------------------------------------------------------*/
 
 /**
  * @defgroup ADS1220_COUNT Number of ADS1220 chips
+ * @brief One chip per 4 columns; the count follows the grid geometry
+ *        selected in grid_config.h (8 chips at 16x32, 10 at 40x40).
  * @{
  */
-#define ADS1220_NUM_CHIPS       8U      /**< 8 ADS1220 chips for 32 columns */
+#define ADS1220_NUM_CHIPS       GRID_CFG_NUM_CHIPS
 #define ADS1220_CHANNELS        4U      /**< 4 single-ended channels per chip */
-#define ADS1220_TOTAL_CHANNELS  (ADS1220_NUM_CHIPS * ADS1220_CHANNELS)  /**< 32 */
+#define ADS1220_TOTAL_CHANNELS  (ADS1220_NUM_CHIPS * ADS1220_CHANNELS)
 /** @} */
 
 /**
@@ -56,7 +59,9 @@ extern "C" {
 #define ADS1220_CMD_RESET       0x06U   /**< Reset the device */
 #define ADS1220_CMD_START       0x08U   /**< Start/Sync conversions */
 #define ADS1220_CMD_POWERDOWN   0x02U   /**< Enter power-down mode */
-#define ADS1220_CMD_RDATA       0x10U   /**< Read data by command */
+#define ADS1220_CMD_RDATA       0x10U   /**< Read data by command (kept for
+                                             reference; readout is
+                                             DOUT-direct after DRDY) */
 #define ADS1220_CMD_RREG        0x20U   /**< Read register (OR with addr << 2) */
 #define ADS1220_CMD_WREG        0x40U   /**< Write register (OR with addr << 2) */
 /** @} */
@@ -113,6 +118,11 @@ extern "C" {
 /* Conversion Mode */
 #define ADS1220_CM_SINGLE       0x00U   /**< Single-shot mode */
 #define ADS1220_CM_CONTINUOUS   0x04U   /**< Continuous conversion */
+
+/* Temperature Sensor */
+#define ADS1220_TS_ENABLE       0x02U   /**< Route the on-die temperature
+                                             sensor to the ADC (MUX/GAIN
+                                             settings are ignored) */
 /** @} */
 
 /**
@@ -128,40 +138,131 @@ extern "C" {
 #define ADS1220_REJECT_BOTH     0x10U   /**< Reject 50Hz and 60Hz */
 /** @} */
 
+/**
+ * @defgroup ADS1220_DRDY DRDY Interrupt Configuration
+ * @brief Dedicated DRDY lines on GPIOB, falling-edge EXTI per chip.
+ *        Set ADS1220_USE_DRDY_EXTI to 0 to fall back to fixed delays.
+ * @{
+ */
+#define ADS1220_USE_DRDY_EXTI   1U      /**< 1 = event-driven, 0 = HAL_Delay */
+#define ADS1220_DRDY_TIMEOUT_MS 3U      /**< Fallback bound (>1 conversion) */
+#define ADS1220_ALL_READY_MASK \
+    ((ADS1220_Mask_t)((1UL << ADS1220_NUM_CHIPS) - 1UL))
+/** @} */
+
+/**
+ * @defgroup ADS1220_HEALTH Per-chip Timeouts and Health Monitoring
+ * @brief Bounded SPI timeouts so one dead chip cannot hang the scan loop;
+ *        chips failing repeatedly are dropped from the scan until reset.
+ * @{
+ */
+#define ADS1220_SPI_TIMEOUT_MS  5U      /**< Bound for every SPI transaction */
+#define ADS1220_MAX_CONSEC_ERR  8U      /**< Failures before chip is dropped */
+/** @} */
+
+/**
+ * @defgroup ADS1220_SPI_TUNE SPI Clock Qualification
+ * @brief Per-board bus qualification: step the SPI prescaler up while
+ *        register readback patterns and cross-rate conversion checks
+ *        stay clean, then keep the fastest prescaler that passed.
+ *        Wiring differs between grid builds, so the usable SCLK does
+ *        too; a static conservative clock wastes readout bandwidth on
+ *        the clean harnesses.
+ * @{
+ */
+
+/** @brief  Conversion-consistency bound for qualification (raw counts).
+ *          A readout at the candidate clock must land within this of the
+ *          same channel read at the slowest ladder rate; bit errors on a
+ *          marginal bus corrupt high-order result bits and miss by far
+ *          more than idle-pad noise ever drifts. */
+#define ADS1220_TUNE_CONV_TOL   0x20000UL
+/** @} */
+
 /* Exported types ------------------------------------------------------------*/
 
+/**
+ * @brief  Per-chip bitmask (DRDY/alive flags), bit n = chip n
+ * @note   Widens automatically when a geometry needs more than 8 chips
+ */
+#if (ADS1220_NUM_CHIPS > 8U)
+typedef uint16_t ADS1220_Mask_t;
+#else
+typedef uint8_t ADS1220_Mask_t;
+#endif
+
 /**
  * @brief  ADS1220 chip handle structure
  */
 typedef struct {
-    GPIO_TypeDef *cs_port;      /**< Chip select GPIO port */
-    uint16_t cs_pin;            /**< Chip select GPIO pin */
+    SPI_HandleTypeDef *hspi;    /**< SPI bus this chip hangs off */
     uint8_t config_reg[4];      /**< Cached configuration registers */
 } ADS1220_Handle_t;
 
+/**
+ * @brief  Per-chip health state, updated on every SPI transaction
+ */
+typedef struct {
+    uint8_t alive;              /**< 1 = scanned, 0 = dropped from the scan */
+    uint8_t consecutiveErrors;  /**< Failures since the last good transfer */
+    uint8_t lastError;          /**< HAL status of the most recent failure */
+    uint32_t totalErrors;       /**< Lifetime failure count */
+} ADS1220_Health_t;
+
 /* Exported variables --------------------------------------------------------*/
 
 extern ADS1220_Handle_t g_ADS1220[ADS1220_NUM_CHIPS];
+extern ADS1220_Health_t g_ADS1220Health[ADS1220_NUM_CHIPS];
 
 /* Exported functions --------------------------------------------------------*/
 
 /**
- * @brief  Initialize all ADS1220 chips
+ * @brief  Initialize all ADS1220 chips on a single shared SPI bus
  * @param  hspi: Pointer to SPI handle
  * @retval None
  */
 void ADS1220_Init(SPI_HandleTypeDef *hspi);
 
+/**
+ * @brief  Initialize with chips 0-3 on one bus and 4-7 on a second bus
+ * @param  hspiA: SPI bus for chips 0-3 (columns 0-15)
+ * @param  hspiB: SPI bus for chips 4-7 (columns 16-31)
+ * @retval None
+ * @note   Both bus harvests run concurrently, halving readout time
+ */
+void ADS1220_InitDual(SPI_HandleTypeDef *hspiA, SPI_HandleTypeDef *hspiB);
+
+/**
+ * @brief  Bitmask of chips still in the scan (bit set = alive)
+ * @retval Alive mask, one bit per chip (bit0 = chip 0)
+ */
+ADS1220_Mask_t ADS1220_GetAliveMask(void);
+
+/**
+ * @brief  Mark a chip alive again and clear its error counters
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval None
+ * @note   For recovery paths that reset and reconfigure a dropped chip
+ */
+void ADS1220_ReviveChip(uint8_t chipIndex);
+
+/**
+ * @brief  Forward an SPI IRQ to the driver's bus handle (for IT transfers)
+ * @param  instance: SPI peripheral instance (SPI1/SPI2/SPI3)
+ * @retval None
+ */
+void ADS1220_SPI_IRQHandler(SPI_TypeDef *instance);
+
 /**
  * @brief  Reset a specific ADS1220 chip
- * @param  chipIndex: Chip index (0-7)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
  * @retval None
  */
 void ADS1220_Reset(uint8_t chipIndex);
 
 /**
  * @brief  Configure a specific ADS1220 chip
- * @param  chipIndex: Chip index (0-7)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
  * @param  reg0: Register 0 value
  * @param  reg1: Register 1 value
  * @param  reg2: Register 2 value
@@ -171,36 +272,260 @@ void ADS1220_Reset(uint8_t chipIndex);
 void ADS1220_Configure(uint8_t chipIndex, uint8_t reg0, uint8_t reg1, 
                        uint8_t reg2, uint8_t reg3);
 
+/**
+ * @brief  Reset all chips with a single broadcast command
+ * @retval None
+ */
+void ADS1220_BroadcastReset(void);
+
+/**
+ * @brief  Configure all chips with one broadcast register burst
+ * @param  reg0: Register 0 value
+ * @param  reg1: Register 1 value
+ * @param  reg2: Register 2 value
+ * @param  reg3: Register 3 value
+ * @retval None
+ */
+void ADS1220_BroadcastConfigure(uint8_t reg0, uint8_t reg1,
+                                uint8_t reg2, uint8_t reg3);
+
+/**
+ * @brief  Select a channel and start conversion on every chip at once
+ * @param  channel: ADS1220 input channel (0-3)
+ * @retval None
+ * @note   One write-only all-CS window per bus; ISR-safe
+ */
+void ADS1220_BroadcastSelectAndStart(uint8_t channel);
+
+/**
+ * @brief  Park every chip in power-down mode (one broadcast command)
+ * @retval None
+ * @note   Registers are retained; resume with ADS1220_WakeAll
+ */
+void ADS1220_PowerDownAll(void);
+
+/**
+ * @brief  Wake every parked chip with one broadcast START
+ * @retval None
+ */
+void ADS1220_WakeAll(void);
+
 /**
  * @brief  Set input channel on a specific ADS1220
- * @param  chipIndex: Chip index (0-7)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
  * @param  channel: Channel (0-3)
  * @retval None
  */
 void ADS1220_SetChannel(uint8_t chipIndex, uint8_t channel);
 
+/**
+ * @brief  Select channel and start conversion in a single CS window
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @param  channel: Channel (0-3)
+ * @retval None
+ */
+void ADS1220_SelectAndStart(uint8_t chipIndex, uint8_t channel);
+
+/**
+ * @brief  Select channel, PGA gain and start conversion in one CS window
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @param  channel: Channel (0-3)
+ * @param  gainShift: log2 of the gain (0-2 -> gain 1/2/4, PGA bypassed)
+ * @retval None
+ * @note   For auto-ranging re-reads; the next gain-1 select restores REG0
+ */
+void ADS1220_SelectAndStartGain(uint8_t chipIndex, uint8_t channel,
+                                uint8_t gainShift);
+
+/**
+ * @brief  Re-apply the cached config registers to one chip (after reset)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval None
+ */
+void ADS1220_RestoreConfig(uint8_t chipIndex);
+
+/**
+ * @brief  Switch all chips between single-shot and continuous conversion
+ * @param  continuous: 1 = ADS1220_CM_CONTINUOUS (free-running),
+ *                     0 = ADS1220_CM_SINGLE
+ * @retval None
+ */
+void ADS1220_SetConversionMode(uint8_t continuous);
+
+/**
+ * @brief  Query the current conversion mode
+ * @retval 1 if continuous, 0 if single-shot
+ */
+uint8_t ADS1220_GetConversionMode(void);
+
+/**
+ * @brief  Change data rate, operating mode and mains rejection at runtime
+ * @param  drModeBits: DR[2:0] | MODE[1:0] bits for REG1
+ *                     (ADS1220_DR_* | ADS1220_MODE_*)
+ * @param  rejectBits: 50/60Hz rejection bits for REG2 (ADS1220_REJECT_*)
+ * @param  convTimeUs: Nominal conversion period at the new rate; scales
+ *                     the driver's DRDY timeouts and fallback delays
+ * @retval None
+ * @note   Conversion mode and the temperature-sensor bit are preserved
+ *         from the shadows; one broadcast WREG burst per bus
+ */
+void ADS1220_SetDataRate(uint8_t drModeBits, uint8_t rejectBits,
+                         uint32_t convTimeUs);
+
+/**
+ * @brief  Nominal conversion period at the current data rate
+ * @retval Microseconds per conversion
+ */
+uint32_t ADS1220_GetConvTimeUs(void);
+
+/**
+ * @brief  Apply a new SPI clock prescaler to every ADS1220 bus
+ * @param  prescaler: SPI_BAUDRATEPRESCALER_* value
+ * @retval None
+ * @note   Waits out any transfer in flight, rewrites CR1.BR with the
+ *         peripheral disabled, and keeps the HAL Init field in step
+ */
+void ADS1220_SetSpiPrescaler(uint32_t prescaler);
+
+/**
+ * @brief  SPI clock prescaler currently applied to the ADS1220 buses
+ * @retval SPI_BAUDRATEPRESCALER_* value
+ */
+uint32_t ADS1220_GetSpiPrescaler(void);
+
+/**
+ * @brief  Qualify the bus at increasing SPI clocks and keep the fastest
+ *         clean prescaler
+ * @retval The SPI_BAUDRATEPRESCALER_* value settled on
+ * @note   Validation per rate = register write/readback patterns plus a
+ *         conversion cross-checked against a slow-clock reference on
+ *         every alive chip (the ADS1220 has no readout CRC to lean on).
+ *         Falls back to the last rate that passed, so the worst outcome
+ *         is the slowest ladder entry. Blocking; run between frames.
+ */
+uint32_t ADS1220_TuneSpiClock(void);
+
+/**
+ * @brief  Start a conversion on one ADS1220 without waiting for it
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval None
+ */
+void ADS1220_StartConversion(uint8_t chipIndex);
+
+/**
+ * @brief  Block until the chips in mask have signalled DRDY
+ * @param  readyMask: Bit per chip (bit0 = chip 0)
+ * @retval None
+ * @note   Falls back to a bounded delay if a DRDY edge is missed
+ */
+void ADS1220_WaitReady(ADS1220_Mask_t readyMask);
+
+/**
+ * @brief  Current DRDY bitmask without blocking (for cooperative scans)
+ * @retval Bit per chip, set = conversion result available
+ */
+ADS1220_Mask_t ADS1220_ReadyMask(void);
+
+/**
+ * @brief  DRDY EXTI handler, call from HAL_GPIO_EXTI_Callback
+ * @param  GPIO_Pin: Pin that triggered the interrupt
+ * @retval None
+ */
+void ADS1220_DrdyISR(uint16_t GPIO_Pin);
+
+/**
+ * @brief  Read the most recent conversion result (no START, no wait)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval 24-bit ADC value (right-justified in uint32_t)
+ */
+uint32_t ADS1220_ReadResult(uint8_t chipIndex);
+
 /**
  * @brief  Start conversion and read result from one ADS1220
- * @param  chipIndex: Chip index (0-7)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
  * @retval 24-bit ADC value (right-justified in uint32_t)
  */
 uint32_t ADS1220_ReadData(uint8_t chipIndex);
 
 /**
  * @brief  Read a specific channel from a specific chip (convenience)
- * @param  chipIndex: Chip index (0-7)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
  * @param  channel: Channel (0-3)
  * @retval 24-bit ADC value
  */
 uint32_t ADS1220_ReadChannel(uint8_t chipIndex, uint8_t channel);
 
 /**
- * @brief  Read all 32 columns (all chips, all channels)
+ * @brief  Switch one chip to the on-die temperature sensor and start a
+ *         conversion (non-blocking half of a temperature read)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval None
+ * @note   Pair with ADS1220_FinishTemperature once DRDY signals
+ */
+void ADS1220_StartTemperature(uint8_t chipIndex);
+
+/**
+ * @brief  Collect a finished temperature conversion and restore the
+ *         chip's normal analog configuration
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval On-die temperature in units of 1/32 degC (14-bit signed code)
+ */
+int16_t ADS1220_FinishTemperature(uint8_t chipIndex);
+
+/**
+ * @brief  Blocking on-die temperature read (start, wait, collect)
+ * @param  chipIndex: Chip index (0 .. ADS1220_NUM_CHIPS-1)
+ * @retval On-die temperature in units of 1/32 degC (14-bit signed code)
+ */
+int16_t ADS1220_ReadTemperature(uint8_t chipIndex);
+
+/**
+ * @brief  Read all columns (all chips, all channels)
  * @param  values: Array of 32 uint32_t to store results
  * @retval None
+ * @note   Chips marked dead and channels on the skip list are left
+ *         zeroed without spending a conversion slot on them
  */
 void ADS1220_ReadAllColumns(uint32_t values[ADS1220_TOTAL_CHANNELS]);
 
+/**
+ * @brief  Exclude chips from one channel index of the column scan
+ * @param  channel: Channel index (0 .. ADS1220_CHANNELS-1)
+ * @param  chipMask: Chips whose input on this channel is dead (bit per
+ *         chip); 0 re-enables the full channel
+ * @retval None
+ * @note   Skip-listed columns read back as zero. When every alive chip
+ *         skips a channel index the whole conversion round is elided,
+ *         which is where the frame time actually comes back.
+ */
+void ADS1220_SetChannelSkip(uint8_t channel, ADS1220_Mask_t chipMask);
+
+/**
+ * @brief  DMA-chained harvest of one channel from all alive chips
+ * @param  aliveMask: chips to read (others left untouched in values)
+ * @param  channel: converted channel whose results are collected
+ * @param  values: destination, indexed chip * ADS1220_CHANNELS + channel
+ * @retval 1 when the chain ran (results stored), 0 when the bus has no
+ *         DMA configured and the caller must harvest with ReadResult
+ * @note   One RDATA exchange per chip, sequenced entirely by the DMA
+ *         transfer-complete interrupt: the ISR stores the result, flips
+ *         CS and starts the next chip. The CPU sleeps in WFI until the
+ *         chain finishes, or can do unrelated work between
+ *         ADS1220_HarvestStart and ADS1220_HarvestFinish.
+ */
+uint8_t ADS1220_HarvestRow(ADS1220_Mask_t aliveMask, uint8_t channel,
+                           uint32_t values[ADS1220_TOTAL_CHANNELS]);
+
+/**
+ * @brief  Start the DMA harvest chain without waiting
+ * @retval 1 when started, 0 when DMA is unavailable on every bus
+ */
+uint8_t ADS1220_HarvestStart(ADS1220_Mask_t aliveMask, uint8_t channel,
+                             uint32_t values[ADS1220_TOTAL_CHANNELS]);
+
+/** @brief  Block (WFI) until a started harvest chain has finished */
+void ADS1220_HarvestFinish(void);
+
 #ifdef __cplusplus
 }
 #endif
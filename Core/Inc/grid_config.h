@@ -0,0 +1,122 @@
+/**
+ ******************************************************************************
+ * @file           : grid_config.h
+ * @brief          : Compile-time grid geometry configuration
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ * @attention
+ *
+ * Single source of truth for the grid build variant. The lab runs two
+ * prototype sizes and maintaining divergent source copies is how the
+ * old 16x32-header / 40x40-main inconsistency happened; instead, every
+ * geometry-dependent constant (rows, columns, chip count, packet and
+ * buffer sizes, row-driver mapping, calibration flash footprint) is
+ * derived from the one GRID_GEOMETRY selection below. All buffers stay
+ * static and optimally sized for the selected variant - no dynamic
+ * allocation on either target.
+ *
+ * Select the variant from the build system, e.g.:
+ *     -DGRID_GEOMETRY=GRID_GEOMETRY_40X40
+ * With nothing defined the default is the 16x32 bench grid.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __GRID_CONFIG_H
+#define __GRID_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Known geometries ----------------------------------------------------------*/
+
+#define GRID_GEOMETRY_16X32     1   /**< 16 rows x 32 cols, 8 ADS1220 */
+#define GRID_GEOMETRY_40X40     2   /**< 40 rows x 40 cols, 10 ADS1220 */
+
+#ifndef GRID_GEOMETRY
+#define GRID_GEOMETRY           GRID_GEOMETRY_16X32
+#endif
+
+/* Variant parameters --------------------------------------------------------*/
+
+#if (GRID_GEOMETRY == GRID_GEOMETRY_16X32)
+
+#define GRID_CFG_NUM_ROWS       16U
+#define GRID_CFG_NUM_COLS       32U
+#define GRID_CFG_NUM_CHIPS      8U      /**< 4 columns per ADS1220 */
+
+/* Row driver: every row has its own GPIO, all on one port, so a single
+ * BSRR write switches rows glitch-free. */
+#define GRID_CFG_ROWS_MUXED     0
+#define GRID_CFG_ROW_GPIO_PORT  GPIOC
+#define GRID_CFG_ROW_GPIO_PINS  0xFFFFU     /**< PC0-PC15 */
+
+/* Calibration image: magic + checksum + baseline (u16/node, scaled) +
+ * threshold map (u16/node) + prescaler + dead mask = 2064 bytes
+ * -> 2 flash pages of 2 KB. */
+#define GRID_CFG_CAL_FLASH_PAGES 2U
+
+/* Frame buffers are small enough to keep deep retransmit/aggregation
+ * rings without pressuring the 64 KB SRAM. */
+#define GRID_CFG_RETAIN_DEPTH   4U
+#define GRID_CFG_AGG_FRAMES_MAX 4U
+
+#elif (GRID_GEOMETRY == GRID_GEOMETRY_40X40)
+
+#define GRID_CFG_NUM_ROWS       40U
+#define GRID_CFG_NUM_COLS       40U
+#define GRID_CFG_NUM_CHIPS      10U     /**< 4 columns per ADS1220 */
+
+/* Row driver: 40 rows do not fit one GPIO port, so rows go through
+ * five CD4051 8:1 mux banks. The three select lines S0-S2 are shared
+ * across banks on PC8-PC10 and each bank has an active-high enable on
+ * PC0-PC4; select and enable live on the same port so one BSRR write
+ * still switches rows atomically. */
+#define GRID_CFG_ROWS_MUXED     1
+#define GRID_CFG_ROWMUX_PORT    GPIOC
+#define GRID_CFG_ROWMUX_SEL_SHIFT 8U    /**< PC8-PC10 = S0-S2 */
+#define GRID_CFG_ROWMUX_EN_SHIFT  0U    /**< PC0-PC4 = bank enables */
+
+/* Calibration image grows to 6416 bytes -> 4 flash pages. */
+#define GRID_CFG_CAL_FLASH_PAGES 4U
+
+/* A raw 40x40 frame is ~3.2 KB; halving the retain and aggregation
+ * depths keeps the static buffer budget inside the F303RE's SRAM. */
+#define GRID_CFG_RETAIN_DEPTH   2U
+#define GRID_CFG_AGG_FRAMES_MAX 2U
+
+#else
+#error "GRID_GEOMETRY must be one of the GRID_GEOMETRY_* values"
+#endif
+
+/* Derived row-mux masks -----------------------------------------------------*/
+
+#if GRID_CFG_ROWS_MUXED
+#define GRID_CFG_ROWMUX_SEL_MASK \
+    (7UL << GRID_CFG_ROWMUX_SEL_SHIFT)
+#define GRID_CFG_ROWMUX_EN_MASK \
+    ((((1UL << ((GRID_CFG_NUM_ROWS + 7U) / 8U)) - 1UL)) \
+     << GRID_CFG_ROWMUX_EN_SHIFT)
+#endif
+
+/* Sanity checks -------------------------------------------------------------*/
+
+#if (GRID_CFG_NUM_COLS != (GRID_CFG_NUM_CHIPS * 4U))
+#error "Column count must equal 4 channels times the ADS1220 chip count"
+#endif
+
+#if (!GRID_CFG_ROWS_MUXED && (GRID_CFG_NUM_ROWS > 16U))
+#error "Direct row drive is limited to the 16 pins of one GPIO port"
+#endif
+
+#if ((GRID_CFG_NUM_ROWS % 2U) || (GRID_CFG_NUM_COLS % 2U))
+#error "Preview binning needs even row and column counts"
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GRID_CONFIG_H */
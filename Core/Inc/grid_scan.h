@@ -1,7 +1,7 @@
 /**
  ******************************************************************************
  * @file           : grid_scan.h
- * @brief          : 16x32 Grid Scanning Engine Header (ADS1220 Version)
+ * @brief          : Grid Scanning Engine Header (ADS1220 Version)
  * @author         : Capstone Project
  * @date           : 2026-01-13
  ******************************************************************************
@@ -23,6 +23,10 @@
  *    │                                                                 │
  *    └─────────────────────────────────────────────────────────────────┘
  *
+ *   The diagram shows the default 16x32 bench build; the geometry
+ *   (rows, columns, chip count, row-driver mapping) is selected at
+ *   compile time in grid_config.h and everything below derives from it.
+ *
  ******************************************************************************
  */
 
@@ -35,17 +39,21 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "grid_config.h"
 #include "ads1220.h"
 
 /* Exported defines ----------------------------------------------------------*/
 
 /**
  * @defgroup GRID_DIMENSIONS Grid Dimensions
+ * @brief Selected by GRID_GEOMETRY in grid_config.h; every packet and
+ *        buffer size below derives from these, so both prototype sizes
+ *        build from the same source.
  * @{
  */
-#define GRID_NUM_ROWS           16U     /**< 16 rows driven by GPIO PC0-PC15 */
-#define GRID_NUM_COLS           32U     /**< 32 columns from 8x ADS1220 */
-#define GRID_TOTAL_NODES        (GRID_NUM_ROWS * GRID_NUM_COLS)  /**< 512 */
+#define GRID_NUM_ROWS           GRID_CFG_NUM_ROWS
+#define GRID_NUM_COLS           GRID_CFG_NUM_COLS
+#define GRID_TOTAL_NODES        (GRID_NUM_ROWS * GRID_NUM_COLS)
 /** @} */
 
 /**
@@ -55,18 +63,444 @@ extern "C" {
 #define PACKET_SYNC_BYTE_1      0xAAU
 #define PACKET_SYNC_BYTE_2      0x55U
 #define PACKET_HEADER_SIZE      2U
-#define PACKET_PAYLOAD_SIZE     (GRID_TOTAL_NODES * 2U)  /**< 512 x 2 = 1024 bytes */
-#define PACKET_FOOTER_SIZE      4U
-#define PACKET_TOTAL_SIZE       (PACKET_HEADER_SIZE + PACKET_PAYLOAD_SIZE + PACKET_FOOTER_SIZE)
+#define PACKET_PAYLOAD_SIZE     (GRID_TOTAL_NODES * 2U)  /**< 2 bytes/node */
+#define PACKET_META_SIZE        24U  /**< Frame summary: peak value (u16),
+                                          peak row/col (u8 each), total
+                                          force (u32), centroid row/col
+                                          (u16, x256 fixed point), frame
+                                          identity: sequence number (u32)
+                                          and scan-complete timestamp in
+                                          ms (u32), then the dead-column
+                                          mask (u32, bit n = column n) */
+#define PACKET_FOOTER_SIZE      6U   /**< CRC32 (4 bytes, LE) + CR + LF */
+#define PACKET_TOTAL_SIZE       (PACKET_HEADER_SIZE + PACKET_PAYLOAD_SIZE \
+                                 + PACKET_META_SIZE + PACKET_FOOTER_SIZE)
+
+/* Delta-frame mode: slow palpation work changes only a handful of cells
+ * per frame, so deltas send (index, value) pairs against the last
+ * keyframe and resync with a periodic full frame. Delta payload layout:
+ * count (u16), reserved pad (u16), then count x {index u16, value u16}. */
+#define PACKET_SYNC_DELTA       0x58U  /**< Second sync byte, delta frames */
+#define PACKET_DELTA_HDR_SIZE   4U     /**< count + pad */
+#define GRID_DELTA_KEYFRAME_PERIOD 32U /**< Full frame every Nth frame */
+#define GRID_DELTA_MAX_CELLS    200U   /**< Above this a full frame is
+                                            cheaper - send one instead */
+
+/* Run-length-encoded idle frames: after thresholding an untouched grid
+ * is all zeros, yet a raw frame still ships 1024 payload bytes. RLE
+ * frames alternate (zero-run u16, literal-count u16, literals u16...)
+ * tokens and are only sent when the encoding beats the cap below, so
+ * busy frames automatically fall back to raw. Payload: encoded length
+ * (u16) + pad (u16) + tokens, padded to a word boundary. */
+#define PACKET_SYNC_RLE         0x59U  /**< Second sync byte, RLE frames */
+#define PACKET_RLE_HDR_SIZE     4U     /**< encoded length + pad */
+#define PACKET_RLE_MAX_PAYLOAD  (PACKET_PAYLOAD_SIZE / 2U)  /**< Above
+                                            half a raw payload, raw wins */
+
+/* Row-streaming mode (negotiated): each row leaves the board as a
+ * compact packet the moment its harvest is processed, so wire time
+ * overlaps the remainder of the scan and first-touch-to-pixel latency
+ * shrinks from (full scan + full-frame transmit) to (one row + one
+ * 76-byte packet). The trade is frame atomicity: no frame metadata
+ * block ships while the mode is active, the host reassembles rows by
+ * sequence number. Payload: row index (u8), pad (u8), frame sequence
+ * low bits (u16), then GRID_NUM_COLS cell values (u16 LE). */
+#define PACKET_SYNC_ROW         0x5EU  /**< Second sync byte, row packets */
+#define PACKET_ROW_HDR_SIZE     4U     /**< row + pad + sequence u16 */
+#define PACKET_ROW_PAYLOAD_SIZE (PACKET_ROW_HDR_SIZE + GRID_NUM_COLS * 2U)
+#define PACKET_ROW_TOTAL_SIZE   (PACKET_HEADER_SIZE + \
+                                 PACKET_ROW_PAYLOAD_SIZE + \
+                                 PACKET_FOOTER_SIZE)
+
+/* Interlaced mode (negotiated): each frame scans and ships only one
+ * row parity - odd rows, then even rows - as a half-frame field, so
+ * the displayed update rate doubles at unchanged baud (the 25 Hz
+ * heatmap strobes visibly during fast palpation; 50 Hz fields do
+ * not). The host merges fields into its persistent frame state, the
+ * same way streamed rows patch in. Unscanned-parity rows ride one
+ * field stale in the local frame halves - the same staleness the
+ * adaptive scheduler already tolerates for skipped rows. The frame
+ * summary metadata covers the scanned field only. Payload: field
+ * parity (u8), pad (u8), frame sequence low bits (u16), then the
+ * field's rows top-to-bottom (u16 LE cells). */
+#define PACKET_SYNC_FIELD       0x5FU  /**< Second sync byte, fields */
+#define PACKET_FIELD_HDR_SIZE   4U     /**< parity + pad + sequence u16 */
+#define PACKET_FIELD_ROWS       (GRID_NUM_ROWS / 2U)
+#define PACKET_FIELD_PAYLOAD_SIZE (PACKET_FIELD_HDR_SIZE + \
+                                   PACKET_FIELD_ROWS * GRID_NUM_COLS * 2U)
+#define PACKET_FIELD_TOTAL_SIZE (PACKET_HEADER_SIZE + \
+                                 PACKET_FIELD_PAYLOAD_SIZE + \
+                                 PACKET_META_SIZE + PACKET_FOOTER_SIZE)
+
+/* Heartbeat stats packet, sent once a second alongside the data
+ * stream: uptime (u32 ms), frame count (u32), last frame scan time
+ * (u32 us), TX stall count (u32, frames that waited on the previous
+ * DMA - a saturated-link indicator), dropped command count (u32),
+ * ADS1220 alive mask (u8), mode flags (u8: bit0 packed, bit1 delta,
+ * bit2 COBS, bit3 RLE, bit4 adaptive, bit5 median, bit6 streaming),
+ * settle time (u16 us), then the profiling block: min/avg/max frame
+ * time in us (u16 each) for every phase below over the last stats
+ * period, then the inter-frame jitter histogram (GRID_JITTER_BINS x
+ * u16), the governor's last touch-to-full-rate ramp bound (u16 ms,
+ * 0 = no ramp yet), plus a pad (u16). Turns field diagnosis into
+ * reading a panel instead of attaching a debugger. */
+#define PACKET_SYNC_STATS       0x5AU  /**< Second sync byte, stats */
+#define PACKET_STATS_PAYLOAD_SIZE 80U
+#define GRID_STATS_PERIOD_MS    1000U
+
+/* Scan-pipeline profiling: DWT->CYCCNT scoped around each phase of the
+ * frame, folded into per-phase min/avg/max and shipped in the stats
+ * packet, so optimizations are verified from the diagnostics panel
+ * instead of an oscilloscope. Conversion wait and SPI readout happen
+ * inside ADS1220_ReadAllColumns and are measured together as READ. */
+#define GRID_PROF_SETTLE        0U     /**< Un-hidden row settling wait */
+#define GRID_PROF_READ          1U     /**< ADS1220 convert + readout */
+#define GRID_PROF_PROCESS       2U     /**< Per-row scale/filter/store */
+#define GRID_PROF_TX            3U     /**< Packet build + send (CPU) */
+#define GRID_PROF_FRAME         4U     /**< Whole-frame scan time */
+#define GRID_PROF_ISR           5U     /**< Per-ISR run time (max = the
+                                            worst-case handler in the
+                                            window; every handler is
+                                            one sample, not one frame) */
+#define GRID_PROF_PHASES        6U
+
+/* Inter-frame jitter histogram: the motion pipeline derives palpation
+ * speed from frame differences, so pacing jitter converts directly
+ * into velocity noise. Every full-frame completion is stamped with the
+ * DWT cycle counter (microsecond resolution, unlike the old ms tick)
+ * and the absolute change between consecutive completion-to-completion
+ * intervals is binned - deviations under 100 us in the first bin, then
+ * 200/500/1000/2000/5000/10000 us bounds, idle stretches in the open
+ * top bin. The counts ride the stats packet and reset each heartbeat,
+ * so the panel shows whether the timer-driven scheduler is actually
+ * pacing deterministically. */
+#define GRID_JITTER_BINS        8U
+
+/* Multi-frame aggregation (negotiated): K payload+metadata units under
+ * one header and CRC, so the host does a single read, sync scan and
+ * integrity check per K frames instead of per frame. Trades up to K-1
+ * frames of latency for a large cut in per-frame host CPU. Header:
+ * count (u8), pad (u8), unit size (u16). */
+#define PACKET_SYNC_AGG         0x5BU  /**< Second sync byte, aggregate */
+#define PACKET_AGG_HDR_SIZE     4U
+#define GRID_AGG_FRAMES_MAX     GRID_CFG_AGG_FRAMES_MAX
+
+/* Log packets: printf output lands in a RAM ring and is drained here
+ * in the gaps between data frames, so diagnostics ride the existing
+ * stream instead of stalling the scan loop one blocking HAL call per
+ * character. Header: text length (u16), pad (u16); the text is
+ * word-padded and the CRC covers the payload only. */
+#define PACKET_SYNC_LOG         0x5CU  /**< Second sync byte, log text */
+#define PACKET_LOG_HDR_SIZE     4U
+#define GRID_LOG_RING_SIZE      1024U  /**< Buffered log bytes (the boot
+                                            banner must fit until the
+                                            first drain opportunity) */
+#define GRID_LOG_CHUNK_MAX      128U   /**< Text bytes per log packet */
+
+/* On-target microbenchmark (command 0xD2): each scan primitive runs in
+ * isolation for N iterations - ADS1220 conversion start-to-read, raw
+ * SPI result readout, row-driver switching, packet finalize (metadata
+ * plus payload CRC) and one full UART DMA packet including wire time -
+ * and the per-test min/avg/max DWT cycle counts come back in a 0x5D
+ * packet. Ten seconds on a fresh grid build says which stage bounds the
+ * frame rate, instead of guessing from end-to-end fps. Payload:
+ * iterations (u16), pad (u16), then GRID_BENCH_TESTS x {min, avg, max}
+ * cycles (u32 each), in test-id order. */
+#define PACKET_SYNC_BENCH       0x5DU  /**< Second sync byte, benchmark */
+#define GRID_BENCH_ADC_READ     0U     /**< ADS1220 start + wait + read */
+#define GRID_BENCH_SPI_READ     1U     /**< Result readout, SPI cost only */
+#define GRID_BENCH_ROW_SWITCH   2U     /**< GRID_EnableRow toggling */
+#define GRID_BENCH_PACK         3U     /**< Metadata build + payload CRC */
+#define GRID_BENCH_UART_TX      4U     /**< One log packet incl. wire time */
+#define GRID_BENCH_TESTS        5U
+#define GRID_BENCH_ITERS_DEFAULT 64U
+#define GRID_BENCH_ITERS_MAX    1024U  /**< Keeps u32 cycle sums safe */
+#define PACKET_BENCH_PAYLOAD_SIZE (4U + (GRID_BENCH_TESTS * 12U))
+
+/* Independent watchdog: recovers a wedged scan loop (seen with a
+ * marginal SPI connection and HAL_MAX_DELAY) without a power cycle.
+ * The reset is flagged as a warm restart, and since the calibration
+ * baseline already persists in flash, the unit is streaming again in
+ * well under a second instead of costing minutes of recalibration. */
+#define GRID_WDG_TIMEOUT_MS     500U   /**< Several worst-case frames */
+
+/* Idle power management: between sessions the grid sits untouched for
+ * minutes while every ADS1220 keeps converting at turbo rate. After
+ * GRID_IDLE_FRAMES consecutive all-quiet frames the chips are parked
+ * with the POWERDOWN command (registers retained), and a low-rate
+ * sentinel scan - one ordinary frame that is never transmitted -
+ * probes for contact every GRID_IDLE_SENTINEL_MS and resumes the
+ * stream the moment a touch lands. A cooler analog front end holds
+ * calibration better, and the cart-battery deployment gains runtime. */
+#define GRID_IDLE_FRAMES        2048U  /**< Quiet frames before parking
+                                            (~80 s at 25 Hz) */
+#define GRID_IDLE_SENTINEL_MS   250U   /**< Sentinel period while parked */
+
+/* Activity-driven frame-rate governor (timer scan only): a fixed
+ * maximum rate is the wrong policy for a device that alternates
+ * between active palpation and long idle stretches. Under contact the
+ * scan runs at its configured pacing; once the quiet streak passes
+ * GRID_GOV_QUIET_FRAMES the pacing doubles each further quiet frame
+ * down to the GRID_GOV_IDLE_MS floor (~2 fps). Ramp-up is the hard
+ * constraint: the first frame that sees contact clears the stretch
+ * before its pacing gap starts, so full rate resumes one frame after
+ * first contact and the touch-to-full-rate latency is bounded by one
+ * governed interval - the bound is reported in the stats heartbeat.
+ * Complements the deep park above, which still powers the ADCs down
+ * after a much longer quiet stretch. */
+#define GRID_GOV_IDLE_MS        500U   /**< Pacing floor while quiet */
+#define GRID_GOV_QUIET_FRAMES   32U    /**< Quiet streak before the
+                                            back-off starts */
+
+/* 12-bit packed payload mode: two cells in 3 bytes. The useful dynamic
+ * range after scaling and thresholding is well under 16 bits, and the
+ * 25% smaller frame is a direct frame-rate win on the wire. */
+#define PACKET_SYNC_PACKED      0x57U  /**< Second sync byte, packed frames */
+#define PACKET_PACKED_PAYLOAD_SIZE (GRID_TOTAL_NODES * 3U / 2U)  /**< 768 */
+#define PACKET_PACKED_TOTAL_SIZE (PACKET_HEADER_SIZE \
+                                 + PACKET_PACKED_PAYLOAD_SIZE \
+                                 + PACKET_META_SIZE + PACKET_FOOTER_SIZE)
+
+/* Negotiated link speed: the link always boots at 115200 so a freshly
+ * started host can talk to a running board. The host commands a higher
+ * rate, confirms once it sees a valid frame there, and the firmware
+ * reverts on its own if the confirm never arrives or the host later
+ * shows up at the wrong rate (framing errors on RX). */
+#define GRID_BAUD_DEFAULT       115200UL   /**< Boot and fallback rate */
+#define GRID_BAUD_HIGH          921600UL
+#define GRID_BAUD_MAX           2000000UL
+
+#define GRID_CMD_BAUD_DEFAULT   0xB0U  /**< Host command: 115200 */
+#define GRID_CMD_BAUD_HIGH      0xB1U  /**< Host command: 921600 */
+#define GRID_CMD_BAUD_MAX       0xB2U  /**< Host command: 2 Mbaud */
+#define GRID_CMD_BAUD_CONFIRM   0xBFU  /**< Host heard us at the new rate */
+
+#define GRID_BAUD_CONFIRM_FRAMES 50U   /**< Frames to wait for the confirm
+                                            before reverting to default */
+
+/* Host command channel: single-byte opcodes with fixed-length
+ * little-endian arguments on the same UART, decoded in the RX
+ * interrupt and applied at the next packet boundary. This is the
+ * downlink every host-selectable mode negotiates over. */
+#define GRID_CMD_CALIBRATE      0xC0U  /**< No args; stalls one frame */
+#define GRID_CMD_SET_THRESHOLD  0xC1U  /**< u16: global noise threshold
+                                            (overwrites the learned map) */
+#define GRID_CMD_SET_ROI        0xC2U  /**< rowStart u8, rowEnd u8,
+                                            colMask u32 */
+#define GRID_CMD_CLEAR_ROI      0xC3U  /**< No args */
+#define GRID_CMD_SET_PACKED     0xC4U  /**< u8: 0/1 */
+#define GRID_CMD_SET_DELTA      0xC5U  /**< u8: 0/1 */
+#define GRID_CMD_SET_MEDIAN     0xC6U  /**< u8: 0/1 */
+#define GRID_CMD_SET_FILTER     0xC7U  /**< u8: EWMA shift, 0 = off */
+#define GRID_CMD_SET_OVERSAMPLE 0xC8U  /**< u8: 2^n samples per cell */
+#define GRID_CMD_SET_ADAPTIVE   0xC9U  /**< u8: 0/1 */
+#define GRID_CMD_SET_COBS       0xCAU  /**< u8: 0/1 */
+#define GRID_CMD_SET_SETTLE     0xCBU  /**< u16: settling time in us */
+#define GRID_CMD_STREAM         0xCCU  /**< u8: 0 idle, 1 free-running */
+#define GRID_CMD_SNAPSHOT       0xCDU  /**< No args: one frame on demand */
+#define GRID_CMD_BURST          0xCEU  /**< count u16, interval ms u16:
+                                            N frames, then back to idle */
+#define GRID_CMD_NACK           0xCFU  /**< u32: sequence number to
+                                            retransmit from the retain
+                                            ring (lossless recording) */
+#define GRID_CMD_SET_RLE        0xD0U  /**< u8: 0/1 RLE idle frames */
+#define GRID_CMD_SET_AGG        0xD1U  /**< u8: frames per super-packet
+                                            (0/1 = off, up to 4) */
+#define GRID_CMD_BENCHMARK      0xD2U  /**< u16: iterations per test
+                                            (0 = default); stalls the
+                                            scan while it runs */
+#define GRID_CMD_SET_PROFILE    0xD3U  /**< u8: GRID_PROFILE_* index */
+#define GRID_CMD_SET_AUTORANGE  0xD4U  /**< u8: 0/1 per-cell gain ranging */
+#define GRID_CMD_TUNE_SPI       0xD5U  /**< No args: qualify the SPI clock
+                                            ladder and keep the fastest
+                                            clean rate; stalls the scan */
+#define GRID_CMD_SET_ROWSTREAM  0xD6U  /**< u8: 0/1 per-row streaming
+                                            packets (0x5E) instead of
+                                            whole frames */
+#define GRID_CMD_SET_GOVERNOR   0xD7U  /**< u8: 0/1 activity-driven
+                                            frame-rate governor */
+#define GRID_CMD_SET_XTALK      0xD8U  /**< u8: crosstalk ghost ratio in
+                                            Q8, 0 = off */
+#define GRID_CMD_SET_INTERLACE  0xD9U  /**< u8: 0/1 odd/even field
+                                            half-frames (0x5F) */
+#define GRID_CMD_SAVE_CONFIG    0xDAU  /**< No args: persist the current
+                                            tuning to the config store */
+#define GRID_CMD_RESET_CONFIG   0xDBU  /**< No args: erase the config
+                                            store; next boot runs the
+                                            firmware defaults */
+#define GRID_CMD_INJECT         0xDCU  /**< row u8, col u8, value u16:
+                                            latency probe - force the
+                                            marker into one cell of the
+                                            next frame's output */
+#define GRID_CMD_SET_TIMERSCAN  0xDDU  /**< u8: 1 = timer-driven scan
+                                            engine (the default), 0 =
+                                            blocking foreground loop */
+
+#define GRID_RETAIN_DEPTH       GRID_CFG_RETAIN_DEPTH  /**< Transmitted
+                                            frames kept for NACK
+                                            retransmission */
+
+#define GRID_CMD_ARGS_MAX       6U     /**< Longest argument list (ROI) */
+#define GRID_CMD_QUEUE_DEPTH    4U     /**< Commands pending application */
+
+/* COBS framing (negotiated): the sync-byte scan can false-match on
+ * 0xAA 0x55 inside the 16-bit payload, costing the host whole frames
+ * while it recovers after a dropped byte. With byte stuffing each
+ * packet is COBS-encoded and terminated by a 0x00 delimiter that can
+ * never appear inside the encoded body, so frame boundaries are
+ * unambiguous. Worst-case overhead is one byte per 254 plus the
+ * delimiter. */
+#define GRID_COBS_MAX_ENCODED   (PACKET_TOTAL_SIZE \
+                                 + (PACKET_TOTAL_SIZE / 254U) + 2U)
 /** @} */
 
 /**
- * @defgroup ROW_GPIO Row GPIO Configuration
- * @brief Using GPIOC for all 16 row drivers
+ * @defgroup PREVIEW_MODE Fast-Preview Binned Scanning
+ * @brief 8x16 half-resolution frames: row pairs are driven together and
+ *        only every other column is converted, so a preview frame costs
+ *        about a quarter of a full scan. Preview packets carry a
+ *        distinct second sync byte so the host can tell them apart.
  * @{
  */
-#define ROW_GPIO_PORT           GPIOC
-#define ROW_GPIO_PINS           0xFFFFU  /**< PC0-PC15 */
+#define PREVIEW_NUM_ROWS        (GRID_NUM_ROWS / 2U)   /**< Binned rows */
+#define PREVIEW_NUM_COLS        (GRID_NUM_COLS / 2U)   /**< Kept columns */
+#define PACKET_SYNC_PREVIEW     0x56U  /**< Second sync byte, preview frames */
+#define PREVIEW_PAYLOAD_SIZE    (PREVIEW_NUM_ROWS * PREVIEW_NUM_COLS * 2U)
+#define PREVIEW_TOTAL_SIZE      (PACKET_HEADER_SIZE + PREVIEW_PAYLOAD_SIZE \
+                                 + PACKET_FOOTER_SIZE)
+/** @} */
+
+/**
+ * @defgroup ROW_GPIO Row Driver Configuration
+ * @brief Direct builds drive one GPIO per row on a single port; muxed
+ *        builds route rows through CD4051 banks. Both mappings come
+ *        from grid_config.h and both switch rows with one BSRR write.
+ * @{
+ */
+#if !GRID_CFG_ROWS_MUXED
+#define ROW_GPIO_PORT           GRID_CFG_ROW_GPIO_PORT
+#define ROW_GPIO_PINS           GRID_CFG_ROW_GPIO_PINS
+#endif
+/** @} */
+
+/**
+ * @defgroup SCAN_TIMER Timer-driven Scan State Machine
+ * @brief TIM7 ticks the scan forward in 100us steps; each tick advances
+ *        one phase (row select / settle / convert / harvest / transmit)
+ *        so the main loop stays free for command processing.
+ * @{
+ */
+#define GRID_SCAN_TICK_US       100U    /**< State machine tick period */
+#define GRID_FRAME_INTERVAL_MS  40U     /**< Default frame pacing (25 Hz) */
+#define GRID_CONVERT_TIMEOUT_TICKS 30U  /**< Cap on a conversion wait
+                                             (FAST profile; recomputed on
+                                             a profile switch) */
+/** @} */
+
+/**
+ * @defgroup ACQ_PROFILES Acquisition Profiles
+ * @brief Named trade-offs between frame rate and SNR, switchable at
+ *        runtime over the command channel (GRID_CMD_SET_PROFILE). A
+ *        switch reprograms every ADS1220's data rate and mains
+ *        rejection in one broadcast and recomputes the derived timings:
+ *        settling, the conversion-wait cap and frame pacing.
+ * @{
+ */
+typedef enum {
+    GRID_PROFILE_FAST = 0,  /**< 1000 SPS turbo, no rejection: live
+                                 streaming (the power-on configuration) */
+    GRID_PROFILE_CLINIC,    /**< 330 SPS with 50/60Hz rejection: noisy
+                                 clinic mains */
+    GRID_PROFILE_QUIET,     /**< 20 SPS with rejection: maximum-SNR
+                                 static assessment, seconds per frame */
+    GRID_PROFILE_COUNT
+} GridProfile_t;
+/** @} */
+
+/**
+ * @defgroup ROW_SETTLING Row Settling Time
+ * @brief Microsecond-granular settling delay (DWT cycle counter based)
+ *        with a self-calibration routine that finds the minimum safe
+ *        value for this particular grid build.
+ * @{
+ */
+#define GRID_SETTLE_US_DEFAULT  100U    /**< Safe default before tuning */
+#define GRID_SETTLE_US_MAX      500U    /**< Reference (fully settled) */
+#define GRID_SETTLE_GUARD_US    10U     /**< Margin added to tuned value */
+#define GRID_SETTLE_TOLERANCE   2000U   /**< Max 24-bit deviation allowed */
+/** @} */
+
+/**
+ * @defgroup ADAPTIVE_SCAN Activity-based Adaptive Scanning
+ * @brief With adaptive mode on, rows showing recent contact are scanned
+ *        every frame while quiescent rows drop to a background refresh,
+ *        concentrating the frame budget on the cells that are moving.
+ * @{
+ */
+#define GRID_ACTIVITY_HOLD_FRAMES  25U  /**< Frames a row stays hot after
+                                             its last above-noise cell */
+#define GRID_IDLE_REFRESH_PERIOD   8U   /**< Quiescent rows rescan every
+                                             Nth frame (staggered) */
+/** @} */
+
+/**
+ * @defgroup CAL_FLASH Persisted Calibration Baseline
+ * @brief The baseline and threshold tables are saved to the last flash
+ *        pages after GRID_Calibrate and reloaded at boot, so a power
+ *        cycle no longer forces either an uncalibrated run or a fresh
+ *        hands-off-the-grid calibration wait. The page count scales
+ *        with the grid geometry; the region always ends at the top of
+ *        the F303RE's 512 KB flash.
+ * @{
+ */
+#define GRID_CAL_FLASH_PAGES    GRID_CFG_CAL_FLASH_PAGES
+#define GRID_CAL_FLASH_ADDR     (0x08080000UL \
+                                 - (GRID_CAL_FLASH_PAGES * 0x800UL))
+#define GRID_CAL_MAGIC          0x47524435UL  /**< 'GRD5': 16-bit scaled
+                                                   baseline + threshold
+                                                   map + SPI prescaler +
+                                                   dead-column mask layout
+                                                   ('GRD4' stored the
+                                                   baseline as u32) */
+/** @} */
+
+/**
+ * @defgroup CFG_STORE Persisted Configuration Store
+ * @brief The host-tunable settings (acquisition profile, modes, ROI,
+ *        filter strengths, governor, crosstalk ratio) can be written to
+ *        the flash page below the calibration region and are re-applied
+ *        during GRID_Init before the first frame, so a headless unit
+ *        powers on streaming the site's tuning with no command replay.
+ *        Saves append fixed-size sequence-numbered slots and the page
+ *        erases only once all slots are spent, spreading wear across
+ *        the erase budget. Link-negotiation state (baud profile, COBS
+ *        framing) is deliberately excluded - the link must always come
+ *        up where a fresh host can find it - and the learned threshold
+ *        map already rides the calibration image.
+ * @{
+ */
+#define GRID_CFGSTORE_FLASH_ADDR  (GRID_CAL_FLASH_ADDR - 0x800UL)
+#define GRID_CFGSTORE_MAGIC       0x47524331UL /**< 'GRC1': slot layout v1 */
+#define GRID_CFGSTORE_SLOT_WORDS  8U   /**< magic, sequence, 5 payload
+                                            words, additive checksum */
+#define GRID_CFGSTORE_SLOTS       (0x800UL \
+                                   / (GRID_CFGSTORE_SLOT_WORDS * 4U))
+/** @} */
+
+/**
+ * @defgroup DEAD_CHANNELS Dead-channel Detection
+ * @brief Velostat cells and column traces fail in the field (about one
+ *        dead column per grid per quarter). Calibration flags columns
+ *        whose every cell is rail-pinned or shows zero spread across
+ *        all samples - an open or shorted trace, or a dead AFE input.
+ *        Flagged columns are dropped from the conversion schedule,
+ *        zeroed on the wire, and marked in the frame metadata so the
+ *        host interpolates across them instead of feeding zeros to the
+ *        centroid and spine detection.
+ * @{
+ */
+#define GRID_DEAD_RAIL_LOW      0x000200UL /**< Mean at/below = shorted */
+#define GRID_DEAD_RAIL_HIGH     0x7F0000UL /**< Mean at/above = open/stuck */
 /** @} */
 
 /**
@@ -74,8 +508,64 @@ extern "C" {
  * @{
  */
 #define ADC_MAX_VALUE           0xFFFFFFU  /**< 24-bit max */
-#define ADC_NOISE_THRESHOLD     5000U      /**< Noise floor threshold */
+#define ADC_NOISE_THRESHOLD     5000U      /**< Default threshold until a
+                                                per-cell map is learned */
+#define ADC_THRESH_FLOOR        1000U      /**< Minimum learned threshold */
+#define ADC_THRESH_SPREAD_MULT  4U         /**< Learned threshold = floor +
+                                                mult x observed spread */
 #define ADC_SCALE_SHIFT         8U         /**< Shift 24-bit to 16-bit (>> 8) */
+#define GRID_FILTER_SHIFT_MAX   6U         /**< Heaviest EWMA smoothing
+                                                (alpha = 1/64) */
+#define GRID_OVERSAMPLE_SHIFT_MAX 4U       /**< Up to 16 samples per cell
+                                                (16 x 24-bit fits 32-bit
+                                                accumulators) */
+#define GRID_BASELINE_DRIFT_SHIFT 8U       /**< Baseline tracking EWMA:
+                                                alpha = 1/256, ~10 s time
+                                                constant at 25 Hz */
+
+/* Crosstalk compensation: in a passive resistive matrix a press lifts
+ * every cell on its row and column through parasitic current paths
+ * (measured ghost ratio 5-10%), which systematically biases the
+ * centroid and the spine detector. Each cell subtracts the Q8
+ * coefficient times the previous frame's row+column activity
+ * aggregates (own contribution excluded) - ghosting is quasi-static
+ * at frame rate, so the frame-old terms keep the stage single-pass
+ * and it rides inside the conversion-wait window like the rest of
+ * the processing. The default ratio was characterized on the 16x32
+ * bench grid with a single-point press; GRID_CMD_SET_XTALK retunes
+ * or disables it at runtime. */
+#define GRID_XTALK_COEFF_Q8     18U        /**< Default ghost ratio,
+                                                18/256 = ~7% */
+
+/* Temperature-compensated baseline: one chip's on-die sensor is read
+ * per frame (rotating - one extra conversion slot out of ~512), and
+ * the resting-level shift predicted from the temperature change since
+ * calibration is added to that chip's four columns of baseline. The
+ * per-cell drift EWMA above only learns from untouched cells; this
+ * term also holds cells under sustained contact through warm-up,
+ * where thermal drift eats light-touch headroom fastest. */
+#define GRID_TEMP_COMP_COUNTS_PER_C (-120) /**< Resting-level drift in
+                                                ADC counts per degC
+                                                (bench velostat + front
+                                                end, warm-up sweep) */
+/** @} */
+
+/**
+ * @defgroup AUTO_RANGE Per-cell Automatic Gain Ranging
+ * @brief Cells whose last amplitude sat just above the noise floor are
+ *        re-read at ADS1220 gain 2 or 4 and divided back in firmware,
+ *        recovering quantization resolution on light palpation without
+ *        oversampling the whole grid. The gain map is steered by the
+ *        previous frame, so only borderline cells pay the extra
+ *        conversion round.
+ * @{
+ */
+#define GRID_AUTORANGE_MAX_SHIFT 2U     /**< Gain cap: 1 << 2 = 4 */
+#define GRID_AUTORANGE_LOW      (ADC_NOISE_THRESHOLD * 4U) /**< Boost
+                                            amplitudes below this */
+#define GRID_AUTORANGE_SAT_RAW  0x7C0000UL /**< Boosted 24-bit code at
+                                            which the read is treated as
+                                            clipped and discarded */
 /** @} */
 
 /* Exported types ------------------------------------------------------------*/
@@ -87,14 +577,62 @@ typedef enum {
     GRID_STATE_CALIBRATING
 } GridState_t;
 
+/* RAM budget for the acquisition state (bytes, by geometry):
+ *
+ *                          16x32    40x40
+ *   frame[2]                2048     6400
+ *   baseline                1024     3200
+ *   bookkeeping tail          ~20      ~20
+ *   GridData_t total        ~3.1K    ~9.6K
+ *
+ * The baseline is stored in the same >> ADC_SCALE_SHIFT scaled domain
+ * the wire uses: one scaled LSB is 256 raw counts, far below both the
+ * 5000-count default noise threshold and any learned one, so nothing
+ * the host can observe changes - and the kilobyte a u32 baseline used
+ * to burn is exactly what the second frame[] half costs on the 64 KB
+ * F303RE, alongside the retransmit ring and the DMA/TX buffers.
+ *
+ * Field order is DMA-facing payload first: frame[] sits at offset 0,
+ * each half contiguous row-major u16, so the TX path hands a half
+ * straight to the UART DMA with no gather step. */
 typedef struct {
-    uint16_t data[GRID_NUM_ROWS][GRID_NUM_COLS];  /**< 16-bit scaled values */
-    uint32_t baseline[GRID_NUM_ROWS][GRID_NUM_COLS]; /**< 24-bit baseline */
+    uint16_t frame[2][GRID_NUM_ROWS][GRID_NUM_COLS]; /**< Double-buffered
+                                                          16-bit scaled values:
+                                                          one half is scanned
+                                                          into while the other
+                                                          is transmitted */
+    uint16_t baseline[GRID_NUM_ROWS][GRID_NUM_COLS]; /**< Resting level,
+                                                          scaled domain
+                                                          (raw >> ADC_SCALE_SHIFT) */
     GridState_t state;
+    uint8_t scanIndex;       /**< frame[] half currently being scanned into */
     uint32_t frameCount;
     uint32_t lastScanTimeMs;
+    uint32_t lastFrameIntervalUs; /**< Completion-to-completion spacing
+                                       of the last two full frames (DWT
+                                       derived, microsecond resolution) */
 } GridData_t;
 
+/**
+ * @brief  Read-only view of a sealed frame, handed out by
+ *         GRID_AcquireFrame. Zero-copy: @ref cells aliases one half of
+ *         the double buffer, which the scan engines will not reuse
+ *         while the view is outstanding - release it promptly
+ */
+typedef struct {
+    const uint16_t (*cells)[GRID_NUM_COLS]; /**< GRID_NUM_ROWS rows of
+                                                 sealed cell values */
+    uint32_t seq;            /**< Frame sequence number at seal time */
+    uint8_t slot;            /**< Buffer half held (for the release) */
+} GridFrameView_t;
+
+/**
+ * @brief  Outbound transport send hook: start a non-blocking transmit
+ *         of @p len bytes and return 1, or 0 if the transport refuses.
+ *         The transport reports completion via GRID_TransportTxDone().
+ */
+typedef uint8_t (*GRID_TransportSend_t)(uint8_t *data, uint16_t len);
+
 /* Exported variables --------------------------------------------------------*/
 
 extern GridData_t g_GridData;
@@ -128,6 +666,358 @@ void GRID_TransmitData(void);
  */
 void GRID_ScanLoop(void);
 
+/**
+ * @brief  Acquire a zero-copy view of the most recently sealed frame
+ * @param  view: Filled in on success
+ * @retval 1 when a view was handed out, 0 when no frame is sealed yet
+ *         (startup, or the writer reclaimed the buffer mid-call)
+ * @note   Thread-mode callers only. The handoff is lock-free against a
+ *         scan completing mid-acquire: the slot is re-checked after
+ *         registering as a reader and the call backs off to the newly
+ *         published frame instead of blocking. A held view pins its
+ *         buffer half, so the scan engines keep writing the other one;
+ *         release with GRID_ReleaseFrame as soon as possible
+ */
+uint8_t GRID_AcquireFrame(GridFrameView_t *view);
+
+/**
+ * @brief  Release a view obtained from GRID_AcquireFrame
+ */
+void GRID_ReleaseFrame(const GridFrameView_t *view);
+
+/**
+ * @brief  Scan and transmit one binned 8x16 preview frame
+ */
+void GRID_ScanPreview(void);
+
+/**
+ * @brief  Set the oversampling quality level
+ * @param  shift: 2^shift conversions per cell, averaged on-chip; 0 = one
+ *         conversion per cell (full frame rate)
+ * @note   Extra conversions overlap across all 8 chips, so 4x
+ *         oversampling costs well under 4x frame time
+ */
+void GRID_SetOversampling(uint8_t shift);
+
+/**
+ * @brief  Enable or disable per-cell automatic gain ranging
+ * @param  enable: 1 = re-read borderline cells at boosted PGA gain
+ * @note   Disabling clears the learned gain map back to gain 1
+ */
+void GRID_SetAutoRange(uint8_t enable);
+
+/**
+ * @brief  Qualify the SPI buses and keep the fastest clean clock
+ * @note   Wraps ADS1220_TuneSpiClock and persists the result alongside
+ *         the calibration image, so a board is characterized once and
+ *         boots at its own proven rate thereafter. Blocking; runs at a
+ *         packet boundary like GRID_CMD_CALIBRATE
+ */
+void GRID_TuneSpiClock(void);
+
+/**
+ * @brief  Enable or disable delta-frame encoding
+ * @param  enable: 1 = send changed cells only, with periodic keyframes
+ * @note   Cuts wire bytes 5-10x during typical sessions; the host
+ *         reconstructs frames from the deltas and resyncs on keyframes
+ */
+void GRID_SetDeltaMode(uint8_t enable);
+
+/**
+ * @brief  Switch full frames between 16-bit and 12-bit packed payloads
+ * @param  enable: 1 = two cells in 3 bytes (0xAA 0x57 sync), 0 = 16-bit
+ * @note   Negotiated by the host; values are sent as val >> 4 and the
+ *         host restores the scale
+ */
+void GRID_SetPackedPayload(uint8_t enable);
+
+/**
+ * @brief  Enable or disable the 3-frame median spike rejection filter
+ * @param  enable: 1 = median-of-3 over the two previous frames
+ * @note   Kills the single-frame row-switching transients that exceed
+ *         the noise threshold and register as false palpation events;
+ *         adds one frame of latency to fast transients
+ */
+void GRID_SetMedianFilter(uint8_t enable);
+
+/**
+ * @brief  Set the per-cell EWMA temporal filter strength
+ * @param  shift: alpha = 1/2^shift; 0 disables the filter
+ * @note   Runs in fixed-point during row processing, which the scan
+ *         pipeline hides inside the conversion wait - smoothing here is
+ *         free where smoothing in the GUI costs render frame rate
+ */
+void GRID_SetFilterShift(uint8_t shift);
+
+/**
+ * @brief  Enable or disable activity-based adaptive row scheduling
+ * @param  enable: 1 = scan quiescent rows at reduced duty cycle
+ */
+void GRID_SetAdaptiveScan(uint8_t enable);
+
+/**
+ * @brief  Restrict scanning to a region of interest
+ * @param  rowStart: First row to scan (0-15)
+ * @param  rowEnd: Last row to scan, inclusive (0-15)
+ * @param  colMask: Bit per column (bit n = column n); 0 = all columns
+ * @note   Cells outside the window transmit as zero. Frame time shrinks
+ *         proportionally with the window, so a 6-row ROI delivers close
+ *         to 3x the full-frame rate (set the frame interval accordingly)
+ */
+void GRID_SetROI(uint8_t rowStart, uint8_t rowEnd, uint32_t colMask);
+
+/**
+ * @brief  Restore full 16x32 scanning
+ */
+void GRID_ClearROI(void);
+
+/**
+ * @brief  Set the row settling time in microseconds
+ * @param  settleUs: Delay between row switch and first conversion
+ */
+void GRID_SetSettleTime(uint16_t settleUs);
+
+/**
+ * @brief  Get the current row settling time in microseconds
+ */
+uint16_t GRID_GetSettleTime(void);
+
+/**
+ * @brief  Switch to a named acquisition profile
+ * @param  profile: GRID_PROFILE_* index (out of range is ignored)
+ * @note   Reprograms every ADS1220 and recomputes all derived timings;
+ *         a scan in flight at worst mixes rates for one frame
+ */
+void GRID_SetProfile(uint8_t profile);
+
+/**
+ * @brief  Get the active acquisition profile
+ * @retval GRID_PROFILE_* index
+ */
+uint8_t GRID_GetProfile(void);
+
+/**
+ * @brief  Reconfigure the UART to a new baud rate
+ * @param  baud: Target rate (one of the GRID_BAUD_* profiles)
+ * @note   Normally driven by the GRID_CMD_BAUD_* handshake rather than
+ *         called directly; waits for the in-flight packet to drain first
+ */
+void GRID_SetUartBaud(uint32_t baud);
+
+/**
+ * @brief  Route outbound packets through an alternate transport
+ * @param  send: Non-blocking send hook, or NULL for the UART/DMA path
+ * @note   Every frame type leaves through one send call on a finished
+ *         packet buffer and the format carries its own sync/CRC, so a
+ *         USB CDC wrapper (around CDC_Transmit_FS, once the USB device
+ *         middleware is added to the build for the F303's FS
+ *         peripheral) can carry the identical stream at bus rates
+ */
+void GRID_SetTransport(GRID_TransportSend_t send);
+
+/**
+ * @brief  Transport completion callback: releases the in-flight buffer
+ * @note   Call from the transport's TX-complete context; the UART path
+ *         does this itself via HAL_UART_TxCpltCallback
+ */
+void GRID_TransportTxDone(void);
+
+/**
+ * @brief  Enable or disable COBS byte-stuffed framing
+ * @param  enable: 1 to COBS-encode every outbound packet (0x00
+ *         delimited), 0 for raw sync-byte framing
+ * @note   Negotiated: the host parser must be switched together with
+ *         this, like the packed and delta modes
+ */
+void GRID_SetCobsFraming(uint8_t enable);
+
+/**
+ * @brief  Enable or disable free-running acquisition
+ * @param  enable: 1 streams continuously (the default); 0 idles the
+ *         scanner until GRID_RequestFrames wakes it
+ * @note   Idle still services host commands, so a paused GUI or a
+ *         scripted protocol can wake the device without reflashing
+ */
+void GRID_SetStreaming(uint8_t enable);
+
+/**
+ * @brief  Enable or disable run-length-encoded idle frames
+ * @param  enable: 1 sends RLE frames whenever the encoding beats
+ *         PACKET_RLE_MAX_PAYLOAD (idle frames shrink to tens of
+ *         bytes); busy frames fall back to the raw format on their own
+ */
+void GRID_SetRleMode(uint8_t enable);
+
+/**
+ * @brief  Set frames-per-super-packet aggregation
+ * @param  frames: 0 or 1 disables; 2-4 collect that many full frames
+ *         under one header/CRC before transmitting
+ * @note   Applies to the raw/packed full-frame path; delta and RLE
+ *         frames are already small enough not to need it
+ */
+void GRID_SetAggregation(uint8_t frames);
+
+/**
+ * @brief  Enable or disable per-row streaming packets
+ * @param  enable: 1 ships each row as a 0x5E packet the moment its
+ *         harvest is processed, overlapping wire time with the rest of
+ *         the scan; 0 restores whole-frame packets
+ * @note   Negotiated: while active no frame metadata ships and retained
+ *         frames are not updated, so NACK retransmission is unavailable.
+ *         Disabling forces the next delta frame to be a keyframe
+ */
+void GRID_SetRowStream(uint8_t enable);
+
+/**
+ * @brief  Enable or disable the activity-driven frame-rate governor
+ * @param  enable: 1 lets a quiet grid back its pacing off to the
+ *         GRID_GOV_IDLE_MS floor; 0 restores fixed pacing immediately
+ * @note   Continuous streaming only (either scan engine); burst and
+ *         snapshot captures pace themselves. Full rate resumes one
+ *         frame after first contact
+ */
+void GRID_SetGovernor(uint8_t enable);
+
+/**
+ * @brief  Select the scan engine
+ * @param  enable: 1 runs the timer-driven state machine (the production
+ *         default: deterministic pacing, foreground free for commands),
+ *         0 drops back to the blocking foreground loop
+ * @note   Takes effect at the next GRID_ScanLoop pass; the choice
+ *         persists through the config store like the other mode flags
+ */
+void GRID_SetTimerScan(uint8_t enable);
+
+/**
+ * @brief  Set the crosstalk compensation coefficient
+ * @param  coeffQ8: Ghost ratio in Q8 fixed point (18 = ~7%); 0 turns
+ *         the compensation stage off
+ */
+void GRID_SetCrosstalk(uint8_t coeffQ8);
+
+/**
+ * @brief  Enable or disable interlaced odd/even field transmission
+ * @param  enable: 1 scans and ships alternating half-frames (0x5F
+ *         field packets) for double the update rate at unchanged
+ *         baud; 0 restores progressive full frames
+ * @note   Negotiated: bypasses the delta/RLE/aggregation paths while
+ *         active. Disabling forces the next delta frame to a keyframe
+ */
+void GRID_SetInterlace(uint8_t enable);
+
+/**
+ * @brief  Persist the current host-tunable settings to the config store
+ * @retval 1 on success, 0 on any flash error
+ * @note   Appends a slot; erases the page only when all slots are spent
+ */
+uint8_t GRID_SaveConfig(void);
+
+/**
+ * @brief  Erase the persisted configuration
+ * @note   The running settings are left as they are; the next boot
+ *         comes up on the firmware defaults
+ */
+void GRID_ResetConfig(void);
+
+/**
+ * @brief  Arm the latency probe: force a marker value into one cell of
+ *         the next frame, at the point the scan pipeline commits its
+ *         output
+ * @param  row/col: target cell (ignored when out of range); must sit
+ *         inside the ROI and off dead columns, where the marker is
+ *         zeroed like any real reading
+ * @param  value: wire value to plant; the host harness matches on it
+ * @note   The injection tick goes out on the log channel as
+ *         "latinj t=<hex ms>", so the host (grid_latency.h) can put
+ *         firmware residency beside its own per-stage timestamps and
+ *         report a measured touch-to-display breakdown
+ */
+void GRID_InjectCell(uint8_t row, uint8_t col, uint16_t value);
+
+/**
+ * @brief  Queue bytes on the asynchronous log channel
+ * @param  data: Text to log (printf retargets here via __io_putchar)
+ * @param  len: Number of bytes
+ * @note   Never blocks: bytes that do not fit in the ring are dropped.
+ *         The ring is drained as 0x5C log packets at packet boundaries
+ */
+void GRID_LogWrite(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Charge one interrupt handler's run time to the ISR profile
+ * @param  startCycles: DWT->CYCCNT captured at handler entry
+ * @note   Called at the tail of every peripheral ISR (stm32f3xx_it.c).
+ *         Each handler run is one profiling sample, so the stats
+ *         packet's GRID_PROF_ISR max is the worst-case handler of the
+ *         window. With preemption grouping a preempted handler's time
+ *         includes its preemptors - that is the latency the tier
+ *         actually experienced, which is the number being watched
+ */
+void GRID_IsrProfRecord(uint32_t startCycles);
+
+/**
+ * @brief  Run the on-target microbenchmark suite and send the results
+ * @param  iterations: Passes per test (0 = GRID_BENCH_ITERS_DEFAULT,
+ *         clamped to GRID_BENCH_ITERS_MAX)
+ * @note   Stalls scanning while it runs; results go out as one 0x5D
+ *         packet with per-test min/avg/max DWT cycle counts
+ */
+void GRID_RunBenchmark(uint16_t iterations);
+
+/**
+ * @brief  Request a one-shot capture or a paced burst
+ * @param  count: Frames to capture (1 = single snapshot)
+ * @param  intervalMs: Pacing between burst frames, 0 = max rate
+ * @note   Runs on top of the idle mode: after the burst the scanner
+ *         returns to idle with the wire fully drained
+ */
+void GRID_RequestFrames(uint16_t count, uint16_t intervalMs);
+
+/**
+ * @brief  Auto-tune the settling time for this grid build
+ * @retval The settling time (us) now in effect
+ * @note   Steps the delay down while comparing readings against a
+ *         fully-settled reference; run with the grid untouched
+ */
+uint16_t GRID_CalibrateSettleTime(void);
+
+/**
+ * @brief  Start the timer-driven scan state machine (replaces ScanLoop)
+ * @param  frameIntervalMs: Frame pacing; 0 = free-running
+ */
+void GRID_StartScanTimer(uint16_t frameIntervalMs);
+
+/**
+ * @brief  Stop the timer-driven scan
+ */
+void GRID_StopScanTimer(void);
+
+/**
+ * @brief  Advance the scan state machine by one tick (TIM7 ISR context)
+ */
+void GRID_ScanTimerTick(void);
+
+/**
+ * @brief  Start the independent watchdog
+ * @note   LSI-clocked, so it fires even if the core wedges inside a
+ *         HAL_MAX_DELAY wait. Cannot be stopped once started - every
+ *         foreground loop pass must call GRID_WatchdogKick()
+ */
+void GRID_WatchdogInit(void);
+
+/**
+ * @brief  Reload the watchdog counter (call once per scan-loop pass)
+ */
+void GRID_WatchdogKick(void);
+
+/**
+ * @brief  Check (and clear) whether this boot follows a watchdog reset
+ * @retval 1 on a warm restart - main() skips the banner and settling
+ *         delays and resumes streaming with the flash-restored
+ *         baseline in well under a second
+ */
+uint8_t GRID_WasWarmReset(void);
+
 /**
  * @brief  Enable a specific row (set GPIO high)
  * @param  row: Row index (0-15)
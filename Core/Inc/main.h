@@ -42,6 +42,31 @@ extern "C" {
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
 
+/* NVIC priority tiers. All four priority bits are preemption bits
+ * (NVIC_PRIORITYGROUP_4, set in HAL_MspInit), so a lower tier can never
+ * delay a higher one: conversion timing preempts data movement, which
+ * preempts telemetry, which preempts command handling. Every ISR is
+ * flag-and-queue only - DRDY sets a chip bit, DMA completion advances
+ * the chained readout, RX bytes land in the command queue - and the
+ * deferred work runs from GRID_ScanLoop, so time spent at any tier is
+ * bounded and measured (GRID_PROF_ISR in the stats heartbeat). */
+#define GRID_IRQPRI_CONVERSION  0U  /**< DRDY EXTI + scan/row timers */
+#define GRID_IRQPRI_DATAMOVE    1U  /**< ADS1220 SPI events + SPI DMA */
+#define GRID_IRQPRI_TELEMETRY   2U  /**< UART TX DMA completion */
+#define GRID_IRQPRI_COMMAND     3U  /**< USART2 RX command bytes */
+
+/* CCM placement. The F303RE's 16 KB CCM RAM sits on the core's D/I
+ * buses with zero wait states and no contention from the SPI/UART DMA
+ * traffic on the main SRAM. DMA cannot reach CCM at all, so only
+ * CPU-private objects may carry these attributes - never a DMA source
+ * or destination buffer. GRID_CCM_BSS objects land in the NOLOAD
+ * .ccmbss section and are zeroed by the startup code; GRID_CCM_CODE
+ * functions are copied from flash into .ccmram at reset and execute
+ * without flash wait states (the linker inserts the long-branch
+ * veneers the 128 MB flash-to-CCM distance needs). */
+#define GRID_CCM_BSS    __attribute__((section(".ccmbss")))
+#define GRID_CCM_CODE   __attribute__((section(".ccmram")))
+
 /* USER CODE END EC */
 
 /* Exported macro ------------------------------------------------------------*/
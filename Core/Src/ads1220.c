@@ -13,12 +13,106 @@
 
 /* Private variables ---------------------------------------------------------*/
 
-/** @brief  Pointer to SPI handle */
-static SPI_HandleTypeDef *s_hSpi = NULL;
+/** @brief  SPI buses: [0] chips 0-3 (always set), [1] chips 4-7 (dual only) */
+static SPI_HandleTypeDef *s_hSpiBus[2] = {NULL, NULL};
+
+/** @brief  Non-zero when the chips are split across two SPI buses */
+static uint8_t s_DualBus = 0;
 
 /** @brief  ADS1220 chip handles with CS pin assignments */
 ADS1220_Handle_t g_ADS1220[ADS1220_NUM_CHIPS];
 
+/** @brief  Per-chip health state (alive flags, error counters) */
+ADS1220_Health_t g_ADS1220Health[ADS1220_NUM_CHIPS];
+
+/** @brief  Bitmask of chips that have signalled DRDY (set in EXTI context) */
+static volatile ADS1220_Mask_t s_DrdyReady = 0;
+
+/** @brief  Non-zero when the chips are free-running (ADS1220_CM_CONTINUOUS) */
+static uint8_t s_ContinuousMode = 0;
+
+/** @brief  Nominal conversion period at the configured data rate (us);
+ *          see ADS1220_SetDataRate. The power-on value matches the
+ *          1000 SPS turbo configuration ADS1220_Init programs. */
+static uint32_t s_ConvTimeUs = 1000U;
+
+/** @brief  DRDY wait bound derived from the conversion period, so slow
+ *          profiles are not cut short by a fixed 1000 SPS timeout */
+static uint32_t s_DrdyTimeoutMs = ADS1220_DRDY_TIMEOUT_MS;
+
+/** @brief  SPI prescaler currently applied to the buses; captured from
+ *          the CubeMX init, retuned by ADS1220_TuneSpiClock */
+static uint32_t s_SpiPrescaler = SPI_BAUDRATEPRESCALER_8;
+
+/** @brief  Per-channel skip masks (bit per chip): dead columns flagged
+ *          by calibration, excluded from the column scan */
+static ADS1220_Mask_t s_ChanSkip[ADS1220_CHANNELS] = {0};
+
+/**
+ * @brief  Compile-time CS descriptor table - the one copy of the CS
+ *         topology (init and the hot toggles both index it)
+ * @note   One BSRR write per toggle: BSRR[15:0] sets, BSRR[31:16] resets,
+ *         so CS assert/deassert is a single store with no HAL call.
+ */
+typedef struct {
+    GPIO_TypeDef *port;     /**< CS GPIO port */
+    uint32_t set;           /**< BSRR value driving CS high (idle) */
+    uint32_t reset;         /**< BSRR value driving CS low (selected) */
+} ADS1220_CsDesc_t;
+
+static const ADS1220_CsDesc_t s_CsDesc[ADS1220_NUM_CHIPS] = {
+    {GPIOA, GPIO_PIN_0, (uint32_t)GPIO_PIN_0 << 16U},
+    {GPIOA, GPIO_PIN_1, (uint32_t)GPIO_PIN_1 << 16U},
+    {GPIOA, GPIO_PIN_4, (uint32_t)GPIO_PIN_4 << 16U},
+    {GPIOA, GPIO_PIN_5, (uint32_t)GPIO_PIN_5 << 16U},
+    {GPIOA, GPIO_PIN_6, (uint32_t)GPIO_PIN_6 << 16U},
+    {GPIOA, GPIO_PIN_7, (uint32_t)GPIO_PIN_7 << 16U},
+    {GPIOA, GPIO_PIN_8, (uint32_t)GPIO_PIN_8 << 16U},
+    {GPIOA, GPIO_PIN_9, (uint32_t)GPIO_PIN_9 << 16U},
+#if (ADS1220_NUM_CHIPS > 8U)
+    /* 40x40 build: GPIOA is full, chips 8-9 select on GPIOB */
+    {GPIOB, GPIO_PIN_11, (uint32_t)GPIO_PIN_11 << 16U},
+    {GPIOB, GPIO_PIN_12, (uint32_t)GPIO_PIN_12 << 16U},
+#endif
+};
+
+/** @brief  Combined mask of the GPIOA CS pins for broadcast */
+#define ADS1220_CS_ALL_PINS     (GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_4 | \
+                                 GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7 | \
+                                 GPIO_PIN_8 | GPIO_PIN_9)
+
+#if (ADS1220_NUM_CHIPS > 8U)
+/** @brief  CS pins of chips 8-9 (GPIOB) for broadcast */
+#define ADS1220_CS_ALL_PINS_B   (GPIO_PIN_11 | GPIO_PIN_12)
+#endif
+
+/**
+ * @brief  Compile-time DRDY input table (all on GPIOB; PB3 skipped: SWO)
+ * @note   Each pin has its own EXTI line so every chip signals
+ *         independently. Init wires the EXTI config from this table and
+ *         the DRDY ISR maps a pin back to its chip through it, so the
+ *         topology lives in flash instead of being rebuilt into RAM.
+ */
+typedef struct {
+    GPIO_TypeDef *port;     /**< DRDY GPIO port */
+    uint16_t pin;           /**< DRDY GPIO pin (EXTI input) */
+} ADS1220_DrdyDesc_t;
+
+static const ADS1220_DrdyDesc_t s_DrdyDesc[ADS1220_NUM_CHIPS] = {
+    {GPIOB, GPIO_PIN_0},
+    {GPIOB, GPIO_PIN_1},
+    {GPIOB, GPIO_PIN_2},
+    {GPIOB, GPIO_PIN_4},
+    {GPIOB, GPIO_PIN_5},
+    {GPIOB, GPIO_PIN_6},
+    {GPIOB, GPIO_PIN_7},
+    {GPIOB, GPIO_PIN_8},
+#if (ADS1220_NUM_CHIPS > 8U)
+    {GPIOB, GPIO_PIN_9},
+    {GPIOB, GPIO_PIN_10},
+#endif
+};
+
 /** @brief  MUX register values for each channel (single-ended vs AVSS) */
 static const uint8_t s_ChannelMux[4] = {
     ADS1220_MUX_AIN0_AVSS,  /* Channel 0 */
@@ -34,30 +128,76 @@ static void ADS1220_SendCommand(uint8_t chipIndex, uint8_t cmd);
 static void ADS1220_WriteRegister(uint8_t chipIndex, uint8_t reg, uint8_t value);
 static uint8_t ADS1220_ReadRegister(uint8_t chipIndex, uint8_t reg);
 static void ADS1220_WaitDRDY(uint8_t chipIndex);
+static void ADS1220_ReadResultPair(uint8_t chipA, uint8_t chipB,
+                                   uint32_t *valA, uint32_t *valB);
+static void ADS1220_RecordStatus(uint8_t chipIndex, HAL_StatusTypeDef status);
+static uint8_t ADS1220_QualifyBus(const uint32_t ref[ADS1220_NUM_CHIPS]);
 
 /* Private functions ---------------------------------------------------------*/
 
 /**
- * @brief  Assert chip select (active LOW)
+ * @brief  Assert chip select (active LOW) - single BSRR store
  */
-static void ADS1220_CS_Low(uint8_t chipIndex)
+static inline void ADS1220_CS_Low(uint8_t chipIndex)
 {
-    if (chipIndex < ADS1220_NUM_CHIPS) {
-        HAL_GPIO_WritePin(g_ADS1220[chipIndex].cs_port, 
-                          g_ADS1220[chipIndex].cs_pin, 
-                          GPIO_PIN_RESET);
-    }
+    s_CsDesc[chipIndex].port->BSRR = s_CsDesc[chipIndex].reset;
+}
+
+/**
+ * @brief  Deassert chip select - single BSRR store
+ */
+static inline void ADS1220_CS_High(uint8_t chipIndex)
+{
+    s_CsDesc[chipIndex].port->BSRR = s_CsDesc[chipIndex].set;
+}
+
+/**
+ * @brief  Assert chip select on all chips at once (broadcast window)
+ * @note   All chips share MOSI/SCK, so with every CS low a single SPI
+ *         write is clocked into all devices simultaneously. Only valid
+ *         for write-only traffic (reads would contend on MISO).
+ *         One BSRR store per CS port.
+ */
+static inline void ADS1220_CS_AllLow(void)
+{
+    GPIOA->BSRR = (uint32_t)ADS1220_CS_ALL_PINS << 16U;
+#if (ADS1220_NUM_CHIPS > 8U)
+    GPIOB->BSRR = (uint32_t)ADS1220_CS_ALL_PINS_B << 16U;
+#endif
+}
+
+/**
+ * @brief  Deassert chip select on all chips - one BSRR store per port
+ */
+static inline void ADS1220_CS_AllHigh(void)
+{
+    GPIOA->BSRR = ADS1220_CS_ALL_PINS;
+#if (ADS1220_NUM_CHIPS > 8U)
+    GPIOB->BSRR = ADS1220_CS_ALL_PINS_B;
+#endif
 }
 
 /**
- * @brief  Deassert chip select
+ * @brief  Track the outcome of a per-chip SPI transaction
+ * @note   A run of ADS1220_MAX_CONSEC_ERR failures drops the chip from
+ *         the scan so the other columns keep streaming at full rate.
  */
-static void ADS1220_CS_High(uint8_t chipIndex)
+static void ADS1220_RecordStatus(uint8_t chipIndex, HAL_StatusTypeDef status)
 {
-    if (chipIndex < ADS1220_NUM_CHIPS) {
-        HAL_GPIO_WritePin(g_ADS1220[chipIndex].cs_port, 
-                          g_ADS1220[chipIndex].cs_pin, 
-                          GPIO_PIN_SET);
+    ADS1220_Health_t *h = &g_ADS1220Health[chipIndex];
+
+    if (status == HAL_OK) {
+        h->consecutiveErrors = 0;
+        return;
+    }
+
+    h->lastError = (uint8_t)status;
+    h->totalErrors++;
+    if (h->consecutiveErrors < 0xFFU) {
+        h->consecutiveErrors++;
+    }
+    if (h->consecutiveErrors >= ADS1220_MAX_CONSEC_ERR) {
+        h->alive = 0;
     }
 }
 
@@ -66,9 +206,14 @@ static void ADS1220_CS_High(uint8_t chipIndex)
  */
 static void ADS1220_SendCommand(uint8_t chipIndex, uint8_t cmd)
 {
+    HAL_StatusTypeDef status;
+
     ADS1220_CS_Low(chipIndex);
-    HAL_SPI_Transmit(s_hSpi, &cmd, 1, HAL_MAX_DELAY);
+    status = HAL_SPI_Transmit(g_ADS1220[chipIndex].hspi, &cmd, 1,
+                              ADS1220_SPI_TIMEOUT_MS);
     ADS1220_CS_High(chipIndex);
+
+    ADS1220_RecordStatus(chipIndex, status);
 }
 
 /**
@@ -80,10 +225,15 @@ static void ADS1220_WriteRegister(uint8_t chipIndex, uint8_t reg, uint8_t value)
     txData[0] = ADS1220_CMD_WREG | (reg << 2);  /* WREG command + address */
     txData[1] = value;
     
+    HAL_StatusTypeDef status;
+
     ADS1220_CS_Low(chipIndex);
-    HAL_SPI_Transmit(s_hSpi, txData, 2, HAL_MAX_DELAY);
+    status = HAL_SPI_Transmit(g_ADS1220[chipIndex].hspi, txData, 2,
+                              ADS1220_SPI_TIMEOUT_MS);
     ADS1220_CS_High(chipIndex);
-    
+
+    ADS1220_RecordStatus(chipIndex, status);
+
     /* Cache the value */
     if (reg < 4) {
         g_ADS1220[chipIndex].config_reg[reg] = value;
@@ -99,68 +249,359 @@ static uint8_t ADS1220_ReadRegister(uint8_t chipIndex, uint8_t reg)
     uint8_t rxData = 0;
     
     ADS1220_CS_Low(chipIndex);
-    HAL_SPI_Transmit(s_hSpi, &txData, 1, HAL_MAX_DELAY);
-    HAL_SPI_Receive(s_hSpi, &rxData, 1, HAL_MAX_DELAY);
+    HAL_SPI_Transmit(g_ADS1220[chipIndex].hspi, &txData, 1,
+                     ADS1220_SPI_TIMEOUT_MS);
+    HAL_SPI_Receive(g_ADS1220[chipIndex].hspi, &rxData, 1,
+                    ADS1220_SPI_TIMEOUT_MS);
     ADS1220_CS_High(chipIndex);
     
     return rxData;
 }
 
 /**
- * @brief  Wait for data ready (DRDY low on DOUT pin during CS low)
- * @note   For simplicity, we use a fixed delay based on data rate
+ * @brief  Read results from one chip on each bus concurrently
+ * @note   Uses IT transfers so both SPI peripherals clock at the same
+ *         time; the caller's chips must sit on different buses.
+ */
+static void ADS1220_ReadResultPair(uint8_t chipA, uint8_t chipB,
+                                   uint32_t *valA, uint32_t *valB)
+{
+    /* DOUT-direct: 24 clocked bits, no RDATA byte (see ReadResult) */
+    uint8_t txData[3] = {0, 0, 0};
+    uint8_t rxA[3] = {0, 0, 0};
+    uint8_t rxB[3] = {0, 0, 0};
+
+    ADS1220_CS_Low(chipA);
+    ADS1220_CS_Low(chipB);
+
+    HAL_SPI_TransmitReceive_IT(g_ADS1220[chipA].hspi, txData, rxA, 3);
+    HAL_SPI_TransmitReceive_IT(g_ADS1220[chipB].hspi, txData, rxB, 3);
+
+    while (HAL_SPI_GetState(g_ADS1220[chipA].hspi) != HAL_SPI_STATE_READY ||
+           HAL_SPI_GetState(g_ADS1220[chipB].hspi) != HAL_SPI_STATE_READY) {
+        /* Both 3-byte exchanges complete within microseconds */
+    }
+
+    ADS1220_CS_High(chipA);
+    ADS1220_CS_High(chipB);
+
+    *valA = ((uint32_t)rxA[0] << 16) | ((uint32_t)rxA[1] << 8) | rxA[2];
+    *valB = ((uint32_t)rxB[0] << 16) | ((uint32_t)rxB[1] << 8) | rxB[2];
+}
+
+/**
+ * @brief  Wait for data ready on a single chip
  */
 static void ADS1220_WaitDRDY(uint8_t chipIndex)
 {
-    /* At 1000 SPS turbo mode, conversion takes ~1ms
-     * Add margin for safety */
-    HAL_Delay(2);
+#if ADS1220_USE_DRDY_EXTI
+    ADS1220_WaitReady((ADS1220_Mask_t)(1UL << chipIndex));
+#else
+    /* One conversion period at the configured rate plus margin */
+    HAL_Delay(s_ConvTimeUs / 1000U + 1U);
+#endif
 }
 
 /* Exported functions --------------------------------------------------------*/
 
 /**
- * @brief  Initialize all ADS1220 chips
+ * @brief  Initialize all ADS1220 chips on a single shared SPI bus
  */
 void ADS1220_Init(SPI_HandleTypeDef *hspi)
 {
-    s_hSpi = hspi;
-    
-    /* Initialize CS pin assignments for each chip */
-    /* CS0-CS7 on PA0, PA1, PA4, PA5, PA6, PA7, PA8, PA9 */
-    g_ADS1220[0].cs_port = GPIOA; g_ADS1220[0].cs_pin = GPIO_PIN_0;
-    g_ADS1220[1].cs_port = GPIOA; g_ADS1220[1].cs_pin = GPIO_PIN_1;
-    g_ADS1220[2].cs_port = GPIOA; g_ADS1220[2].cs_pin = GPIO_PIN_4;
-    g_ADS1220[3].cs_port = GPIOA; g_ADS1220[3].cs_pin = GPIO_PIN_5;
-    g_ADS1220[4].cs_port = GPIOA; g_ADS1220[4].cs_pin = GPIO_PIN_6;
-    g_ADS1220[5].cs_port = GPIOA; g_ADS1220[5].cs_pin = GPIO_PIN_7;
-    g_ADS1220[6].cs_port = GPIOA; g_ADS1220[6].cs_pin = GPIO_PIN_8;
-    g_ADS1220[7].cs_port = GPIOA; g_ADS1220[7].cs_pin = GPIO_PIN_9;
-    
+    s_hSpiBus[0] = hspi;
+    s_hSpiBus[1] = NULL;
+    s_DualBus = 0;
+    s_SpiPrescaler = hspi->Init.BaudRatePrescaler;
+
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        g_ADS1220[i].hspi = hspi;
+    }
+
+    /* Fresh health state: every chip starts alive */
+    memset(g_ADS1220Health, 0, sizeof(g_ADS1220Health));
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        g_ADS1220Health[i].alive = 1;
+    }
+
+    /* Pin topology (CS BSRR words, DRDY inputs) lives in the const
+     * s_CsDesc / s_DrdyDesc tables in flash; nothing to copy here. */
+
+#if ADS1220_USE_DRDY_EXTI
+    /* Configure DRDY pins as falling-edge EXTI inputs (DRDY is active LOW:
+     * the falling edge marks conversion complete) */
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        GPIO_InitStruct.Pin = s_DrdyDesc[i].pin;
+        GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+        GPIO_InitStruct.Pull = GPIO_PULLUP;
+        HAL_GPIO_Init(s_DrdyDesc[i].port, &GPIO_InitStruct);
+    }
+
+    HAL_NVIC_SetPriority(EXTI0_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+    HAL_NVIC_SetPriority(EXTI1_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(EXTI1_IRQn);
+    HAL_NVIC_SetPriority(EXTI2_TSC_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(EXTI2_TSC_IRQn);
+    HAL_NVIC_SetPriority(EXTI4_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(EXTI4_IRQn);
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+#if (ADS1220_NUM_CHIPS > 8U)
+    /* Chip 9's DRDY (PB10) is the only line above EXTI9 */
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+#endif
+#endif
+
     /* Deselect all chips initially */
     for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
         ADS1220_CS_High(i);
     }
     
     HAL_Delay(10);  /* Power-on delay */
-    
-    /* Reset and configure each chip */
-    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+
+    /* Broadcast reset + configure: all chips receive identical values,
+     * so one RESET and one register payload over the shared bus replaces
+     * the old 8x serial init with interleaved delays.
+     *
+     * REG0: AIN0 vs AVSS, Gain=1, PGA bypassed
+     * REG1: 1000 SPS turbo, single-shot mode
+     * REG2: AVDD as reference (3.3V), no 50/60Hz rejection
+     * REG3: Default (no DRDY on DOUT)
+     */
+    ADS1220_BroadcastReset();
+    HAL_Delay(1);
+    ADS1220_BroadcastConfigure(
+        ADS1220_MUX_AIN0_AVSS | ADS1220_GAIN_1 | ADS1220_PGA_BYPASS,
+        ADS1220_DR_1000SPS | ADS1220_MODE_TURBO | ADS1220_CM_SINGLE,
+        ADS1220_VREF_AVDD,
+        0x00
+    );
+}
+
+/**
+ * @brief  Initialize with chips 0-3 on one bus and 4-7 on a second bus
+ */
+void ADS1220_InitDual(SPI_HandleTypeDef *hspiA, SPI_HandleTypeDef *hspiB)
+{
+    /* Run the single-bus init first, then repoint chips 4-7 and re-send
+     * their configuration over the second bus */
+    ADS1220_Init(hspiA);
+
+    s_hSpiBus[1] = hspiB;
+    s_DualBus = 1;
+
+    for (uint8_t i = ADS1220_NUM_CHIPS / 2; i < ADS1220_NUM_CHIPS; i++) {
+        g_ADS1220[i].hspi = hspiB;
         ADS1220_Reset(i);
-        HAL_Delay(1);
-        
-        /* Configure for fast single-shot readings:
-         * REG0: AIN0 vs AVSS, Gain=1, PGA bypassed
-         * REG1: 1000 SPS turbo, single-shot mode
-         * REG2: AVDD as reference (3.3V), no 50/60Hz rejection
-         * REG3: Default (no DRDY on DOUT)
-         */
-        ADS1220_Configure(i,
-            ADS1220_MUX_AIN0_AVSS | ADS1220_GAIN_1 | ADS1220_PGA_BYPASS,
-            ADS1220_DR_1000SPS | ADS1220_MODE_TURBO | ADS1220_CM_SINGLE,
-            ADS1220_VREF_AVDD,
-            0x00
-        );
+    }
+    HAL_Delay(1);
+    for (uint8_t i = ADS1220_NUM_CHIPS / 2; i < ADS1220_NUM_CHIPS; i++) {
+        ADS1220_RestoreConfig(i);
+    }
+
+    /* IT-based concurrent harvest needs the SPI IRQs unmasked */
+    if (hspiA->Instance == SPI1 || hspiB->Instance == SPI1) {
+        HAL_NVIC_SetPriority(SPI1_IRQn, GRID_IRQPRI_DATAMOVE, 0);
+        HAL_NVIC_EnableIRQ(SPI1_IRQn);
+    }
+    if (hspiA->Instance == SPI2 || hspiB->Instance == SPI2) {
+        HAL_NVIC_SetPriority(SPI2_IRQn, GRID_IRQPRI_DATAMOVE, 0);
+        HAL_NVIC_EnableIRQ(SPI2_IRQn);
+    }
+    if (hspiA->Instance == SPI3 || hspiB->Instance == SPI3) {
+        HAL_NVIC_SetPriority(SPI3_IRQn, GRID_IRQPRI_DATAMOVE, 0);
+        HAL_NVIC_EnableIRQ(SPI3_IRQn);
+    }
+}
+
+/**
+ * @brief  Forward an SPI IRQ to the driver's bus handle (for IT transfers)
+ */
+void ADS1220_SPI_IRQHandler(SPI_TypeDef *instance)
+{
+    for (uint8_t b = 0; b < 2; b++) {
+        if (s_hSpiBus[b] != NULL && s_hSpiBus[b]->Instance == instance) {
+            HAL_SPI_IRQHandler(s_hSpiBus[b]);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  Reset all chips with a single broadcast command
+ */
+void ADS1220_BroadcastReset(void)
+{
+    uint8_t cmd = ADS1220_CMD_RESET;
+
+    if (!s_DualBus) {
+        ADS1220_CS_AllLow();
+        HAL_SPI_Transmit(s_hSpiBus[0], &cmd, 1, ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_AllHigh();
+        return;
+    }
+
+    /* Dual-bus: broadcast per bus (CS of that bus's chips only) */
+    for (uint8_t b = 0; b < 2; b++) {
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_Low(i);
+        }
+        HAL_SPI_Transmit(s_hSpiBus[b], &cmd, 1, ADS1220_SPI_TIMEOUT_MS);
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_High(i);
+        }
+    }
+}
+
+/**
+ * @brief  Configure all chips with one broadcast register burst
+ */
+void ADS1220_BroadcastConfigure(uint8_t reg0, uint8_t reg1,
+                                uint8_t reg2, uint8_t reg3)
+{
+    uint8_t txData[5];
+
+    /* Burst WREG: start at REG0, count field = 4 registers (nn = 3) */
+    txData[0] = ADS1220_CMD_WREG | (ADS1220_REG0 << 2) | 0x03U;
+    txData[1] = reg0;
+    txData[2] = reg1;
+    txData[3] = reg2;
+    txData[4] = reg3;
+
+    if (!s_DualBus) {
+        ADS1220_CS_AllLow();
+        HAL_SPI_Transmit(s_hSpiBus[0], txData, 5, ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_AllHigh();
+    } else {
+        for (uint8_t b = 0; b < 2; b++) {
+            for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+                if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_Low(i);
+            }
+            HAL_SPI_Transmit(s_hSpiBus[b], txData, 5, ADS1220_SPI_TIMEOUT_MS);
+            for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+                if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_High(i);
+            }
+        }
+    }
+
+    /* Keep every shadow cache coherent with the broadcast */
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        g_ADS1220[i].config_reg[ADS1220_REG0] = reg0;
+        g_ADS1220[i].config_reg[ADS1220_REG1] = reg1;
+        g_ADS1220[i].config_reg[ADS1220_REG2] = reg2;
+        g_ADS1220[i].config_reg[ADS1220_REG3] = reg3;
+    }
+}
+
+/**
+ * @brief  Select a channel and start conversion on every chip at once
+ * @note   Broadcast counterpart of ADS1220_SelectAndStart: all chips
+ *         need the same MUX value during a row scan, so one all-CS
+ *         write-only window per bus replaces the per-chip fused
+ *         transactions. Small enough to run from an ISR - one WREG
+ *         pair plus START per bus.
+ */
+void ADS1220_BroadcastSelectAndStart(uint8_t channel)
+{
+    if (channel >= ADS1220_CHANNELS) return;
+
+    uint8_t reg0 = s_ChannelMux[channel] | ADS1220_GAIN_1 |
+                   ADS1220_PGA_BYPASS;
+    uint8_t txData[3];
+    uint16_t len = 0;
+
+    txData[len++] = ADS1220_CMD_WREG | (ADS1220_REG0 << 2);
+    txData[len++] = reg0;
+    if (!s_ContinuousMode) {
+        txData[len++] = ADS1220_CMD_START;
+    }
+
+    /* All pending results go stale the moment the restart lands */
+    s_DrdyReady = 0;
+
+    if (!s_DualBus) {
+        ADS1220_CS_AllLow();
+        HAL_SPI_Transmit(s_hSpiBus[0], txData, len,
+                         ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_AllHigh();
+    } else {
+        for (uint8_t b = 0; b < 2; b++) {
+            for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+                if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_Low(i);
+            }
+            HAL_SPI_Transmit(s_hSpiBus[b], txData, len,
+                             ADS1220_SPI_TIMEOUT_MS);
+            for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+                if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_High(i);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        g_ADS1220[i].config_reg[ADS1220_REG0] = reg0;
+    }
+}
+
+/**
+ * @brief  Park every chip in power-down mode with one broadcast command
+ * @note   Register contents survive power-down, so ADS1220_WakeAll
+ *         resumes with the existing configuration - no reconfigure pass
+ */
+void ADS1220_PowerDownAll(void)
+{
+    uint8_t cmd = ADS1220_CMD_POWERDOWN;
+
+    /* No conversions will land while parked */
+    s_DrdyReady = 0;
+
+    if (!s_DualBus) {
+        ADS1220_CS_AllLow();
+        HAL_SPI_Transmit(s_hSpiBus[0], &cmd, 1, ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_AllHigh();
+        return;
+    }
+
+    for (uint8_t b = 0; b < 2; b++) {
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_Low(i);
+        }
+        HAL_SPI_Transmit(s_hSpiBus[b], &cmd, 1, ADS1220_SPI_TIMEOUT_MS);
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_High(i);
+        }
+    }
+}
+
+/**
+ * @brief  Wake every parked chip with one broadcast START
+ * @note   START exits power-down and begins converting immediately
+ *         (free-running again if continuous mode was active)
+ */
+void ADS1220_WakeAll(void)
+{
+    uint8_t cmd = ADS1220_CMD_START;
+
+    s_DrdyReady = 0;
+
+    if (!s_DualBus) {
+        ADS1220_CS_AllLow();
+        HAL_SPI_Transmit(s_hSpiBus[0], &cmd, 1, ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_AllHigh();
+        return;
+    }
+
+    for (uint8_t b = 0; b < 2; b++) {
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_Low(i);
+        }
+        HAL_SPI_Transmit(s_hSpiBus[b], &cmd, 1, ADS1220_SPI_TIMEOUT_MS);
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_High(i);
+        }
     }
 }
 
@@ -190,58 +631,809 @@ void ADS1220_Configure(uint8_t chipIndex, uint8_t reg0, uint8_t reg1,
 void ADS1220_SetChannel(uint8_t chipIndex, uint8_t channel)
 {
     if (channel >= 4) return;
-    
+
     /* Update REG0 with new MUX setting, keep gain and PGA settings */
     uint8_t reg0 = s_ChannelMux[channel] | ADS1220_GAIN_1 | ADS1220_PGA_BYPASS;
+
+    /* Shadow cache hit: the register already holds this value, skip the
+     * SPI write entirely (common when re-reading the same column) */
+    if (g_ADS1220[chipIndex].config_reg[ADS1220_REG0] == reg0) {
+        return;
+    }
+
+    /* In continuous mode a config write restarts the running conversion,
+     * so the pending result becomes stale: mark the chip busy again */
+    if (s_ContinuousMode) {
+        s_DrdyReady &= (ADS1220_Mask_t)~(1UL << chipIndex);
+    }
+
     ADS1220_WriteRegister(chipIndex, ADS1220_REG0, reg0);
 }
 
 /**
- * @brief  Start conversion and read result
+ * @brief  Re-apply the cached configuration to one chip in a single burst
+ * @note   For use after ADS1220_Reset: the shadow cache still holds the
+ *         wanted values while the chip is back at defaults.
  */
-uint32_t ADS1220_ReadData(uint8_t chipIndex)
+void ADS1220_RestoreConfig(uint8_t chipIndex)
 {
-    uint8_t rxData[3] = {0, 0, 0};
-    
-    /* Start conversion */
+    uint8_t txData[5];
+
+    /* Burst WREG: start at REG0, count field = 4 registers (nn = 3) */
+    txData[0] = ADS1220_CMD_WREG | (ADS1220_REG0 << 2) | 0x03U;
+    txData[1] = g_ADS1220[chipIndex].config_reg[ADS1220_REG0];
+    txData[2] = g_ADS1220[chipIndex].config_reg[ADS1220_REG1];
+    txData[3] = g_ADS1220[chipIndex].config_reg[ADS1220_REG2];
+    txData[4] = g_ADS1220[chipIndex].config_reg[ADS1220_REG3];
+
+    HAL_StatusTypeDef status;
+
+    ADS1220_CS_Low(chipIndex);
+    status = HAL_SPI_Transmit(g_ADS1220[chipIndex].hspi, txData, 5,
+                              ADS1220_SPI_TIMEOUT_MS);
+    ADS1220_CS_High(chipIndex);
+
+    ADS1220_RecordStatus(chipIndex, status);
+}
+
+/**
+ * @brief  Select channel and start conversion in a single CS window
+ * @note   Fuses the 2-byte WREG of REG0 with the START command into one
+ *         SPI transaction. In continuous mode the MUX write alone
+ *         restarts the conversion, so START is omitted.
+ */
+void ADS1220_SelectAndStart(uint8_t chipIndex, uint8_t channel)
+{
+    ADS1220_SelectAndStartGain(chipIndex, channel, 0U);
+}
+
+/**
+ * @brief  Select channel, PGA gain and start conversion in one CS window
+ * @note   Gain-boosted variant of ADS1220_SelectAndStart for the
+ *         auto-ranging re-read pass. Gains up to 4 remain available
+ *         with the PGA bypassed, which the single-ended AINx-AVSS
+ *         inputs require. The shadow cache is updated, so the next
+ *         gain-1 select (per-chip or broadcast) rewrites REG0 and no
+ *         explicit restore step is needed.
+ */
+void ADS1220_SelectAndStartGain(uint8_t chipIndex, uint8_t channel,
+                                uint8_t gainShift)
+{
+    if (channel >= 4 || gainShift > 2U) return;
+
+    uint8_t reg0 = (uint8_t)(s_ChannelMux[channel] | (gainShift << 1)
+                             | ADS1220_PGA_BYPASS);
+    uint8_t txData[3];
+    uint16_t len = 0;
+
+    /* Elide the WREG when the shadow cache already matches (no-op MUX
+     * switch); the START below still restarts the conversion */
+    if (g_ADS1220[chipIndex].config_reg[ADS1220_REG0] != reg0) {
+        txData[len++] = ADS1220_CMD_WREG | (ADS1220_REG0 << 2);
+        txData[len++] = reg0;
+    }
+    if (!s_ContinuousMode) {
+        txData[len++] = ADS1220_CMD_START;
+    }
+
+    /* Either path restarts the conversion; in continuous mode with no
+     * register change we simply wait out the next free-running result */
+    s_DrdyReady &= (ADS1220_Mask_t)~(1UL << chipIndex);
+
+    if (len > 0) {
+        HAL_StatusTypeDef status;
+
+        ADS1220_CS_Low(chipIndex);
+        status = HAL_SPI_Transmit(g_ADS1220[chipIndex].hspi, txData, len,
+                                  ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_High(chipIndex);
+
+        ADS1220_RecordStatus(chipIndex, status);
+    }
+
+    g_ADS1220[chipIndex].config_reg[ADS1220_REG0] = reg0;
+}
+
+/**
+ * @brief  Switch all chips between single-shot and continuous conversion
+ */
+void ADS1220_SetConversionMode(uint8_t continuous)
+{
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        /* Preserve DR and MODE bits from the shadow cache, replace CM */
+        uint8_t reg1 = g_ADS1220[i].config_reg[ADS1220_REG1];
+        reg1 &= (uint8_t)~ADS1220_CM_CONTINUOUS;
+        if (continuous) {
+            reg1 |= ADS1220_CM_CONTINUOUS;
+        }
+        ADS1220_WriteRegister(i, ADS1220_REG1, reg1);
+    }
+
+    s_ContinuousMode = continuous ? 1U : 0U;
+
+    /* Continuous mode still needs one START to begin free-running */
+    if (continuous) {
+        for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+            ADS1220_StartConversion(i);
+        }
+    }
+}
+
+/**
+ * @brief  Query the current conversion mode
+ */
+uint8_t ADS1220_GetConversionMode(void)
+{
+    return s_ContinuousMode;
+}
+
+/**
+ * @brief  Change data rate, operating mode and mains rejection at runtime
+ * @note   DR and MODE replace their REG1 fields with CM/TS/BCS kept from
+ *         the shadow; the rejection bits replace their REG2 field with
+ *         the reference selection kept. One WREG burst of REG1+REG2 per
+ *         bus reaches every chip at once, BroadcastConfigure-style.
+ */
+void ADS1220_SetDataRate(uint8_t drModeBits, uint8_t rejectBits,
+                         uint32_t convTimeUs)
+{
+    uint8_t reg1 = (uint8_t)((g_ADS1220[0].config_reg[ADS1220_REG1]
+                              & 0x07U) | drModeBits);
+    uint8_t reg2 = (uint8_t)((g_ADS1220[0].config_reg[ADS1220_REG2]
+                              & (uint8_t)~0x30U) | rejectBits);
+    uint8_t txData[3];
+
+    /* Burst WREG: start at REG1, count field = 2 registers (nn = 1) */
+    txData[0] = ADS1220_CMD_WREG | (ADS1220_REG1 << 2) | 0x01U;
+    txData[1] = reg1;
+    txData[2] = reg2;
+
+    /* In-flight conversions finish at the old rate: drop them */
+    s_DrdyReady = 0;
+
+    if (!s_DualBus) {
+        ADS1220_CS_AllLow();
+        HAL_SPI_Transmit(s_hSpiBus[0], txData, 3, ADS1220_SPI_TIMEOUT_MS);
+        ADS1220_CS_AllHigh();
+    } else {
+        for (uint8_t b = 0; b < 2; b++) {
+            for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+                if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_Low(i);
+            }
+            HAL_SPI_Transmit(s_hSpiBus[b], txData, 3,
+                             ADS1220_SPI_TIMEOUT_MS);
+            for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+                if (g_ADS1220[i].hspi == s_hSpiBus[b]) ADS1220_CS_High(i);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        g_ADS1220[i].config_reg[ADS1220_REG1] = reg1;
+        g_ADS1220[i].config_reg[ADS1220_REG2] = reg2;
+    }
+
+    if (convTimeUs == 0U) {
+        convTimeUs = 1U;
+    }
+    s_ConvTimeUs = convTimeUs;
+    s_DrdyTimeoutMs = convTimeUs / 1000U + 2U;
+
+    /* Free-running chips resume converting at the new rate on their
+     * own; single-shot chips wait for the next START as usual */
+    if (s_ContinuousMode) {
+        ADS1220_WakeAll();
+    }
+}
+
+/**
+ * @brief  Nominal conversion period at the current data rate
+ */
+uint32_t ADS1220_GetConvTimeUs(void)
+{
+    return s_ConvTimeUs;
+}
+
+/**
+ * @brief  Apply a new SPI clock prescaler to every ADS1220 bus
+ * @note   CR1.BR may only change with SPE clear, so each bus is briefly
+ *         disabled around the rewrite; the handle's Init field is kept
+ *         in step so a HAL re-init does not silently revert the clock.
+ */
+void ADS1220_SetSpiPrescaler(uint32_t prescaler)
+{
+    if (s_hSpiBus[0] == NULL || (prescaler & ~SPI_CR1_BR) != 0U) {
+        return;
+    }
+
+    for (uint8_t b = 0; b < 2; b++) {
+        SPI_HandleTypeDef *hspi = s_hSpiBus[b];
+        if (hspi == NULL) {
+            continue;
+        }
+        while (__HAL_SPI_GET_FLAG(hspi, SPI_FLAG_BSY)) {
+            /* Transfers here are bounded (see ADS1220_SPI_TIMEOUT_MS) */
+        }
+        __HAL_SPI_DISABLE(hspi);
+        MODIFY_REG(hspi->Instance->CR1, SPI_CR1_BR, prescaler);
+        hspi->Init.BaudRatePrescaler = prescaler;
+        __HAL_SPI_ENABLE(hspi);
+    }
+
+    s_SpiPrescaler = prescaler;
+}
+
+/**
+ * @brief  SPI clock prescaler currently applied to the ADS1220 buses
+ */
+uint32_t ADS1220_GetSpiPrescaler(void)
+{
+    return s_SpiPrescaler;
+}
+
+/**
+ * @brief  Exercise every alive chip at the current SPI clock
+ * @param  ref: Per-chip channel-0 reference readings taken at the
+ *         slowest ladder rate
+ * @retval 1 when every check passed, 0 on the first mismatch
+ * @note   Two layers: REG0 write/readback with alternating bit patterns
+ *         catches shifted or sampled-late bits on both MOSI and MISO,
+ *         then a live conversion compared against the slow-clock
+ *         reference catches errors the pattern test cannot (DOUT-direct
+ *         readouts never echo through a register). REG0 is safe to
+ *         scribble on - every field is plain read/write and the final
+ *         write puts the cached value back.
+ */
+static uint8_t ADS1220_QualifyBus(const uint32_t ref[ADS1220_NUM_CHIPS])
+{
+    static const uint8_t patterns[4] = {0x55U, 0xAAU, 0x0FU, 0xF0U};
+
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        if (!g_ADS1220Health[i].alive) {
+            continue;
+        }
+
+        uint8_t saved = g_ADS1220[i].config_reg[ADS1220_REG0];
+        uint8_t clean = 1;
+
+        for (uint8_t p = 0; p < 4U && clean; p++) {
+            ADS1220_WriteRegister(i, ADS1220_REG0, patterns[p]);
+            clean = (ADS1220_ReadRegister(i, ADS1220_REG0) == patterns[p]);
+        }
+        ADS1220_WriteRegister(i, ADS1220_REG0, saved);
+        if (!clean) {
+            return 0;
+        }
+
+        uint32_t v = ADS1220_ReadChannel(i, 0);
+        uint32_t diff = (v > ref[i]) ? (v - ref[i]) : (ref[i] - v);
+        if (diff > ADS1220_TUNE_CONV_TOL) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief  Qualify the bus at increasing SPI clocks and keep the fastest
+ *         clean prescaler
+ * @note   On the 36 MHz APB1 buses the ladder runs 1.125 / 2.25 / 4.5 /
+ *         9 MHz; prescaler 2 (18 MHz) exceeds the ADS1220's rated SCLK
+ *         and is never offered. References are captured at the slowest
+ *         rung so a marginal bus cannot corrupt its own yardstick, and
+ *         the first failed rung drops straight back to the last clean
+ *         one - the worst outcome is the slowest entry.
+ */
+uint32_t ADS1220_TuneSpiClock(void)
+{
+    static const uint32_t ladder[] = {
+        SPI_BAUDRATEPRESCALER_32,
+        SPI_BAUDRATEPRESCALER_16,
+        SPI_BAUDRATEPRESCALER_8,
+        SPI_BAUDRATEPRESCALER_4,
+    };
+    uint32_t ref[ADS1220_NUM_CHIPS] = {0};
+    uint32_t best = ladder[0];
+
+    if (s_hSpiBus[0] == NULL) {
+        return s_SpiPrescaler;
+    }
+
+    ADS1220_SetSpiPrescaler(ladder[0]);
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        if (g_ADS1220Health[i].alive) {
+            ref[i] = ADS1220_ReadChannel(i, 0);
+        }
+    }
+
+    for (uint8_t step = 1;
+         step < sizeof(ladder) / sizeof(ladder[0]); step++) {
+        ADS1220_SetSpiPrescaler(ladder[step]);
+        if (!ADS1220_QualifyBus(ref)) {
+            break;
+        }
+        best = ladder[step];
+    }
+
+    ADS1220_SetSpiPrescaler(best);
+    return best;
+}
+
+/**
+ * @brief  Start a conversion on one chip (non-blocking)
+ */
+void ADS1220_StartConversion(uint8_t chipIndex)
+{
+    /* Mark this chip busy before the START command so the DRDY edge
+     * cannot race the flag clear */
+    s_DrdyReady &= (ADS1220_Mask_t)~(1UL << chipIndex);
     ADS1220_SendCommand(chipIndex, ADS1220_CMD_START);
-    
-    /* Wait for conversion complete */
-    ADS1220_WaitDRDY(chipIndex);
-    
-    /* Read 24-bit result */
-    uint8_t cmd = ADS1220_CMD_RDATA;
+}
+
+/**
+ * @brief  Block until the chips in mask have signalled DRDY
+ */
+void ADS1220_WaitReady(ADS1220_Mask_t readyMask)
+{
+    uint32_t start = HAL_GetTick();
+
+    while ((s_DrdyReady & readyMask) != readyMask) {
+        if ((HAL_GetTick() - start) > s_DrdyTimeoutMs) {
+            /* Missed edge (chip not wired, glitch): the timeout itself
+             * is longer than a conversion, so the data is ready anyway */
+            break;
+        }
+        /* Sleep until any interrupt - the DRDY EXTI edge wakes us the
+         * moment a conversion lands, and SysTick (1 ms) guarantees the
+         * timeout check above keeps making progress */
+        __WFI();
+    }
+}
+
+/**
+ * @brief  Current DRDY bitmask without blocking (for cooperative scans)
+ */
+ADS1220_Mask_t ADS1220_ReadyMask(void)
+{
+    return s_DrdyReady;
+}
+
+/**
+ * @brief  DRDY EXTI handler, call from HAL_GPIO_EXTI_Callback
+ * @note   Hottest interrupt path in the system (one entry per chip per
+ *         conversion), so the handler body runs from zero-wait-state
+ *         CCM RAM
+ */
+GRID_CCM_CODE void ADS1220_DrdyISR(uint16_t GPIO_Pin)
+{
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        if (s_DrdyDesc[i].pin == GPIO_Pin) {
+            s_DrdyReady |= (ADS1220_Mask_t)(1UL << i);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  HAL EXTI callback (DRDY lines on GPIOB)
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    ADS1220_DrdyISR(GPIO_Pin);
+}
+
+/**
+ * @brief  Read the latest conversion result (no START, no wait)
+ */
+uint32_t ADS1220_ReadResult(uint8_t chipIndex)
+{
+    /* DOUT-direct readout: once DRDY falls the chip presents the
+     * result on DOUT by itself, so clocking 24 bits is enough - no
+     * RDATA command byte. Every caller reads exactly once per DRDY
+     * edge, which is the pattern this shortcut requires; RDATA only
+     * buys re-reads at arbitrary times, which nothing here does.
+     * One byte in four off every conversion readout on the bus. */
+    uint8_t txData[3] = {0, 0, 0};
+    uint8_t rxData[3] = {0, 0, 0};
+
+    HAL_StatusTypeDef status;
+
     ADS1220_CS_Low(chipIndex);
-    HAL_SPI_Transmit(s_hSpi, &cmd, 1, HAL_MAX_DELAY);
-    HAL_SPI_Receive(s_hSpi, rxData, 3, HAL_MAX_DELAY);
+    status = HAL_SPI_TransmitReceive(g_ADS1220[chipIndex].hspi, txData,
+                                     rxData, 3, ADS1220_SPI_TIMEOUT_MS);
     ADS1220_CS_High(chipIndex);
-    
-    /* Combine bytes (MSB first) */
-    uint32_t value = ((uint32_t)rxData[0] << 16) | 
-                     ((uint32_t)rxData[1] << 8) | 
+
+    ADS1220_RecordStatus(chipIndex, status);
+
+    /* Result bytes arrive MSB first */
+    uint32_t value = ((uint32_t)rxData[0] << 16) |
+                     ((uint32_t)rxData[1] << 8) |
                      ((uint32_t)rxData[2]);
-    
+
     return value;
 }
 
+/**
+ * @brief  Start conversion and read result
+ */
+uint32_t ADS1220_ReadData(uint8_t chipIndex)
+{
+    /* Start conversion */
+    ADS1220_StartConversion(chipIndex);
+
+    /* Wait for conversion complete */
+    ADS1220_WaitDRDY(chipIndex);
+
+    return ADS1220_ReadResult(chipIndex);
+}
+
 /**
  * @brief  Read a specific channel
  */
 uint32_t ADS1220_ReadChannel(uint8_t chipIndex, uint8_t channel)
 {
-    ADS1220_SetChannel(chipIndex, channel);
-    return ADS1220_ReadData(chipIndex);
+    ADS1220_SelectAndStart(chipIndex, channel);
+    ADS1220_WaitDRDY(chipIndex);
+    return ADS1220_ReadResult(chipIndex);
+}
+
+/**
+ * @brief  Switch one chip to the temperature sensor and start converting
+ * @note   Sets the TS bit with a raw write so the shadow cache keeps the
+ *         normal (TS clear) REG1 value - ADS1220_FinishTemperature then
+ *         restores the analog path with a single cached write
+ */
+void ADS1220_StartTemperature(uint8_t chipIndex)
+{
+    uint8_t reg1 = g_ADS1220[chipIndex].config_reg[ADS1220_REG1]
+                   | ADS1220_TS_ENABLE;
+    uint8_t txData[3];
+    uint16_t len = 0;
+
+    txData[len++] = ADS1220_CMD_WREG | (ADS1220_REG1 << 2);
+    txData[len++] = reg1;
+    /* In continuous mode the config write alone restarts conversion */
+    if (!s_ContinuousMode) {
+        txData[len++] = ADS1220_CMD_START;
+    }
+
+    s_DrdyReady &= (ADS1220_Mask_t)~(1UL << chipIndex);
+
+    HAL_StatusTypeDef status;
+
+    ADS1220_CS_Low(chipIndex);
+    status = HAL_SPI_Transmit(g_ADS1220[chipIndex].hspi, txData, len,
+                              ADS1220_SPI_TIMEOUT_MS);
+    ADS1220_CS_High(chipIndex);
+
+    ADS1220_RecordStatus(chipIndex, status);
+}
+
+/**
+ * @brief  Collect a finished temperature conversion and drop back to the
+ *         normal analog configuration
+ * @note   In TS mode the 14-bit result sits in the top bits of the
+ *         24-bit word, LSB = 1/32 degC (two's complement)
+ */
+int16_t ADS1220_FinishTemperature(uint8_t chipIndex)
+{
+    uint32_t raw = ADS1220_ReadResult(chipIndex);
+
+    /* Restore the cached REG1 (TS clear); in continuous mode this also
+     * restarts normal conversions, so mark the pending result stale */
+    ADS1220_WriteRegister(chipIndex, ADS1220_REG1,
+                          g_ADS1220[chipIndex].config_reg[ADS1220_REG1]);
+    if (s_ContinuousMode) {
+        s_DrdyReady &= (ADS1220_Mask_t)~(1UL << chipIndex);
+    }
+
+    int16_t code = (int16_t)((raw >> 10) & 0x3FFFU);
+    if (code & 0x2000) {
+        code -= 0x4000;     /* Sign-extend the 14-bit result */
+    }
+    return code;
+}
+
+/**
+ * @brief  Blocking on-die temperature read (start, wait, collect)
+ */
+int16_t ADS1220_ReadTemperature(uint8_t chipIndex)
+{
+    ADS1220_StartTemperature(chipIndex);
+    ADS1220_WaitDRDY(chipIndex);
+    return ADS1220_FinishTemperature(chipIndex);
+}
+
+/**
+ * @brief  One in-flight DMA harvest sequence per SPI bus
+ * @note   The F3's DMA has no hardware descriptor lists, so the chain
+ *         is advanced by the SPI transfer-complete interrupt instead:
+ *         the ISR's whole job is store result, CS up, next CS down,
+ *         restart DMA - a handful of instructions per chip. Between
+ *         chips the CPU never touches the bus.
+ */
+typedef struct {
+    uint8_t chips[ADS1220_NUM_CHIPS];  /* Harvest order on this bus */
+    volatile uint8_t pos;              /* Next chip to complete */
+    uint8_t count;
+    uint8_t channel;
+    uint32_t *values;
+    uint8_t tx[3];
+    uint8_t rx[3];
+    volatile uint8_t busy;
+} ADS1220_HarvestChain_t;
+
+static ADS1220_HarvestChain_t s_Chain[2];
+
+/**
+ * @brief  Kick the DMA exchange for the chain's current chip
+ * @note   Runs in thread context for the first chip and interrupt
+ *         context for the rest; HAL has marked the bus READY before
+ *         the completion callback fires, so restarting here is safe
+ */
+static uint8_t ADS1220_ChainKick(uint8_t bus)
+{
+    ADS1220_HarvestChain_t *chain = &s_Chain[bus];
+    uint8_t chip = chain->chips[chain->pos];
+
+    ADS1220_CS_Low(chip);
+    if (HAL_SPI_TransmitReceive_DMA(s_hSpiBus[bus], chain->tx,
+                                    chain->rx, 3) != HAL_OK) {
+        ADS1220_CS_High(chip);
+        ADS1220_RecordStatus(chip, HAL_ERROR);
+        chain->busy = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  Completion step: store the result and advance the chain
+ */
+static void ADS1220_ChainAdvance(uint8_t bus)
+{
+    ADS1220_HarvestChain_t *chain = &s_Chain[bus];
+    uint8_t chip = chain->chips[chain->pos];
+
+    ADS1220_CS_High(chip);
+    chain->values[chip * ADS1220_CHANNELS + chain->channel] =
+        ((uint32_t)chain->rx[0] << 16) |
+        ((uint32_t)chain->rx[1] << 8) |
+        (uint32_t)chain->rx[2];
+    ADS1220_RecordStatus(chip, HAL_OK);
+
+    chain->pos++;
+    if (chain->pos < chain->count) {
+        (void)ADS1220_ChainKick(bus);
+    } else {
+        chain->busy = 0;
+    }
+}
+
+/**
+ * @brief  HAL completion callback for the DMA harvest exchanges
+ * @note   ReadResultPair's IT transfers land here too; those poll the
+ *         bus state themselves, so completions with no chain running
+ *         are ignored
+ */
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    for (uint8_t b = 0; b < 2; b++) {
+        if (s_Chain[b].busy && s_hSpiBus[b] == hspi) {
+            ADS1220_ChainAdvance(b);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  HAL error callback: fail the chain instead of wedging it
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    for (uint8_t b = 0; b < 2; b++) {
+        ADS1220_HarvestChain_t *chain = &s_Chain[b];
+        if (chain->busy && s_hSpiBus[b] == hspi) {
+            uint8_t chip = chain->chips[chain->pos];
+            ADS1220_CS_High(chip);
+            ADS1220_RecordStatus(chip, HAL_ERROR);
+            chain->busy = 0;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  Start the DMA harvest chain without waiting
+ */
+uint8_t ADS1220_HarvestStart(ADS1220_Mask_t aliveMask, uint8_t channel,
+                             uint32_t values[ADS1220_TOTAL_CHANNELS])
+{
+    uint8_t started = 0;
+
+    for (uint8_t b = 0; b < 2; b++) {
+        ADS1220_HarvestChain_t *chain = &s_Chain[b];
+
+        if (s_hSpiBus[b] == NULL || s_hSpiBus[b]->hdmarx == NULL ||
+            s_hSpiBus[b]->hdmatx == NULL) {
+            continue;
+        }
+
+        chain->count = 0;
+        for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+            if ((aliveMask & (1UL << chip)) &&
+                g_ADS1220[chip].hspi == s_hSpiBus[b]) {
+                chain->chips[chain->count++] = chip;
+            }
+        }
+        if (chain->count == 0) {
+            continue;
+        }
+
+        chain->pos = 0;
+        chain->channel = channel;
+        chain->values = values;
+        /* DOUT-direct: the chips present data unprompted after DRDY,
+         * so the exchange is 3 NOP bytes - no RDATA command */
+        chain->tx[0] = 0;
+        chain->tx[1] = 0;
+        chain->tx[2] = 0;
+        chain->busy = 1;
+        if (ADS1220_ChainKick(b)) {
+            started = 1;
+        }
+    }
+    return started;
+}
+
+/**
+ * @brief  Block (WFI) until a started harvest chain has finished
+ */
+void ADS1220_HarvestFinish(void)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (s_Chain[0].busy || s_Chain[1].busy) {
+        if ((HAL_GetTick() - start) > ADS1220_SPI_TIMEOUT_MS) {
+            /* Wedged transfer (chip unplugged mid-exchange): abort so
+             * the scan degrades to the blocking path instead of dying */
+            for (uint8_t b = 0; b < 2; b++) {
+                if (s_Chain[b].busy) {
+                    HAL_SPI_Abort(s_hSpiBus[b]);
+                    ADS1220_CS_High(s_Chain[b].chips[s_Chain[b].pos]);
+                    ADS1220_RecordStatus(s_Chain[b].chips[s_Chain[b].pos],
+                                         HAL_TIMEOUT);
+                    s_Chain[b].busy = 0;
+                }
+            }
+            return;
+        }
+        __WFI();    /* The chain's DMA interrupts wake us */
+    }
+}
+
+/**
+ * @brief  DMA-chained harvest of one channel from all alive chips
+ */
+uint8_t ADS1220_HarvestRow(ADS1220_Mask_t aliveMask, uint8_t channel,
+                           uint32_t values[ADS1220_TOTAL_CHANNELS])
+{
+    if (!ADS1220_HarvestStart(aliveMask, channel, values)) {
+        return 0;
+    }
+    ADS1220_HarvestFinish();
+    return 1;
 }
 
 /**
- * @brief  Read all 32 columns
+ * @brief  Read all columns
+ * @note   Pipelined: each chip has its own converter, so for each channel
+ *         index we start every chip back-to-back, wait out a single
+ *         conversion period, then harvest all the results. A full row
+ *         costs 4 conversion waits instead of one per column.
  */
 void ADS1220_ReadAllColumns(uint32_t values[ADS1220_TOTAL_CHANNELS])
 {
-    for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
-        for (uint8_t ch = 0; ch < ADS1220_CHANNELS; ch++) {
-            uint8_t colIndex = chip * ADS1220_CHANNELS + ch;
-            values[colIndex] = ADS1220_ReadChannel(chip, ch);
+    ADS1220_Mask_t aliveMask = ADS1220_GetAliveMask();
+
+    for (uint8_t ch = 0; ch < ADS1220_CHANNELS; ch++) {
+        /* Chips whose input on this channel is skip-listed sit the
+         * round out alongside the dead chips */
+        ADS1220_Mask_t chMask =
+            aliveMask & (ADS1220_Mask_t)~s_ChanSkip[ch];
+
+        /* Phase 1: select this channel and restart conversion on the
+         * participating chips, one fused SPI transaction per chip. Dead
+         * chips are skipped so a flaky joint cannot stall the whole
+         * scan; skip-listed columns read back as zero. */
+        for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+            if (chMask & (1U << chip)) {
+                ADS1220_SelectAndStart(chip, ch);
+            } else {
+                values[chip * ADS1220_CHANNELS + ch] = 0;
+            }
+        }
+        if (chMask == 0U) {
+            /* Nothing converting: the whole round (and its conversion
+             * wait) is elided */
+            continue;
+        }
+
+        /* Phase 2: wait for every participating chip to signal DRDY
+         * (they convert in parallel, so this costs a single conversion
+         * period) */
+        ADS1220_WaitReady(chMask);
+
+        /* Phase 3: harvest the results. Preferred path is the DMA
+         * chain - the CPU sleeps while the transfer-complete interrupt
+         * walks the chips (both buses run their chains concurrently).
+         * Falls back to blocking reads when DMA is not configured. */
+        if (ADS1220_HarvestRow(chMask, ch, values)) {
+            continue;
+        }
+        if (s_DualBus) {
+            for (uint8_t pair = 0; pair < ADS1220_NUM_CHIPS / 2; pair++) {
+                uint8_t chipA = pair;
+                uint8_t chipB = pair + ADS1220_NUM_CHIPS / 2;
+                if ((chMask & (1U << chipA)) && (chMask & (1U << chipB))) {
+                    ADS1220_ReadResultPair(chipA, chipB,
+                        &values[chipA * ADS1220_CHANNELS + ch],
+                        &values[chipB * ADS1220_CHANNELS + ch]);
+                } else {
+                    if (chMask & (1U << chipA)) {
+                        values[chipA * ADS1220_CHANNELS + ch] =
+                            ADS1220_ReadResult(chipA);
+                    }
+                    if (chMask & (1U << chipB)) {
+                        values[chipB * ADS1220_CHANNELS + ch] =
+                            ADS1220_ReadResult(chipB);
+                    }
+                }
+            }
+        } else {
+            for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                if (chMask & (1U << chip)) {
+                    values[chip * ADS1220_CHANNELS + ch] =
+                        ADS1220_ReadResult(chip);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief  Exclude chips from one channel index of the column scan
+ */
+void ADS1220_SetChannelSkip(uint8_t channel, ADS1220_Mask_t chipMask)
+{
+    if (channel >= ADS1220_CHANNELS) return;
+
+    s_ChanSkip[channel] = chipMask;
+}
+
+/**
+ * @brief  Bitmask of chips still in the scan (bit set = alive)
+ */
+ADS1220_Mask_t ADS1220_GetAliveMask(void)
+{
+    ADS1220_Mask_t mask = 0;
+
+    for (uint8_t i = 0; i < ADS1220_NUM_CHIPS; i++) {
+        if (g_ADS1220Health[i].alive) {
+            mask |= (ADS1220_Mask_t)(1UL << i);
         }
     }
+    return mask;
+}
+
+/**
+ * @brief  Mark a chip alive again and clear its error counters
+ */
+void ADS1220_ReviveChip(uint8_t chipIndex)
+{
+    if (chipIndex >= ADS1220_NUM_CHIPS) return;
+
+    g_ADS1220Health[chipIndex].alive = 1;
+    g_ADS1220Health[chipIndex].consecutiveErrors = 0;
 }
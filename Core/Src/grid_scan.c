@@ -1,7 +1,7 @@
 /**
  ******************************************************************************
  * @file           : grid_scan.c
- * @brief          : 16x32 Grid Scanning Engine (ADS1220 Version)
+ * @brief          : Grid Scanning Engine (ADS1220 Version)
  * @author         : Capstone Project
  * @date           : 2026-01-13
  ******************************************************************************
@@ -15,183 +15,4164 @@
 
 GridData_t g_GridData;
 
+/** @brief  TIM7 handle driving the scan state machine (100us ticks) */
+TIM_HandleTypeDef g_hScanTim;
+
+/** @brief  TIM2 handle: free-running 1MHz row timeline. Compare channel
+ *          1 closes settling windows on the microsecond instead of
+ *          rounding them up to a 100us scan tick or busy-waiting. */
+TIM_HandleTypeDef g_hRowTim;
+
 static UART_HandleTypeDef *s_hUart = NULL;
-static uint8_t s_TxBuffer[PACKET_TOTAL_SIZE];
+
+/** @brief  Double-buffered TX packets, one per frame half */
+static uint8_t s_TxBuffer[2][PACKET_TOTAL_SIZE];
+
+/** @brief  Non-zero while a DMA transmit is in flight */
+static volatile uint8_t s_TxBusy = 0;
+
+/** @brief  Foreground claim on the frame boundary: while set, the timer
+ *          scan machine neither starts a new frame nor initiates any
+ *          transmit, so command handlers and telemetry (which may block
+ *          for milliseconds) run purely in thread context */
+static volatile uint8_t s_FgBoundary = 0;
+
+/** @brief  TX packet for binned half-resolution preview frames */
+static uint8_t s_PreviewBuffer[PREVIEW_TOTAL_SIZE];
+
+/** @brief  Frame lifecycle per double-buffer half: a finished scan
+ *          seals its half immutable, and the scan engines only reuse a
+ *          half no reader holds (single writer, thread-mode readers) */
+static struct {
+    uint32_t seq;               /**< Sequence number at seal time */
+    volatile uint8_t sealed;    /**< 1 = immutable, safe to view */
+    volatile uint8_t readers;   /**< Outstanding acquired views */
+} s_FrameSlots[2];
+
+/** @brief  Most recently sealed half (0xFF until the first seal) */
+static volatile uint8_t s_PublishedSlot = 0xFF;
+
+/** @brief  Single-byte RX buffer for the interrupt-driven command path */
+static uint8_t s_RxByte;
+
+/** @brief  Baud rate a host command asked for, applied between packets
+ *          (0 = no change pending) */
+static volatile uint32_t s_PendingBaud = 0;
+
+/** @brief  Frames left to hear GRID_CMD_BAUD_CONFIRM before reverting
+ *          to the default rate (0 = not waiting for a confirm) */
+static volatile uint8_t s_BaudConfirmWait = 0;
+
+/** @brief  Alternate transport send hook; NULL = UART/DMA path */
+static GRID_TransportSend_t s_TransportSend = NULL;
+
+/** @brief  Argument byte count per command opcode (index: cmd - 0xC0) */
+static const uint8_t s_CmdArgLen[] = {
+    0U,  /* GRID_CMD_CALIBRATE */
+    2U,  /* GRID_CMD_SET_THRESHOLD */
+    6U,  /* GRID_CMD_SET_ROI */
+    0U,  /* GRID_CMD_CLEAR_ROI */
+    1U,  /* GRID_CMD_SET_PACKED */
+    1U,  /* GRID_CMD_SET_DELTA */
+    1U,  /* GRID_CMD_SET_MEDIAN */
+    1U,  /* GRID_CMD_SET_FILTER */
+    1U,  /* GRID_CMD_SET_OVERSAMPLE */
+    1U,  /* GRID_CMD_SET_ADAPTIVE */
+    1U,  /* GRID_CMD_SET_COBS */
+    2U,  /* GRID_CMD_SET_SETTLE */
+    1U,  /* GRID_CMD_STREAM */
+    0U,  /* GRID_CMD_SNAPSHOT */
+    4U,  /* GRID_CMD_BURST */
+    4U,  /* GRID_CMD_NACK */
+    1U,  /* GRID_CMD_SET_RLE */
+    1U,  /* GRID_CMD_SET_AGG */
+    2U,  /* GRID_CMD_BENCHMARK */
+    1U,  /* GRID_CMD_SET_PROFILE */
+    1U,  /* GRID_CMD_SET_AUTORANGE */
+    0U,  /* GRID_CMD_TUNE_SPI */
+    1U,  /* GRID_CMD_SET_ROWSTREAM */
+    1U,  /* GRID_CMD_SET_GOVERNOR */
+    1U,  /* GRID_CMD_SET_XTALK */
+    1U,  /* GRID_CMD_SET_INTERLACE */
+    0U,  /* GRID_CMD_SAVE_CONFIG */
+    0U,  /* GRID_CMD_RESET_CONFIG */
+    4U,  /* GRID_CMD_INJECT */
+    1U   /* GRID_CMD_SET_TIMERSCAN */
+};
+
+/** @brief  Command assembly state (RX interrupt context only) */
+static struct {
+    uint8_t cmd;                     /**< 0 = no command in progress */
+    uint8_t idx;
+    uint8_t args[GRID_CMD_ARGS_MAX];
+} s_CmdRx;
+
+/** @brief  Completed commands waiting for a packet boundary, where
+ *          setters that flush or zero TX buffers are safe to run */
+static struct {
+    uint8_t cmd;
+    uint8_t args[GRID_CMD_ARGS_MAX];
+} s_CmdQueue[GRID_CMD_QUEUE_DEPTH];
+static volatile uint8_t s_CmdHead = 0;
+static volatile uint8_t s_CmdTail = 0;
+
+/** @brief  Free-running acquisition (default); 0 = idle until a
+ *          snapshot or burst request arrives */
+static volatile uint8_t s_StreamMode = 1;
+
+/** @brief  On-demand frames still owed to the host */
+static volatile uint16_t s_PendingFrames = 0;
+
+/** @brief  Pacing between burst frames in ms (0 = max rate) */
+static uint16_t s_BurstIntervalMs = 0;
+
+/** @brief  HAL tick at which the next burst frame is due */
+static uint32_t s_BurstDueMs = 0;
+
+/** @brief  Ring of recently transmitted packets (full, packed and
+ *          delta frames - anything carrying a sequence number), kept
+ *          so a host NACK can fill checksum gaps without full ARQ */
+static struct {
+    uint32_t seq;
+    uint16_t len;               /**< 0 = slot empty */
+    uint8_t data[PACKET_TOTAL_SIZE];
+} s_RetainRing[GRID_RETAIN_DEPTH];
+
+/** @brief  Next retain slot to overwrite */
+static uint8_t s_RetainNext = 0;
+
+/** @brief  Non-zero when run-length-encoded idle frames are active */
+static uint8_t s_RleMode = 0;
+
+/** @brief  Non-zero when per-row streaming packets are active */
+static uint8_t s_RowStreamMode = 0;
+
+/** @brief  Configured scan engine: 1 = timer-driven state machine (the
+ *          production default), 0 = blocking foreground loop.
+ *          s_TimerScan.running tracks the live machine, which the idle
+ *          power manager stops and restarts underneath this setting */
+static uint8_t s_TimerScanMode = 1;
+
+/** @brief  Row packet under construction (single buffer: the previous
+ *          row's DMA is drained or the row is skipped before reuse) */
+static uint8_t s_RowBuffer[PACKET_ROW_TOTAL_SIZE];
+
+/** @brief  Non-zero when interlaced field transmission is active */
+static uint8_t s_InterlaceMode = 0;
+
+/** @brief  Parity of the field being scanned (0 = even rows) */
+static uint8_t s_InterlaceField = 0;
+
+/** @brief  Field packet under construction (built at the transmit
+ *          boundary, after the previous frame's DMA drained) */
+static uint8_t s_FieldBuffer[PACKET_FIELD_TOTAL_SIZE];
+
+/** @brief  Frames per aggregated super-packet (0/1 = off) */
+static uint8_t s_AggFrames = 0;
+
+/** @brief  Payload+metadata units collected so far */
+static uint8_t s_AggCount = 0;
+
+/** @brief  Super-packet under construction (worst case: 4 raw frames) */
+static uint8_t s_AggBuffer[PACKET_HEADER_SIZE + PACKET_AGG_HDR_SIZE
+                           + GRID_AGG_FRAMES_MAX
+                             * (PACKET_PAYLOAD_SIZE + PACKET_META_SIZE)
+                           + PACKET_FOOTER_SIZE];
+
+/** @brief  TX packet for the 1 Hz heartbeat stats */
+static uint8_t s_StatsBuffer[PACKET_HEADER_SIZE + PACKET_STATS_PAYLOAD_SIZE
+                             + PACKET_FOOTER_SIZE];
+
+/** @brief  HAL tick of the last heartbeat sent */
+static uint32_t s_LastStatsMs = 0;
+
+/** @brief  Duration of the last completed frame scan in microseconds */
+static uint32_t s_LastScanUs = 0;
+
+/** @brief  Frames that had to wait on the previous packet's DMA - a
+ *          rising count means the link, not the scan, is the ceiling */
+static uint32_t s_TxStallFrames = 0;
+
+/** @brief  Host commands dropped on a full queue */
+static uint32_t s_CmdDrops = 0;
+
+/** @brief  Asynchronous log ring: printf bytes land here from any
+ *          context and leave as 0x5C packets at packet boundaries */
+static uint8_t s_LogRing[GRID_LOG_RING_SIZE];
+
+/** @brief  Log ring write index (producer side) */
+static volatile uint16_t s_LogHead = 0;
+
+/** @brief  Log ring read index (drain side) */
+static volatile uint16_t s_LogTail = 0;
+
+/** @brief  Log bytes dropped on a full ring (logging never blocks) */
+static uint32_t s_LogDrops = 0;
+
+/** @brief  TX packet for one log chunk */
+static uint8_t s_LogBuffer[PACKET_HEADER_SIZE + PACKET_LOG_HDR_SIZE
+                           + GRID_LOG_CHUNK_MAX + PACKET_FOOTER_SIZE];
+
+/** @brief  TX packet for benchmark results (0x5D) */
+static uint8_t s_BenchBuffer[PACKET_HEADER_SIZE + PACKET_BENCH_PAYLOAD_SIZE
+                             + PACKET_FOOTER_SIZE];
+
+/** @brief  TX packet for RLE frames (largest accepted encoding plus
+ *          word-alignment slack) */
+static uint8_t s_RleBuffer[PACKET_HEADER_SIZE + PACKET_RLE_HDR_SIZE
+                           + PACKET_RLE_MAX_PAYLOAD + 2U
+                           + PACKET_META_SIZE + PACKET_FOOTER_SIZE];
+
+/** @brief  Non-zero when outbound packets are COBS byte-stuffed */
+static uint8_t s_CobsMode = 0;
+
+/** @brief  Encode buffer for COBS framing (largest packet plus
+ *          stuffing overhead and the 0x00 delimiter) */
+static uint8_t s_CobsBuffer[GRID_COBS_MAX_ENCODED];
+
+/** @brief  Frame summary, accumulated in the per-cell processing loop
+ *          (which already touches every value) and shipped in the
+ *          packet metadata block so the host can read peak / total /
+ *          centroid without walking the full frame */
+static struct {
+    uint16_t peak;
+    uint8_t peakRow;
+    uint8_t peakCol;
+    uint32_t total;             /**< Sum of all cell values */
+    uint32_t momentRow;         /**< Sum of value * row */
+    uint32_t momentCol;         /**< Sum of value * col */
+} s_FrameStats;
+
 static uint8_t s_IsCalibrated = 0;
 
-/* Private function prototypes -----------------------------------------------*/
+/** @brief  Row settling time in microseconds (tunable, see
+ *          GRID_CalibrateSettleTime) */
+static uint16_t s_SettleTimeUs = GRID_SETTLE_US_DEFAULT;
+
+/** @brief  One acquisition profile's register and timing package */
+typedef struct {
+    uint8_t reg1DrMode;         /**< ADS1220 REG1 DR | MODE bits */
+    uint8_t reg2Reject;         /**< ADS1220 REG2 rejection bits */
+    uint32_t convTimeUs;        /**< Nominal conversion period */
+    uint16_t settleUs;          /**< Row settling matched to the rate */
+    uint16_t frameIntervalMs;   /**< Frame pacing (0 = free-running) */
+} GridProfileDef_t;
+
+/** @brief  The named trade-off points (indexed by GRID_PROFILE_*).
+ *          Conversion periods are nominal; the timeout derivation in
+ *          GRID_SetProfile adds its own margin. */
+static const GridProfileDef_t s_Profiles[GRID_PROFILE_COUNT] = {
+    /* FAST: matches the power-on configuration */
+    { ADS1220_DR_1000SPS | ADS1220_MODE_TURBO, ADS1220_REJECT_OFF,
+      1000U, GRID_SETTLE_US_DEFAULT, GRID_FRAME_INTERVAL_MS },
+    /* CLINIC: mains rejection buys SNR at a few frames per second */
+    { ADS1220_DR_330SPS | ADS1220_MODE_NORMAL, ADS1220_REJECT_BOTH,
+      3100U, 200U, 0U },
+    /* QUIET: static assessment, several seconds per frame */
+    { ADS1220_DR_20SPS | ADS1220_MODE_NORMAL, ADS1220_REJECT_BOTH,
+      50000U, GRID_SETTLE_US_MAX, 0U },
+};
+
+/** @brief  Active acquisition profile */
+static GridProfile_t s_Profile = GRID_PROFILE_FAST;
+
+/** @brief  Conversion-wait cap in scan ticks, recomputed per profile */
+static uint16_t s_ConvertTimeoutTicks = GRID_CONVERT_TIMEOUT_TICKS;
+
+/** @brief  Region-of-interest window (defaults to the full grid) */
+static uint8_t s_RoiRowStart = 0;
+static uint8_t s_RoiRowEnd = GRID_NUM_ROWS - 1U;
+static uint32_t s_RoiColMask = 0xFFFFFFFFUL;
+
+/** @brief  ADS1220 channel indices the column mask touches (bits 0-3);
+ *          conversion rounds for unused channels are skipped entirely */
+static uint8_t s_RoiChMask = 0x0FU;
+
+/** @brief  Oversampling: 2^shift conversions per cell, 0 = single */
+static uint8_t s_OversampleShift = 0;
+
+/** @brief  Auto-ranging on/off (GRID_CMD_SET_AUTORANGE) */
+static uint8_t s_AutoRange = 0;
+
+/** @brief  Per-cell PGA gain shift (0-2 -> gain 1/2/4), steered by the
+ *          previous frame's amplitudes in GRID_ProcessRow */
+static uint8_t s_CellGainShift[GRID_NUM_ROWS][GRID_NUM_COLS];
+
+/** @brief  Per-cell noise threshold (24-bit domain), learned from the
+ *          observed sample spread during GRID_Calibrate - edge columns
+ *          run measurably noisier than the center, so one global value
+ *          either clips light touches or passes noise */
+static uint16_t s_NoiseThreshold[GRID_NUM_ROWS][GRID_NUM_COLS];
+
+/** @brief  Columns calibration flagged dead (bit n = column n): skipped
+ *          in the scan, zeroed on the wire, interpolated by the host */
+static uint32_t s_DeadColMask = 0;
+
+/** @brief  Per-chip on-die temperature at calibration (1/32 degC codes),
+ *          the reference point for the linear baseline compensation */
+static int16_t s_TempCalCode[ADS1220_NUM_CHIPS];
+
+/** @brief  Baseline correction per chip in 24-bit ADC counts, rebuilt
+ *          each time that chip's temperature slot comes around */
+static int32_t s_TempComp[ADS1220_NUM_CHIPS];
+
+/** @brief  Next chip in the rotating temperature schedule */
+static uint8_t s_TempChip = 0;
+
+/** @brief  Chip whose temperature conversion is in flight (timer scan) */
+static uint8_t s_TempChipActive = 0;
+
+/** @brief  Non-zero once temperature references have been captured */
+static uint8_t s_TempHaveRef = 0;
+
+/** @brief  Consecutive all-quiet frames (feeds the idle power manager) */
+static uint32_t s_QuietFrames = 0;
+
+/** @brief  Frame-rate governor on/off (GRID_CMD_SET_GOVERNOR) */
+static uint8_t s_GovMode = 0;
+
+/** @brief  Governed pacing override in scan ticks (0 = full rate) */
+static uint16_t s_GovIntervalTicks = 0;
+
+/** @brief  Touch-to-full-rate bound of the last ramp-up in ms
+ *          (the governed interval in force when contact landed) */
+static uint16_t s_GovRampMs = 0;
+
+/** @brief  Non-zero while the ADCs are parked in power-down */
+static uint8_t s_Idle = 0;
+
+/** @brief  Timer scan was running when the grid parked (restart on wake) */
+static uint8_t s_IdleTimerWasOn = 0;
+
+/** @brief  Timer-scan pacing to restore on wake, in ms */
+static uint16_t s_IdleTimerIntervalMs = 0;
+
+/** @brief  HAL tick of the next sentinel scan while parked */
+static uint32_t s_NextSentinelMs = 0;
+
+/** @brief  Non-zero when full frames use the 12-bit packed payload */
+static uint8_t s_PackedMode = 0;
+
+/** @brief  Non-zero when delta-frame encoding is active */
+static uint8_t s_DeltaMode = 0;
+
+/** @brief  Cell values as of the last keyframe the host saw; deltas
+ *          are computed against this */
+static uint16_t s_DeltaRef[GRID_NUM_ROWS][GRID_NUM_COLS];
+
+/** @brief  Frames sent since the last keyframe */
+static uint8_t s_DeltaFramesSinceKey = 0;
+
+/** @brief  TX packet for delta frames (worst accepted case) */
+static uint8_t s_DeltaBuffer[PACKET_HEADER_SIZE + PACKET_DELTA_HDR_SIZE
+                             + GRID_DELTA_MAX_CELLS * 4U
+                             + PACKET_META_SIZE + PACKET_FOOTER_SIZE];
+
+/** @brief  Pending latency-probe injection (GRID_CMD_INJECT): the
+ *          marker lands in the next frame's output and disarms */
+static struct {
+    volatile uint8_t armed;
+    uint8_t row;
+    uint8_t col;
+    uint16_t value;
+} s_Inject;
+
+/** @brief  Non-zero when median-of-3 spike rejection is active */
+static uint8_t s_MedianMode = 0;
+
+/** @brief  Ring of the two previous frames' values per cell, feeding
+ *          the median-of-3 stage ([0] older, [1] newer); word-aligned
+ *          so the DSP kernel can load cell pairs whole */
+static uint16_t s_MedianHist[2][GRID_NUM_ROWS][GRID_NUM_COLS]
+    __attribute__((aligned(4)));
+
+/** @brief  EWMA filter strength: alpha = 1/2^shift, 0 = filter off */
+static uint8_t s_FilterShift = 0;
+
+/** @brief  Per-cell EWMA state in Q8 fixed point (value << 8), so light
+ *          touches are not lost to integer truncation deadband.
+ *          CPU-only working set, so it lives in CCM: the per-cell
+ *          read-modify-write runs with zero wait states and never
+ *          contends with the SPI/UART DMA traffic on main SRAM.
+ *          (g_GridData and the TX buffers must stay in SRAM - DMA
+ *          cannot reach CCM.) */
+GRID_CCM_BSS static uint32_t s_FilterState[GRID_NUM_ROWS][GRID_NUM_COLS];
+
+/** @brief  Crosstalk ghost ratio in Q8 (GRID_CMD_SET_XTALK, 0 = off) */
+static uint8_t s_XtalkCoeff = GRID_XTALK_COEFF_Q8;
+
+/** @brief  Previous frame's per-row / per-column activity sums (val
+ *          domain) - the aggregate terms of the crosstalk stage */
+GRID_CCM_BSS static uint32_t s_XtRowSum[GRID_NUM_ROWS];
+GRID_CCM_BSS static uint32_t s_XtColSum[GRID_NUM_COLS];
+
+/** @brief  Aggregates being accumulated for the frame in flight,
+ *          promoted to the sums above when the frame seals */
+GRID_CCM_BSS static uint32_t s_XtRowAcc[GRID_NUM_ROWS];
+GRID_CCM_BSS static uint32_t s_XtColAcc[GRID_NUM_COLS];
+
+/** @brief  Non-zero when adaptive row scheduling is active */
+static uint8_t s_AdaptiveMode = 0;
+
+/** @brief  Frames each row remains hot; refreshed by GRID_ProcessRow
+ *          whenever the row has a cell above the noise threshold */
+GRID_CCM_BSS static uint8_t s_RowActivity[GRID_NUM_ROWS];
+
+/**
+ * @brief  Phases of the timer-driven scan state machine
+ */
+typedef enum {
+    SCAN_PHASE_WAIT_FRAME = 0,  /**< Pacing gap between frames */
+    SCAN_PHASE_ROW_SELECT,      /**< Drive the next row */
+    SCAN_PHASE_SETTLE,          /**< Analog settling after row switch */
+    SCAN_PHASE_CONVERT,         /**< Conversions running, poll DRDY mask */
+    SCAN_PHASE_HARVEST,         /**< Read back 8 results for this channel */
+    SCAN_PHASE_TEMP,            /**< Rotating on-die temperature slot */
+    SCAN_PHASE_FINISH           /**< Frame done: transmit and flip buffers */
+} ScanPhase_t;
+
+/** @brief  Timer-scan state (only touched from the TIM7 ISR) */
+static struct {
+    ScanPhase_t phase;
+    uint8_t row;                /**< Row being scanned */
+    uint8_t channel;            /**< ADS1220 channel index (0-3) */
+    uint8_t pass;               /**< Oversampling pass for this channel */
+    uint8_t boost;              /**< 1 = gain-boosted re-read in flight */
+    ADS1220_Mask_t boostMask;   /**< Chips in the boosted re-read round */
+    uint16_t phaseTicks;        /**< Ticks spent in the current phase */
+    uint16_t frameTicks;        /**< Ticks since the frame started */
+    uint16_t frameIntervalTicks;/**< Pacing target, 0 = free-running */
+    uint32_t rowValues[GRID_NUM_COLS]; /**< Raw 24-bit values for the row */
+    uint8_t running;
+} GRID_CCM_BSS s_TimerScan;
+
+/** @brief  What the armed row-timeline compare should do when it fires */
+typedef enum {
+    ROWTIM_IDLE = 0,            /**< Nothing armed */
+    ROWTIM_FLAG,                /**< Blocking scan: just raise s_RowTimDone */
+    ROWTIM_PHASE                /**< Timer scan: broadcast START, go CONVERT */
+} RowTimMode_t;
+
+/** @brief  Armed compare action; written before arming, consumed in the
+ *          TIM2 CC1 ISR. Both it and the TIM7 tick run at the same
+ *          preemption priority (GRID_IRQPRI_CONVERSION), so they can
+ *          never corrupt s_TimerScan by running inside each other. */
+static volatile RowTimMode_t s_RowTimMode = ROWTIM_IDLE;
+
+/** @brief  Raised by the compare ISR; polled in ROWTIM_FLAG mode */
+static volatile uint8_t s_RowTimDone = 0;
+
+/** @brief  Non-zero once the row timeline timer is up */
+static uint8_t s_RowTimReady = 0;
+
+/** @brief  Per-phase DWT profiling: cycles accumulated over the current
+ *          frame, folded into a min/avg/max window per stats period */
+typedef struct {
+    uint32_t frameCycles;       /**< Cycles accumulated this frame */
+    uint16_t minUs;             /**< Shortest frame in the window */
+    uint16_t maxUs;             /**< Longest frame in the window */
+    uint32_t sumUs;             /**< For the window average */
+    uint32_t samples;           /**< Frames folded into the window */
+} GridProfPhase_t;
+
+/** @brief  Profiling state, indexed by GRID_PROF_* */
+GRID_CCM_BSS static GridProfPhase_t s_Prof[GRID_PROF_PHASES];
+
+/** @brief  ISR run-time window, updated from interrupt context only
+ *          (GRID_IsrProfRecord) and folded into s_Prof[GRID_PROF_ISR]
+ *          under masked interrupts when the stats packet is built */
+static volatile struct {
+    uint16_t minUs;
+    uint16_t maxUs;
+    uint32_t sumUs;
+    uint32_t samples;
+} GRID_CCM_BSS s_IsrProf;
+
+/** @brief  Jitter histogram bin upper bounds in us (last bin is open) */
+static const uint16_t s_JitterBoundsUs[GRID_JITTER_BINS - 1U] = {
+    100U, 200U, 500U, 1000U, 2000U, 5000U, 10000U
+};
+
+/** @brief  Inter-frame jitter counts for the current stats window */
+GRID_CCM_BSS static uint16_t s_JitterHist[GRID_JITTER_BINS];
+
+/** @brief  DWT stamp of the last full-frame completion (0 = none yet) */
+static uint32_t s_LastFrameCycles = 0;
+
+/** @brief  Previous completion-to-completion interval in us */
+static uint32_t s_PrevFrameIntervalUs = 0;
+
+/** @brief  One microbenchmark test's cycle statistics */
+typedef struct {
+    uint32_t min;               /**< Fastest pass in cycles */
+    uint32_t max;               /**< Slowest pass in cycles */
+    uint32_t sum;               /**< For the average */
+    uint32_t samples;           /**< Passes recorded */
+} GridBenchResult_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static void GRID_ProcessRow(uint8_t row,
+                            const uint32_t colValues[GRID_NUM_COLS]);
+static void GRID_RowTimerInit(void);
+static void GRID_RowTimerArm(uint32_t us, RowTimMode_t mode);
+static void GRID_AutoRangeRow(uint8_t row,
+                              uint32_t colValues[GRID_NUM_COLS]);
+static void GRID_ApplyColumnSkips(void);
+static void GRID_ClaimFrame(void);
+static void GRID_SealFrame(void);
+static void GRID_TransmitRow(uint8_t row);
+static void GRID_Send(uint8_t *data, uint16_t len);
+static void GRID_TransmitFrame(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  Busy-wait for a number of microseconds using the DWT cycle
+ *         counter (72 cycles per us at full speed)
+ * @note   Cycle-exact and independent of compiler optimization level,
+ *         unlike the volatile spin loop it replaces
+ */
+static inline void GRID_DelayUs(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t cycles = us * (SystemCoreClock / 1000000UL);
+    while ((DWT->CYCCNT - start) < cycles) { }
+}
+
+/**
+ * @brief  Enable the DWT cycle counter used by GRID_DelayUs
+ */
+static void GRID_DwtInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief  Append a u32 as eight lowercase hex digits
+ * @retval Pointer past the last digit written
+ * @note   Log lines are formatted by hand - printf is too heavy for
+ *         the scan ISR this runs in
+ */
+static char *GRID_HexU32(char *p, uint32_t v)
+{
+    static const char digits[] = "0123456789abcdef";
+    for (int8_t sh = 28; sh >= 0; sh -= 4) {
+        *p++ = digits[(v >> sh) & 0xFU];
+    }
+    return p;
+}
+
+/**
+ * @brief  Charge a scoped DWT measurement to a profiling phase
+ * @param  phase: GRID_PROF_* index
+ * @param  startCycles: DWT->CYCCNT captured when the phase began
+ */
+static inline void GRID_ProfAdd(uint8_t phase, uint32_t startCycles)
+{
+    s_Prof[phase].frameCycles += DWT->CYCCNT - startCycles;
+}
+
+/**
+ * @brief  Fold a phase's accumulated frame time into its min/avg/max
+ *         window and reset the accumulator for the next frame
+ */
+static void GRID_ProfFold(uint8_t phase)
+{
+    GridProfPhase_t *p = &s_Prof[phase];
+    uint32_t us = p->frameCycles / (SystemCoreClock / 1000000UL);
+
+    p->frameCycles = 0;
+    if (us > 0xFFFFU) {
+        us = 0xFFFFU;
+    }
+    if (p->samples == 0U || (uint16_t)us < p->minUs) {
+        p->minUs = (uint16_t)us;
+    }
+    if ((uint16_t)us > p->maxUs) {
+        p->maxUs = (uint16_t)us;
+    }
+    p->sumUs += us;
+    p->samples++;
+}
+
+/**
+ * @brief  Charge one interrupt handler's run time to the ISR profile
+ * @note   Runs in interrupt context; handlers at different tiers can
+ *         preempt each other mid-update, so the few cycles of window
+ *         arithmetic run with interrupts masked. Before GRID_DwtInit
+ *         the cycle counter reads 0 and nothing meaningful is recorded.
+ *         Runs from CCM: it executes on every interrupt return path,
+ *         so it gets zero-wait-state fetches and stays clear of DMA
+ *         bus traffic
+ */
+GRID_CCM_CODE void GRID_IsrProfRecord(uint32_t startCycles)
+{
+    uint32_t us = (DWT->CYCCNT - startCycles)
+                  / (SystemCoreClock / 1000000UL);
+    uint32_t primask = __get_PRIMASK();
+
+    if (us > 0xFFFFU) {
+        us = 0xFFFFU;
+    }
+    __disable_irq();
+    if (s_IsrProf.samples == 0U || (uint16_t)us < s_IsrProf.minUs) {
+        s_IsrProf.minUs = (uint16_t)us;
+    }
+    if ((uint16_t)us > s_IsrProf.maxUs) {
+        s_IsrProf.maxUs = (uint16_t)us;
+    }
+    s_IsrProf.sumUs += us;
+    s_IsrProf.samples++;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  Stamp a full-frame completion and bin the pacing jitter
+ * @note   Jitter is the absolute change between consecutive
+ *         completion-to-completion intervals, so it needs no nominal
+ *         rate and reads the same for timer-paced and free-running
+ *         scans. Preview frames are not stamped - the motion pipeline
+ *         only consumes full frames. The DWT counter wraps every ~59 s
+ *         at 72 MHz; unsigned subtraction keeps short intervals exact
+ *         across the wrap, and anything longer lands in the open top
+ *         bin where it belongs.
+ */
+static void GRID_JitterRecord(void)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if (s_LastFrameCycles != 0U) {
+        uint32_t us = (now - s_LastFrameCycles)
+                      / (SystemCoreClock / 1000000UL);
+        g_GridData.lastFrameIntervalUs = us;
+
+        if (s_PrevFrameIntervalUs != 0U) {
+            uint32_t dev = (us > s_PrevFrameIntervalUs)
+                           ? (us - s_PrevFrameIntervalUs)
+                           : (s_PrevFrameIntervalUs - us);
+            uint8_t bin = 0;
+            while (bin < (GRID_JITTER_BINS - 1U)
+                   && dev >= s_JitterBoundsUs[bin]) {
+                bin++;
+            }
+            if (s_JitterHist[bin] != 0xFFFFU) {
+                s_JitterHist[bin]++;
+            }
+        }
+        s_PrevFrameIntervalUs = us;
+    }
+    s_LastFrameCycles = (now != 0U) ? now : 1U;
+}
+
+/**
+ * @brief  Count consecutive all-quiet frames for the idle power manager
+ * @note   Runs on the frame summary the processing already produced, so
+ *         quiescence is judged after thresholding - pure noise frames
+ *         count as quiet
+ */
+static void GRID_IdleFrameHook(void)
+{
+    if (s_FrameStats.total == 0U) {
+        if (s_QuietFrames != 0xFFFFFFFFUL) {
+            s_QuietFrames++;
+        }
+    } else {
+        s_QuietFrames = 0;
+    }
+}
+
+/**
+ * @brief  Activity-driven frame-rate governor (frame seal hook, both
+ *         engines)
+ * @note   Judges activity from the same post-threshold frame summary
+ *         that feeds the adaptive row scheduler and the idle power
+ *         manager. Back-off is gradual - once the quiet streak passes
+ *         GRID_GOV_QUIET_FRAMES the pacing doubles per quiet frame
+ *         down to the GRID_GOV_IDLE_MS floor. Ramp-up is immediate:
+ *         the frame that sees contact clears the stretch here, before
+ *         its own pacing gap starts, so at most one governed interval
+ *         separates first contact from full-rate scanning. That bound
+ *         is latched for the stats heartbeat.
+ */
+static void GRID_GovernorUpdate(void)
+{
+    if (!s_GovMode || !s_StreamMode) {
+        s_GovIntervalTicks = 0;
+        return;
+    }
+
+    if (s_FrameStats.total != 0U) {
+        if (s_GovIntervalTicks != 0U) {
+            s_GovRampMs = (uint16_t)((uint32_t)s_GovIntervalTicks
+                                     * GRID_SCAN_TICK_US / 1000U);
+            s_GovIntervalTicks = 0;
+        }
+        return;
+    }
+
+    if (s_QuietFrames < GRID_GOV_QUIET_FRAMES) {
+        return;
+    }
+
+    uint32_t cap = GRID_GOV_IDLE_MS * 1000UL / GRID_SCAN_TICK_US;
+    uint32_t next = s_GovIntervalTicks;
+    if (next == 0U) {
+        /* Free-running scans have no pacing target; start the back-off
+         * from the time the frame actually took (the foreground engine
+         * has no tick count, so it uses the measured scan time) */
+        if (s_TimerScan.running) {
+            next = (s_TimerScan.frameIntervalTicks != 0U)
+                   ? s_TimerScan.frameIntervalTicks
+                   : s_TimerScan.frameTicks;
+        } else {
+            next = s_LastScanUs / GRID_SCAN_TICK_US;
+        }
+        if (next == 0U) {
+            next = 1U;
+        }
+    }
+    next *= 2U;
+    if (next > cap) {
+        next = cap;
+    }
+    s_GovIntervalTicks = (uint16_t)next;
+}
+
+/**
+ * @brief  Fold one chip's fresh temperature sample into its baseline
+ *         correction term
+ * @note   Correction = (T_now - T_cal) * counts/degC; the sensor code
+ *         LSB is 1/32 degC, hence the divide
+ */
+static void GRID_TempFold(uint8_t chip, int16_t code)
+{
+    if (!s_TempHaveRef) {
+        return;
+    }
+    int32_t delta = (int32_t)code - (int32_t)s_TempCalCode[chip];
+    s_TempComp[chip] = (delta * GRID_TEMP_COMP_COUNTS_PER_C) / 32;
+}
+
+/**
+ * @brief  Next alive chip in the rotating temperature schedule, or
+ *         ADS1220_NUM_CHIPS when every chip has been dropped
+ */
+static uint8_t GRID_NextTempChip(void)
+{
+    ADS1220_Mask_t alive = ADS1220_GetAliveMask();
+
+    for (uint8_t n = 0; n < ADS1220_NUM_CHIPS; n++) {
+        uint8_t chip = (uint8_t)((s_TempChip + n) % ADS1220_NUM_CHIPS);
+        if (alive & (ADS1220_Mask_t)(1UL << chip)) {
+            s_TempChip = (uint8_t)((chip + 1U) % ADS1220_NUM_CHIPS);
+            return chip;
+        }
+    }
+    return ADS1220_NUM_CHIPS;
+}
+
+/**
+ * @brief  Capture every alive chip's current temperature as the
+ *         compensation reference (zero correction at this point)
+ * @note   Called at calibration, and after a flash baseline restore -
+ *         there the stored baseline is simply assumed to match the
+ *         present temperature, and the drift EWMA trues up the residue
+ */
+static void GRID_TempReference(void)
+{
+    ADS1220_Mask_t alive = ADS1220_GetAliveMask();
+
+    for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+        if (alive & (ADS1220_Mask_t)(1UL << chip)) {
+            s_TempCalCode[chip] = ADS1220_ReadTemperature(chip);
+        }
+        s_TempComp[chip] = 0;
+    }
+    s_TempHaveRef = 1;
+}
+
+/**
+ * @brief  Next ADS1220 channel index at or after @p from that the ROI
+ *         column mask touches, or ADS1220_CHANNELS if none remain
+ */
+static uint8_t GRID_NextRoiChannel(uint8_t from)
+{
+    for (uint8_t ch = from; ch < ADS1220_CHANNELS; ch++) {
+        if (s_RoiChMask & (1U << ch)) {
+            return ch;
+        }
+    }
+    return ADS1220_CHANNELS;
+}
+
+/**
+ * @brief  CRC-32 (IEEE, zlib-compatible) over a buffer whose length is
+ *         a multiple of 4, using the hardware CRC unit
+ * @note   Word-reversed input + reversed output + final inversion make
+ *         the result match Python's zlib.crc32 on the host. Both packet
+ *         regions we protect (1048 and 256 bytes) are word multiples;
+ *         the M4 handles the unaligned word loads from the TX buffer.
+ */
+static uint32_t GRID_CrcBlock(const uint8_t *data, uint32_t lenBytes)
+{
+    const uint32_t *words = (const uint32_t *)(const void *)data;
+    uint32_t count = lenBytes / 4U;
+
+    CRC->CR |= CRC_CR_RESET;
+    for (uint32_t i = 0; i < count; i++) {
+        CRC->DR = words[i];
+    }
+    return ~CRC->DR;
+}
+
+/**
+ * @brief  32-bit additive checksum over the baseline table, used as the
+ *         validity check for the flash-persisted copy
+ */
+static uint32_t GRID_BaselineChecksum(const uint32_t *words, uint32_t count)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        sum += words[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief  Persist the baseline table to the calibration flash pages
+ * @retval 1 on success, 0 on any flash error
+ */
+static uint8_t GRID_SaveBaseline(void)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t pageError = 0;
+    const uint32_t *base = (const uint32_t *)&g_GridData.baseline[0][0];
+    const uint32_t *thresh = (const uint32_t *)&s_NoiseThreshold[0][0];
+    uint32_t baseCount = sizeof(g_GridData.baseline) / sizeof(uint32_t);
+    uint32_t threshCount = sizeof(s_NoiseThreshold) / sizeof(uint32_t);
+    uint8_t ok = 1;
+
+    HAL_FLASH_Unlock();
+
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.PageAddress = GRID_CAL_FLASH_ADDR;
+    erase.NbPages = GRID_CAL_FLASH_PAGES;
+    if (HAL_FLASHEx_Erase(&erase, &pageError) != HAL_OK) {
+        HAL_FLASH_Lock();
+        return 0;
+    }
+
+    /* Layout: magic, checksum, baseline words, threshold-map words,
+     * qualified SPI prescaler, dead-column mask */
+    uint32_t presc = ADS1220_GetSpiPrescaler();
+    uint32_t sum = GRID_BaselineChecksum(base, baseCount)
+                 + GRID_BaselineChecksum(thresh, threshCount)
+                 + presc + s_DeadColMask;
+
+    uint32_t addr = GRID_CAL_FLASH_ADDR;
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                             GRID_CAL_MAGIC) == HAL_OK);
+    addr += 4U;
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, sum) == HAL_OK);
+    addr += 4U;
+
+    for (uint32_t i = 0; ok && i < baseCount; i++) {
+        ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                                 base[i]) == HAL_OK);
+        addr += 4U;
+    }
+    for (uint32_t i = 0; ok && i < threshCount; i++) {
+        ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                                 thresh[i]) == HAL_OK);
+        addr += 4U;
+    }
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                             presc) == HAL_OK);
+    addr += 4U;
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                             s_DeadColMask) == HAL_OK);
+
+    HAL_FLASH_Lock();
+    return ok;
+}
+
+/**
+ * @brief  Restore the baseline table from flash if a valid copy exists
+ * @retval 1 when a checksum-valid baseline was loaded, 0 otherwise
+ */
+static uint8_t GRID_LoadBaseline(void)
+{
+    const uint32_t *stored = (const uint32_t *)GRID_CAL_FLASH_ADDR;
+    uint32_t baseCount = sizeof(g_GridData.baseline) / sizeof(uint32_t);
+    uint32_t threshCount = sizeof(s_NoiseThreshold) / sizeof(uint32_t);
+
+    if (stored[0] != GRID_CAL_MAGIC) {
+        return 0;
+    }
+    if (GRID_BaselineChecksum(&stored[2], baseCount + threshCount + 2U)
+            != stored[1]) {
+        return 0;
+    }
+
+    memcpy(g_GridData.baseline, &stored[2], sizeof(g_GridData.baseline));
+    memcpy(s_NoiseThreshold, &stored[2U + baseCount],
+           sizeof(s_NoiseThreshold));
+
+    /* Re-apply the SPI clock this board qualified at (bus-qualification
+     * runs once per build, not once per boot). SetSpiPrescaler rejects
+     * anything that is not a bare CR1.BR value. */
+    ADS1220_SetSpiPrescaler(stored[2U + baseCount + threshCount]);
+
+    /* Dead columns found by the calibration this baseline came from:
+     * re-arm the scan skips so a boot from flash behaves like the
+     * session that saved it */
+    s_DeadColMask = stored[2U + baseCount + threshCount + 1U];
+    GRID_ApplyColumnSkips();
+    return 1;
+}
+
+/** @brief  Mode-flag bit positions in a config-slot payload (word 4) */
+#define GRID_CFGSTORE_F_PACKED     (1UL << 0)
+#define GRID_CFGSTORE_F_DELTA      (1UL << 1)
+#define GRID_CFGSTORE_F_RLE        (1UL << 2)
+#define GRID_CFGSTORE_F_MEDIAN     (1UL << 3)
+#define GRID_CFGSTORE_F_ADAPTIVE   (1UL << 4)
+#define GRID_CFGSTORE_F_AUTORANGE  (1UL << 5)
+#define GRID_CFGSTORE_F_ROWSTREAM  (1UL << 6)
+#define GRID_CFGSTORE_F_GOVERNOR   (1UL << 7)
+#define GRID_CFGSTORE_F_INTERLACE  (1UL << 8)
+#define GRID_CFGSTORE_F_STREAM     (1UL << 9)
+#define GRID_CFGSTORE_F_TIMERSCAN  (1UL << 10)
+
+/**
+ * @brief  Snapshot the host-tunable settings into config-slot payload
+ *         words (layout is the 'GRC1' contract: bump the magic if it
+ *         ever changes shape)
+ */
+static void GRID_ConfigSnapshot(uint32_t w[5])
+{
+    w[0] = (uint32_t)s_SettleTimeUs
+         | ((uint32_t)s_OversampleShift << 16)
+         | ((uint32_t)s_FilterShift << 24);
+    w[1] = s_RoiColMask;
+    w[2] = (uint32_t)s_RoiRowStart
+         | ((uint32_t)s_RoiRowEnd << 8)
+         | ((uint32_t)s_Profile << 16)
+         | ((uint32_t)s_AggFrames << 24);
+    w[3] = s_XtalkCoeff;
+    w[4] = (s_PackedMode ? GRID_CFGSTORE_F_PACKED : 0U)
+         | (s_DeltaMode ? GRID_CFGSTORE_F_DELTA : 0U)
+         | (s_RleMode ? GRID_CFGSTORE_F_RLE : 0U)
+         | (s_MedianMode ? GRID_CFGSTORE_F_MEDIAN : 0U)
+         | (s_AdaptiveMode ? GRID_CFGSTORE_F_ADAPTIVE : 0U)
+         | (s_AutoRange ? GRID_CFGSTORE_F_AUTORANGE : 0U)
+         | (s_RowStreamMode ? GRID_CFGSTORE_F_ROWSTREAM : 0U)
+         | (s_GovMode ? GRID_CFGSTORE_F_GOVERNOR : 0U)
+         | (s_InterlaceMode ? GRID_CFGSTORE_F_INTERLACE : 0U)
+         | (s_StreamMode ? GRID_CFGSTORE_F_STREAM : 0U)
+         | (s_TimerScanMode ? GRID_CFGSTORE_F_TIMERSCAN : 0U);
+}
+
+/**
+ * @brief  Re-apply a config-slot payload through the public setters, so
+ *         every stored value gets the same clamping and side effects
+ *         (buffer resets, keyframe forcing) a host command would
+ * @note   The profile goes first: it programs the converters and derives
+ *         the settle time, which the stored explicit settle then
+ *         overrides if the site tuned it past the profile default
+ */
+static void GRID_ConfigApply(const uint32_t w[5])
+{
+    GRID_SetProfile((uint8_t)(w[2] >> 16));
+    GRID_SetSettleTime((uint16_t)w[0]);
+    GRID_SetOversampling((uint8_t)(w[0] >> 16));
+    GRID_SetFilterShift((uint8_t)(w[0] >> 24));
+    GRID_SetROI((uint8_t)w[2], (uint8_t)(w[2] >> 8), w[1]);
+    GRID_SetAggregation((uint8_t)(w[2] >> 24));
+    GRID_SetCrosstalk((uint8_t)w[3]);
+
+    GRID_SetPackedPayload((w[4] & GRID_CFGSTORE_F_PACKED) != 0U);
+    GRID_SetDeltaMode((w[4] & GRID_CFGSTORE_F_DELTA) != 0U);
+    GRID_SetRleMode((w[4] & GRID_CFGSTORE_F_RLE) != 0U);
+    GRID_SetMedianFilter((w[4] & GRID_CFGSTORE_F_MEDIAN) != 0U);
+    GRID_SetAdaptiveScan((w[4] & GRID_CFGSTORE_F_ADAPTIVE) != 0U);
+    GRID_SetAutoRange((w[4] & GRID_CFGSTORE_F_AUTORANGE) != 0U);
+    GRID_SetRowStream((w[4] & GRID_CFGSTORE_F_ROWSTREAM) != 0U);
+    GRID_SetGovernor((w[4] & GRID_CFGSTORE_F_GOVERNOR) != 0U);
+    GRID_SetInterlace((w[4] & GRID_CFGSTORE_F_INTERLACE) != 0U);
+    GRID_SetStreaming((w[4] & GRID_CFGSTORE_F_STREAM) != 0U);
+    GRID_SetTimerScan((w[4] & GRID_CFGSTORE_F_TIMERSCAN) != 0U);
+}
+
+/**
+ * @brief  Persist the current settings to the next free config slot
+ * @retval 1 on success, 0 on any flash error
+ * @note   Wear scheme: the page is append-only. Each save burns one
+ *         32-byte slot and the 2 KB page erases only when all 64 are
+ *         spent, so the erase budget stretches 64x over naive
+ *         erase-per-save. An interrupted save leaves a checksum-invalid
+ *         slot behind; the loader skips it and keeps the newest valid
+ *         sequence number instead
+ */
+uint8_t GRID_SaveConfig(void)
+{
+    const uint32_t *page = (const uint32_t *)GRID_CFGSTORE_FLASH_ADDR;
+    uint32_t freeSlot = GRID_CFGSTORE_SLOTS;
+    uint32_t seq = 1;
+    uint32_t w[5];
+    uint8_t ok = 1;
+
+    /* First erased slot wins; the sequence number continues past the
+     * newest record already on the page */
+    for (uint32_t slot = 0; slot < GRID_CFGSTORE_SLOTS; slot++) {
+        const uint32_t *rec = &page[slot * GRID_CFGSTORE_SLOT_WORDS];
+        if (rec[0] == 0xFFFFFFFFUL) {
+            freeSlot = slot;
+            break;
+        }
+        if (rec[0] == GRID_CFGSTORE_MAGIC && rec[1] >= seq) {
+            seq = rec[1] + 1U;
+        }
+    }
+
+    HAL_FLASH_Unlock();
+
+    if (freeSlot == GRID_CFGSTORE_SLOTS) {
+        FLASH_EraseInitTypeDef erase;
+        uint32_t pageError = 0;
+
+        erase.TypeErase = FLASH_TYPEERASE_PAGES;
+        erase.PageAddress = GRID_CFGSTORE_FLASH_ADDR;
+        erase.NbPages = 1;
+        if (HAL_FLASHEx_Erase(&erase, &pageError) != HAL_OK) {
+            HAL_FLASH_Lock();
+            return 0;
+        }
+        freeSlot = 0;
+    }
+
+    GRID_ConfigSnapshot(w);
+
+    uint32_t addr = GRID_CFGSTORE_FLASH_ADDR
+                  + freeSlot * GRID_CFGSTORE_SLOT_WORDS * 4U;
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                             GRID_CFGSTORE_MAGIC) == HAL_OK);
+    addr += 4U;
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, seq) == HAL_OK);
+    addr += 4U;
+    for (uint32_t i = 0; ok && i < 5U; i++) {
+        ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                                 w[i]) == HAL_OK);
+        addr += 4U;
+    }
+    ok &= (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr,
+                             GRID_BaselineChecksum(w, 5U) + seq) == HAL_OK);
+
+    HAL_FLASH_Lock();
+    return ok;
+}
+
+/**
+ * @brief  Apply the newest valid persisted configuration, if any
+ * @retval 1 when a slot was applied, 0 otherwise
+ */
+static uint8_t GRID_LoadConfig(void)
+{
+    const uint32_t *page = (const uint32_t *)GRID_CFGSTORE_FLASH_ADDR;
+    const uint32_t *best = NULL;
+    uint32_t bestSeq = 0;
+
+    for (uint32_t slot = 0; slot < GRID_CFGSTORE_SLOTS; slot++) {
+        const uint32_t *rec = &page[slot * GRID_CFGSTORE_SLOT_WORDS];
+        if (rec[0] != GRID_CFGSTORE_MAGIC) {
+            continue;
+        }
+        if (GRID_BaselineChecksum(&rec[2], 5U) + rec[1] != rec[7]) {
+            continue;
+        }
+        if (rec[1] > bestSeq) {
+            bestSeq = rec[1];
+            best = rec;
+        }
+    }
+
+    if (best == NULL) {
+        return 0;
+    }
+    GRID_ConfigApply(&best[2]);
+    return 1;
+}
+
+/**
+ * @brief  Erase the persisted configuration
+ * @note   Leaves the running settings alone; the next boot comes up on
+ *         the firmware defaults
+ */
+void GRID_ResetConfig(void)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t pageError = 0;
+
+    HAL_FLASH_Unlock();
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.PageAddress = GRID_CFGSTORE_FLASH_ADDR;
+    erase.NbPages = 1;
+    (void)HAL_FLASHEx_Erase(&erase, &pageError);
+    HAL_FLASH_Lock();
+}
+
+/**
+ * @brief  Serialize the frame summary metadata block (little-endian)
+ */
+static void GRID_BuildMeta(uint8_t meta[PACKET_META_SIZE])
+{
+    /* Center of pressure in x256 fixed point (0 when no contact) */
+    uint16_t centRow = 0, centCol = 0;
+    if (s_FrameStats.total > 0U) {
+        centRow = (uint16_t)(((uint64_t)s_FrameStats.momentRow << 8)
+                             / s_FrameStats.total);
+        centCol = (uint16_t)(((uint64_t)s_FrameStats.momentCol << 8)
+                             / s_FrameStats.total);
+    }
+
+    meta[0] = (uint8_t)(s_FrameStats.peak & 0xFF);
+    meta[1] = (uint8_t)(s_FrameStats.peak >> 8);
+    meta[2] = s_FrameStats.peakRow;
+    meta[3] = s_FrameStats.peakCol;
+    meta[4] = (uint8_t)(s_FrameStats.total & 0xFF);
+    meta[5] = (uint8_t)((s_FrameStats.total >> 8) & 0xFF);
+    meta[6] = (uint8_t)((s_FrameStats.total >> 16) & 0xFF);
+    meta[7] = (uint8_t)((s_FrameStats.total >> 24) & 0xFF);
+    meta[8] = (uint8_t)(centRow & 0xFF);
+    meta[9] = (uint8_t)(centRow >> 8);
+    meta[10] = (uint8_t)(centCol & 0xFF);
+    meta[11] = (uint8_t)(centCol >> 8);
+
+    /* Frame identity: sequence number and scan-complete timestamp, so
+     * the host can detect dropped frames and measure real pacing
+     * instead of assuming a fixed frame rate */
+    uint32_t seq = g_GridData.frameCount;
+    uint32_t stampMs = g_GridData.lastScanTimeMs;
+    meta[12] = (uint8_t)(seq & 0xFF);
+    meta[13] = (uint8_t)((seq >> 8) & 0xFF);
+    meta[14] = (uint8_t)((seq >> 16) & 0xFF);
+    meta[15] = (uint8_t)((seq >> 24) & 0xFF);
+    meta[16] = (uint8_t)(stampMs & 0xFF);
+    meta[17] = (uint8_t)((stampMs >> 8) & 0xFF);
+    meta[18] = (uint8_t)((stampMs >> 16) & 0xFF);
+    meta[19] = (uint8_t)((stampMs >> 24) & 0xFF);
+
+    /* Columns calibration flagged dead (bit n = column n): their cells
+     * are zeroed in the payload, the host interpolates across them */
+    meta[20] = (uint8_t)(s_DeadColMask & 0xFF);
+    meta[21] = (uint8_t)((s_DeadColMask >> 8) & 0xFF);
+    meta[22] = (uint8_t)((s_DeadColMask >> 16) & 0xFF);
+    meta[23] = (uint8_t)((s_DeadColMask >> 24) & 0xFF);
+}
+
+/**
+ * @brief  COBS-encode a packet and append the 0x00 frame delimiter
+ * @retval Encoded length including the delimiter
+ */
+static uint16_t GRID_CobsEncode(const uint8_t *src, uint16_t len,
+                                uint8_t *dst)
+{
+    uint16_t out = 1;       /* Slot 0 holds the first code byte */
+    uint16_t codeIdx = 0;
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < len; i++) {
+        if (src[i] == 0x00U) {
+            dst[codeIdx] = code;
+            codeIdx = out++;
+            code = 1;
+        } else {
+            dst[out++] = src[i];
+            if (++code == 0xFFU) {
+                dst[codeIdx] = code;
+                codeIdx = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[codeIdx] = code;
+    dst[out++] = 0x00U;     /* Delimiter - never occurs in the body */
+    return out;
+}
+
+/**
+ * @brief  Keep a copy of an outgoing packet for NACK retransmission
+ */
+static void GRID_RetainPacket(uint32_t seq, const uint8_t *pkt,
+                              uint16_t len)
+{
+    s_RetainRing[s_RetainNext].seq = seq;
+    s_RetainRing[s_RetainNext].len = len;
+    memcpy(s_RetainRing[s_RetainNext].data, pkt, len);
+    s_RetainNext = (uint8_t)((s_RetainNext + 1U) % GRID_RETAIN_DEPTH);
+}
+
+/**
+ * @brief  Queue a completed host command (RX interrupt context)
+ * @note   A full queue drops the command; the host can resend
+ */
+static void GRID_CmdEnqueue(uint8_t cmd, const uint8_t *args)
+{
+    uint8_t next = (uint8_t)((s_CmdHead + 1U) % GRID_CMD_QUEUE_DEPTH);
+    if (next == s_CmdTail) {
+        s_CmdDrops++;
+        return;
+    }
+    s_CmdQueue[s_CmdHead].cmd = cmd;
+    if (args != NULL) {
+        memcpy(s_CmdQueue[s_CmdHead].args, args, GRID_CMD_ARGS_MAX);
+    }
+    s_CmdHead = next;
+}
+
+/**
+ * @brief  Apply queued host commands
+ * @note   Called with no transmit in flight; GRID_CMD_CALIBRATE stalls
+ *         scanning for its full averaging window
+ */
+static void GRID_ServiceCommands(void)
+{
+    while (s_CmdTail != s_CmdHead) {
+        const uint8_t *a = s_CmdQueue[s_CmdTail].args;
+
+        switch (s_CmdQueue[s_CmdTail].cmd) {
+        case GRID_CMD_CALIBRATE:
+            GRID_Calibrate();
+            break;
+        case GRID_CMD_SET_THRESHOLD: {
+            uint16_t thresh = (uint16_t)(a[0] | ((uint16_t)a[1] << 8));
+            for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
+                for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+                    s_NoiseThreshold[row][col] = thresh;
+                }
+            }
+            break;
+        }
+        case GRID_CMD_SET_ROI:
+            GRID_SetROI(a[0], a[1],
+                        (uint32_t)a[2] | ((uint32_t)a[3] << 8)
+                            | ((uint32_t)a[4] << 16) | ((uint32_t)a[5] << 24));
+            break;
+        case GRID_CMD_CLEAR_ROI:
+            GRID_ClearROI();
+            break;
+        case GRID_CMD_SET_PACKED:
+            GRID_SetPackedPayload(a[0]);
+            break;
+        case GRID_CMD_SET_DELTA:
+            GRID_SetDeltaMode(a[0]);
+            break;
+        case GRID_CMD_SET_MEDIAN:
+            GRID_SetMedianFilter(a[0]);
+            break;
+        case GRID_CMD_SET_FILTER:
+            GRID_SetFilterShift(a[0]);
+            break;
+        case GRID_CMD_SET_OVERSAMPLE:
+            GRID_SetOversampling(a[0]);
+            break;
+        case GRID_CMD_SET_ADAPTIVE:
+            GRID_SetAdaptiveScan(a[0]);
+            break;
+        case GRID_CMD_SET_COBS:
+            GRID_SetCobsFraming(a[0]);
+            break;
+        case GRID_CMD_SET_SETTLE:
+            GRID_SetSettleTime((uint16_t)(a[0] | ((uint16_t)a[1] << 8)));
+            break;
+        case GRID_CMD_STREAM:
+            GRID_SetStreaming(a[0]);
+            break;
+        case GRID_CMD_SNAPSHOT:
+            GRID_RequestFrames(1U, 0U);
+            break;
+        case GRID_CMD_BURST:
+            GRID_RequestFrames((uint16_t)(a[0] | ((uint16_t)a[1] << 8)),
+                               (uint16_t)(a[2] | ((uint16_t)a[3] << 8)));
+            break;
+        case GRID_CMD_NACK: {
+            uint32_t seq = (uint32_t)a[0] | ((uint32_t)a[1] << 8)
+                               | ((uint32_t)a[2] << 16)
+                               | ((uint32_t)a[3] << 24);
+            for (uint8_t i = 0; i < GRID_RETAIN_DEPTH; i++) {
+                if (s_RetainRing[i].len != 0U
+                        && s_RetainRing[i].seq == seq) {
+                    while (s_TxBusy) { }
+                    GRID_Send(s_RetainRing[i].data, s_RetainRing[i].len);
+                    break;
+                }
+            }
+            /* Aged out of the ring: nothing left to resend */
+            break;
+        }
+        case GRID_CMD_SET_RLE:
+            GRID_SetRleMode(a[0]);
+            break;
+        case GRID_CMD_SET_AGG:
+            GRID_SetAggregation(a[0]);
+            break;
+        case GRID_CMD_BENCHMARK:
+            GRID_RunBenchmark((uint16_t)(a[0] | ((uint16_t)a[1] << 8)));
+            break;
+        case GRID_CMD_SET_PROFILE:
+            GRID_SetProfile(a[0]);
+            break;
+        case GRID_CMD_SET_AUTORANGE:
+            GRID_SetAutoRange(a[0]);
+            break;
+        case GRID_CMD_TUNE_SPI:
+            GRID_TuneSpiClock();
+            break;
+        case GRID_CMD_SET_ROWSTREAM:
+            GRID_SetRowStream(a[0]);
+            break;
+        case GRID_CMD_SET_GOVERNOR:
+            GRID_SetGovernor(a[0]);
+            break;
+        case GRID_CMD_SET_XTALK:
+            GRID_SetCrosstalk(a[0]);
+            break;
+        case GRID_CMD_SET_INTERLACE:
+            GRID_SetInterlace(a[0]);
+            break;
+        case GRID_CMD_SAVE_CONFIG:
+            GRID_SaveConfig();
+            break;
+        case GRID_CMD_RESET_CONFIG:
+            GRID_ResetConfig();
+            break;
+        case GRID_CMD_INJECT:
+            GRID_InjectCell(a[0], a[1],
+                            (uint16_t)(a[2] | ((uint16_t)a[3] << 8)));
+            break;
+        case GRID_CMD_SET_TIMERSCAN:
+            GRID_SetTimerScan(a[0]);
+            break;
+        default:
+            break;
+        }
+
+        s_CmdTail = (uint8_t)((s_CmdTail + 1U) % GRID_CMD_QUEUE_DEPTH);
+    }
+}
+
+/**
+ * @brief  Hand a finished packet to the active transport
+ * @note   Registered transports (e.g. USB CDC) carry the same packets
+ *         unchanged; the UART path keeps its blocking fallback for when
+ *         the DMA channel is unavailable
+ */
+static void GRID_Send(uint8_t *data, uint16_t len)
+{
+    /* Byte-stuffed framing: callers have already waited out the
+     * previous send, so the single encode buffer is free for reuse */
+    if (s_CobsMode) {
+        len = GRID_CobsEncode(data, len, s_CobsBuffer);
+        data = s_CobsBuffer;
+    }
+
+    s_TxBusy = 1;
+
+    if (s_TransportSend != NULL) {
+        if (!s_TransportSend(data, len)) {
+            s_TxBusy = 0;
+        }
+        return;
+    }
+
+    if (HAL_UART_Transmit_DMA(s_hUart, data, len) != HAL_OK) {
+        /* DMA unavailable (e.g. printf debug path active): fall back */
+        s_TxBusy = 0;
+        HAL_UART_Transmit(s_hUart, data, len, 100);
+    }
+}
+
+/**
+ * @brief  Try to send the current frame as a delta against the last
+ *         keyframe
+ * @retval 1 if a delta packet was sent; 0 when too many cells changed
+ *         (caller falls through to a full frame)
+ */
+static uint8_t GRID_TransmitDelta(void)
+{
+    const uint16_t (*cur)[GRID_NUM_COLS] =
+        g_GridData.frame[g_GridData.scanIndex];
+
+    /* First pass: is a delta actually smaller than a full frame? */
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < GRID_TOTAL_NODES; i++) {
+        if (cur[i / GRID_NUM_COLS][i % GRID_NUM_COLS]
+                != s_DeltaRef[i / GRID_NUM_COLS][i % GRID_NUM_COLS]) {
+            if (++count > GRID_DELTA_MAX_CELLS) {
+                return 0;
+            }
+        }
+    }
+
+    uint8_t *buf = s_DeltaBuffer;
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_DELTA;
+
+    uint16_t idx = PACKET_HEADER_SIZE;
+    buf[idx++] = (uint8_t)(count & 0xFF);
+    buf[idx++] = (uint8_t)(count >> 8);
+    buf[idx++] = 0;     /* pad: keeps the CRC region a word multiple */
+    buf[idx++] = 0;
+
+    for (uint16_t i = 0; i < GRID_TOTAL_NODES; i++) {
+        uint16_t v = cur[i / GRID_NUM_COLS][i % GRID_NUM_COLS];
+        if (v != s_DeltaRef[i / GRID_NUM_COLS][i % GRID_NUM_COLS]) {
+            buf[idx++] = (uint8_t)(i & 0xFF);
+            buf[idx++] = (uint8_t)(i >> 8);
+            buf[idx++] = (uint8_t)(v & 0xFF);
+            buf[idx++] = (uint8_t)(v >> 8);
+        }
+    }
+
+    /* The host's reconstruction now equals this frame: delta against
+     * it next time */
+    memcpy(s_DeltaRef, cur, sizeof(s_DeltaRef));
+    s_DeltaFramesSinceKey++;
+
+    uint8_t meta[PACKET_META_SIZE];
+    GRID_BuildMeta(meta);
+    for (uint8_t i = 0; i < PACKET_META_SIZE; i++) {
+        buf[idx++] = meta[i];
+    }
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 (uint32_t)idx - PACKET_HEADER_SIZE);
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_RetainPacket(g_GridData.frameCount, buf, idx);
+    GRID_Send(buf, idx);
+    return 1;
+}
+
+/**
+ * @brief  Send the heartbeat stats packet when one is due
+ * @note   Called at packet boundaries; never waits on the link - a
+ *         still-draining DMA just defers the heartbeat to the next
+ *         boundary, and the send it starts is left in flight (callers
+ *         with more to transmit drain first)
+ */
+static void GRID_MaybeSendStats(void)
+{
+    uint32_t now = HAL_GetTick();
+    if ((now - s_LastStatsMs) < GRID_STATS_PERIOD_MS || s_TxBusy) {
+        return;
+    }
+    s_LastStatsMs = now;
+
+    uint8_t *buf = s_StatsBuffer;
+    uint16_t idx = PACKET_HEADER_SIZE;
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_STATS;
+
+    uint32_t words[5] = { now, g_GridData.frameCount, s_LastScanUs,
+                          s_TxStallFrames, s_CmdDrops };
+    for (uint8_t w = 0; w < 5U; w++) {
+        buf[idx++] = (uint8_t)(words[w] & 0xFF);
+        buf[idx++] = (uint8_t)((words[w] >> 8) & 0xFF);
+        buf[idx++] = (uint8_t)((words[w] >> 16) & 0xFF);
+        buf[idx++] = (uint8_t)((words[w] >> 24) & 0xFF);
+    }
+
+    /* Low 8 chip bits; geometries past 8 chips report the first bank */
+    buf[idx++] = (uint8_t)ADS1220_GetAliveMask();
+
+    uint8_t flags = (uint8_t)((s_PackedMode << 0) | (s_DeltaMode << 1)
+                              | (s_CobsMode << 2) | (s_RleMode << 3)
+                              | (s_AdaptiveMode << 4) | (s_MedianMode << 5)
+                              | (s_StreamMode << 6));
+    buf[idx++] = flags;
+    buf[idx++] = (uint8_t)(s_SettleTimeUs & 0xFF);
+    buf[idx++] = (uint8_t)(s_SettleTimeUs >> 8);
+
+    /* Fold the ISR window in first: it accumulates in interrupt
+     * context, so snapshot-and-reset runs with interrupts masked */
+    {
+        GridProfPhase_t *isr = &s_Prof[GRID_PROF_ISR];
+        uint32_t primask = __get_PRIMASK();
+
+        __disable_irq();
+        isr->minUs = s_IsrProf.minUs;
+        isr->maxUs = s_IsrProf.maxUs;
+        isr->sumUs = s_IsrProf.sumUs;
+        isr->samples = s_IsrProf.samples;
+        s_IsrProf.minUs = 0;
+        s_IsrProf.maxUs = 0;
+        s_IsrProf.sumUs = 0;
+        s_IsrProf.samples = 0;
+        __set_PRIMASK(primask);
+    }
+
+    /* Profiling block: min/avg/max us per phase over the last period,
+     * then reset each window so every heartbeat is self-contained */
+    for (uint8_t ph = 0; ph < GRID_PROF_PHASES; ph++) {
+        GridProfPhase_t *p = &s_Prof[ph];
+        uint16_t triple[3];
+
+        triple[0] = (p->samples != 0U) ? p->minUs : 0U;
+        triple[1] = (p->samples != 0U)
+                    ? (uint16_t)(p->sumUs / p->samples) : 0U;
+        triple[2] = p->maxUs;
+        for (uint8_t t = 0; t < 3U; t++) {
+            buf[idx++] = (uint8_t)(triple[t] & 0xFF);
+            buf[idx++] = (uint8_t)(triple[t] >> 8);
+        }
+        p->minUs = 0;
+        p->maxUs = 0;
+        p->sumUs = 0;
+        p->samples = 0;
+    }
+
+    /* Inter-frame jitter histogram over the same window, then reset */
+    for (uint8_t b = 0; b < GRID_JITTER_BINS; b++) {
+        buf[idx++] = (uint8_t)(s_JitterHist[b] & 0xFF);
+        buf[idx++] = (uint8_t)(s_JitterHist[b] >> 8);
+        s_JitterHist[b] = 0;
+    }
+
+    /* Governor: last touch-to-full-rate ramp bound (ms, 0 = none yet) */
+    buf[idx++] = (uint8_t)(s_GovRampMs & 0xFF);
+    buf[idx++] = (uint8_t)(s_GovRampMs >> 8);
+
+    buf[idx++] = 0U;  /* Pad to a word boundary for the CRC unit */
+    buf[idx++] = 0U;
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 PACKET_STATS_PAYLOAD_SIZE);
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_Send(buf, idx);
+}
+
+void GRID_LogWrite(const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t next = (uint16_t)((s_LogHead + 1U) % GRID_LOG_RING_SIZE);
+        if (next == s_LogTail) {
+            /* Full ring: drop the rest rather than stall the caller */
+            s_LogDrops += (uint32_t)(len - i);
+            return;
+        }
+        s_LogRing[s_LogHead] = data[i];
+        s_LogHead = next;
+    }
+}
+
+/**
+ * @brief  Drain one chunk of buffered log text as a 0x5C packet
+ * @note   Called at packet boundaries alongside the heartbeat; never
+ *         waits on the link - the ring holds the text, so a busy DMA
+ *         just means this chunk rides a later boundary - and leaves
+ *         its own send in flight (callers with more to transmit drain
+ *         first)
+ */
+static void GRID_MaybeSendLog(void)
+{
+    if (s_LogHead == s_LogTail || s_TxBusy) {
+        return;
+    }
+
+    uint8_t *buf = s_LogBuffer;
+    uint16_t idx = PACKET_HEADER_SIZE + PACKET_LOG_HDR_SIZE;
+    uint16_t textLen = 0;
+
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_LOG;
+
+    while (s_LogTail != s_LogHead && textLen < GRID_LOG_CHUNK_MAX) {
+        buf[idx++] = s_LogRing[s_LogTail];
+        s_LogTail = (uint16_t)((s_LogTail + 1U) % GRID_LOG_RING_SIZE);
+        textLen++;
+    }
+
+    /* Pad the text to a word boundary for the hardware CRC unit */
+    uint16_t padded = (uint16_t)((textLen + 3U) & ~3U);
+    while (idx < (uint16_t)(PACKET_HEADER_SIZE + PACKET_LOG_HDR_SIZE
+                            + padded)) {
+        buf[idx++] = 0U;
+    }
+
+    buf[PACKET_HEADER_SIZE]      = (uint8_t)(textLen & 0xFF);
+    buf[PACKET_HEADER_SIZE + 1U] = (uint8_t)(textLen >> 8);
+    buf[PACKET_HEADER_SIZE + 2U] = 0U;
+    buf[PACKET_HEADER_SIZE + 3U] = 0U;
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 (uint16_t)(PACKET_LOG_HDR_SIZE + padded));
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_Send(buf, idx);
+}
+
+/**
+ * @brief  Fold one scoped DWT measurement into a benchmark result
+ */
+static void GRID_BenchRecord(GridBenchResult_t *res, uint32_t startCycles)
+{
+    uint32_t cycles = DWT->CYCCNT - startCycles;
+
+    if (res->samples == 0U || cycles < res->min) {
+        res->min = cycles;
+    }
+    if (cycles > res->max) {
+        res->max = cycles;
+    }
+    res->sum += cycles;
+    res->samples++;
+}
+
+/**
+ * @brief  Run the on-target microbenchmark suite and send the results
+ * @note   Each primitive runs in isolation so a wiring or build change
+ *         shows up against the stage it actually slowed. Called at a
+ *         packet boundary (like GRID_CMD_CALIBRATE), so scanning simply
+ *         stalls for the run
+ */
+void GRID_RunBenchmark(uint16_t iterations)
+{
+    GridBenchResult_t res[GRID_BENCH_TESTS];
+
+    if (iterations == 0U) {
+        iterations = GRID_BENCH_ITERS_DEFAULT;
+    }
+    if (iterations > GRID_BENCH_ITERS_MAX) {
+        iterations = GRID_BENCH_ITERS_MAX;
+    }
+    memset(res, 0, sizeof(res));
+
+    /* Quiesce the link so the UART test sees an idle wire */
+    while (s_TxBusy) { __WFI(); }
+
+    ADS1220_Mask_t alive = ADS1220_GetAliveMask();
+    uint8_t chip = 0;
+
+    /* Full conversion cost (START + DRDY wait + readout), rotated
+     * across the alive chips so one slow joint shows in the max */
+    if (alive != 0U) {
+        for (uint16_t i = 0; i < iterations; i++) {
+            while (!(alive & (1UL << chip))) {
+                chip = (uint8_t)((chip + 1U) % ADS1220_NUM_CHIPS);
+            }
+            uint32_t start = DWT->CYCCNT;
+            (void)ADS1220_ReadData(chip);
+            GRID_BenchRecord(&res[GRID_BENCH_ADC_READ], start);
+            chip = (uint8_t)((chip + 1U) % ADS1220_NUM_CHIPS);
+        }
+
+        /* Result readout alone: the pure SPI round-trip, no wait */
+        for (uint16_t i = 0; i < iterations; i++) {
+            while (!(alive & (1UL << chip))) {
+                chip = (uint8_t)((chip + 1U) % ADS1220_NUM_CHIPS);
+            }
+            uint32_t start = DWT->CYCCNT;
+            (void)ADS1220_ReadResult(chip);
+            GRID_BenchRecord(&res[GRID_BENCH_SPI_READ], start);
+            chip = (uint8_t)((chip + 1U) % ADS1220_NUM_CHIPS);
+        }
+    }
+
+    /* Row driver switching (one BSRR write on either build) */
+    for (uint16_t i = 0; i < iterations; i++) {
+        uint32_t start = DWT->CYCCNT;
+        GRID_EnableRow((uint8_t)(i % GRID_NUM_ROWS));
+        GRID_BenchRecord(&res[GRID_BENCH_ROW_SWITCH], start);
+    }
+    GRID_DisableAllRows();
+
+    /* Packet finalize: metadata serialization plus the hardware CRC
+     * over a full raw payload (the CPU side of a frame transmit) */
+    for (uint16_t i = 0; i < iterations; i++) {
+        uint8_t meta[PACKET_META_SIZE];
+        uint32_t start = DWT->CYCCNT;
+        GRID_BuildMeta(meta);
+        (void)GRID_CrcBlock(&s_TxBuffer[0][PACKET_HEADER_SIZE],
+                            PACKET_PAYLOAD_SIZE);
+        GRID_BenchRecord(&res[GRID_BENCH_PACK], start);
+    }
+
+    /* One real log packet per pass, DMA setup through wire completion,
+     * so the cycle count converts straight to bytes/s at the current
+     * baud. Capped: wire time dominates and 8 passes already average
+     * out the scheduling noise */
+    static const char probe[] = "[BENCH] UART throughput probe "
+                                "..............................\r\n";
+    uint16_t uartIters = (iterations < 8U) ? iterations : 8U;
+    for (uint16_t i = 0; i < uartIters; i++) {
+        GRID_LogWrite((const uint8_t *)probe,
+                      (uint16_t)(sizeof(probe) - 1U));
+        uint32_t start = DWT->CYCCNT;
+        GRID_MaybeSendLog();
+        GRID_BenchRecord(&res[GRID_BENCH_UART_TX], start);
+    }
+
+    /* Report: iterations, pad, then min/avg/max cycles per test */
+    uint8_t *buf = s_BenchBuffer;
+    uint16_t idx = PACKET_HEADER_SIZE;
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_BENCH;
+    buf[idx++] = (uint8_t)(iterations & 0xFF);
+    buf[idx++] = (uint8_t)(iterations >> 8);
+    buf[idx++] = 0U;
+    buf[idx++] = 0U;
+
+    for (uint8_t t = 0; t < GRID_BENCH_TESTS; t++) {
+        uint32_t triple[3];
+
+        triple[0] = (res[t].samples != 0U) ? res[t].min : 0U;
+        triple[1] = (res[t].samples != 0U)
+                    ? (res[t].sum / res[t].samples) : 0U;
+        triple[2] = res[t].max;
+        for (uint8_t w = 0; w < 3U; w++) {
+            buf[idx++] = (uint8_t)(triple[w] & 0xFF);
+            buf[idx++] = (uint8_t)((triple[w] >> 8) & 0xFF);
+            buf[idx++] = (uint8_t)((triple[w] >> 16) & 0xFF);
+            buf[idx++] = (uint8_t)((triple[w] >> 24) & 0xFF);
+        }
+    }
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 PACKET_BENCH_PAYLOAD_SIZE);
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_Send(buf, idx);
+    while (s_TxBusy) { }
+}
+
+/**
+ * @brief  Try to send the current frame run-length encoded
+ * @retval 1 if an RLE packet was sent; 0 when the encoding exceeds
+ *         PACKET_RLE_MAX_PAYLOAD (caller falls through to a raw frame)
+ * @note   An untouched grid encodes to a single 4-byte token, so idle
+ *         frames - which dominate clinic sessions - cost tens of bytes
+ *         on the wire instead of a kilobyte
+ */
+static uint8_t GRID_TransmitRle(void)
+{
+    const uint16_t (*cur)[GRID_NUM_COLS] =
+        g_GridData.frame[g_GridData.scanIndex];
+    uint8_t *buf = s_RleBuffer;
+    uint16_t idx = PACKET_HEADER_SIZE + PACKET_RLE_HDR_SIZE;
+    uint16_t i = 0;
+
+    while (i < GRID_TOTAL_NODES) {
+        uint16_t zeros = 0, lits = 0;
+        while (i < GRID_TOTAL_NODES
+                && cur[i / GRID_NUM_COLS][i % GRID_NUM_COLS] == 0U) {
+            zeros++;
+            i++;
+        }
+        uint16_t litStart = i;
+        while (i < GRID_TOTAL_NODES
+                && cur[i / GRID_NUM_COLS][i % GRID_NUM_COLS] != 0U) {
+            lits++;
+            i++;
+        }
+
+        if (idx + 4U + lits * 2U > (uint16_t)(PACKET_HEADER_SIZE
+                + PACKET_RLE_HDR_SIZE + PACKET_RLE_MAX_PAYLOAD)) {
+            return 0;
+        }
+
+        buf[idx++] = (uint8_t)(zeros & 0xFF);
+        buf[idx++] = (uint8_t)(zeros >> 8);
+        buf[idx++] = (uint8_t)(lits & 0xFF);
+        buf[idx++] = (uint8_t)(lits >> 8);
+        for (uint16_t k = 0; k < lits; k++) {
+            uint16_t cell = litStart + k;
+            uint16_t val = cur[cell / GRID_NUM_COLS][cell % GRID_NUM_COLS];
+            buf[idx++] = (uint8_t)(val & 0xFF);
+            buf[idx++] = (uint8_t)(val >> 8);
+        }
+    }
+
+    uint16_t encodedLen = idx - PACKET_HEADER_SIZE - PACKET_RLE_HDR_SIZE;
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_RLE;
+    buf[PACKET_HEADER_SIZE + 0U] = (uint8_t)(encodedLen & 0xFF);
+    buf[PACKET_HEADER_SIZE + 1U] = (uint8_t)(encodedLen >> 8);
+    buf[PACKET_HEADER_SIZE + 2U] = 0;
+    buf[PACKET_HEADER_SIZE + 3U] = 0;
+
+    /* Pad the token stream to a word boundary for the hardware CRC */
+    while (((idx - PACKET_HEADER_SIZE) & 3U) != 0U) {
+        buf[idx++] = 0;
+    }
+
+    uint8_t meta[PACKET_META_SIZE];
+    GRID_BuildMeta(meta);
+    for (uint8_t m = 0; m < PACKET_META_SIZE; m++) {
+        buf[idx++] = meta[m];
+    }
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 idx - PACKET_HEADER_SIZE);
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_RetainPacket(g_GridData.frameCount, buf, idx);
+    GRID_Send(buf, idx);
+    return 1;
+}
+
+/**
+ * @brief  Send one finished row as a compact 0x5E streaming packet
+ * @note   Runs right after GRID_ProcessRow, while the next row is
+ *         already settling, so this row's wire time hides under the
+ *         remainder of the scan. In the timer-scan engine this executes
+ *         at interrupt level, so a still-busy link - or a foreground
+ *         boundary claim mid-send - skips the row (counted as a TX
+ *         stall) instead of blocking the tick machine; the foreground
+ *         engine sleeps out the previous row's DMA
+ */
+static void GRID_TransmitRow(uint8_t row)
+{
+    if (s_TxBusy || s_FgBoundary) {
+        s_TxStallFrames++;
+        if (s_TimerScan.running) {
+            return;
+        }
+        while (s_TxBusy) {
+            __WFI();
+        }
+    }
+
+    uint8_t *buf = s_RowBuffer;
+    uint16_t idx = PACKET_HEADER_SIZE;
+    uint16_t seq = (uint16_t)g_GridData.frameCount;
+
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_ROW;
+    buf[idx++] = row;
+    buf[idx++] = 0;             /* Pad: keeps the cells 16-bit aligned */
+    buf[idx++] = (uint8_t)(seq & 0xFF);
+    buf[idx++] = (uint8_t)(seq >> 8);
+
+    for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+        uint16_t val = g_GridData.frame[g_GridData.scanIndex][row][col];
+        buf[idx++] = (uint8_t)(val & 0xFF);
+        buf[idx++] = (uint8_t)(val >> 8);
+    }
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 PACKET_ROW_PAYLOAD_SIZE);
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_Send(buf, idx);
+}
+
+/**
+ * @brief  Build and send the just-scanned field as a 0x5F half-frame
+ * @note   Caller (GRID_TransmitFrame) has already drained the previous
+ *         DMA and serviced commands at the packet boundary. Cells come
+ *         straight from the frame half GRID_ProcessRow just filled;
+ *         the metadata block summarizes the scanned field only.
+ */
+static void GRID_TransmitField(void)
+{
+    uint8_t *buf = s_FieldBuffer;
+    uint16_t idx = PACKET_HEADER_SIZE;
+    uint16_t seq = (uint16_t)g_GridData.frameCount;
+
+    buf[0] = PACKET_SYNC_BYTE_1;
+    buf[1] = PACKET_SYNC_FIELD;
+    buf[idx++] = s_InterlaceField;
+    buf[idx++] = 0;             /* Pad: keeps the cells 16-bit aligned */
+    buf[idx++] = (uint8_t)(seq & 0xFF);
+    buf[idx++] = (uint8_t)(seq >> 8);
+
+    for (uint8_t row = s_InterlaceField; row < GRID_NUM_ROWS;
+         row += 2U) {
+        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+            uint16_t val = g_GridData.frame[g_GridData.scanIndex]
+                                           [row][col];
+            buf[idx++] = (uint8_t)(val & 0xFF);
+            buf[idx++] = (uint8_t)(val >> 8);
+        }
+    }
+
+    uint8_t meta[PACKET_META_SIZE];
+    GRID_BuildMeta(meta);
+    for (uint8_t i = 0; i < PACKET_META_SIZE; i++) {
+        buf[idx++] = meta[i];
+    }
+
+    uint32_t crc = GRID_CrcBlock(&buf[PACKET_HEADER_SIZE],
+                                 PACKET_FIELD_PAYLOAD_SIZE
+                                 + PACKET_META_SIZE);
+    buf[idx++] = (uint8_t)(crc & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    buf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    buf[idx++] = '\r';
+    buf[idx++] = '\n';
+
+    GRID_Send(buf, idx);
+}
+
+/**
+ * @brief  Whether @p row is due a scan this frame
+ * @note   Hot rows scan every frame; quiescent rows scan on a staggered
+ *         1-in-GRID_IDLE_REFRESH_PERIOD rota so a new touch is still
+ *         picked up within a few frames anywhere on the grid
+ */
+static uint8_t GRID_RowScheduled(uint8_t row)
+{
+    /* Interlace: only this field's parity is scanned this frame */
+    if (s_InterlaceMode && ((row ^ s_InterlaceField) & 1U)) return 0;
+    if (!s_AdaptiveMode) return 1;
+    if (s_RowActivity[row] > 0) return 1;
+    return ((g_GridData.frameCount % GRID_IDLE_REFRESH_PERIOD)
+            == (row % GRID_IDLE_REFRESH_PERIOD)) ? 1U : 0U;
+}
+
+/**
+ * @brief  Next scheduled row at or after @p from inside the ROI window,
+ *         or 0xFF when the frame has no rows left
+ */
+static uint8_t GRID_NextScheduledRow(uint8_t from)
+{
+    for (uint8_t row = from; row <= s_RoiRowEnd; row++) {
+        if (GRID_RowScheduled(row)) {
+            return row;
+        }
+    }
+    return 0xFFU;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  Set the oversampling quality level
+ */
+void GRID_SetOversampling(uint8_t shift)
+{
+    if (shift > GRID_OVERSAMPLE_SHIFT_MAX) {
+        shift = GRID_OVERSAMPLE_SHIFT_MAX;
+    }
+    s_OversampleShift = shift;
+}
+
+/**
+ * @brief  Enable or disable per-cell automatic gain ranging
+ */
+void GRID_SetAutoRange(uint8_t enable)
+{
+    s_AutoRange = (enable != 0U) ? 1U : 0U;
+    if (!s_AutoRange) {
+        memset(s_CellGainShift, 0, sizeof(s_CellGainShift));
+    }
+}
+
+/**
+ * @brief  Qualify the SPI buses and keep the fastest clean clock
+ * @note   The chosen prescaler rides in the calibration flash image, so
+ *         it is written out now when a baseline exists and otherwise
+ *         lands with the next GRID_Calibrate - persisting alone would
+ *         mean saving an all-zero baseline as a side effect
+ */
+void GRID_TuneSpiClock(void)
+{
+    ADS1220_TuneSpiClock();
+
+    if (s_IsCalibrated) {
+        GRID_SaveBaseline();
+    }
+}
+
+/**
+ * @brief  Enable or disable delta-frame encoding
+ */
+void GRID_SetDeltaMode(uint8_t enable)
+{
+    s_DeltaMode = (enable != 0U) ? 1U : 0U;
+
+    /* Force a keyframe first so the host has a reference to delta from */
+    s_DeltaFramesSinceKey = GRID_DELTA_KEYFRAME_PERIOD;
+}
+
+/**
+ * @brief  Switch full frames between 16-bit and 12-bit packed payloads
+ */
+void GRID_SetPackedPayload(uint8_t enable)
+{
+    s_PackedMode = (enable != 0U) ? 1U : 0U;
+
+    /* Payload offsets shift with the format: restart from clean
+     * buffers with the matching sync byte, and drop any half-built
+     * super-packet whose unit size no longer matches */
+    for (uint8_t b = 0; b < 2; b++) {
+        memset(&s_TxBuffer[b][PACKET_HEADER_SIZE], 0, PACKET_PAYLOAD_SIZE);
+        s_TxBuffer[b][1] = s_PackedMode ? PACKET_SYNC_PACKED
+                                        : PACKET_SYNC_BYTE_2;
+    }
+    s_AggCount = 0;
+}
+
+/**
+ * @brief  Enable or disable COBS byte-stuffed framing
+ */
+void GRID_SetCobsFraming(uint8_t enable)
+{
+    /* Let the in-flight packet finish under the old framing */
+    while (s_TxBusy) { }
+    s_CobsMode = (enable != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  Enable or disable run-length-encoded idle frames
+ */
+void GRID_SetRleMode(uint8_t enable)
+{
+    s_RleMode = (enable != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  Enable or disable per-row streaming packets
+ */
+void GRID_SetRowStream(uint8_t enable)
+{
+    s_RowStreamMode = (enable != 0U) ? 1U : 0U;
+
+    /* Leaving the mode: the delta reference went stale while frames
+     * were shipped row by row, so force the next frame to a keyframe */
+    if (!s_RowStreamMode) {
+        s_DeltaFramesSinceKey = GRID_DELTA_KEYFRAME_PERIOD;
+    }
+}
+
+/**
+ * @brief  Enable or disable the activity-driven frame-rate governor
+ */
+void GRID_SetGovernor(uint8_t enable)
+{
+    s_GovMode = (enable != 0U) ? 1U : 0U;
+    /* Switching either way restores full rate; a quiet grid backs off
+     * again on its own */
+    s_GovIntervalTicks = 0;
+}
+
+/**
+ * @brief  Select the timer-driven or blocking foreground scan engine
+ * @note   Records the choice only: GRID_ScanLoop applies it at its next
+ *         pass - starting the machine where no foreground frame is in
+ *         progress, stopping it at a frame boundary - so an engine
+ *         switch can never land mid-scan
+ */
+void GRID_SetTimerScan(uint8_t enable)
+{
+    s_TimerScanMode = (enable != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  Set the crosstalk compensation coefficient
+ * @note   The aggregates refresh every frame, so a new ratio (or off)
+ *         takes full effect one frame later
+ */
+void GRID_SetCrosstalk(uint8_t coeffQ8)
+{
+    s_XtalkCoeff = coeffQ8;
+}
+
+/**
+ * @brief  Enable or disable interlaced odd/even field transmission
+ */
+void GRID_SetInterlace(uint8_t enable)
+{
+    s_InterlaceMode = (enable != 0U) ? 1U : 0U;
+    s_InterlaceField = 0;
+
+    /* Leaving the mode: the delta reference went stale while only
+     * half-frames were shipped, so force the next frame to a keyframe */
+    if (!s_InterlaceMode) {
+        s_DeltaFramesSinceKey = GRID_DELTA_KEYFRAME_PERIOD;
+    }
+}
+
+/**
+ * @brief  Arm the latency probe for the next frame
+ */
+void GRID_InjectCell(uint8_t row, uint8_t col, uint16_t value)
+{
+    if (row >= GRID_NUM_ROWS || col >= GRID_NUM_COLS) {
+        return;
+    }
+    s_Inject.row = row;
+    s_Inject.col = col;
+    s_Inject.value = value;
+    s_Inject.armed = 1;
+}
+
+/**
+ * @brief  Set frames-per-super-packet aggregation
+ */
+void GRID_SetAggregation(uint8_t frames)
+{
+    if (frames > GRID_AGG_FRAMES_MAX) {
+        frames = GRID_AGG_FRAMES_MAX;
+    }
+    s_AggFrames = frames;
+    s_AggCount = 0;     /* Restart collection under the new setting */
+}
+
+/**
+ * @brief  Enable or disable free-running acquisition
+ */
+void GRID_SetStreaming(uint8_t enable)
+{
+    s_StreamMode = (enable != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  Request a one-shot capture or a paced burst
+ */
+void GRID_RequestFrames(uint16_t count, uint16_t intervalMs)
+{
+    s_BurstIntervalMs = intervalMs;
+    s_BurstDueMs = HAL_GetTick();   /* First frame immediately */
+    s_PendingFrames = count;
+}
+
+/**
+ * @brief  Whether a frame capture is due right now
+ * @note   Consumes one owed frame in burst mode and re-arms its pacing
+ *         deadline; continuous streaming is always due
+ */
+static uint8_t GRID_CaptureDue(void)
+{
+    if (s_StreamMode) {
+        return 1;
+    }
+    if (s_PendingFrames == 0U) {
+        return 0;
+    }
+    if ((int32_t)(HAL_GetTick() - s_BurstDueMs) < 0) {
+        return 0;
+    }
+    s_PendingFrames--;
+    s_BurstDueMs = HAL_GetTick() + s_BurstIntervalMs;
+    return 1;
+}
+
+/**
+ * @brief  Enable or disable the 3-frame median spike rejection filter
+ */
+void GRID_SetMedianFilter(uint8_t enable)
+{
+    s_MedianMode = (enable != 0U) ? 1U : 0U;
+    memset(s_MedianHist, 0, sizeof(s_MedianHist));
+}
+
+/**
+ * @brief  Set the per-cell EWMA temporal filter strength
+ */
+void GRID_SetFilterShift(uint8_t shift)
+{
+    if (shift > GRID_FILTER_SHIFT_MAX) {
+        shift = GRID_FILTER_SHIFT_MAX;
+    }
+
+    /* Restart from clean state so a strength change does not drag old
+     * history across at the new time constant */
+    memset(s_FilterState, 0, sizeof(s_FilterState));
+    s_FilterShift = shift;
+}
+
+/**
+ * @brief  Enable or disable activity-based adaptive row scheduling
+ */
+void GRID_SetAdaptiveScan(uint8_t enable)
+{
+    s_AdaptiveMode = (enable != 0U) ? 1U : 0U;
+    memset((void *)s_RowActivity, 0, sizeof(s_RowActivity));
+
+    /* A skipped row's payload must be zero for the running checksum to
+     * stay valid, so start adaptive mode from a clean slate */
+    memset(g_GridData.frame, 0, sizeof(g_GridData.frame));
+    for (uint8_t b = 0; b < 2; b++) {
+        memset(&s_TxBuffer[b][PACKET_HEADER_SIZE], 0, PACKET_PAYLOAD_SIZE);
+    }
+}
+
+/**
+ * @brief  Initialize the grid scanning system
+ */
+void GRID_Init(SPI_HandleTypeDef *hspi, UART_HandleTypeDef *huart)
+{
+    s_hUart = huart;
+
+    /* Cycle counter for microsecond settling delays */
+    GRID_DwtInit();
+
+    /* Microsecond row timeline (settling windows, START scheduling) */
+    GRID_RowTimerInit();
+
+    /* Hardware CRC unit for packet integrity: default 0x04C11DB7
+     * polynomial, word-reversed input and reversed output so the
+     * result matches the host's standard CRC-32 */
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->INIT = 0xFFFFFFFFUL;
+    CRC->CR = CRC_CR_REV_OUT | CRC_CR_REV_IN;
+
+    /* Clear grid data */
+    memset(&g_GridData, 0, sizeof(GridData_t));
+    g_GridData.state = GRID_STATE_IDLE;
+
+    /* Global default until calibration learns a per-cell map */
+    for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
+        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+            s_NoiseThreshold[row][col] = ADC_NOISE_THRESHOLD;
+        }
+    }
+    
+    /* Initialize all ADS1220 chips */
+    ADS1220_Init(hspi);
+
+    /* Free-run the converters: the scan pattern repeats forever, so the
+     * single-shot START/restart overhead per sample is pure loss */
+    ADS1220_SetConversionMode(1);
+
+
+    /* Disable all rows initially */
+    GRID_DisableAllRows();
+    
+    /* Prepare packet headers in both TX buffers */
+    for (uint8_t b = 0; b < 2; b++) {
+        s_TxBuffer[b][0] = PACKET_SYNC_BYTE_1;
+        s_TxBuffer[b][1] = PACKET_SYNC_BYTE_2;
+    }
+
+    /* Pick up the last saved calibration so a power cycle does not
+     * force an uncalibrated run (drift tracking handles the residue) */
+    if (GRID_LoadBaseline()) {
+        s_IsCalibrated = 1;
+        /* No calibration temperature survives in flash: reference the
+         * compensation to the present temperature instead and let the
+         * drift EWMA absorb whatever the restored baseline is off by */
+        GRID_TempReference();
+    }
+
+    /* Re-apply the site's persisted tuning before the first frame, so
+     * a headless unit powers on streaming its configured settings with
+     * no host round-trips */
+    GRID_LoadConfig();
+
+    /* Listen for host commands (baud-profile handshake) */
+    HAL_UART_Receive_IT(s_hUart, &s_RxByte, 1);
+}
+
+#if GRID_CFG_ROWS_MUXED
+
+/** @brief  Per-row BSRR words, precomputed into flash: new select
+ *          address + bank enable in the set half, every other select
+ *          and enable bit in the reset half */
+#define GRID_ROWMUX_SET(r) \
+    (((uint32_t)((r) & 7U) << GRID_CFG_ROWMUX_SEL_SHIFT) | \
+     (1UL << (GRID_CFG_ROWMUX_EN_SHIFT + ((r) >> 3))))
+#define GRID_ROWMUX_BSRR(r) \
+    ((((GRID_CFG_ROWMUX_SEL_MASK | GRID_CFG_ROWMUX_EN_MASK) \
+       & ~GRID_ROWMUX_SET(r)) << 16) | GRID_ROWMUX_SET(r))
+
+static const uint32_t s_RowBsrr[GRID_NUM_ROWS] = {
+    GRID_ROWMUX_BSRR(0),  GRID_ROWMUX_BSRR(1),  GRID_ROWMUX_BSRR(2),
+    GRID_ROWMUX_BSRR(3),  GRID_ROWMUX_BSRR(4),  GRID_ROWMUX_BSRR(5),
+    GRID_ROWMUX_BSRR(6),  GRID_ROWMUX_BSRR(7),  GRID_ROWMUX_BSRR(8),
+    GRID_ROWMUX_BSRR(9),  GRID_ROWMUX_BSRR(10), GRID_ROWMUX_BSRR(11),
+    GRID_ROWMUX_BSRR(12), GRID_ROWMUX_BSRR(13), GRID_ROWMUX_BSRR(14),
+    GRID_ROWMUX_BSRR(15), GRID_ROWMUX_BSRR(16), GRID_ROWMUX_BSRR(17),
+    GRID_ROWMUX_BSRR(18), GRID_ROWMUX_BSRR(19), GRID_ROWMUX_BSRR(20),
+    GRID_ROWMUX_BSRR(21), GRID_ROWMUX_BSRR(22), GRID_ROWMUX_BSRR(23),
+    GRID_ROWMUX_BSRR(24), GRID_ROWMUX_BSRR(25), GRID_ROWMUX_BSRR(26),
+    GRID_ROWMUX_BSRR(27), GRID_ROWMUX_BSRR(28), GRID_ROWMUX_BSRR(29),
+    GRID_ROWMUX_BSRR(30), GRID_ROWMUX_BSRR(31), GRID_ROWMUX_BSRR(32),
+    GRID_ROWMUX_BSRR(33), GRID_ROWMUX_BSRR(34), GRID_ROWMUX_BSRR(35),
+    GRID_ROWMUX_BSRR(36), GRID_ROWMUX_BSRR(37), GRID_ROWMUX_BSRR(38),
+    GRID_ROWMUX_BSRR(39),
+};
+
+/**
+ * @brief  Enable a specific row (CD4051 mux banks)
+ * @note   The shared S0-S2 select lines and the per-bank enables all
+ *         live on one port, so the new address, the new bank enable and
+ *         the old bank's disable land in a single BSRR write - same
+ *         glitch-free switch as the direct-drive build. The BSRR word
+ *         comes straight from the const table: one load, one store.
+ */
+void GRID_EnableRow(uint8_t row)
+{
+    if (row >= GRID_NUM_ROWS) return;
+
+    GRID_CFG_ROWMUX_PORT->BSRR = s_RowBsrr[row];
+}
+
+/**
+ * @brief  Disable all rows
+ */
+void GRID_DisableAllRows(void)
+{
+    /* Dropping the bank enables is enough; the selects can stay */
+    GRID_CFG_ROWMUX_PORT->BSRR =
+        (uint32_t)GRID_CFG_ROWMUX_EN_MASK << 16;
+}
+
+#else /* direct GPIO row drive */
+
+/** @brief  Per-row BSRR words, precomputed into flash: the row's pin in
+ *          the set half, every other row pin in the reset half. Set
+ *          wins on overlap, but the new pin is excluded from the reset
+ *          mask anyway. */
+#define GRID_ROW_BSRR(r) \
+    ((((uint32_t)ROW_GPIO_PINS & ~(1UL << (r))) << 16) | (1UL << (r)))
+
+static const uint32_t s_RowBsrr[GRID_NUM_ROWS] = {
+    GRID_ROW_BSRR(0),  GRID_ROW_BSRR(1),  GRID_ROW_BSRR(2),
+    GRID_ROW_BSRR(3),  GRID_ROW_BSRR(4),  GRID_ROW_BSRR(5),
+    GRID_ROW_BSRR(6),  GRID_ROW_BSRR(7),  GRID_ROW_BSRR(8),
+    GRID_ROW_BSRR(9),  GRID_ROW_BSRR(10), GRID_ROW_BSRR(11),
+    GRID_ROW_BSRR(12), GRID_ROW_BSRR(13), GRID_ROW_BSRR(14),
+    GRID_ROW_BSRR(15),
+};
+
+/**
+ * @brief  Enable a specific row
+ * @note   All rows live on one port, so one BSRR write clears every
+ *         other row and sets the new one in the same bus cycle - no
+ *         all-rows-off glitch and no second HAL call per switch. The
+ *         BSRR word comes straight from the const table: one load,
+ *         one store.
+ */
+void GRID_EnableRow(uint8_t row)
+{
+    if (row >= GRID_NUM_ROWS) return;
+
+    ROW_GPIO_PORT->BSRR = s_RowBsrr[row];
+}
+
+/**
+ * @brief  Disable all rows
+ */
+void GRID_DisableAllRows(void)
+{
+    /* Clear all row GPIOs in one BSRR write */
+    ROW_GPIO_PORT->BSRR = (uint32_t)ROW_GPIO_PINS << 16;
+}
+
+#endif /* GRID_CFG_ROWS_MUXED */
+
+/**
+ * @brief  Push the dead-column mask into the driver's per-channel skips
+ * @note   Column n maps to chip n/4, channel n%4; the driver elides a
+ *         whole conversion round once every chip skips a channel index
+ */
+static void GRID_ApplyColumnSkips(void)
+{
+    for (uint8_t ch = 0; ch < ADS1220_CHANNELS; ch++) {
+        ADS1220_Mask_t mask = 0;
+        for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+            uint8_t col = (uint8_t)(chip * ADS1220_CHANNELS + ch);
+            if (col < 32U && (s_DeadColMask & (1UL << col))) {
+                mask |= (ADS1220_Mask_t)(1UL << chip);
+            }
+        }
+        ADS1220_SetChannelSkip(ch, mask);
+    }
+}
+
+/**
+ * @brief  Perform baseline calibration
+ * @note   Runs on the pipelined scan structure (interleaved next-row
+ *         settling, all chips converting in parallel) with a per-cell
+ *         running mean, so 16 samples of averaging finish in less wall
+ *         time than the old 4 blocking scans with their HAL_Delay
+ *         settling. Samples that deviate hard from a cell's
+ *         already-established mean are rejected as motion - a bump or
+ *         lean mid-calibration costs a few samples, not the baseline.
+ */
+void GRID_Calibrate(void)
+{
+    #define CALIBRATION_SAMPLES 16
+    #define CALIBRATION_WARMUP  4
+    /* Reject samples further than this from the cell's running mean
+     * once the warmup has pinned it down */
+    #define CALIBRATION_OUTLIER (ADC_NOISE_THRESHOLD * 8U)
+
+    /* Per-cell spread and accepted-sample count across the calibration
+     * scans (rejection makes counts differ); static so the tables do
+     * not land on the stack (only live during cal) */
+    static uint32_t minSeen[GRID_NUM_ROWS][GRID_NUM_COLS];
+    static uint32_t maxSeen[GRID_NUM_ROWS][GRID_NUM_COLS];
+    static uint8_t calCount[GRID_NUM_ROWS][GRID_NUM_COLS];
+
+    g_GridData.state = GRID_STATE_CALIBRATING;
+
+    /* Clear baseline */
+    memset(g_GridData.baseline, 0, sizeof(g_GridData.baseline));
+    memset(maxSeen, 0, sizeof(maxSeen));
+    memset(minSeen, 0xFF, sizeof(minSeen));
+    memset(calCount, 0, sizeof(calCount));
+
+    /* Lift the scan skips for the duration: a repaired column must be
+     * able to requalify itself */
+    s_DeadColMask = 0;
+    GRID_ApplyColumnSkips();
+
+    /* Calibrate at the FAST conversion rate regardless of the active
+     * profile: baseline quality comes from averaging many samples, not
+     * from slow-rate SNR, and at the QUIET rate this many samples
+     * would take tens of seconds of hands-off-the-grid stillness. The
+     * active profile's rate is restored below. */
+    const GridProfileDef_t *fast = &s_Profiles[GRID_PROFILE_FAST];
+    const GridProfileDef_t *active = &s_Profiles[s_Profile];
+    if (active != fast) {
+        ADS1220_SetDataRate(fast->reg1DrMode, fast->reg2Reject,
+                            fast->convTimeUs);
+    }
+
+    /* Accumulate, GRID_ScanMatrix-style: the next row is driven before
+     * this row's samples are folded, so its settling runs under the
+     * accumulation arithmetic instead of as dead delay time */
+    uint32_t settleCycles =
+        (uint32_t)s_SettleTimeUs * (SystemCoreClock / 1000000UL);
+
+    for (uint8_t scan = 0; scan < CALIBRATION_SAMPLES; scan++) {
+        uint8_t row = 0;
+        GRID_EnableRow(0);
+        uint32_t settleStart = DWT->CYCCNT;
+        if (s_RowTimReady) {
+            GRID_RowTimerArm(s_SettleTimeUs, ROWTIM_FLAG);
+        }
+
+        while (row < GRID_NUM_ROWS) {
+            /* Close whatever settling the fold below did not cover */
+            if (s_RowTimReady) {
+                while (!s_RowTimDone) {
+                    __WFI();
+                }
+            } else {
+                while ((DWT->CYCCNT - settleStart) < settleCycles) { }
+            }
+
+            uint32_t colValues[GRID_NUM_COLS];
+            ADS1220_ReadAllColumns(colValues);
+
+            /* Pre-drive the next row before folding this one */
+            uint8_t next = (uint8_t)(row + 1U);
+            if (next < GRID_NUM_ROWS) {
+                GRID_EnableRow(next);
+                settleStart = DWT->CYCCNT;
+                if (s_RowTimReady) {
+                    GRID_RowTimerArm(s_SettleTimeUs, ROWTIM_FLAG);
+                }
+            }
+
+            /* Fold into the running means (next row settles meanwhile).
+             * Means run in the scaled baseline domain; the half-LSB of
+             * rounding this costs is a single count of the 16-bit
+             * output, well under every noise threshold */
+            for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+                uint32_t v = colValues[col];
+                uint32_t vs = (v + (1UL << (ADC_SCALE_SHIFT - 1U)))
+                              >> ADC_SCALE_SHIFT;
+                uint16_t *mean = &g_GridData.baseline[row][col];
+                uint8_t *n = &calCount[row][col];
+
+                /* Outlier rejection: once the warmup samples have
+                 * established the mean, a sample this far out is
+                 * someone touching the grid, not noise - drop it so
+                 * motion never averages into the baseline */
+                if (*n >= CALIBRATION_WARMUP) {
+                    uint32_t dev = (vs > *mean) ? (vs - *mean)
+                                                : (*mean - vs);
+                    if (dev > (CALIBRATION_OUTLIER >> ADC_SCALE_SHIFT)) {
+                        continue;
+                    }
+                }
+
+                /* Incremental mean: no wide accumulator, no second
+                 * averaging pass over the whole array */
+                (*n)++;
+                *mean = (uint16_t)((int32_t)*mean
+                        + (int32_t)(vs - *mean) / (int32_t)*n);
+
+                if (v < minSeen[row][col]) minSeen[row][col] = v;
+                if (v > maxSeen[row][col]) maxSeen[row][col] = v;
+            }
+
+            row = next;
+        }
+    }
+
+    /* Turn each cell's accepted-sample spread into its noise
+     * threshold: noisy edge columns get headroom, quiet center cells
+     * keep sensitivity for light touches */
+    for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
+        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+            uint32_t spread = maxSeen[row][col] - minSeen[row][col];
+            uint32_t thresh =
+                ADC_THRESH_FLOOR + spread * ADC_THRESH_SPREAD_MULT;
+            if (thresh > 0xFFFFU) thresh = 0xFFFFU;
+            s_NoiseThreshold[row][col] = (uint16_t)thresh;
+        }
+    }
+
+    /* Dead-channel detection: a healthy velostat cell always shows a
+     * few codes of spread over the calibration reads, and its resting
+     * level sits well inside the rails. A column whose every cell is
+     * rail-pinned or perfectly static is an open or shorted trace (or
+     * a dead AFE input): drop it from the conversion schedule and flag
+     * it in the metadata so the host interpolates. The wire mask is 32
+     * bits, so columns past 31 (40x40 build) are never flagged - same
+     * rule as the ROI column mask. */
+    for (uint8_t col = 0; col < GRID_NUM_COLS && col < 32U; col++) {
+        uint8_t dead = 1;
+        for (uint8_t row = 0; row < GRID_NUM_ROWS && dead; row++) {
+            uint32_t mean = (uint32_t)g_GridData.baseline[row][col]
+                            << ADC_SCALE_SHIFT;
+            uint32_t spread = maxSeen[row][col] - minSeen[row][col];
+            if (spread != 0U && mean > GRID_DEAD_RAIL_LOW
+                    && mean < GRID_DEAD_RAIL_HIGH) {
+                dead = 0;
+            }
+        }
+        if (dead) {
+            s_DeadColMask |= (1UL << col);
+        }
+    }
+    GRID_ApplyColumnSkips();
+
+    GRID_DisableAllRows();
+
+    /* Back to the active profile's rate (no-op when FAST is active) */
+    if (active != fast) {
+        ADS1220_SetDataRate(active->reg1DrMode, active->reg2Reject,
+                            active->convTimeUs);
+    }
+
+    s_IsCalibrated = 1;
+
+    /* The baseline just captured belongs to the present die temperature:
+     * make that the zero point of the per-chip compensation */
+    GRID_TempReference();
+
+    /* Persist so the next boot starts calibrated immediately */
+    GRID_SaveBaseline();
+
+    g_GridData.state = GRID_STATE_IDLE;
+}
+
+/**
+ * @brief  Re-read this row's borderline cells at boosted PGA gain
+ * @note   One extra conversion round per channel that has boosted cells
+ *         on it; all boosted chips of a channel convert concurrently.
+ *         The boosted 24-bit code is divided back by the gain, so
+ *         everything downstream stays in the gain-1 domain - just with
+ *         finer quantization where it matters. A clipped boosted read
+ *         keeps the gain-1 value and steps that cell's gain back down.
+ */
+static void GRID_AutoRangeRow(uint8_t row,
+                              uint32_t colValues[GRID_NUM_COLS])
+{
+    if (!s_AutoRange) {
+        return;
+    }
+
+    ADS1220_Mask_t alive = ADS1220_GetAliveMask();
+
+    for (uint8_t ch = 0; ch < ADS1220_CHANNELS; ch++) {
+        if (!(s_RoiChMask & (uint8_t)(1U << ch))) {
+            continue;
+        }
+
+        ADS1220_Mask_t mask = 0;
+        for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+            uint8_t col = (uint8_t)(chip * ADS1220_CHANNELS + ch);
+            if ((alive & (ADS1220_Mask_t)(1UL << chip)) &&
+                s_CellGainShift[row][col] != 0U) {
+                ADS1220_SelectAndStartGain(chip, ch,
+                                           s_CellGainShift[row][col]);
+                mask |= (ADS1220_Mask_t)(1UL << chip);
+            }
+        }
+        if (mask == 0U) {
+            continue;
+        }
+
+        ADS1220_WaitReady(mask);
+
+        for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+            if (!(mask & (ADS1220_Mask_t)(1UL << chip))) {
+                continue;
+            }
+            uint8_t col = (uint8_t)(chip * ADS1220_CHANNELS + ch);
+            uint32_t raw = ADS1220_ReadResult(chip);
+            if (raw >= GRID_AUTORANGE_SAT_RAW) {
+                s_CellGainShift[row][col]--;
+            } else {
+                colValues[col] = raw >> s_CellGainShift[row][col];
+            }
+        }
+    }
+}
+
+/**
+ * @brief  Reclaim the scan half of the double buffer for writing
+ * @note   Frame start in both scan engines. The flip at the transmit
+ *         boundary only moved here if no reader holds this half, so
+ *         clearing the seal is all the claim needs to do
+ */
+static void GRID_ClaimFrame(void)
+{
+    s_FrameSlots[g_GridData.scanIndex].sealed = 0;
+    __DMB();
+}
+
+/**
+ * @brief  Seal the just-finished scan half immutable and publish it
+ * @note   Frame end in both scan engines, after frameCount settles.
+ *         The barrier orders the cell writes before the seal so an
+ *         acquiring reader never sees a half-written frame
+ */
+static void GRID_SealFrame(void)
+{
+    uint8_t slot = g_GridData.scanIndex;
+
+    /* Promote the finished frame's crosstalk aggregates; the next
+     * frame compensates against them */
+    memcpy(s_XtRowSum, s_XtRowAcc, sizeof(s_XtRowSum));
+    memcpy(s_XtColSum, s_XtColAcc, sizeof(s_XtColSum));
+    memset(s_XtRowAcc, 0, sizeof(s_XtRowAcc));
+    memset(s_XtColAcc, 0, sizeof(s_XtColAcc));
+
+    s_FrameSlots[slot].seq = g_GridData.frameCount;
+    __DMB();
+    s_FrameSlots[slot].sealed = 1;
+    s_PublishedSlot = slot;
+}
+
+/**
+ * @brief  Scan the entire grid
+ */
+void GRID_ScanMatrix(void)
+{
+    uint32_t scanStart = DWT->CYCCNT;
+
+    g_GridData.state = GRID_STATE_SCANNING;
+    GRID_ClaimFrame();
+    memset(&s_FrameStats, 0, sizeof(s_FrameStats));
+
+    /* Interleaved ordering: the next row is driven the moment the
+     * current row's conversions are harvested, so its settling runs
+     * underneath GRID_ProcessRow's arithmetic instead of as dead wait.
+     * Only whatever settling time the processing did not cover is
+     * actually spent idling at the top of the loop. */
+    uint32_t settleCycles =
+        (uint32_t)s_SettleTimeUs * (SystemCoreClock / 1000000UL);
+
+    uint8_t row = GRID_NextScheduledRow(s_RoiRowStart);
+    uint32_t settleStart = DWT->CYCCNT;
+
+    if (row != 0xFFU) {
+        GRID_EnableRow(row);
+        settleStart = DWT->CYCCNT;
+        if (s_RowTimReady) {
+            GRID_RowTimerArm(s_SettleTimeUs, ROWTIM_FLAG);
+        }
+    }
+
+    while (row != 0xFFU) {
+        /* Sleep (not spin) until the compare armed at row-enable time
+         * closes any settling not already hidden under processing; the
+         * DWT burn-off only remains as the no-timer fallback */
+        uint32_t profStart = DWT->CYCCNT;
+        if (s_RowTimReady) {
+            while (!s_RowTimDone) {
+                __WFI();
+            }
+        } else {
+            while ((DWT->CYCCNT - settleStart) < settleCycles) { }
+        }
+        GRID_ProfAdd(GRID_PROF_SETTLE, profStart);
+
+        /* Read all columns via ADS1220s, accumulating extra passes
+         * when oversampling is on (each pass overlaps all chips) */
+        uint32_t colValues[GRID_NUM_COLS];
+        profStart = DWT->CYCCNT;
+        ADS1220_ReadAllColumns(colValues);
+
+        if (s_OversampleShift) {
+            uint32_t extra[GRID_NUM_COLS];
+            for (uint8_t n = 1; n < (1U << s_OversampleShift); n++) {
+                ADS1220_ReadAllColumns(extra);
+                for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+                    colValues[col] += extra[col];
+                }
+            }
+            for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+                colValues[col] >>= s_OversampleShift;
+            }
+        }
+
+        /* Borderline cells flagged last frame get a gain-boosted pass */
+        GRID_AutoRangeRow(row, colValues);
+        GRID_ProfAdd(GRID_PROF_READ, profStart);
+
+        /* Pre-drive the next scheduled row before processing this one */
+        uint8_t next = GRID_NextScheduledRow(row + 1U);
+        if (next != 0xFFU) {
+            GRID_EnableRow(next);
+            settleStart = DWT->CYCCNT;
+            if (s_RowTimReady) {
+                GRID_RowTimerArm(s_SettleTimeUs, ROWTIM_FLAG);
+            }
+        }
+
+        /* Process and store values (settling ticks away meanwhile) */
+        profStart = DWT->CYCCNT;
+        GRID_ProcessRow(row, colValues);
+        GRID_ProfAdd(GRID_PROF_PROCESS, profStart);
+
+        /* Row streaming: ship this row now so its wire time overlaps
+         * the rest of the scan instead of waiting for the frame */
+        if (s_RowStreamMode) {
+            GRID_TransmitRow(row);
+        }
+        row = next;
+    }
+
+    GRID_DisableAllRows();
+
+    /* Rotating temperature slot: one extra conversion per frame (out
+     * of ~512) keeps every chip's correction a few seconds fresh */
+    uint8_t tempChip = GRID_NextTempChip();
+    if (tempChip < ADS1220_NUM_CHIPS) {
+        GRID_TempFold(tempChip, ADS1220_ReadTemperature(tempChip));
+    }
+
+    g_GridData.frameCount++;
+    GRID_SealFrame();
+    g_GridData.lastScanTimeMs = HAL_GetTick();
+    GRID_JitterRecord();
+    GRID_IdleFrameHook();
+    s_LastScanUs = (DWT->CYCCNT - scanStart)
+                   / (SystemCoreClock / 1000000UL);
+    GRID_GovernorUpdate();
+
+    /* Fold this frame's phase totals into the stats-period windows */
+    s_Prof[GRID_PROF_FRAME].frameCycles = DWT->CYCCNT - scanStart;
+    GRID_ProfFold(GRID_PROF_SETTLE);
+    GRID_ProfFold(GRID_PROF_READ);
+    GRID_ProfFold(GRID_PROF_PROCESS);
+    GRID_ProfFold(GRID_PROF_FRAME);
+    g_GridData.state = GRID_STATE_IDLE;
+}
+
+/**
+ * @brief  Scan and transmit one binned half-resolution preview frame
+ * @note   Row pairs are driven together through one BSRR write and only
+ *         even columns (ADS1220 channels 0 and 2) are converted, so the
+ *         frame costs roughly a quarter of a full scan. Values are raw
+ *         inversions without baseline subtraction - all contact
+ *         detection and the spine-line drag gesture need. Packets carry
+ *         0xAA 0x56 sync so the host can tell preview from full frames.
+ */
+void GRID_ScanPreview(void)
+{
+    static const uint8_t previewCh[2] = { 0U, 2U };
+
+    g_GridData.state = GRID_STATE_SCANNING;
+
+    s_PreviewBuffer[0] = PACKET_SYNC_BYTE_1;
+    s_PreviewBuffer[1] = PACKET_SYNC_PREVIEW;
+
+    for (uint8_t pair = 0; pair < PREVIEW_NUM_ROWS; pair++) {
+#if GRID_CFG_ROWS_MUXED
+        /* A mux bank can only route one row at a time, so the binned
+         * pair degrades to its even row; preview only needs contact
+         * detection, not absolute level */
+        GRID_EnableRow((uint8_t)(pair * 2U));
+#else
+        /* Drive both rows of the pair in one atomic BSRR write */
+        uint32_t pins = 3UL << (pair * 2U);
+        ROW_GPIO_PORT->BSRR = ((ROW_GPIO_PINS & ~pins) << 16) | pins;
+#endif
+        GRID_DelayUs(s_SettleTimeUs);
+
+        uint8_t *payload = &s_PreviewBuffer[PACKET_HEADER_SIZE
+            + (uint16_t)pair * PREVIEW_NUM_COLS * 2U];
+
+        for (uint8_t c = 0; c < 2U; c++) {
+            uint8_t ch = previewCh[c];
+
+            for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                ADS1220_SelectAndStart(chip, ch);
+            }
+            ADS1220_WaitReady(ADS1220_GetAliveMask());
+
+            for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                uint32_t raw = ADS1220_ReadResult(chip);
+                uint32_t pressure =
+                    (raw < ADC_MAX_VALUE) ? (ADC_MAX_VALUE - raw) : 0;
+                if (pressure < ADC_NOISE_THRESHOLD) {
+                    pressure = 0;
+                }
+                uint16_t val = (uint16_t)(pressure >> ADC_SCALE_SHIFT);
+
+                /* Preview column: each chip contributes two kept
+                 * columns; channel 2 is the second of the pair */
+                uint16_t idx =
+                    (uint16_t)(chip * 2U + (ch >> 1)) * 2U;
+                payload[idx] = (uint8_t)(val & 0xFF);
+                payload[idx + 1U] = (uint8_t)(val >> 8);
+            }
+        }
+    }
+
+    GRID_DisableAllRows();
+
+    uint16_t fi = PACKET_HEADER_SIZE + PREVIEW_PAYLOAD_SIZE;
+    uint32_t crc = GRID_CrcBlock(&s_PreviewBuffer[PACKET_HEADER_SIZE],
+                                 PREVIEW_PAYLOAD_SIZE);
+    s_PreviewBuffer[fi++] = (uint8_t)(crc & 0xFF);
+    s_PreviewBuffer[fi++] = (uint8_t)((crc >> 8) & 0xFF);
+    s_PreviewBuffer[fi++] = (uint8_t)((crc >> 16) & 0xFF);
+    s_PreviewBuffer[fi++] = (uint8_t)((crc >> 24) & 0xFF);
+    s_PreviewBuffer[fi++] = '\r';
+    s_PreviewBuffer[fi++] = '\n';
+
+    while (s_TxBusy) { }
+    GRID_Send(s_PreviewBuffer, PREVIEW_TOTAL_SIZE);
+
+    g_GridData.frameCount++;
+    g_GridData.lastScanTimeMs = HAL_GetTick();
+    g_GridData.state = GRID_STATE_IDLE;
+}
+
+/**
+ * @brief  Unsigned halfword-pair minimum using the M4 DSP extensions
+ * @note   USUB16 latches a per-halfword GE flag (set where op1 >= op2);
+ *         SEL then steers each lane from its flag - two 16-bit min/max
+ *         results per instruction with no branches. The difference
+ *         itself is discarded; only the GE side effect matters.
+ */
+static inline uint32_t GRID_DspUMin16(uint32_t a, uint32_t b)
+{
+    (void)__USUB16(a, b);
+    return __SEL(b, a);
+}
+
+/** @brief  Unsigned halfword-pair maximum (see GRID_DspUMin16) */
+static inline uint32_t GRID_DspUMax16(uint32_t a, uint32_t b)
+{
+    (void)__USUB16(a, b);
+    return __SEL(a, b);
+}
+
+/**
+ * @brief  Median-of-3 spike filter across a whole row, two cells at a
+ *         time, rotating the two-frame history as it goes
+ * @note   The scalar median3 costs three compare/branch pairs per cell;
+ *         the SEL form is four branch-free ops per cell PAIR, roughly
+ *         halving the stage. All three arrays are word-aligned: the row
+ *         stride is GRID_NUM_COLS halfwords (even in both grid builds)
+ *         and the buffers are 4-byte aligned at their definitions.
+ */
+static void GRID_DspMedian3Row(uint16_t *vals, uint16_t *h0, uint16_t *h1)
+{
+    uint32_t *v = (uint32_t *)(void *)vals;
+    uint32_t *p0 = (uint32_t *)(void *)h0;
+    uint32_t *p1 = (uint32_t *)(void *)h1;
+
+    for (uint8_t i = 0; i < GRID_NUM_COLS / 2U; i++) {
+        uint32_t a = p0[i];
+        uint32_t b = p1[i];
+        uint32_t c = v[i];
+
+        p0[i] = b;
+        p1[i] = c;
+
+        /* median3 = max(min(a,b), min(max(a,b), c)), per lane */
+        v[i] = GRID_DspUMax16(GRID_DspUMin16(a, b),
+                              GRID_DspUMin16(GRID_DspUMax16(a, b), c));
+    }
+}
+
+/**
+ * @brief  Convert one row of raw 24-bit readings to 16-bit pressure
+ * @note   Zero-copy: the little-endian payload bytes are written straight
+ *         into this frame's TX buffer, so GRID_TransmitData only has to
+ *         append metadata and run the packed bytes through the CRC unit.
+ *         Staged as row passes: the conditional 32-bit front half
+ *         (baseline, crosstalk, threshold, drift) runs per cell, then
+ *         the elementwise 16-bit filters run over the packed row so the
+ *         DSP kernels above can chew two cells per instruction.
+ */
+static void GRID_ProcessRow(uint8_t row,
+                            const uint32_t colValues[GRID_NUM_COLS])
+{
+    uint16_t vals[GRID_NUM_COLS] __attribute__((aligned(4))) = { 0 };
+    uint8_t rowActive = 0;
+
+    for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+        /* Outside the ROI column window the cell stays zeroed. The
+         * wire mask is 32 bits, so columns past 31 (40x40 build) are
+         * always scanned. */
+        if (col < 32U && !(s_RoiColMask & (1UL << col))) {
+            continue;
+        }
+
+        /* Dead column: stays zeroed on the wire (the conversion slot
+         * was never spent), flagged in the metadata for interpolation */
+        if (col < 32U && (s_DeadColMask & (1UL << col))) {
+            continue;
+        }
+
+        uint32_t raw = colValues[col];
+        uint32_t pressure;
+
+        if (s_IsCalibrated) {
+            /* Subtract the temperature-corrected baseline (stored in
+             * the scaled domain, reconstructed to raw here): the
+             * per-chip term predicts where the resting level has
+             * drifted to */
+            int32_t base = ((int32_t)g_GridData.baseline[row][col]
+                            << ADC_SCALE_SHIFT)
+                         + s_TempComp[col >> 2];
+            int32_t diff = base - (int32_t)raw;
+            pressure = (diff > 0) ? (uint32_t)diff : 0;
+        } else {
+            /* Invert: higher pressure = lower ADC reading */
+            pressure = (raw < ADC_MAX_VALUE) ? (ADC_MAX_VALUE - raw) : 0;
+        }
+
+        /* Crosstalk compensation: subtract the ghost a press elsewhere
+         * on this row or column induces here. The aggregate terms are
+         * the previous frame's activity sums (own contribution
+         * excluded via the other frame half) - ghosting is
+         * quasi-static at frame rate, and the frame-old terms keep
+         * this single-pass: a handful of fixed-point ops per cell,
+         * well inside the conversion-wait window. Runs before the
+         * threshold so ghosts are removed, not just hidden under it. */
+        if (s_XtalkCoeff != 0U && s_IsCalibrated) {
+            uint32_t vprev =
+                g_GridData.frame[g_GridData.scanIndex ^ 1U][row][col];
+            uint32_t rowTerm = (s_XtRowSum[row] > vprev)
+                               ? s_XtRowSum[row] - vprev : 0U;
+            uint32_t colTerm = (s_XtColSum[col] > vprev)
+                               ? s_XtColSum[col] - vprev : 0U;
+            uint32_t ghost = (((rowTerm + colTerm) * s_XtalkCoeff) >> 8)
+                             << ADC_SCALE_SHIFT;
+            pressure = (pressure > ghost) ? pressure - ghost : 0U;
+        }
+
+        /* Steer the per-cell gain for the next frame: amplitudes just
+         * above the noise floor earn a boosted re-read, anything with
+         * solid signal (or none at all) decays back toward gain 1 so
+         * idle cells stop paying for the extra conversion */
+        if (s_AutoRange) {
+            uint8_t *sh = &s_CellGainShift[row][col];
+            if (pressure != 0U && pressure < GRID_AUTORANGE_LOW) {
+                if (*sh < GRID_AUTORANGE_MAX_SHIFT) {
+                    (*sh)++;
+                }
+            } else if (*sh > 0U) {
+                (*sh)--;
+            }
+        }
+
+        /* Apply this cell's learned noise threshold */
+        if (pressure < s_NoiseThreshold[row][col]) {
+            pressure = 0;
+        } else {
+            rowActive = 1;
+        }
+
+        /* Untouched cells slowly pull the baseline toward the current
+         * reading, tracking velostat temperature/humidity creep so a
+         * long session never needs a recalibration stop. A pressed
+         * cell is left alone - we must not learn the touch away. */
+        if (s_IsCalibrated && pressure == 0U) {
+            /* Track against the corrected baseline, so the EWMA learns
+             * only the temperature-free residue instead of slowly
+             * re-absorbing what the compensation already removed. The
+             * baseline moves in scaled LSBs (256 raw counts each); the
+             * deadband defeat only fires once the residue is worth at
+             * least half an LSB, or noise alone would walk it upward */
+            int32_t drift = (int32_t)raw
+                          - (((int32_t)g_GridData.baseline[row][col]
+                              << ADC_SCALE_SHIFT)
+                             + s_TempComp[col >> 2]);
+            int32_t step = drift >> (GRID_BASELINE_DRIFT_SHIFT
+                                     + ADC_SCALE_SHIFT);
+            if (step == 0 && drift > (1L << (GRID_BASELINE_DRIFT_SHIFT
+                                             + ADC_SCALE_SHIFT - 1U))) {
+                step = 1;   /* Defeat the truncation deadband */
+            }
+            int32_t next = (int32_t)g_GridData.baseline[row][col] + step;
+            if (next < 0) {
+                next = 0;
+            } else if (next > 0xFFFF) {
+                next = 0xFFFF;
+            }
+            g_GridData.baseline[row][col] = (uint16_t)next;
+        }
+
+        /* Scale 24-bit to 16-bit for transmission */
+        vals[col] = (uint16_t)(pressure >> ADC_SCALE_SHIFT);
+    }
+
+    /* Optional spike rejection: median of this value and the two
+     * previous frames', so a one-frame transient never escapes. Runs
+     * before the EWMA so spikes are not smeared into it - the DSP
+     * kernel filters two cells per instruction */
+    if (s_MedianMode) {
+        GRID_DspMedian3Row(vals, s_MedianHist[0][row],
+                           s_MedianHist[1][row]);
+    }
+
+    /* Optional EWMA stage: state += alpha * (new - state), with
+     * alpha = 1/2^shift done as a plain arithmetic shift. Stays
+     * scalar: the Q8 state is 24 bits wide, and dropping the fraction
+     * to pack two per halfword would bring back the settling deadband
+     * the extra precision exists to defeat */
+    if (s_FilterShift) {
+        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+            uint32_t *st = &s_FilterState[row][col];
+            int32_t diff = (int32_t)((uint32_t)vals[col] << 8)
+                         - (int32_t)*st;
+            *st = (uint32_t)((int32_t)*st + (diff >> s_FilterShift));
+            vals[col] = (uint16_t)(*st >> 8);
+        }
+    }
+
+    /* Latency-probe marker: planted after the filters so it reaches
+     * the wire intact, before the commit pass so it rides the same
+     * aggregate/stats/pack path as a real touch. The injection tick
+     * goes out on the log channel for the host's breakdown report */
+    if (s_Inject.armed && row == s_Inject.row) {
+        vals[s_Inject.col] = s_Inject.value;
+        s_Inject.armed = 0;
+
+        char msg[24];
+        memcpy(msg, "latinj t=", 9);
+        char *p = GRID_HexU32(&msg[9], HAL_GetTick());
+        *p++ = '\n';
+        GRID_LogWrite((const uint8_t *)msg, (uint16_t)(p - msg));
+    }
+
+    /* Commit pass: excluded columns are forced back to zero first (the
+     * EWMA now runs over the whole row, and would otherwise bleed a
+     * decaying tail onto the wire after an ROI shrink), then the
+     * aggregates and frame summary come from the finished values */
+    uint32_t excl = ~s_RoiColMask | s_DeadColMask;
+    for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+        if (col < 32U && ((excl >> col) & 1U)) {
+            vals[col] = 0;
+        }
+        uint16_t val = vals[col];
+
+        /* Crosstalk aggregates for the next frame's compensation */
+        s_XtRowAcc[row] += val;
+        s_XtColAcc[col] += val;
+
+        /* Frame summary accumulation - the cell is already in hand */
+        if (val > 0U) {
+            s_FrameStats.total += val;
+            s_FrameStats.momentRow += (uint32_t)val * row;
+            s_FrameStats.momentCol += (uint32_t)val * col;
+            if (val > s_FrameStats.peak) {
+                s_FrameStats.peak = val;
+                s_FrameStats.peakRow = row;
+                s_FrameStats.peakCol = col;
+            }
+        }
+    }
+
+    /* Word-wide copy into the frame half - same u16 row layout */
+    memcpy(&g_GridData.frame[g_GridData.scanIndex][row][0], vals,
+           sizeof(vals));
+
+    /* Pack the row into the TX buffer in the negotiated format */
+    uint8_t *txBuf = s_TxBuffer[g_GridData.scanIndex];
+    if (s_PackedMode) {
+        /* 12-bit packed: two cells in 3 bytes, 48 bytes per row */
+        uint8_t *payload = &txBuf[PACKET_HEADER_SIZE
+            + (uint16_t)row * (GRID_NUM_COLS / 2U) * 3U];
+        for (uint8_t col = 0; col < GRID_NUM_COLS; col += 2U) {
+            uint16_t a = vals[col] >> 4;
+            uint16_t b = vals[col + 1U] >> 4;
+            payload[0] = (uint8_t)(a & 0xFF);
+            payload[1] = (uint8_t)((a >> 8) | ((b & 0x0FU) << 4));
+            payload[2] = (uint8_t)(b >> 4);
+            payload += 3;
+        }
+    } else {
+        /* The wire format is little-endian u16, which on this core is
+         * the in-memory layout - a straight copy, word-wide */
+        memcpy(&txBuf[PACKET_HEADER_SIZE + (uint16_t)row
+                      * GRID_NUM_COLS * 2U],
+               vals, sizeof(vals));
+    }
+
+    /* Feed the adaptive scheduler: contact re-arms the hold window, a
+     * clean row lets it decay toward the idle refresh rota */
+    if (rowActive) {
+        s_RowActivity[row] = GRID_ACTIVITY_HOLD_FRAMES;
+    } else if (s_RowActivity[row] > 0) {
+        s_RowActivity[row]--;
+    }
+}
+
+/**
+ * @brief  Restrict scanning to a region of interest
+ */
+void GRID_SetROI(uint8_t rowStart, uint8_t rowEnd, uint32_t colMask)
+{
+    if (rowEnd >= GRID_NUM_ROWS) rowEnd = GRID_NUM_ROWS - 1U;
+    if (rowStart > rowEnd) rowStart = rowEnd;
+    if (colMask == 0U) colMask = 0xFFFFFFFFUL;
+
+    s_RoiRowStart = rowStart;
+    s_RoiRowEnd = rowEnd;
+    s_RoiColMask = colMask;
+
+    /* Column col lives on chip col/4, channel col%4: work out which
+     * channel indices still need a conversion round at all. The wire
+     * mask covers 32 columns; any past that always convert. */
+    s_RoiChMask = 0;
+    for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+        if (col >= 32U || (colMask & (1UL << col))) {
+            s_RoiChMask |= (uint8_t)(1U << (col % ADS1220_CHANNELS));
+        }
+    }
+
+    /* Cells outside the window transmit as zero; clearing them here
+     * keeps the running checksum valid (zero bytes contribute zero) */
+    memset(g_GridData.frame, 0, sizeof(g_GridData.frame));
+    for (uint8_t b = 0; b < 2; b++) {
+        memset(&s_TxBuffer[b][PACKET_HEADER_SIZE], 0, PACKET_PAYLOAD_SIZE);
+    }
+}
+
+/**
+ * @brief  Restore full-grid scanning
+ */
+void GRID_ClearROI(void)
+{
+    GRID_SetROI(0, GRID_NUM_ROWS - 1U, 0xFFFFFFFFUL);
+}
+
+/**
+ * @brief  Set the row settling time in microseconds
+ */
+void GRID_SetSettleTime(uint16_t settleUs)
+{
+    if (settleUs > GRID_SETTLE_US_MAX) {
+        settleUs = GRID_SETTLE_US_MAX;
+    }
+    s_SettleTimeUs = settleUs;
+}
+
+/**
+ * @brief  Get the current row settling time in microseconds
+ */
+uint16_t GRID_GetSettleTime(void)
+{
+    return s_SettleTimeUs;
+}
+
+/**
+ * @brief  Switch to a named acquisition profile
+ * @note   One broadcast reprograms every chip, then each derived timing
+ *         is recomputed from the new conversion period: the settling
+ *         time, the conversion-wait cap (2x the period, rounded up to
+ *         whole ticks) and the pacing of a running timer scan. A frame
+ *         in flight may mix rates for its remaining rows; the next one
+ *         is uniform.
+ */
+void GRID_SetProfile(uint8_t profile)
+{
+    if (profile >= GRID_PROFILE_COUNT) {
+        return;
+    }
+    const GridProfileDef_t *p = &s_Profiles[profile];
+    s_Profile = (GridProfile_t)profile;
+
+    ADS1220_SetDataRate(p->reg1DrMode, p->reg2Reject, p->convTimeUs);
+
+    GRID_SetSettleTime(p->settleUs);
+
+    uint32_t ticks = (2U * p->convTimeUs + GRID_SCAN_TICK_US - 1U)
+                     / GRID_SCAN_TICK_US;
+    if (ticks > 0xFFFFU) {
+        ticks = 0xFFFFU;
+    }
+    s_ConvertTimeoutTicks = (uint16_t)ticks;
+
+    if (s_TimerScan.running) {
+        s_TimerScan.frameIntervalTicks = (uint16_t)
+            ((uint32_t)p->frameIntervalMs * 1000U / GRID_SCAN_TICK_US);
+    }
+}
+
+/**
+ * @brief  Get the active acquisition profile
+ */
+uint8_t GRID_GetProfile(void)
+{
+    return (uint8_t)s_Profile;
+}
+
+/**
+ * @brief  Reconfigure the UART to a new baud rate
+ * @note   Waits for the in-flight packet and the shift register to
+ *         drain so the last frame at the old rate arrives intact
+ */
+void GRID_SetUartBaud(uint32_t baud)
+{
+    while (s_TxBusy) { }
+    while (__HAL_UART_GET_FLAG(s_hUart, UART_FLAG_TC) == RESET) { }
+
+    HAL_UART_AbortReceive(s_hUart);
+    s_hUart->Init.BaudRate = baud;
+    if (HAL_UART_Init(s_hUart) != HAL_OK) {
+        Error_Handler();
+    }
+    HAL_UART_Receive_IT(s_hUart, &s_RxByte, 1);
+}
+
+/**
+ * @brief  Auto-tune the settling time for this grid build
+ * @note   For each candidate delay (stepping down from the default), a
+ *         sample of rows is read and compared against a fully-settled
+ *         reference reading of the same row. The shortest delay whose
+ *         worst-case deviation stays inside GRID_SETTLE_TOLERANCE wins,
+ *         plus a small guard margin. Run at boot with the grid unloaded
+ *         or quiescent; on any instability the previous (longer) delay
+ *         is kept, so the routine can only ever pick a safe value.
+ */
+uint16_t GRID_CalibrateSettleTime(void)
+{
+    static const uint16_t candidates[] =
+        { 100U, 75U, 50U, 35U, 25U, 15U, 10U, 5U };
+    /* Spot-check rows from both ends and the middle of the grid: edge
+     * rows have the longest trace runs and settle slowest */
+    static const uint8_t testRows[] = { 0U, 7U, 15U };
+
+    uint32_t reference[sizeof(testRows)][GRID_NUM_COLS];
+    uint32_t sample[GRID_NUM_COLS];
+    uint16_t best = GRID_SETTLE_US_DEFAULT;
+
+    g_GridData.state = GRID_STATE_CALIBRATING;
+
+    /* Reference: fully-settled readings for each test row */
+    for (uint8_t r = 0; r < sizeof(testRows); r++) {
+        GRID_EnableRow(testRows[r]);
+        GRID_DelayUs(GRID_SETTLE_US_MAX);
+        ADS1220_ReadAllColumns(reference[r]);
+    }
+
+    for (uint8_t c = 0; c < sizeof(candidates) / sizeof(candidates[0]); c++) {
+        uint8_t stable = 1;
+
+        for (uint8_t r = 0; r < sizeof(testRows) && stable; r++) {
+            /* Park on a different row first so each trial sees a real
+             * row-to-row transition, then time only the candidate delay */
+            GRID_EnableRow((testRows[r] + 1U) % GRID_NUM_ROWS);
+            GRID_DelayUs(GRID_SETTLE_US_MAX);
+            GRID_EnableRow(testRows[r]);
+            GRID_DelayUs(candidates[c]);
+            ADS1220_ReadAllColumns(sample);
+
+            for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
+                int32_t dev = (int32_t)sample[col]
+                            - (int32_t)reference[r][col];
+                if (dev < 0) dev = -dev;
+                if ((uint32_t)dev > GRID_SETTLE_TOLERANCE) {
+                    stable = 0;
+                    break;
+                }
+            }
+        }
+
+        if (!stable) {
+            break;  /* Keep the last delay that passed */
+        }
+        best = candidates[c];
+    }
+
+    GRID_DisableAllRows();
+    g_GridData.state = GRID_STATE_IDLE;
+
+    GRID_SetSettleTime(best + GRID_SETTLE_GUARD_US);
+    return s_SettleTimeUs;
+}
+
+/**
+ * @brief  Bring up the row-timeline timer
+ * @note   TIM2 free-runs at 1 MHz over its full 32-bit range; events are
+ *         scheduled by arming compare channel 1 at CNT + delay, so the
+ *         counter is never stopped and arming costs three register
+ *         writes. The IRQ gets the same priority as the TIM7 scan tick:
+ *         both drive s_TimerScan and must take turns, which their equal
+ *         preemption priority (GRID_IRQPRI_CONVERSION) guarantees even
+ *         under the full-preemption NVIC_PRIORITYGROUP_4 grouping.
+ */
+static void GRID_RowTimerInit(void)
+{
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    g_hRowTim.Instance = TIM2;
+    g_hRowTim.Init.Prescaler = 71;          /* 72 MHz / 72 = 1 MHz */
+    g_hRowTim.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_hRowTim.Init.Period = 0xFFFFFFFFUL;   /* Free-running 32-bit */
+    g_hRowTim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_OC_Init(&g_hRowTim) != HAL_OK) {
+        Error_Handler();
+    }
+
+    TIM_OC_InitTypeDef oc = {0};
+    oc.OCMode = TIM_OCMODE_TIMING;          /* Interrupt only, no pin */
+    oc.Pulse = 0;
+    if (HAL_TIM_OC_ConfigChannel(&g_hRowTim, &oc, TIM_CHANNEL_1)
+            != HAL_OK) {
+        Error_Handler();
+    }
+
+    HAL_NVIC_SetPriority(TIM2_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+    __HAL_TIM_ENABLE(&g_hRowTim);
+    s_RowTimReady = 1;
+}
+
+/**
+ * @brief  Schedule a compare interrupt on the row timeline
+ * @param  us: microseconds from now (floored at 2 so the compare value
+ *         cannot land behind the free-running counter)
+ * @param  mode: what the compare ISR should do (ROWTIM_*)
+ */
+static void GRID_RowTimerArm(uint32_t us, RowTimMode_t mode)
+{
+    if (us < 2U) {
+        us = 2U;
+    }
+    s_RowTimMode = mode;
+    s_RowTimDone = 0;
+    __HAL_TIM_SET_COMPARE(&g_hRowTim, TIM_CHANNEL_1,
+                          __HAL_TIM_GET_COUNTER(&g_hRowTim) + us);
+    __HAL_TIM_CLEAR_FLAG(&g_hRowTim, TIM_FLAG_CC1);
+    __HAL_TIM_ENABLE_IT(&g_hRowTim, TIM_IT_CC1);
+}
+
+/**
+ * @brief  Row-timeline compare expired (TIM2 CC1 ISR context)
+ * @note   In PHASE mode this is the precise end of the settling window:
+ *         one all-CS broadcast per bus STARTs the first channel on
+ *         every chip at once and the scan machine moves to CONVERT,
+ *         where the DRDY EXTI lines already event-drive the conversion
+ *         wait. The whole row timeline is then hardware-timed down to
+ *         the DRDY edges with no busy-waiting anywhere.
+ */
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance != TIM2 ||
+        htim->Channel != HAL_TIM_ACTIVE_CHANNEL_1) {
+        return;
+    }
+    __HAL_TIM_DISABLE_IT(&g_hRowTim, TIM_IT_CC1);
+
+    RowTimMode_t mode = s_RowTimMode;
+    s_RowTimMode = ROWTIM_IDLE;
+    s_RowTimDone = 1;
+
+    if (mode == ROWTIM_PHASE && s_TimerScan.running &&
+        s_TimerScan.phase == SCAN_PHASE_SETTLE) {
+        s_TimerScan.channel = GRID_NextRoiChannel(0);
+        s_TimerScan.pass = 0;
+        ADS1220_BroadcastSelectAndStart(s_TimerScan.channel);
+        s_TimerScan.phaseTicks = 0;
+        s_TimerScan.phase = SCAN_PHASE_CONVERT;
+    }
+}
+
+/**
+ * @brief  Start the timer-driven scan state machine
+ */
+void GRID_StartScanTimer(uint16_t frameIntervalMs)
+{
+    /* TIM7: 72 MHz APB1 timer clock / 72 = 1 MHz, period 100 ticks
+     * -> one update interrupt every GRID_SCAN_TICK_US */
+    __HAL_RCC_TIM7_CLK_ENABLE();
 
-/* Exported functions --------------------------------------------------------*/
+    g_hScanTim.Instance = TIM7;
+    g_hScanTim.Init.Prescaler = 71;
+    g_hScanTim.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_hScanTim.Init.Period = GRID_SCAN_TICK_US - 1U;
+    g_hScanTim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&g_hScanTim) != HAL_OK) {
+        Error_Handler();
+    }
+
+    memset(&s_TimerScan, 0, sizeof(s_TimerScan));
+    s_TimerScan.frameIntervalTicks =
+        (uint16_t)((uint32_t)frameIntervalMs * 1000U / GRID_SCAN_TICK_US);
+    s_TimerScan.phase = SCAN_PHASE_ROW_SELECT;
+    s_TimerScan.running = 1;
+
+    HAL_NVIC_SetPriority(TIM7_IRQn, GRID_IRQPRI_CONVERSION, 0);
+    HAL_NVIC_EnableIRQ(TIM7_IRQn);
+    HAL_TIM_Base_Start_IT(&g_hScanTim);
+}
 
 /**
- * @brief  Initialize the grid scanning system
+ * @brief  Stop the timer-driven scan
  */
-void GRID_Init(SPI_HandleTypeDef *hspi, UART_HandleTypeDef *huart)
+void GRID_StopScanTimer(void)
 {
-    s_hUart = huart;
-    
-    /* Clear grid data */
-    memset(&g_GridData, 0, sizeof(GridData_t));
-    g_GridData.state = GRID_STATE_IDLE;
-    
-    /* Initialize all ADS1220 chips */
-    ADS1220_Init(hspi);
-    
-    /* Disable all rows initially */
+    HAL_TIM_Base_Stop_IT(&g_hScanTim);
+    s_TimerScan.running = 0;
+    /* Disarm any in-flight settling compare */
+    __HAL_TIM_DISABLE_IT(&g_hRowTim, TIM_IT_CC1);
+    s_RowTimMode = ROWTIM_IDLE;
     GRID_DisableAllRows();
-    
-    /* Prepare packet header */
-    s_TxBuffer[0] = PACKET_SYNC_BYTE_1;
-    s_TxBuffer[1] = PACKET_SYNC_BYTE_2;
 }
 
 /**
- * @brief  Enable a specific row
+ * @brief  Advance the scan state machine by one tick (TIM7 ISR context)
+ * @note   Every phase is short and bounded; the longest work item is
+ *         harvesting 8 results (~30us of SPI), so the ISR stays well
+ *         under the tick period.
  */
-void GRID_EnableRow(uint8_t row)
+void GRID_ScanTimerTick(void)
 {
-    if (row >= GRID_NUM_ROWS) return;
-    
-    /* Disable all rows first */
-    GRID_DisableAllRows();
-    
-    /* Enable the specific row (set HIGH) */
-    HAL_GPIO_WritePin(ROW_GPIO_PORT, (1U << row), GPIO_PIN_SET);
+    if (!s_TimerScan.running) return;
+
+    s_TimerScan.frameTicks++;
+    s_TimerScan.phaseTicks++;
+
+    switch (s_TimerScan.phase) {
+
+    case SCAN_PHASE_WAIT_FRAME: {
+        /* Deterministic pacing: hold until the frame interval elapses
+         * and, in on-demand modes, until a capture is due. Command
+         * servicing and telemetry live in GRID_ScanLoop - the tick only
+         * paces, and holds here while the foreground has the boundary
+         * claimed. A governed (quiet-grid) stretch overrides the
+         * configured pacing. */
+        uint16_t pace = s_TimerScan.frameIntervalTicks;
+        if (s_GovIntervalTicks > pace) {
+            pace = s_GovIntervalTicks;
+        }
+        if (s_TimerScan.frameTicks >= pace && !s_FgBoundary
+                && GRID_CaptureDue()) {
+            s_TimerScan.frameTicks = 0;
+            s_TimerScan.phase = SCAN_PHASE_ROW_SELECT;
+        }
+        break;
+    }
+
+    case SCAN_PHASE_ROW_SELECT:
+        /* Only entered at frame start (later rows interleave straight
+         * into SETTLE from HARVEST) */
+        GRID_ClaimFrame();
+        memset(&s_FrameStats, 0, sizeof(s_FrameStats));
+        s_TimerScan.row = GRID_NextScheduledRow(s_RoiRowStart);
+        if (s_TimerScan.row == 0xFFU) {
+            /* Nothing due this frame: ship the (all-quiet) payload */
+            g_GridData.frameCount++;
+            GRID_SealFrame();
+            g_GridData.lastScanTimeMs = HAL_GetTick();
+            GRID_JitterRecord();
+            GRID_IdleFrameHook();
+            GRID_GovernorUpdate();
+            s_TimerScan.phase = SCAN_PHASE_FINISH;
+            break;
+        }
+        GRID_EnableRow(s_TimerScan.row);
+        if (s_RowTimReady) {
+            GRID_RowTimerArm(s_SettleTimeUs, ROWTIM_PHASE);
+        }
+        s_TimerScan.phaseTicks = 0;
+        s_TimerScan.phase = SCAN_PHASE_SETTLE;
+        break;
+
+    case SCAN_PHASE_SETTLE:
+        /* The TIM2 compare armed at row-enable time advances this phase
+         * on the exact microsecond; the tick arithmetic below is only
+         * the fallback when the row timeline is unavailable */
+        if (s_RowTimReady) {
+            break;
+        }
+        /* Round the tuned settling time up to whole ticks */
+        if ((uint32_t)s_TimerScan.phaseTicks * GRID_SCAN_TICK_US
+                >= s_SettleTimeUs) {
+            s_TimerScan.channel = GRID_NextRoiChannel(0);
+            s_TimerScan.pass = 0;
+            /* Kick off the first needed channel on all chips */
+            ADS1220_BroadcastSelectAndStart(s_TimerScan.channel);
+            s_TimerScan.phaseTicks = 0;
+            s_TimerScan.phase = SCAN_PHASE_CONVERT;
+        }
+        break;
+
+    case SCAN_PHASE_CONVERT: {
+        /* A boosted re-read round only restarted the flagged chips, so
+         * only their DRDY lines are owed */
+        ADS1220_Mask_t need = s_TimerScan.boost ? s_TimerScan.boostMask
+                                                : ADS1220_GetAliveMask();
+        if ((ADS1220_ReadyMask() & need) == need ||
+            s_TimerScan.phaseTicks >= s_ConvertTimeoutTicks) {
+            s_TimerScan.phase = SCAN_PHASE_HARVEST;
+        }
+        break;
+    }
+
+    case SCAN_PHASE_HARVEST: {
+        uint8_t ch = s_TimerScan.channel;
+
+        if (s_TimerScan.boost) {
+            /* Collect the gain-boosted re-reads, normalized back to the
+             * gain-1 domain; a clipped read keeps the original value
+             * and steps that cell's gain back down */
+            for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                if (!(s_TimerScan.boostMask
+                        & (ADS1220_Mask_t)(1UL << chip))) {
+                    continue;
+                }
+                uint8_t col = (uint8_t)(chip * ADS1220_CHANNELS + ch);
+                uint32_t v = ADS1220_ReadResult(chip);
+                if (v >= GRID_AUTORANGE_SAT_RAW) {
+                    s_CellGainShift[s_TimerScan.row][col]--;
+                } else {
+                    s_TimerScan.rowValues[col] =
+                        v >> s_CellGainShift[s_TimerScan.row][col];
+                }
+            }
+            s_TimerScan.boost = 0;
+            /* Fall through to the channel advance below */
+        } else {
+            for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                uint32_t v = ADS1220_ReadResult(chip);
+                if (s_TimerScan.pass == 0) {
+                    s_TimerScan.rowValues[chip * ADS1220_CHANNELS + ch] = v;
+                } else {
+                    s_TimerScan.rowValues[chip * ADS1220_CHANNELS + ch] += v;
+                }
+            }
+
+            /* Oversampling: take further conversions of the same channel
+             * (in continuous mode they keep arriving on their own) */
+            if (++s_TimerScan.pass < (1U << s_OversampleShift)) {
+                ADS1220_BroadcastSelectAndStart(ch);
+                s_TimerScan.phaseTicks = 0;
+                s_TimerScan.phase = SCAN_PHASE_CONVERT;
+                break;
+            }
+            if (s_OversampleShift) {
+                for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                    s_TimerScan.rowValues[chip * ADS1220_CHANNELS + ch] >>=
+                        s_OversampleShift;
+                }
+            }
+            s_TimerScan.pass = 0;
+
+            /* Auto-ranging: restart just the borderline chips of this
+             * channel at their boosted gain and wait one more round */
+            if (s_AutoRange) {
+                ADS1220_Mask_t alive = ADS1220_GetAliveMask();
+                ADS1220_Mask_t mask = 0;
+                for (uint8_t chip = 0; chip < ADS1220_NUM_CHIPS; chip++) {
+                    uint8_t col = (uint8_t)(chip * ADS1220_CHANNELS + ch);
+                    uint8_t sh = s_CellGainShift[s_TimerScan.row][col];
+                    if ((alive & (ADS1220_Mask_t)(1UL << chip)) &&
+                        sh != 0U) {
+                        ADS1220_SelectAndStartGain(chip, ch, sh);
+                        mask |= (ADS1220_Mask_t)(1UL << chip);
+                    }
+                }
+                if (mask != 0U) {
+                    s_TimerScan.boostMask = mask;
+                    s_TimerScan.boost = 1;
+                    s_TimerScan.phaseTicks = 0;
+                    s_TimerScan.phase = SCAN_PHASE_CONVERT;
+                    break;
+                }
+            }
+        }
+
+        s_TimerScan.channel = GRID_NextRoiChannel(ch + 1U);
+        if (s_TimerScan.channel < ADS1220_CHANNELS) {
+            /* Start the next needed channel and go back to waiting */
+            ADS1220_BroadcastSelectAndStart(s_TimerScan.channel);
+            s_TimerScan.phaseTicks = 0;
+            s_TimerScan.phase = SCAN_PHASE_CONVERT;
+            break;
+        }
+
+        /* Row complete. Interleave: drive the next row first so its
+         * settling window opens now and runs under the processing
+         * below, then convert this row's readings */
+        uint8_t doneRow = s_TimerScan.row;
+        uint8_t nextRow = GRID_NextScheduledRow(doneRow + 1U);
+        if (nextRow != 0xFFU) {
+            GRID_EnableRow(nextRow);
+            s_TimerScan.phaseTicks = 0;
+            if (s_RowTimReady) {
+                /* Settling runs under GRID_ProcessRow below; at equal
+                 * preemption priority the compare cannot advance the
+                 * phase until this tick returns */
+                GRID_RowTimerArm(s_SettleTimeUs, ROWTIM_PHASE);
+            }
+        }
+
+        GRID_ProcessRow(doneRow, s_TimerScan.rowValues);
+
+        /* Row streaming: ship the finished row while the next one
+         * settles (skips rather than blocks if the link is busy) */
+        if (s_RowStreamMode) {
+            GRID_TransmitRow(doneRow);
+        }
+        s_TimerScan.row = nextRow;
+
+        if (nextRow != 0xFFU) {
+            /* Row already driven above: go straight to settling */
+            s_TimerScan.phase = SCAN_PHASE_SETTLE;
+        } else {
+            GRID_DisableAllRows();
+            g_GridData.frameCount++;
+            GRID_SealFrame();
+            g_GridData.lastScanTimeMs = HAL_GetTick();
+            GRID_JitterRecord();
+            GRID_IdleFrameHook();
+            GRID_GovernorUpdate();
+            s_LastScanUs =
+                (uint32_t)s_TimerScan.frameTicks * GRID_SCAN_TICK_US;
+
+            /* Rotating temperature slot before the frame ships */
+            s_TempChipActive = GRID_NextTempChip();
+            if (s_TempChipActive < ADS1220_NUM_CHIPS) {
+                ADS1220_StartTemperature(s_TempChipActive);
+                s_TimerScan.phaseTicks = 0;
+                s_TimerScan.phase = SCAN_PHASE_TEMP;
+            } else {
+                s_TimerScan.phase = SCAN_PHASE_FINISH;
+            }
+        }
+        break;
+    }
+
+    case SCAN_PHASE_TEMP:
+        /* The extra conversion slot: collect the rotating chip's
+         * temperature, then ship the frame as usual */
+        if ((ADS1220_ReadyMask()
+                & (ADS1220_Mask_t)(1UL << s_TempChipActive)) ||
+            s_TimerScan.phaseTicks >= s_ConvertTimeoutTicks) {
+            GRID_TempFold(s_TempChipActive,
+                          ADS1220_FinishTemperature(s_TempChipActive));
+            s_TimerScan.phase = SCAN_PHASE_FINISH;
+        }
+        break;
+
+    case SCAN_PHASE_FINISH:
+        /* Frame sealed: shipping it (drain waits, queued commands,
+         * telemetry, the packet build) is all thread-context work, so
+         * the foreground does it and advances the phase - the tick
+         * just holds here. GRID_ScanLoop runs within one tick period
+         * of the WFI it sleeps in, so the boundary adds no lag. */
+        break;
+
+    default:
+        s_TimerScan.phase = SCAN_PHASE_WAIT_FRAME;
+        break;
+    }
 }
 
 /**
- * @brief  Disable all rows
+ * @brief  TIM period-elapsed callback (TIM7 = scan tick)
  */
-void GRID_DisableAllRows(void)
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-    /* Set all row GPIOs LOW */
-    HAL_GPIO_WritePin(ROW_GPIO_PORT, ROW_GPIO_PINS, GPIO_PIN_RESET);
+    if (htim->Instance == TIM7) {
+        GRID_ScanTimerTick();
+    }
 }
 
 /**
- * @brief  Perform baseline calibration
+ * @brief  Transmit grid data in binary format
+ * @note   Thin profiling wrapper: the TX phase covers the whole packet
+ *         build and send initiation, including any drain waits
  */
-void GRID_Calibrate(void)
+void GRID_TransmitData(void)
 {
-    #define CALIBRATION_SAMPLES 4
-    
-    g_GridData.state = GRID_STATE_CALIBRATING;
-    
-    /* Clear baseline */
-    memset(g_GridData.baseline, 0, sizeof(g_GridData.baseline));
-    
-    /* Accumulate multiple scans */
-    for (uint8_t scan = 0; scan < CALIBRATION_SAMPLES; scan++) {
-        for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
-            /* Enable this row */
-            GRID_EnableRow(row);
-            HAL_Delay(1);  /* Settling time */
-            
-            /* Read all 32 columns */
-            uint32_t colValues[GRID_NUM_COLS];
-            ADS1220_ReadAllColumns(colValues);
-            
-            /* Accumulate */
-            for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
-                g_GridData.baseline[row][col] += colValues[col];
-            }
+    uint32_t txStart = DWT->CYCCNT;
+    GRID_TransmitFrame();
+    GRID_ProfAdd(GRID_PROF_TX, txStart);
+    GRID_ProfFold(GRID_PROF_TX);
+}
+
+/**
+ * @brief  Build and send the current frame (body of GRID_TransmitData)
+ */
+static void GRID_TransmitFrame(void)
+{
+    uint8_t *txBuf = s_TxBuffer[g_GridData.scanIndex];
+
+    /* The previous frame's DMA must have drained before its buffer (the
+     * one we are about to reuse on the flip after next) is touched; at
+     * 115200 baud this only waits if scanning outpaces the link */
+    if (s_TxBusy) {
+        s_TxStallFrames++;
+    }
+    /* A stall here can last milliseconds at 115200 baud: sleep through
+     * it - the DMA transfer-complete interrupt is what clears the flag,
+     * so it also wakes the core the instant the drain finishes */
+    while (s_TxBusy) {
+        __WFI();
+    }
+
+    /* Apply a host-commanded rate change between packets, and fall back
+     * to the default rate if the host never confirms it heard us at
+     * the new one (e.g. it missed our last frame before the switch) */
+    if (s_PendingBaud != 0UL) {
+        uint32_t baud = s_PendingBaud;
+        s_PendingBaud = 0;
+        GRID_SetUartBaud(baud);
+        s_BaudConfirmWait = (baud != GRID_BAUD_DEFAULT)
+                                ? GRID_BAUD_CONFIRM_FRAMES : 0U;
+    } else if (s_BaudConfirmWait != 0U && --s_BaudConfirmWait == 0U) {
+        GRID_SetUartBaud(GRID_BAUD_DEFAULT);
+    }
+
+    /* Same boundary for queued host commands: nothing in flight, so
+     * mode switches that reset TX buffers cannot corrupt a packet.
+     * A NACK retransmission counts as a fresh send, hence the second
+     * drain before this frame goes out */
+    GRID_ServiceCommands();
+    while (s_TxBusy) { }
+
+    /* Heartbeat telemetry and buffered log text ride the same boundary;
+     * they leave their sends in flight, and the frame (or field) packet
+     * below needs the link idle again */
+    GRID_MaybeSendStats();
+    GRID_MaybeSendLog();
+    while (s_TxBusy) {
+        __WFI();
+    }
+
+    /* Row streaming: the cells already left the board row by row during
+     * the scan, so the frame boundary keeps only its command, baud and
+     * telemetry duties above */
+    if (s_RowStreamMode) {
+        g_GridData.state = GRID_STATE_IDLE;
+        return;
+    }
+
+    /* Interlaced mode: ship the just-scanned parity as a compact
+     * half-frame and flip the field for the next scan. Bypasses the
+     * delta/RLE/aggregation paths - their keyframe bookkeeping assumes
+     * whole frames */
+    if (s_InterlaceMode) {
+        g_GridData.state = GRID_STATE_TRANSMITTING;
+        GRID_TransmitField();
+        s_InterlaceField ^= 1U;
+        g_GridData.state = GRID_STATE_IDLE;
+        return;
+    }
+
+    g_GridData.state = GRID_STATE_TRANSMITTING;
+
+    /* Delta mode: send changed cells only unless a keyframe is due or
+     * the change list would not be any smaller */
+    if (s_DeltaMode
+            && s_DeltaFramesSinceKey < GRID_DELTA_KEYFRAME_PERIOD
+            && GRID_TransmitDelta()) {
+        g_GridData.state = GRID_STATE_IDLE;
+        return;
+    }
+
+    /* RLE mode: a quiet grid compresses to tens of bytes. The encoding
+     * is lossless, so a successful RLE frame also serves as a delta
+     * keyframe */
+    if (s_RleMode && GRID_TransmitRle()) {
+        if (s_DeltaMode) {
+            memcpy(s_DeltaRef, g_GridData.frame[g_GridData.scanIndex],
+                   sizeof(s_DeltaRef));
+            s_DeltaFramesSinceKey = 0;
         }
+        g_GridData.state = GRID_STATE_IDLE;
+        return;
     }
-    
-    /* Average */
-    for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
-        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
-            g_GridData.baseline[row][col] /= CALIBRATION_SAMPLES;
+
+    /* Payload was packed in place by GRID_ProcessRow; append the frame
+     * summary metadata block, then the footer */
+    uint16_t payloadSize = s_PackedMode ? PACKET_PACKED_PAYLOAD_SIZE
+                                        : PACKET_PAYLOAD_SIZE;
+    uint16_t totalSize = s_PackedMode ? PACKET_PACKED_TOTAL_SIZE
+                                      : PACKET_TOTAL_SIZE;
+    uint16_t idx = PACKET_HEADER_SIZE + payloadSize;
+
+    uint8_t meta[PACKET_META_SIZE];
+    GRID_BuildMeta(meta);
+
+    for (uint8_t i = 0; i < PACKET_META_SIZE; i++) {
+        txBuf[idx++] = meta[i];
+    }
+
+    /* Aggregation: collect K payload+metadata units, then ship them
+     * under one header and CRC so the host does a single read and
+     * integrity check per K frames. Mutually exclusive with the delta
+     * and RLE paths, whose keyframe bookkeeping assumes every full
+     * frame reaches the host promptly */
+    if (s_AggFrames > 1U && !s_DeltaMode && !s_RleMode) {
+        uint16_t unit = payloadSize + PACKET_META_SIZE;
+        memcpy(&s_AggBuffer[PACKET_HEADER_SIZE + PACKET_AGG_HDR_SIZE
+                            + (uint32_t)s_AggCount * unit],
+               &txBuf[PACKET_HEADER_SIZE], unit);
+        s_AggCount++;
+
+        if (s_AggCount < s_AggFrames) {
+            g_GridData.state = GRID_STATE_IDLE;
+            return;
         }
+
+        uint8_t *agg = s_AggBuffer;
+        uint16_t aggBody = PACKET_AGG_HDR_SIZE
+                           + (uint16_t)s_AggCount * unit;
+        agg[0] = PACKET_SYNC_BYTE_1;
+        agg[1] = PACKET_SYNC_AGG;
+        agg[PACKET_HEADER_SIZE + 0U] = s_AggCount;
+        agg[PACKET_HEADER_SIZE + 1U] = 0;
+        agg[PACKET_HEADER_SIZE + 2U] = (uint8_t)(unit & 0xFF);
+        agg[PACKET_HEADER_SIZE + 3U] = (uint8_t)(unit >> 8);
+
+        uint16_t aggIdx = PACKET_HEADER_SIZE + aggBody;
+        uint32_t aggCrc = GRID_CrcBlock(&agg[PACKET_HEADER_SIZE], aggBody);
+        agg[aggIdx++] = (uint8_t)(aggCrc & 0xFF);
+        agg[aggIdx++] = (uint8_t)((aggCrc >> 8) & 0xFF);
+        agg[aggIdx++] = (uint8_t)((aggCrc >> 16) & 0xFF);
+        agg[aggIdx++] = (uint8_t)((aggCrc >> 24) & 0xFF);
+        agg[aggIdx++] = '\r';
+        agg[aggIdx++] = '\n';
+        s_AggCount = 0;
+
+        /* Too large for the retain ring; a lost super-packet is
+         * recovered by the next one's worth of frames instead */
+        GRID_Send(agg, aggIdx);
+        g_GridData.state = GRID_STATE_IDLE;
+        return;
     }
-    
-    GRID_DisableAllRows();
-    s_IsCalibrated = 1;
+
+    /* Hardware CRC32 over payload + metadata: one cycle per word in
+     * the peripheral versus an add per byte on the core, and strong
+     * against the burst errors long cables actually produce */
+    uint32_t crc = GRID_CrcBlock(&txBuf[PACKET_HEADER_SIZE],
+                                 payloadSize + PACKET_META_SIZE);
+    txBuf[idx++] = (uint8_t)(crc & 0xFF);
+    txBuf[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    txBuf[idx++] = (uint8_t)((crc >> 16) & 0xFF);
+    txBuf[idx++] = (uint8_t)((crc >> 24) & 0xFF);
+    txBuf[idx++] = '\r';
+    txBuf[idx++] = '\n';
+
+    /* Kick off the send and return: the core is free to scan the next
+     * frame while the packet drains */
+    GRID_RetainPacket(g_GridData.frameCount, txBuf, totalSize);
+    GRID_Send(txBuf, totalSize);
+
+    /* A full frame is a fresh keyframe for the delta encoder */
+    if (s_DeltaMode) {
+        memcpy(s_DeltaRef, g_GridData.frame[g_GridData.scanIndex],
+               sizeof(s_DeltaRef));
+        s_DeltaFramesSinceKey = 0;
+    }
+
     g_GridData.state = GRID_STATE_IDLE;
 }
 
 /**
- * @brief  Scan the entire 16x32 grid
+ * @brief  UART TX complete callback: release the in-flight buffer
  */
-void GRID_ScanMatrix(void)
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
-    g_GridData.state = GRID_STATE_SCANNING;
-    
-    for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
-        /* Enable this row (drive 3.3V through velostat) */
-        GRID_EnableRow(row);
-        
-        /* Small delay for voltage to stabilize */
-        /* Note: Could be reduced with testing */
-        for (volatile int i = 0; i < 100; i++);
-        
-        /* Read all 32 columns via ADS1220s */
-        uint32_t colValues[GRID_NUM_COLS];
-        ADS1220_ReadAllColumns(colValues);
-        
-        /* Process and store values */
-        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
-            uint32_t raw = colValues[col];
-            uint32_t pressure;
-            
-            if (s_IsCalibrated) {
-                /* Subtract baseline */
-                int32_t diff = (int32_t)g_GridData.baseline[row][col] - (int32_t)raw;
-                pressure = (diff > 0) ? (uint32_t)diff : 0;
-            } else {
-                /* Invert: higher pressure = lower ADC reading */
-                pressure = (raw < ADC_MAX_VALUE) ? (ADC_MAX_VALUE - raw) : 0;
-            }
-            
-            /* Apply noise threshold */
-            if (pressure < ADC_NOISE_THRESHOLD) {
-                pressure = 0;
+    if (huart == s_hUart) {
+        s_TxBusy = 0;
+    }
+}
+
+/**
+ * @brief  Route outbound packets through an alternate transport
+ */
+void GRID_SetTransport(GRID_TransportSend_t send)
+{
+    while (s_TxBusy) { }
+    s_TransportSend = send;
+}
+
+/**
+ * @brief  Transport completion callback: releases the in-flight buffer
+ */
+void GRID_TransportTxDone(void)
+{
+    s_TxBusy = 0;
+}
+
+/**
+ * @brief  UART RX complete callback: one-byte command decoder
+ * @note   Runs at interrupt priority, so commands only set flags; the
+ *         transmit path acts on them at the next packet boundary
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != s_hUart) {
+        return;
+    }
+
+    uint8_t byte = s_RxByte;
+
+    if (s_CmdRx.cmd != 0U) {
+        /* Collecting arguments for a multi-byte command */
+        s_CmdRx.args[s_CmdRx.idx++] = byte;
+        if (s_CmdRx.idx >= s_CmdArgLen[s_CmdRx.cmd - GRID_CMD_CALIBRATE]) {
+            GRID_CmdEnqueue(s_CmdRx.cmd, s_CmdRx.args);
+            s_CmdRx.cmd = 0;
+        }
+    } else {
+        switch (byte) {
+        case GRID_CMD_BAUD_DEFAULT:
+            s_PendingBaud = GRID_BAUD_DEFAULT;
+            break;
+        case GRID_CMD_BAUD_HIGH:
+            s_PendingBaud = GRID_BAUD_HIGH;
+            break;
+        case GRID_CMD_BAUD_MAX:
+            s_PendingBaud = GRID_BAUD_MAX;
+            break;
+        case GRID_CMD_BAUD_CONFIRM:
+            s_BaudConfirmWait = 0;
+            break;
+        default:
+            if (byte >= GRID_CMD_CALIBRATE
+                    && byte <= GRID_CMD_SET_TIMERSCAN) {
+                if (s_CmdArgLen[byte - GRID_CMD_CALIBRATE] == 0U) {
+                    GRID_CmdEnqueue(byte, NULL);
+                } else {
+                    s_CmdRx.cmd = byte;
+                    s_CmdRx.idx = 0;
+                }
             }
-            
-            /* Scale 24-bit to 16-bit for transmission */
-            g_GridData.data[row][col] = (uint16_t)(pressure >> ADC_SCALE_SHIFT);
+            /* Anything else is line noise: ignore */
+            break;
         }
     }
-    
-    GRID_DisableAllRows();
-    g_GridData.frameCount++;
-    g_GridData.lastScanTimeMs = HAL_GetTick();
-    g_GridData.state = GRID_STATE_IDLE;
+
+    HAL_UART_Receive_IT(huart, &s_RxByte, 1);
 }
 
 /**
- * @brief  Transmit grid data in binary format
+ * @brief  UART error callback: framing/noise errors at a negotiated
+ *         rate mean the host is talking at a different speed (it drops
+ *         to 115200 on sync loss) - fall back so it can reach us
  */
-void GRID_TransmitData(void)
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
-    g_GridData.state = GRID_STATE_TRANSMITTING;
-    
-    uint16_t checksum = 0;
-    uint16_t idx = PACKET_HEADER_SIZE;
-    
-    /* Pack 512 x 16-bit values */
-    for (uint8_t row = 0; row < GRID_NUM_ROWS; row++) {
-        for (uint8_t col = 0; col < GRID_NUM_COLS; col++) {
-            uint16_t val = g_GridData.data[row][col];
-            
-            s_TxBuffer[idx++] = (uint8_t)(val & 0xFF);
-            s_TxBuffer[idx++] = (uint8_t)(val >> 8);
-            
-            checksum += (val & 0xFF);
-            checksum += (val >> 8);
+    if (huart != s_hUart) {
+        return;
+    }
+
+    if (s_hUart->Init.BaudRate != GRID_BAUD_DEFAULT) {
+        s_PendingBaud = GRID_BAUD_DEFAULT;
+        s_BaudConfirmWait = 0;
+    }
+
+    HAL_UART_Receive_IT(huart, &s_RxByte, 1);
+}
+
+/**
+ * @brief  Start the independent watchdog
+ * @note   Register-level like the CRC unit (the HAL IWDG module is not
+ *         enabled in this project). LSI ~40 kHz through the /32
+ *         prescaler gives a 1.25 kHz count rate; the reload value maps
+ *         GRID_WDG_TIMEOUT_MS onto that clock.
+ */
+void GRID_WatchdogInit(void)
+{
+    IWDG->KR = 0x5555U;                          /* Unlock PR/RLR */
+    IWDG->PR = IWDG_PR_PR_0 | IWDG_PR_PR_1;      /* LSI / 32 */
+    IWDG->RLR = (GRID_WDG_TIMEOUT_MS * 40U) / 32U;
+    while (IWDG->SR != 0U) { }                   /* Registers latching */
+    IWDG->KR = 0xAAAAU;                          /* Load the reload */
+    IWDG->KR = 0xCCCCU;                          /* Start counting */
+}
+
+/**
+ * @brief  Reload the watchdog counter
+ */
+void GRID_WatchdogKick(void)
+{
+    IWDG->KR = 0xAAAAU;
+}
+
+/**
+ * @brief  Check (and clear) whether this boot follows a watchdog reset
+ */
+uint8_t GRID_WasWarmReset(void)
+{
+    uint8_t warm = (RCC->CSR & RCC_CSR_IWDGRSTF) ? 1U : 0U;
+
+    if (warm) {
+        RCC->CSR |= RCC_CSR_RMVF;  /* Clear the sticky reset flags */
+    }
+    return warm;
+}
+
+/**
+ * @brief  Idle power manager: park the ADCs after a quiet stretch and
+ *         wake them when a sentinel scan sees contact
+ * @retval 1 while the grid is parked (the caller must not scan)
+ * @note   Foreground-only: in timer mode the state machine is stopped
+ *         for the idle stretch and restarted at its old pacing on wake,
+ *         so the (multi-ms) sentinel frame never runs at ISR level
+ */
+static uint8_t GRID_IdleTask(void)
+{
+    if (!s_Idle) {
+        /* Burst/snapshot modes pace themselves; only the continuous
+         * stream can sit converting at full rate over an empty grid */
+        if (!s_StreamMode || s_QuietFrames < GRID_IDLE_FRAMES) {
+            return 0;
         }
+
+        s_IdleTimerWasOn = s_TimerScan.running;
+        if (s_TimerScan.running) {
+            s_IdleTimerIntervalMs = (uint16_t)((uint32_t)
+                s_TimerScan.frameIntervalTicks * GRID_SCAN_TICK_US
+                / 1000U);
+            GRID_StopScanTimer();
+        }
+        ADS1220_PowerDownAll();
+        s_Idle = 1;
+        s_NextSentinelMs = HAL_GetTick() + GRID_IDLE_SENTINEL_MS;
+
+        static const char parked[] = "[PWR] grid quiet: ADCs parked\r\n";
+        GRID_LogWrite((const uint8_t *)parked, sizeof(parked) - 1U);
+        return 1;
+    }
+
+    /* A host request (stream off for a snapshot/burst) outranks the
+     * idle hold: resume immediately rather than waiting for contact */
+    if (!s_StreamMode || s_PendingFrames != 0U) {
+        ADS1220_WakeAll();
+        s_Idle = 0;
+        s_QuietFrames = 0;
+        if (s_IdleTimerWasOn) {
+            GRID_StartScanTimer(s_IdleTimerIntervalMs);
+        }
+        return 0;
+    }
+
+    if ((int32_t)(HAL_GetTick() - s_NextSentinelMs) < 0) {
+        return 1;
+    }
+    s_NextSentinelMs = HAL_GetTick() + GRID_IDLE_SENTINEL_MS;
+
+    /* Sentinel: wake the chips (START resumes with registers intact),
+     * run one ordinary frame without transmitting it, and judge contact
+     * from the frame summary the processing already produces */
+    ADS1220_WakeAll();
+    GRID_ScanMatrix();
+
+    if (s_FrameStats.total != 0U) {
+        s_Idle = 0;
+        s_QuietFrames = 0;
+
+        static const char woke[] = "[PWR] contact: ADCs resumed\r\n";
+        GRID_LogWrite((const uint8_t *)woke, sizeof(woke) - 1U);
+
+        if (s_IdleTimerWasOn) {
+            GRID_StartScanTimer(s_IdleTimerIntervalMs);
+        }
+        return 0;
+    }
+
+    ADS1220_PowerDownAll();
+    return 1;
+}
+
+/**
+ * @brief  Acquire a zero-copy view of the most recently sealed frame
+ */
+uint8_t GRID_AcquireFrame(GridFrameView_t *view)
+{
+    for (;;) {
+        uint8_t slot = s_PublishedSlot;
+
+        if (slot >= 2U || !s_FrameSlots[slot].sealed) {
+            return 0;       /* Nothing sealed yet, or being rewritten */
+        }
+
+        /* Register as a reader, then re-check: if a scan completed in
+         * between and the writer reclaimed this half, back off and try
+         * the newly published one (bounded - no blocking either side) */
+        s_FrameSlots[slot].readers++;
+        __DMB();
+        if (s_FrameSlots[slot].sealed && s_PublishedSlot == slot) {
+            view->cells = g_GridData.frame[slot];
+            view->seq = s_FrameSlots[slot].seq;
+            view->slot = slot;
+            return 1;
+        }
+        s_FrameSlots[slot].readers--;
+    }
+}
+
+/**
+ * @brief  Release a view obtained from GRID_AcquireFrame
+ */
+void GRID_ReleaseFrame(const GridFrameView_t *view)
+{
+    if (view != NULL && view->slot < 2U
+            && s_FrameSlots[view->slot].readers > 0U) {
+        s_FrameSlots[view->slot].readers--;
     }
-    
-    /* Footer */
-    s_TxBuffer[idx++] = (uint8_t)(checksum & 0xFF);
-    s_TxBuffer[idx++] = (uint8_t)(checksum >> 8);
-    s_TxBuffer[idx++] = '\r';
-    s_TxBuffer[idx++] = '\n';
-    
-    /* Transmit */
-    HAL_UART_Transmit(s_hUart, s_TxBuffer, PACKET_TOTAL_SIZE, HAL_MAX_DELAY);
-    
-    g_GridData.state = GRID_STATE_IDLE;
 }
 
 /**
@@ -199,6 +4180,100 @@ void GRID_TransmitData(void)
  */
 void GRID_ScanLoop(void)
 {
+    /* One kick per pass: a wedge anywhere below (SPI, DMA drain, a
+     * stuck ISR starving the foreground) stops the kicks and the
+     * watchdog warm-restarts the unit */
+    GRID_WatchdogKick();
+
+    /* Idle power manager: while the grid is parked, stay responsive to
+     * the host and keep the heartbeat alive, but leave the converters
+     * down and sleep between sentinel probes */
+    if (GRID_IdleTask()) {
+        GRID_ServiceCommands();
+        while (s_TxBusy) { }
+        GRID_MaybeSendStats();
+        GRID_MaybeSendLog();
+        __WFI();
+        return;
+    }
+
+    /* Host-selected engine: GRID_SetTimerScan only records the choice,
+     * so start the machine here, in thread context with no frame in
+     * progress. The matching stop sits in the timer branch below, at a
+     * frame boundary, so a switch never lands mid-scan */
+    if (s_TimerScanMode && !s_TimerScan.running) {
+        GRID_StartScanTimer(0);
+    }
+
+    /* Timer-driven mode: TIM7 sequences rows at interrupt level and
+     * leaves every frame-boundary job here - ship the sealed frame,
+     * apply queued commands, keep the heartbeat and log drain alive.
+     * The claim holds the machine at the boundary, so a long command
+     * (calibration, benchmark) stalls scanning exactly as it does in
+     * the foreground engine instead of running at ISR level */
+    if (s_TimerScan.running) {
+        s_FgBoundary = 1;
+        __DMB();
+        if (s_TimerScan.phase == SCAN_PHASE_FINISH) {
+            GRID_TransmitData();
+            /* Flip only into a half no reader holds; a pinned half
+             * keeps the writer on this one until the view is released */
+            if (s_FrameSlots[g_GridData.scanIndex ^ 1U].readers == 0U) {
+                g_GridData.scanIndex ^= 1U;
+            }
+            s_TimerScan.phase = SCAN_PHASE_WAIT_FRAME;
+        } else if (s_TimerScan.phase == SCAN_PHASE_WAIT_FRAME) {
+            /* Between frames: commands here let a snapshot request
+             * wake an idle scanner that never reaches the transmit
+             * boundary */
+            GRID_ServiceCommands();
+            GRID_MaybeSendStats();
+            GRID_MaybeSendLog();
+            if (!s_TimerScanMode) {
+                /* Host re-selected the foreground engine; the machine
+                 * sits at the boundary, so stopping loses nothing */
+                GRID_StopScanTimer();
+            }
+        }
+        s_FgBoundary = 0;
+        __WFI();
+        return;
+    }
+
+    /* Governed back-off: over a quiet stream the governor stretches the
+     * scan interval, so hold in the idle branch until it elapses. Only
+     * the continuous stream is ever governed - GovernorUpdate zeroes
+     * the interval otherwise, and the stream check here keeps a stale
+     * interval from delaying a burst after stream-off */
+    uint8_t govHold = 0;
+    if (s_StreamMode && s_GovIntervalTicks != 0U) {
+        uint32_t govMs = (uint32_t)s_GovIntervalTicks
+                         * GRID_SCAN_TICK_US / 1000U;
+        govHold = ((HAL_GetTick() - g_GridData.lastScanTimeMs) < govMs)
+                  ? 1U : 0U;
+    }
+
+    /* Idle / between burst frames: keep servicing host commands (so a
+     * snapshot or stream-on request can wake the scanner) and keep the
+     * heartbeat alive for the diagnostics panel, then sleep. Any
+     * interrupt wakes us: the UART RX byte that carries a command, or
+     * SysTick within 1 ms - finer than the ms-granular burst pacing */
+    if (govHold || !GRID_CaptureDue()) {
+        GRID_ServiceCommands();
+        while (s_TxBusy) { }
+        GRID_MaybeSendStats();
+        GRID_MaybeSendLog();
+        __WFI();
+        return;
+    }
+
     GRID_ScanMatrix();
     GRID_TransmitData();
+
+    /* Flip frame buffers: the next scan fills the other half while the
+     * packet built from this one goes out. A reader still holding the
+     * other half pins it - keep writing this one until it lets go */
+    if (s_FrameSlots[g_GridData.scanIndex ^ 1U].readers == 0U) {
+        g_GridData.scanIndex ^= 1U;
+    }
 }
@@ -1,203 +1,406 @@
-/* USER CODE BEGIN Header */
-/**
-  ******************************************************************************
-  * @file    stm32f3xx_it.c
-  * @brief   Interrupt Service Routines.
-  ******************************************************************************
-  * @attention
-  *
-  * Copyright (c) 2025 STMicroelectronics.
-  * All rights reserved.
-  *
-  * This software is licensed under terms that can be found in the LICENSE file
-  * in the root directory of this software component.
-  * If no LICENSE file comes with this software, it is provided AS-IS.
-  *
-  ******************************************************************************
-  */
-/* USER CODE END Header */
-
-/* Includes ------------------------------------------------------------------*/
-#include "main.h"
-#include "stm32f3xx_it.h"
-/* Private includes ----------------------------------------------------------*/
-/* USER CODE BEGIN Includes */
-/* USER CODE END Includes */
-
-/* Private typedef -----------------------------------------------------------*/
-/* USER CODE BEGIN TD */
-
-/* USER CODE END TD */
-
-/* Private define ------------------------------------------------------------*/
-/* USER CODE BEGIN PD */
-
-/* USER CODE END PD */
-
-/* Private macro -------------------------------------------------------------*/
-/* USER CODE BEGIN PM */
-
-/* USER CODE END PM */
-
-/* Private variables ---------------------------------------------------------*/
-/* USER CODE BEGIN PV */
-
-/* USER CODE END PV */
-
-/* Private function prototypes -----------------------------------------------*/
-/* USER CODE BEGIN PFP */
-
-/* USER CODE END PFP */
-
-/* Private user code ---------------------------------------------------------*/
-/* USER CODE BEGIN 0 */
-
-/* USER CODE END 0 */
-
-/* External variables --------------------------------------------------------*/
-
-/* USER CODE BEGIN EV */
-
-/* USER CODE END EV */
-
-/******************************************************************************/
-/*           Cortex-M4 Processor Interruption and Exception Handlers          */
-/******************************************************************************/
-/**
-  * @brief This function handles Non maskable interrupt.
-  */
-void NMI_Handler(void)
-{
-  /* USER CODE BEGIN NonMaskableInt_IRQn 0 */
-
-  /* USER CODE END NonMaskableInt_IRQn 0 */
-  /* USER CODE BEGIN NonMaskableInt_IRQn 1 */
-   while (1)
-  {
-  }
-  /* USER CODE END NonMaskableInt_IRQn 1 */
-}
-
-/**
-  * @brief This function handles Hard fault interrupt.
-  */
-void HardFault_Handler(void)
-{
-  /* USER CODE BEGIN HardFault_IRQn 0 */
-
-  /* USER CODE END HardFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_HardFault_IRQn 0 */
-    /* USER CODE END W1_HardFault_IRQn 0 */
-  }
-}
-
-/**
-  * @brief This function handles Memory management fault.
-  */
-void MemManage_Handler(void)
-{
-  /* USER CODE BEGIN MemoryManagement_IRQn 0 */
-
-  /* USER CODE END MemoryManagement_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_MemoryManagement_IRQn 0 */
-    /* USER CODE END W1_MemoryManagement_IRQn 0 */
-  }
-}
-
-/**
-  * @brief This function handles Pre-fetch fault, memory access fault.
-  */
-void BusFault_Handler(void)
-{
-  /* USER CODE BEGIN BusFault_IRQn 0 */
-
-  /* USER CODE END BusFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_BusFault_IRQn 0 */
-    /* USER CODE END W1_BusFault_IRQn 0 */
-  }
-}
-
-/**
-  * @brief This function handles Undefined instruction or illegal state.
-  */
-void UsageFault_Handler(void)
-{
-  /* USER CODE BEGIN UsageFault_IRQn 0 */
-
-  /* USER CODE END UsageFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_UsageFault_IRQn 0 */
-    /* USER CODE END W1_UsageFault_IRQn 0 */
-  }
-}
-
-/**
-  * @brief This function handles System service call via SWI instruction.
-  */
-void SVC_Handler(void)
-{
-  /* USER CODE BEGIN SVCall_IRQn 0 */
-
-  /* USER CODE END SVCall_IRQn 0 */
-  /* USER CODE BEGIN SVCall_IRQn 1 */
-
-  /* USER CODE END SVCall_IRQn 1 */
-}
-
-/**
-  * @brief This function handles Debug monitor.
-  */
-void DebugMon_Handler(void)
-{
-  /* USER CODE BEGIN DebugMonitor_IRQn 0 */
-
-  /* USER CODE END DebugMonitor_IRQn 0 */
-  /* USER CODE BEGIN DebugMonitor_IRQn 1 */
-
-  /* USER CODE END DebugMonitor_IRQn 1 */
-}
-
-/**
-  * @brief This function handles Pendable request for system service.
-  */
-void PendSV_Handler(void)
-{
-  /* USER CODE BEGIN PendSV_IRQn 0 */
-
-  /* USER CODE END PendSV_IRQn 0 */
-  /* USER CODE BEGIN PendSV_IRQn 1 */
-
-  /* USER CODE END PendSV_IRQn 1 */
-}
-
-/**
-  * @brief This function handles System tick timer.
-  */
-void SysTick_Handler(void)
-{
-  /* USER CODE BEGIN SysTick_IRQn 0 */
-
-  /* USER CODE END SysTick_IRQn 0 */
-  HAL_IncTick();
-  /* USER CODE BEGIN SysTick_IRQn 1 */
-
-  /* USER CODE END SysTick_IRQn 1 */
-}
-
-/******************************************************************************/
-/* STM32F3xx Peripheral Interrupt Handlers                                    */
-/* Add here the Interrupt Handlers for the used peripherals.                  */
-/* For the available peripheral interrupt handler names,                      */
-/* please refer to the startup file (startup_stm32f3xx.s).                    */
-/******************************************************************************/
-
-/* USER CODE BEGIN 1 */
-
-/* USER CODE END 1 */
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    stm32f3xx_it.c
+  * @brief   Interrupt Service Routines.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "stm32f3xx_it.h"
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include "ads1220.h"
+#include "grid_scan.h"
+/* USER CODE END Includes */
+
+/* Private typedef -----------------------------------------------------------*/
+/* USER CODE BEGIN TD */
+
+/* USER CODE END TD */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+
+/* USER CODE END PD */
+
+/* Private macro -------------------------------------------------------------*/
+/* USER CODE BEGIN PM */
+
+/* USER CODE END PM */
+
+/* Private variables ---------------------------------------------------------*/
+/* USER CODE BEGIN PV */
+
+/* USER CODE END PV */
+
+/* Private function prototypes -----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+
+/* USER CODE END PFP */
+
+/* Private user code ---------------------------------------------------------*/
+/* USER CODE BEGIN 0 */
+
+/* USER CODE END 0 */
+
+/* External variables --------------------------------------------------------*/
+
+/* USER CODE BEGIN EV */
+extern DMA_HandleTypeDef hdma_usart2_tx;
+extern DMA_HandleTypeDef hdma_spi2_rx;
+extern DMA_HandleTypeDef hdma_spi2_tx;
+extern UART_HandleTypeDef huart2;
+extern TIM_HandleTypeDef g_hScanTim;
+extern TIM_HandleTypeDef g_hRowTim;
+/* USER CODE END EV */
+
+/******************************************************************************/
+/*           Cortex-M4 Processor Interruption and Exception Handlers          */
+/******************************************************************************/
+/**
+  * @brief This function handles Non maskable interrupt.
+  */
+void NMI_Handler(void)
+{
+  /* USER CODE BEGIN NonMaskableInt_IRQn 0 */
+
+  /* USER CODE END NonMaskableInt_IRQn 0 */
+  /* USER CODE BEGIN NonMaskableInt_IRQn 1 */
+   while (1)
+  {
+  }
+  /* USER CODE END NonMaskableInt_IRQn 1 */
+}
+
+/**
+  * @brief This function handles Hard fault interrupt.
+  */
+void HardFault_Handler(void)
+{
+  /* USER CODE BEGIN HardFault_IRQn 0 */
+
+  /* USER CODE END HardFault_IRQn 0 */
+  while (1)
+  {
+    /* USER CODE BEGIN W1_HardFault_IRQn 0 */
+    /* USER CODE END W1_HardFault_IRQn 0 */
+  }
+}
+
+/**
+  * @brief This function handles Memory management fault.
+  */
+void MemManage_Handler(void)
+{
+  /* USER CODE BEGIN MemoryManagement_IRQn 0 */
+
+  /* USER CODE END MemoryManagement_IRQn 0 */
+  while (1)
+  {
+    /* USER CODE BEGIN W1_MemoryManagement_IRQn 0 */
+    /* USER CODE END W1_MemoryManagement_IRQn 0 */
+  }
+}
+
+/**
+  * @brief This function handles Pre-fetch fault, memory access fault.
+  */
+void BusFault_Handler(void)
+{
+  /* USER CODE BEGIN BusFault_IRQn 0 */
+
+  /* USER CODE END BusFault_IRQn 0 */
+  while (1)
+  {
+    /* USER CODE BEGIN W1_BusFault_IRQn 0 */
+    /* USER CODE END W1_BusFault_IRQn 0 */
+  }
+}
+
+/**
+  * @brief This function handles Undefined instruction or illegal state.
+  */
+void UsageFault_Handler(void)
+{
+  /* USER CODE BEGIN UsageFault_IRQn 0 */
+
+  /* USER CODE END UsageFault_IRQn 0 */
+  while (1)
+  {
+    /* USER CODE BEGIN W1_UsageFault_IRQn 0 */
+    /* USER CODE END W1_UsageFault_IRQn 0 */
+  }
+}
+
+/**
+  * @brief This function handles System service call via SWI instruction.
+  */
+void SVC_Handler(void)
+{
+  /* USER CODE BEGIN SVCall_IRQn 0 */
+
+  /* USER CODE END SVCall_IRQn 0 */
+  /* USER CODE BEGIN SVCall_IRQn 1 */
+
+  /* USER CODE END SVCall_IRQn 1 */
+}
+
+/**
+  * @brief This function handles Debug monitor.
+  */
+void DebugMon_Handler(void)
+{
+  /* USER CODE BEGIN DebugMonitor_IRQn 0 */
+
+  /* USER CODE END DebugMonitor_IRQn 0 */
+  /* USER CODE BEGIN DebugMonitor_IRQn 1 */
+
+  /* USER CODE END DebugMonitor_IRQn 1 */
+}
+
+/**
+  * @brief This function handles Pendable request for system service.
+  */
+void PendSV_Handler(void)
+{
+  /* USER CODE BEGIN PendSV_IRQn 0 */
+
+  /* USER CODE END PendSV_IRQn 0 */
+  /* USER CODE BEGIN PendSV_IRQn 1 */
+
+  /* USER CODE END PendSV_IRQn 1 */
+}
+
+/**
+  * @brief This function handles System tick timer.
+  */
+void SysTick_Handler(void)
+{
+  /* USER CODE BEGIN SysTick_IRQn 0 */
+
+  /* USER CODE END SysTick_IRQn 0 */
+  HAL_IncTick();
+  /* USER CODE BEGIN SysTick_IRQn 1 */
+
+  /* USER CODE END SysTick_IRQn 1 */
+}
+
+/******************************************************************************/
+/* STM32F3xx Peripheral Interrupt Handlers                                    */
+/* Add here the Interrupt Handlers for the used peripherals.                  */
+/* For the available peripheral interrupt handler names,                      */
+/* please refer to the startup file (startup_stm32f3xx.s).                    */
+/******************************************************************************/
+
+/* USER CODE BEGIN 1 */
+
+/* Interrupt architecture: priorities come from the GRID_IRQPRI_* tiers
+ * in main.h (conversion > data movement > telemetry > command), with
+ * full preemption grouping so a chatty lower tier can never delay the
+ * conversion timeline. Every handler here is flag-and-queue - the
+ * deferred work runs in GRID_ScanLoop - and every handler's run time
+ * is charged to the GRID_PROF_ISR window, so the worst-case handler of
+ * each stats period shows up on the diagnostics panel. */
+
+/**
+  * @brief This function handles EXTI line 0 interrupt (ADS1220 chip 0 DRDY).
+  */
+void EXTI0_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles EXTI line 1 interrupt (ADS1220 chip 1 DRDY).
+  */
+void EXTI1_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles EXTI line 2 interrupt (ADS1220 chip 2 DRDY).
+  */
+void EXTI2_TSC_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles EXTI line 4 interrupt (ADS1220 chip 3 DRDY).
+  */
+void EXTI4_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_4);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles EXTI lines 5-9 interrupt (ADS1220 chips 4+ DRDY).
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_5);
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_6);
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_7);
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_8);
+#if (ADS1220_NUM_CHIPS > 8U)
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_9);
+#endif
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+#if (ADS1220_NUM_CHIPS > 8U)
+/**
+  * @brief This function handles EXTI lines 10-15 interrupt (ADS1220 chip 9 DRDY).
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_10);
+
+  GRID_IsrProfRecord(isrStart);
+}
+#endif
+
+/**
+  * @brief This function handles TIM7 global interrupt (scan state machine).
+  */
+void TIM7_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_TIM_IRQHandler(&g_hScanTim);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles TIM2 global interrupt (row timeline).
+  */
+void TIM2_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_TIM_IRQHandler(&g_hRowTim);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles DMA1 channel 4 interrupt (SPI2 RX DMA).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_DMA_IRQHandler(&hdma_spi2_rx);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles DMA1 channel 5 interrupt (SPI2 TX DMA).
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_DMA_IRQHandler(&hdma_spi2_tx);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles DMA1 channel 7 interrupt (USART2 TX DMA).
+  */
+void DMA1_Channel7_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_DMA_IRQHandler(&hdma_usart2_tx);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles USART2 global interrupt.
+  */
+void USART2_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  HAL_UART_IRQHandler(&huart2);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles SPI1 global interrupt (ADS1220 bus).
+  */
+void SPI1_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  ADS1220_SPI_IRQHandler(SPI1);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles SPI2 global interrupt (ADS1220 bus).
+  */
+void SPI2_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  ADS1220_SPI_IRQHandler(SPI2);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/**
+  * @brief This function handles SPI3 global interrupt (ADS1220 bus).
+  */
+void SPI3_IRQHandler(void)
+{
+  uint32_t isrStart = DWT->CYCCNT;
+
+  ADS1220_SPI_IRQHandler(SPI3);
+
+  GRID_IsrProfRecord(isrStart);
+}
+
+/* USER CODE END 1 */
@@ -23,9 +23,13 @@ Date: 2026-01-12
 ================================================================================
 """
 
+import ctypes
+import math
+import os
 import sys
 import struct
 import time
+import zlib
 from collections import deque
 from typing import Optional
 from pathlib import Path
@@ -39,14 +43,26 @@ from PyQt6.QtWidgets import (
     QSlider, QFrame, QProgressBar, QDialog, QDialogButtonBox, QFileDialog
 )
 from PyQt6.QtCore import QTimer, Qt, pyqtSignal, QThread
-from PyQt6.QtGui import QFont, QPalette, QColor, QPainter, QPen, QBrush
+from PyQt6.QtGui import (QFont, QPalette, QColor, QPainter, QPen, QBrush,
+                         QTransform)
 import pyqtgraph as pg
 
+# QOpenGLWidget hosts the native GL heatmap renderer (opt-in via
+# GRID_GUI_GL=1); absent on minimal PyQt installs, where the
+# pyqtgraph heatmap path is used regardless
+try:
+    from PyQt6.QtOpenGLWidgets import QOpenGLWidget
+except ImportError:
+    QOpenGLWidget = None
+
 # Import spine detector module
 from spine_detector import (
     SpineDetector, MovementTracker, PalpationZones, SpeedZones,
     SpinalLandmark, SpineCalibration
 )
+# Native C++ engine when the host library is built; same API, same
+# calibration files, falls back to the pure-Python classes above
+from native_spine import make_spine_detector, make_movement_tracker
 
 
 # ============================================================================
@@ -57,13 +73,139 @@ GRID_ROWS = 16
 GRID_COLS = 32
 GRID_TOTAL = GRID_ROWS * GRID_COLS  # 512
 
+# Display upsampling: the coarse grid is bicubically interpolated to
+# (GRID_ROWS * factor) x (GRID_COLS * factor) by the native library
+# before it reaches the heatmap; 8 gives 128x256. Falls back to the
+# raw grid when the library is absent.
+UPSAMPLE_FACTOR = 8
+
 # Binary protocol
 SYNC_BYTE_1 = 0xAA
 SYNC_BYTE_2 = 0x55
+SYNC_BYTE_2_PREVIEW = 0x56  # Half-resolution 8x16 preview frames
+SYNC_BYTE_2_PACKED = 0x57  # 12-bit packed full frames (2 cells / 3 bytes)
+SYNC_BYTE_2_DELTA = 0x58  # Delta frames: changed cells since last keyframe
+SYNC_BYTE_2_RLE = 0x59  # Run-length-encoded frames (idle grids)
+SYNC_BYTE_2_STATS = 0x5A  # 1 Hz heartbeat/diagnostics packet
+SYNC_BYTE_2_AGG = 0x5B  # Aggregated super-packet: K frames, one CRC
+SYNC_BYTE_2_LOG = 0x5C  # Firmware log text (printf rides the stream)
+SYNC_BYTE_2_BENCH = 0x5D  # On-target microbenchmark results
+SYNC_BYTE_2_ROW = 0x5E  # Streamed single rows (row-streaming mode)
+SYNC_BYTE_2_FIELD = 0x5F  # Interlaced half-frames (odd/even row fields)
 HEADER_SIZE = 2
-PAYLOAD_SIZE = GRID_TOTAL * 2  # 3200 bytes (16-bit values)
-FOOTER_SIZE = 4  # 2-byte checksum + CR + LF
-PACKET_SIZE = HEADER_SIZE + PAYLOAD_SIZE + FOOTER_SIZE  # 3206 bytes
+PAYLOAD_SIZE = GRID_TOTAL * 2  # 1024 bytes (16-bit values)
+META_SIZE = 24  # peak (u16), peak row/col (u8), total (u32), centroid
+                # (2x u16), sequence number (u32), scan timestamp ms (u32),
+                # dead-column mask (u32, bit n = column n)
+FOOTER_SIZE = 6  # 4-byte CRC32 (hardware unit on the MCU) + CR + LF
+PACKET_SIZE = HEADER_SIZE + PAYLOAD_SIZE + META_SIZE + FOOTER_SIZE
+
+# Preview (binned) frames: 8x16, upsampled to full grid for display
+PREVIEW_ROWS = GRID_ROWS // 2
+PREVIEW_COLS = GRID_COLS // 2
+PREVIEW_TOTAL = PREVIEW_ROWS * PREVIEW_COLS
+PREVIEW_PAYLOAD_SIZE = PREVIEW_TOTAL * 2
+PREVIEW_PACKET_SIZE = HEADER_SIZE + PREVIEW_PAYLOAD_SIZE + FOOTER_SIZE
+
+# 12-bit packed full frames (negotiated): values are sent as val >> 4
+PACKED_PAYLOAD_SIZE = GRID_TOTAL * 3 // 2
+PACKED_PACKET_SIZE = HEADER_SIZE + PACKED_PAYLOAD_SIZE + META_SIZE + FOOTER_SIZE
+
+# Delta frames: count (u16) + pad (u16) + count x (index u16, value u16)
+DELTA_HDR_SIZE = 4
+
+# RLE frames: encoded length (u16) + pad (u16), then alternating
+# (zero-run u16, literal-count u16, literals...) tokens, word-padded
+RLE_HDR_SIZE = 4
+
+# Aggregated frames: count (u8) + pad (u8) + unit size (u16), then
+# count x (payload + metadata) units under a single CRC
+AGG_HDR_SIZE = 4
+
+# Log packets: text length (u16) + pad (u16), then the word-padded
+# firmware log text - printf output drained between data frames
+LOG_HDR_SIZE = 4
+
+# Heartbeat stats: uptime ms (u32), frame count (u32), last scan us
+# (u32), TX stalls (u32), dropped commands (u32), ADS1220 alive mask
+# (u8), mode flags (u8), settle us (u16), then the DWT profiling
+# block: min/avg/max us (u16 each) per scan phase over the last
+# second, then the inter-frame jitter histogram (u16 counts, bins
+# bounded at JITTER_BOUNDS_US with an open top bin), the governor's
+# last touch-to-full-rate ramp bound (u16 ms, 0 = no ramp yet), plus
+# a pad (u16) - no metadata block
+PROF_PHASES = ['settle', 'read', 'process', 'tx', 'frame', 'isr']
+JITTER_BOUNDS_US = [100, 200, 500, 1000, 2000, 5000, 10000]
+JITTER_BINS = len(JITTER_BOUNDS_US) + 1
+STATS_PAYLOAD_SIZE = 24 + 6 * len(PROF_PHASES) + 2 * JITTER_BINS + 2 + 2
+STATS_PACKET_SIZE = HEADER_SIZE + STATS_PAYLOAD_SIZE + FOOTER_SIZE
+
+# Streamed rows (negotiated): row index (u8) + pad (u8) + frame
+# sequence low bits (u16), then one row of cells - each row ships the
+# moment the firmware finishes it, so the display updates row by row
+# instead of waiting out the rest of the scan. No metadata block
+ROW_HDR_SIZE = 4
+ROW_PAYLOAD_SIZE = ROW_HDR_SIZE + GRID_COLS * 2
+ROW_PACKET_SIZE = HEADER_SIZE + ROW_PAYLOAD_SIZE + FOOTER_SIZE
+
+# Interlaced fields (negotiated): parity (u8) + pad (u8) + frame
+# sequence low bits (u16), then every second row top to bottom. Each
+# field merges into the retained frame, so the heatmap refreshes at
+# twice the full-frame rate for the same baud
+FIELD_HDR_SIZE = 4
+FIELD_ROWS = GRID_ROWS // 2
+FIELD_PAYLOAD_SIZE = FIELD_HDR_SIZE + FIELD_ROWS * GRID_COLS * 2
+FIELD_PACKET_SIZE = HEADER_SIZE + FIELD_PAYLOAD_SIZE + META_SIZE + FOOTER_SIZE
+
+# Benchmark results: iterations (u16) + pad (u16), then min/avg/max
+# DWT cycle counts (u32 each) per isolated primitive - no metadata
+BENCH_TESTS = ['adc read', 'spi read', 'row switch', 'pack+crc', 'uart tx']
+BENCH_PAYLOAD_SIZE = 4 + 12 * len(BENCH_TESTS)
+BENCH_PACKET_SIZE = HEADER_SIZE + BENCH_PAYLOAD_SIZE + FOOTER_SIZE
+
+# Negotiated baud profiles: the link always opens at 115200, then the
+# host commands a higher rate, reopens there, and confirms on the first
+# valid frame. Firmware reverts on its own if the confirm never arrives.
+DEFAULT_BAUD = 115200
+BAUD_PROFILES = {115200: 0xB0, 921600: 0xB1, 2000000: 0xB2}
+CMD_BAUD_CONFIRM = 0xBF
+SYNC_LOSS_TIMEOUT_S = 2.0  # No valid frame for this long -> fall back
+
+# COBS framing (negotiated): each packet is byte-stuffed and terminated
+# by a 0x00 delimiter, making frame boundaries unambiguous - the sync
+# bytes 0xAA 0x55 can legitimately occur inside 16-bit payload data and
+# cause false resyncs after a dropped byte.
+COBS_DELIMITER = 0x00
+
+# Host command opcodes (single byte, little-endian args) - must match
+# the GRID_CMD_* set in grid_scan.h
+CMD_CALIBRATE = 0xC0       # No args; firmware re-learns its baseline
+CMD_SET_THRESHOLD = 0xC1   # u16 global noise threshold
+CMD_SET_ROI = 0xC2         # rowStart u8, rowEnd u8, colMask u32
+CMD_CLEAR_ROI = 0xC3
+CMD_SET_PACKED = 0xC4      # u8 0/1
+CMD_SET_DELTA = 0xC5       # u8 0/1
+CMD_SET_MEDIAN = 0xC6      # u8 0/1
+CMD_SET_FILTER = 0xC7      # u8 EWMA shift, 0 = off
+CMD_SET_OVERSAMPLE = 0xC8  # u8 2^n samples per cell
+CMD_SET_ADAPTIVE = 0xC9    # u8 0/1
+CMD_SET_COBS = 0xCA        # u8 0/1
+CMD_SET_SETTLE = 0xCB      # u16 settling time in us
+CMD_STREAM = 0xCC          # u8: 0 idle, 1 free-running
+CMD_SNAPSHOT = 0xCD        # No args: one frame on demand
+CMD_BURST = 0xCE           # count u16, interval ms u16
+CMD_NACK = 0xCF            # u32 sequence number to retransmit
+CMD_SET_RLE = 0xD0         # u8 0/1: run-length-encoded idle frames
+CMD_SET_AGG = 0xD1         # u8 frames per super-packet (1 = off, max 4)
+CMD_BENCHMARK = 0xD2       # u16 iterations per test (0 = default)
+CMD_SET_GOVERNOR = 0xD7    # u8 0/1 activity-driven frame-rate governor
+CMD_SET_XTALK = 0xD8       # u8 crosstalk ghost ratio in Q8, 0 = off
+CMD_SET_INTERLACE = 0xD9   # u8 0/1: interlaced odd/even field frames
+CMD_SAVE_CONFIG = 0xDA     # No args: persist current tuning to flash
+CMD_RESET_CONFIG = 0xDB    # No args: erase it; next boot runs defaults
+CMD_INJECT = 0xDC          # row u8, col u8, value u16: latency marker
+CMD_SET_TIMERSCAN = 0xDD   # u8 0/1 timer-driven scan engine (default on)
+RETAIN_DEPTH = 4           # Frames the firmware keeps for NACKs
 
 # Waveform history
 WAVEFORM_HISTORY_SIZE = 200  # ~8 seconds at 25 Hz
@@ -79,6 +221,569 @@ ACCENT_YELLOW = "#f9e2af"
 ACCENT_ORANGE = "#fab387"
 ACCENT_PURPLE = "#cba6f7"
 
+# Heatmap palette stops, dark blue through red; shared by the
+# pyqtgraph lookup table and the native GL colormap texture
+HEATMAP_COLORS = [
+    (0, 0, 128),      # Dark blue
+    (0, 0, 255),      # Blue
+    (0, 255, 255),    # Cyan
+    (0, 255, 0),      # Green
+    (255, 255, 0),    # Yellow
+    (255, 128, 0),    # Orange
+    (255, 0, 0),      # Red
+]
+
+
+def cobs_decode(chunk: bytes) -> Optional[bytes]:
+    """Decode one COBS-encoded chunk (delimiter already stripped).
+
+    Returns None if the chunk is malformed (e.g. truncated by a dropped
+    byte) - the caller just discards it and stays frame-aligned.
+    """
+    out = bytearray()
+    i = 0
+    n = len(chunk)
+    while i < n:
+        code = chunk[i]
+        if code == 0 or i + code > n:
+            return None
+        out.extend(chunk[i + 1:i + code])
+        i += code
+        if code < 0xFF and i < n:
+            out.append(0)
+    return bytes(out)
+
+
+# ============================================================================
+# Native decoder bridge (optional C++ fast path)
+# ============================================================================
+
+class NativeDecoder:
+    """ctypes bridge to the C++ frame decoder (host/ shared library).
+
+    The pure-Python parser in SerialReader stays the reference
+    implementation and the fallback; when the library has been built
+    (see host/CMakeLists.txt) all sync search, CRC verification and
+    payload unpacking moves off the interpreter, which at 25+ fps frees
+    most of a core on the clinic laptops.
+    """
+
+    EV_FRAME = 1
+    EV_PREVIEW = 2
+    EV_STATS = 3
+    EV_LOG = 4
+    EV_BENCH = 5
+
+    class Event(ctypes.Structure):
+        _fields_ = [('type', ctypes.c_int32),
+                    ('rows', ctypes.c_uint32),
+                    ('cols', ctypes.c_uint32),
+                    ('cells', ctypes.POINTER(ctypes.c_uint16)),
+                    ('meta', ctypes.POINTER(ctypes.c_uint8)),
+                    ('aux', ctypes.POINTER(ctypes.c_uint8)),
+                    ('aux_len', ctypes.c_uint32)]
+
+    class LinkStats(ctypes.Structure):
+        _fields_ = [('frames', ctypes.c_uint32),
+                    ('crc_errors', ctypes.c_uint32),
+                    ('resyncs', ctypes.c_uint32),
+                    ('recovered_frames', ctypes.c_uint32),
+                    ('seq_gaps', ctypes.c_uint32),
+                    ('frames_missed', ctypes.c_uint32),
+                    ('arrival_p50_ms', ctypes.c_float),
+                    ('arrival_p90_ms', ctypes.c_float),
+                    ('arrival_p99_ms', ctypes.c_float)]
+
+    _LIB_NAMES = ('libgriddecode.so', 'libgriddecode.dylib',
+                  'griddecode.dll')
+
+    @classmethod
+    def load(cls, cobs_framing: bool) -> Optional['NativeDecoder']:
+        """Find and load the library, or None to use the Python path."""
+        host_dir = Path(__file__).resolve().parent.parent / 'host'
+        for directory in (host_dir / 'build',
+                          Path(__file__).resolve().parent):
+            for name in cls._LIB_NAMES:
+                path = directory / name
+                if path.exists():
+                    try:
+                        return cls(str(path), cobs_framing)
+                    except OSError:
+                        continue
+        return None
+
+    def __init__(self, path: str, cobs_framing: bool):
+        lib = ctypes.CDLL(path)
+        lib.grid_decoder_create.restype = ctypes.c_void_p
+        lib.grid_decoder_create.argtypes = [ctypes.c_uint32,
+                                            ctypes.c_uint32]
+        lib.grid_decoder_destroy.argtypes = [ctypes.c_void_p]
+        lib.grid_decoder_set_cobs.argtypes = [ctypes.c_void_p,
+                                              ctypes.c_int]
+        lib.grid_decoder_reset.argtypes = [ctypes.c_void_p]
+        lib.grid_decoder_feed.restype = ctypes.c_size_t
+        lib.grid_decoder_feed.argtypes = [ctypes.c_void_p,
+                                          ctypes.c_char_p,
+                                          ctypes.c_size_t]
+        lib.grid_decoder_reserve.restype = ctypes.c_void_p
+        lib.grid_decoder_reserve.argtypes = [ctypes.c_void_p,
+                                             ctypes.POINTER(ctypes.c_size_t)]
+        lib.grid_decoder_commit.argtypes = [ctypes.c_void_p,
+                                            ctypes.c_size_t]
+        lib.grid_decoder_poll.restype = ctypes.c_int
+        lib.grid_decoder_poll.argtypes = [ctypes.c_void_p,
+                                          ctypes.POINTER(self.Event)]
+        lib.grid_decoder_link_stats.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(self.LinkStats)]
+        self._lib = lib
+        self._dec = lib.grid_decoder_create(GRID_ROWS, GRID_COLS)
+        if not self._dec:
+            raise OSError('grid_decoder_create failed')
+        lib.grid_decoder_set_cobs(self._dec, 1 if cobs_framing else 0)
+        self._event = self.Event()
+
+    def feed(self, data: bytes):
+        """Push raw serial bytes into the decoder."""
+        self._lib.grid_decoder_feed(self._dec, data, len(data))
+
+    def read_from(self, port) -> int:
+        """Bulk-read waiting serial bytes straight into the decoder ring.
+
+        Reserves ring space and lets pyserial readinto() it, so the
+        bytes never pass through an intermediate Python object. Returns
+        the byte count; falls back to feed() when the ring has no room
+        or COBS framing keeps the reservation API unavailable.
+        """
+        waiting = port.in_waiting
+        if not waiting:
+            return 0
+        avail = ctypes.c_size_t(0)
+        ptr = self._lib.grid_decoder_reserve(self._dec,
+                                             ctypes.byref(avail))
+        if not ptr or avail.value == 0:
+            self.feed(port.read(waiting))
+            return waiting
+        n = min(waiting, avail.value)
+        view = (ctypes.c_uint8 * n).from_address(ptr)
+        got = port.readinto(memoryview(view)) or 0
+        self._lib.grid_decoder_commit(self._dec, got)
+        return got
+
+    def poll(self) -> Optional['NativeDecoder.Event']:
+        """Next decoded packet, or None when more bytes are needed."""
+        if not self._lib.grid_decoder_poll(self._dec,
+                                           ctypes.byref(self._event)):
+            return None
+        return self._event
+
+    def link_stats(self) -> dict:
+        """Snapshot the decoder's link-quality counters as a dict."""
+        st = self.LinkStats()
+        self._lib.grid_decoder_link_stats(self._dec, ctypes.byref(st))
+        return {name: getattr(st, name)
+                for name, _ in self.LinkStats._fields_}
+
+    def reset(self):
+        """Drop buffered bytes (baud fallback resync)."""
+        self._lib.grid_decoder_reset(self._dec)
+
+    def close(self):
+        if self._dec:
+            self._lib.grid_decoder_destroy(self._dec)
+            self._dec = None
+
+
+class NativeUpsampler:
+    """ctypes bridge to grid_kernels_upsample for display interpolation.
+
+    PyQtGraph's generic image path shows the raw 16x32 grid as hard
+    blocks; the native separable bicubic smooths it to UPSAMPLE_FACTOR
+    times the resolution for a fraction of what the scipy-zoom
+    workaround cost. The output array is allocated once and reused
+    every frame, and the heatmap keeps grid coordinates through an
+    ImageItem transform so landmark overlays need no changes.
+    """
+
+    def __init__(self, path: str, rows: int, cols: int, factor: int):
+        lib = ctypes.CDLL(path)
+        lib.grid_kernels_upsample.argtypes = [
+            ctypes.POINTER(ctypes.c_uint16), ctypes.c_uint32,
+            ctypes.c_uint32, ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_uint32]
+        lib.grid_kernels_upsample.restype = None
+        self._lib = lib
+        self._rows = rows
+        self._cols = cols
+        self.factor = factor
+        self._out = np.zeros((rows * factor, cols * factor),
+                             dtype=np.uint16)
+
+    @classmethod
+    def load(cls, rows: int, cols: int,
+             factor: int) -> Optional['NativeUpsampler']:
+        """Find and load the library, or None to show the raw grid."""
+        host_dir = Path(__file__).resolve().parent.parent / 'host'
+        for directory in (host_dir / 'build',
+                          Path(__file__).resolve().parent):
+            for name in NativeDecoder._LIB_NAMES:
+                path = directory / name
+                if path.exists():
+                    try:
+                        return cls(str(path), rows, cols, factor)
+                    except (OSError, AttributeError):
+                        # Older library without the upsample kernel
+                        continue
+        return None
+
+    def apply(self, data: np.ndarray) -> np.ndarray:
+        """Upsampled frame for display; the returned array is reused."""
+        src = np.ascontiguousarray(data, dtype=np.uint16)
+        self._lib.grid_kernels_upsample(
+            src.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+            self._rows, self._cols,
+            self._out.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+            self.factor)
+        return self._out
+
+
+class NativeHeatmapGL:
+    """ctypes bridge to the heatmap_gl renderer in the host library.
+
+    The renderer issues GL calls against whatever context is current,
+    so every method here must only be called from GLHeatmapWidget's
+    initializeGL/paintGL (Qt makes the widget's context current there).
+    create() fails cleanly on machines without usable GL and the GUI
+    keeps the pyqtgraph heatmap.
+    """
+
+    def __init__(self, path: str):
+        lib = ctypes.CDLL(path)
+        lib.heatmap_gl_create.argtypes = [ctypes.c_uint32, ctypes.c_uint32]
+        lib.heatmap_gl_create.restype = ctypes.c_void_p
+        lib.heatmap_gl_destroy.argtypes = [ctypes.c_void_p]
+        lib.heatmap_gl_set_colormap.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint8), ctypes.c_uint32]
+        lib.heatmap_gl_set_range.argtypes = [ctypes.c_void_p, ctypes.c_float]
+        lib.heatmap_gl_upload.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16)]
+        lib.heatmap_gl_set_lines.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_float), ctypes.c_uint32]
+        lib.heatmap_gl_set_markers.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_float), ctypes.c_uint32,
+            ctypes.c_float]
+        lib.heatmap_gl_render.argtypes = [
+            ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+        lib.heatmap_gl_render.restype = ctypes.c_int
+        self._lib = lib
+        self._h = None
+
+    @classmethod
+    def load(cls) -> Optional['NativeHeatmapGL']:
+        """Find and load the library, or None for the pyqtgraph path."""
+        host_dir = Path(__file__).resolve().parent.parent / 'host'
+        for directory in (host_dir / 'build',
+                          Path(__file__).resolve().parent):
+            for name in NativeDecoder._LIB_NAMES:
+                path = directory / name
+                if path.exists():
+                    try:
+                        return cls(str(path))
+                    except (OSError, AttributeError):
+                        # Older library without the GL renderer
+                        continue
+        return None
+
+    def create(self, rows: int, cols: int) -> bool:
+        self._h = self._lib.heatmap_gl_create(rows, cols)
+        return self._h is not None
+
+    def set_colormap(self, stops):
+        arr = np.ascontiguousarray(stops, dtype=np.uint8)
+        self._lib.heatmap_gl_set_colormap(
+            self._h, arr.ctypes.data_as(ctypes.POINTER(ctypes.c_uint8)),
+            arr.shape[0])
+
+    def set_range(self, max_value: float):
+        self._lib.heatmap_gl_set_range(self._h, max_value)
+
+    def upload(self, data: np.ndarray):
+        src = np.ascontiguousarray(data, dtype=np.uint16)
+        self._lib.heatmap_gl_upload(
+            self._h, src.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)))
+
+    def set_lines(self, verts):
+        """verts: (n, 6) float32 rows of x, y, r, g, b, a; pairs form
+        segments. None or empty clears the overlay lines."""
+        if verts is None or len(verts) == 0:
+            self._lib.heatmap_gl_set_lines(
+                self._h, ctypes.POINTER(ctypes.c_float)(), 0)
+            return
+        arr = np.ascontiguousarray(verts, dtype=np.float32)
+        self._lib.heatmap_gl_set_lines(
+            self._h, arr.ctypes.data_as(ctypes.POINTER(ctypes.c_float)),
+            arr.shape[0])
+
+    def set_markers(self, verts, px_size: float):
+        """Same layout as set_lines, one marker per row."""
+        if verts is None or len(verts) == 0:
+            self._lib.heatmap_gl_set_markers(
+                self._h, ctypes.POINTER(ctypes.c_float)(), 0, px_size)
+            return
+        arr = np.ascontiguousarray(verts, dtype=np.float32)
+        self._lib.heatmap_gl_set_markers(
+            self._h, arr.ctypes.data_as(ctypes.POINTER(ctypes.c_float)),
+            arr.shape[0], px_size)
+
+    def render(self, width: int, height: int) -> bool:
+        return self._lib.heatmap_gl_render(self._h, width, height) == 0
+
+
+class LatencyHarness:
+    """ctypes bridge to the grid_latency end-to-end probe.
+
+    arm() is called right before the CMD_INJECT goes on the wire; the
+    serial thread, GUI thread and GL paint callback then mark the
+    marker's progress through their stages (the library locks
+    internally) and report() hands back the per-stage breakdown once
+    the frame-present mark lands.
+    """
+
+    class Report(ctypes.Structure):
+        _fields_ = [('arm_to_decode_ms', ctypes.c_double),
+                    ('decode_to_process_ms', ctypes.c_double),
+                    ('process_to_render_ms', ctypes.c_double),
+                    ('render_to_present_ms', ctypes.c_double),
+                    ('total_ms', ctypes.c_double),
+                    ('fw_inject_ms', ctypes.c_uint32),
+                    ('fw_scan_ms', ctypes.c_uint32)]
+
+    def __init__(self, path: str, rows: int, cols: int):
+        lib = ctypes.CDLL(path)
+        lib.grid_latency_create.restype = ctypes.c_void_p
+        lib.grid_latency_create.argtypes = [ctypes.c_uint32,
+                                            ctypes.c_uint32]
+        lib.grid_latency_destroy.argtypes = [ctypes.c_void_p]
+        lib.grid_latency_arm.argtypes = [
+            ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint32,
+            ctypes.c_uint16]
+        lib.grid_latency_mark_decode.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_char_p]
+        lib.grid_latency_mark_process.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16)]
+        lib.grid_latency_mark_render.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16)]
+        lib.grid_latency_mark_present.argtypes = [ctypes.c_void_p]
+        lib.grid_latency_note_log.argtypes = [
+            ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t]
+        lib.grid_latency_report.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(self.Report)]
+        lib.grid_latency_report.restype = ctypes.c_int
+        self._lib = lib
+        self._h = lib.grid_latency_create(rows, cols)
+        if not self._h:
+            raise OSError('grid_latency_create failed')
+
+    @classmethod
+    def load(cls, rows: int, cols: int) -> Optional['LatencyHarness']:
+        """Find and load the library, or None when it is absent."""
+        host_dir = Path(__file__).resolve().parent.parent / 'host'
+        for directory in (host_dir / 'build',
+                          Path(__file__).resolve().parent):
+            for name in NativeDecoder._LIB_NAMES:
+                path = directory / name
+                if path.exists():
+                    try:
+                        return cls(str(path), rows, cols)
+                    except (OSError, AttributeError):
+                        # Older library without the harness
+                        continue
+        return None
+
+    @staticmethod
+    def _cells(data: np.ndarray):
+        src = np.ascontiguousarray(data, dtype=np.uint16)
+        return src.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
+
+    def arm(self, row: int, col: int, value: int):
+        self._lib.grid_latency_arm(self._h, row, col, value)
+
+    def mark_decode(self, data: np.ndarray, meta: Optional[bytes]):
+        self._lib.grid_latency_mark_decode(self._h, self._cells(data),
+                                           meta)
+
+    def mark_process(self, data: np.ndarray):
+        self._lib.grid_latency_mark_process(self._h, self._cells(data))
+
+    def mark_render(self, data: np.ndarray):
+        self._lib.grid_latency_mark_render(self._h, self._cells(data))
+
+    def mark_present(self):
+        self._lib.grid_latency_mark_present(self._h)
+
+    def note_log(self, text: str):
+        raw = text.encode('ascii', errors='replace')
+        self._lib.grid_latency_note_log(self._h, raw, len(raw))
+
+    def report(self) -> Optional['LatencyHarness.Report']:
+        rep = self.Report()
+        if self._lib.grid_latency_report(self._h, ctypes.byref(rep)):
+            return rep
+        return None
+
+
+if QOpenGLWidget is not None:
+
+    class GLHeatmapWidget(QOpenGLWidget):
+        """Native OpenGL heatmap with the overlay drawn as geometry.
+
+        Drop-in for the heatmap area when GRID_GUI_GL=1: exposes the
+        same set_landmarks/highlight surface as LandmarkOverlay and a
+        cell_clicked signal for the waveform cell selection, so the
+        main window treats both paths alike. The grid texture is
+        uploaded once per frame and colormapped in a fragment shader,
+        so render cost no longer grows with display resolution; only
+        the landmark text labels still go through QPainter.
+        """
+
+        cell_clicked = pyqtSignal(int, int)  # row, col
+
+        def __init__(self, bridge: NativeHeatmapGL, rows: int, cols: int,
+                     parent=None):
+            super().__init__(parent)
+            self._bridge = bridge
+            self._rows = rows
+            self._cols = cols
+            self._pending_frame = None
+            self._landmarks: list = []
+            self._spine_line = None
+            self._highlight = None
+            self._overlay_dirty = False
+            self._ready = False
+            # Latency harness present-stage tap (set by the main window)
+            self.latency: Optional['LatencyHarness'] = None
+            self.setMinimumSize(cols * 8, rows * 8)
+
+        # -- LandmarkOverlay-compatible surface --------------------------
+
+        def set_landmarks(self, landmarks: list, spine_line=None):
+            self._landmarks = landmarks or []
+            self._spine_line = spine_line
+            self._overlay_dirty = True
+            self.update()
+
+        def highlight(self, landmark):
+            self._highlight = landmark
+            self._overlay_dirty = True
+            self.update()
+
+        def set_frame(self, data: np.ndarray):
+            self._pending_frame = data
+            self.update()
+
+        # -- GL plumbing -------------------------------------------------
+
+        def initializeGL(self):
+            self._ready = self._bridge.create(self._rows, self._cols)
+            if self._ready:
+                self._bridge.set_colormap(np.array(HEATMAP_COLORS))
+                self._bridge.set_range(4095.0)
+            else:
+                print("heatmap_gl: no usable OpenGL; run without "
+                      "GRID_GUI_GL=1 for the pyqtgraph heatmap",
+                      file=sys.stderr)
+
+        def resizeGL(self, w, h):
+            # Marker pixel size tracks the letterbox cell size
+            self._overlay_dirty = True
+
+        def paintGL(self):
+            if not self._ready:
+                return
+            if self._pending_frame is not None:
+                self._bridge.upload(self._pending_frame)
+                self._pending_frame = None
+            if self._overlay_dirty:
+                self._push_overlay()
+                self._overlay_dirty = False
+            dpr = self.devicePixelRatioF()
+            self._bridge.render(int(self.width() * dpr),
+                                int(self.height() * dpr))
+            self._paint_labels()
+            if self.latency is not None:
+                self.latency.mark_present()
+
+        # -- Helpers -----------------------------------------------------
+
+        def _cell_px(self) -> float:
+            return min(self.width() / self._cols, self.height() / self._rows)
+
+        def _grid_origin(self):
+            cell = self._cell_px()
+            return ((self.width() - self._cols * cell) / 2,
+                    (self.height() - self._rows * cell) / 2)
+
+        @staticmethod
+        def _rgba(hex_color: str, alpha: float = 1.0):
+            c = QColor(hex_color)
+            return (c.redF(), c.greenF(), c.blueF(), alpha)
+
+        def _push_overlay(self):
+            lines = []
+            if self._spine_line:
+                r, g, b, a = self._rgba(ACCENT_PURPLE)
+                y1 = self._spine_line.start_row
+                y2 = self._spine_line.end_row
+                lines.append([self._spine_line.get_col_at_row(y1), y1,
+                              r, g, b, a])
+                lines.append([self._spine_line.get_col_at_row(y2), y2,
+                              r, g, b, a])
+            self._bridge.set_lines(lines)
+
+            markers = []
+            for lm in self._landmarks:
+                lit = (self._highlight
+                       and lm.level == self._highlight.level
+                       and lm.landmark_type ==
+                           self._highlight.landmark_type)
+                if lm.landmark_type == 'spinous':
+                    color = ACCENT_GREEN if lit else ACCENT_BLUE
+                else:
+                    color = ACCENT_YELLOW if lit else ACCENT_ORANGE
+                markers.append([lm.col, lm.row, *self._rgba(color)])
+            self._bridge.set_markers(
+                markers, 3.0 * self._cell_px() * self.devicePixelRatioF())
+
+        def _paint_labels(self):
+            if not self._landmarks:
+                return
+            painter = QPainter(self)
+            painter.setPen(QPen(QColor(DARK_TEXT)))
+            font = painter.font()
+            font.setPointSize(7)
+            painter.setFont(font)
+            cell = self._cell_px()
+            x0, y0 = self._grid_origin()
+            for lm in self._landmarks:
+                if lm.landmark_type == 'spinous':
+                    painter.drawText(int(x0 + (lm.col + 1.0) * cell),
+                                     int(y0 + (lm.row + 0.5) * cell),
+                                     lm.level)
+            painter.end()
+
+        def mousePressEvent(self, event):
+            cell = self._cell_px()
+            x0, y0 = self._grid_origin()
+            pos = event.position()
+            col = int((pos.x() - x0) / cell)
+            row = int((pos.y() - y0) / cell)
+            if 0 <= row < self._rows and 0 <= col < self._cols:
+                self.cell_clicked.emit(row, col)
+            super().mousePressEvent(event)
+
+else:
+    GLHeatmapWidget = None
+
 
 # ============================================================================
 # Serial Reader Thread
@@ -87,62 +792,457 @@ ACCENT_PURPLE = "#cba6f7"
 class SerialReader(QThread):
     """Background thread for reading serial data."""
     
-    data_received = pyqtSignal(np.ndarray)  # Emits 40x40 numpy array
+    data_received = pyqtSignal(np.ndarray)  # Emits 16x32 numpy array
+    meta_received = pyqtSignal(dict)  # Firmware frame summary (full frames)
+    stats_received = pyqtSignal(dict)  # 1 Hz heartbeat diagnostics
+    log_received = pyqtSignal(str)  # Firmware log text chunks
+    bench_received = pyqtSignal(dict)  # On-target microbenchmark results
+    link_stats_received = pyqtSignal(dict)  # Host-side link quality (native)
     error_occurred = pyqtSignal(str)
     
-    def __init__(self, port: str, baudrate: int = 115200):
+    def __init__(self, port: str, baudrate: int = 115200,
+                 cobs_framing: bool = False):
         super().__init__()
         self.port = port
         self.baudrate = baudrate
+        self.cobs_framing = cobs_framing
         self.running = False
         self.serial: Optional[serial.Serial] = None
-    
+        self._baud_confirmed = True
+        self._last_seq: Optional[int] = None
+        # Reconstruction state for delta frames; resynced on every keyframe
+        self._frame_state = np.zeros((GRID_ROWS, GRID_COLS), dtype=np.uint16)
+        # Latency harness decode-stage tap (set by the main window)
+        self.latency: Optional['LatencyHarness'] = None
+
+    def send_command(self, cmd: int, args: bytes = b''):
+        """Send a host command byte (plus its arguments) to the firmware."""
+        if self.serial and self.serial.is_open:
+            self.serial.write(bytes([cmd]) + args)
+
+    def _switch_baud(self, target: int):
+        """Run the baud-profile handshake: command the new rate at the
+        current one, then reopen at the target. The first valid frame
+        received there triggers the CONFIRM byte (see run loop)."""
+        self.serial.write(bytes([BAUD_PROFILES[target]]))
+        self.serial.flush()
+        time.sleep(0.1)  # Let the firmware finish its in-flight frame
+        self.serial.baudrate = target
+        self.serial.reset_input_buffer()
+        self._baud_confirmed = False
+
+    def _decode_frame_payload(self, body: bytes) -> np.ndarray:
+        """Decode one full-frame payload (16-bit raw or 12-bit packed,
+        distinguished by length) into a 16x32 array."""
+        if len(body) == PACKED_PAYLOAD_SIZE:
+            # Unpack 2 cells from each 3-byte triplet; values were sent
+            # as val >> 4, so shift back up for consistent scaling
+            triplets = np.frombuffer(body, dtype=np.uint8).reshape(-1, 3)
+            t = triplets.astype(np.uint16)
+            a = t[:, 0] | ((t[:, 1] & 0x0F) << 8)
+            b = (t[:, 1] >> 4) | (t[:, 2] << 4)
+            values = np.empty(GRID_TOTAL, dtype=np.uint16)
+            values[0::2] = a
+            values[1::2] = b
+            return (values << 4).reshape(GRID_ROWS, GRID_COLS)
+        values = struct.unpack(f'<{GRID_TOTAL}H', body)
+        return np.array(values, dtype=np.uint16).reshape(GRID_ROWS, GRID_COLS)
+
+    def _handle_meta(self, meta: bytes):
+        """Unpack a frame metadata block, emit it, and NACK any small
+        sequence gap the firmware can still retransmit."""
+        peak, peak_row, peak_col, total, cent_r, cent_c, \
+            seq, stamp_ms, dead_cols = struct.unpack('<HBBIHHIII', meta)
+        self.meta_received.emit({
+            'peak': peak,
+            'peak_cell': (peak_row, peak_col),
+            'total_force': total,
+            'centroid': (cent_r / 256.0, cent_c / 256.0),
+            'seq': seq,
+            'timestamp_ms': stamp_ms,
+            'dead_cols': dead_cols,
+        })
+
+        # NACK small sequence gaps: the firmware retains the last few
+        # frames and resends on request, so a corrupted packet need not
+        # be a recording gap. Retransmits arrive with older seq and must
+        # not rewind the tracker (or we would NACK forever).
+        if self._last_seq is None or seq <= self._last_seq:
+            self._last_seq = max(self._last_seq or seq, seq)
+        else:
+            gap = seq - self._last_seq
+            if 1 < gap <= RETAIN_DEPTH + 1:
+                for missing in range(self._last_seq + 1, seq):
+                    self.send_command(CMD_NACK, struct.pack('<I', missing))
+            self._last_seq = seq
+
+    def _emit_stats(self, payload):
+        """Unpack and emit one heartbeat stats payload."""
+        (uptime_ms, fcount, scan_us, tx_stalls, cmd_drops,
+         alive, flags, settle_us) = struct.unpack_from(
+            '<IIIIIBBH', payload)
+        prof = struct.unpack_from(
+            f'<{3 * len(PROF_PHASES)}H', payload, 24)
+        profile = {name: prof[3 * i:3 * i + 3]
+                   for i, name in enumerate(PROF_PHASES)}
+        jitter = struct.unpack_from(
+            f'<{JITTER_BINS}H', payload, 24 + 6 * len(PROF_PHASES))
+        gov_ramp_ms = struct.unpack_from(
+            '<H', payload, 24 + 6 * len(PROF_PHASES) + 2 * JITTER_BINS)[0]
+        self.stats_received.emit({
+            'profile': profile,
+            'jitter': jitter,
+            'gov_ramp_ms': gov_ramp_ms,
+            'uptime_ms': uptime_ms,
+            'frame_count': fcount,
+            'scan_us': scan_us,
+            'tx_stalls': tx_stalls,
+            'cmd_drops': cmd_drops,
+            'alive_mask': alive,
+            'mode_flags': flags,
+            'settle_us': settle_us,
+        })
+
+    def _emit_bench(self, payload):
+        """Unpack and emit one benchmark results payload."""
+        iters = struct.unpack_from('<H', payload)[0]
+        vals = struct.unpack_from(
+            f'<{3 * len(BENCH_TESTS)}I', payload, 4)
+        self.bench_received.emit({
+            'iterations': iters,
+            'tests': {name: vals[3 * i:3 * i + 3]
+                      for i, name in enumerate(BENCH_TESTS)},
+        })
+
+    def _dispatch_native(self, ev):
+        """Emit the signals for one event from the native decoder."""
+        if ev.type in (NativeDecoder.EV_FRAME, NativeDecoder.EV_PREVIEW):
+            if ev.meta:
+                self._handle_meta(ctypes.string_at(ev.meta, META_SIZE))
+            grid = np.ctypeslib.as_array(
+                ev.cells, shape=(ev.rows, ev.cols)).copy()
+            if ev.type == NativeDecoder.EV_FRAME:
+                # Keep the fallback parser's keyframe state coherent
+                self._frame_state = grid
+                if self.latency is not None:
+                    self.latency.mark_decode(
+                        grid, ctypes.string_at(ev.meta, META_SIZE)
+                        if ev.meta else None)
+            self.data_received.emit(grid)
+        elif ev.type == NativeDecoder.EV_STATS:
+            self._emit_stats(ctypes.string_at(ev.aux, ev.aux_len))
+        elif ev.type == NativeDecoder.EV_LOG:
+            text = ctypes.string_at(ev.aux, ev.aux_len) if ev.aux_len \
+                else b''
+            self.log_received.emit(text.decode('ascii', errors='replace'))
+        elif ev.type == NativeDecoder.EV_BENCH:
+            self._emit_bench(ctypes.string_at(ev.aux, ev.aux_len))
+
     def run(self):
         """Main thread loop - reads and parses binary packets."""
+        native = None
         try:
-            self.serial = serial.Serial(self.port, self.baudrate, timeout=1)
+            # The firmware always boots at the default rate; negotiate
+            # up from there if a faster profile was requested
+            self.serial = serial.Serial(self.port, DEFAULT_BAUD, timeout=1)
+            if self.baudrate != DEFAULT_BAUD:
+                self._switch_baud(self.baudrate)
             self.running = True
             buffer = bytearray()
-            
+            raw = bytearray()  # Undecoded bytes (COBS framing only)
+            last_valid = time.time()
+
+            # Native decode path: the C++ library does sync search, CRC
+            # and payload reconstruction; this thread then only moves
+            # bytes and emits signals. Absent library = Python parser.
+            native = NativeDecoder.load(self.cobs_framing)
+            last_link_emit = time.time()
+
             while self.running:
-                # Read available data
+                if native is not None:
+                    native.read_from(self.serial)
+
+                    if self.baudrate != DEFAULT_BAUD and \
+                            time.time() - last_valid > SYNC_LOSS_TIMEOUT_S:
+                        self.baudrate = DEFAULT_BAUD
+                        self.serial.baudrate = DEFAULT_BAUD
+                        self.serial.write(
+                            bytes([BAUD_PROFILES[DEFAULT_BAUD]]))
+                        self.serial.reset_input_buffer()
+                        native.reset()
+                        last_valid = time.time()
+
+                    while (ev := native.poll()) is not None:
+                        last_valid = time.time()
+                        if not self._baud_confirmed:
+                            self._baud_confirmed = True
+                            self.serial.write(bytes([CMD_BAUD_CONFIRM]))
+                        self._dispatch_native(ev)
+
+                    if time.time() - last_link_emit >= 1.0:
+                        last_link_emit = time.time()
+                        self.link_stats_received.emit(native.link_stats())
+
+                    time.sleep(0.001)
+                    continue
+
+                # Read available data; with COBS framing, split on the
+                # 0x00 delimiters and decode whole chunks into the
+                # packet buffer so boundaries are always exact
                 if self.serial.in_waiting:
-                    buffer.extend(self.serial.read(self.serial.in_waiting))
+                    data = self.serial.read(self.serial.in_waiting)
+                    if self.cobs_framing:
+                        raw.extend(data)
+                        while (end := raw.find(COBS_DELIMITER)) != -1:
+                            decoded = cobs_decode(bytes(raw[:end]))
+                            del raw[:end + 1]
+                            if decoded:
+                                buffer.extend(decoded)
+                    else:
+                        buffer.extend(data)
+
+                # Sync loss at a negotiated rate: the firmware reverts to
+                # the default on a missing confirm or RX framing errors,
+                # so rejoin it there and re-request the profile next run
+                if self.baudrate != DEFAULT_BAUD and \
+                        time.time() - last_valid > SYNC_LOSS_TIMEOUT_S:
+                    self.baudrate = DEFAULT_BAUD
+                    self.serial.baudrate = DEFAULT_BAUD
+                    self.serial.write(bytes([BAUD_PROFILES[DEFAULT_BAUD]]))
+                    self.serial.reset_input_buffer()
+                    buffer.clear()
+                    last_valid = time.time()
                 
-                # Look for sync bytes
-                while len(buffer) >= PACKET_SIZE:
+                # Look for sync bytes (full frames 0xAA 0x55, previews 0xAA 0x56)
+                # Parse whatever complete packets are in the buffer
+                # (the streamed row packet is the smallest at 76 bytes)
+                while len(buffer) >= ROW_PACKET_SIZE:
                     # Find sync pattern
                     sync_idx = -1
                     for i in range(len(buffer) - 1):
-                        if buffer[i] == SYNC_BYTE_1 and buffer[i+1] == SYNC_BYTE_2:
+                        if buffer[i] == SYNC_BYTE_1 and \
+                                buffer[i+1] in (SYNC_BYTE_2, SYNC_BYTE_2_PREVIEW,
+                                                SYNC_BYTE_2_PACKED,
+                                                SYNC_BYTE_2_DELTA,
+                                                SYNC_BYTE_2_RLE,
+                                                SYNC_BYTE_2_STATS,
+                                                SYNC_BYTE_2_AGG,
+                                                SYNC_BYTE_2_LOG,
+                                                SYNC_BYTE_2_BENCH,
+                                                SYNC_BYTE_2_ROW,
+                                                SYNC_BYTE_2_FIELD):
                             sync_idx = i
                             break
-                    
+
                     if sync_idx == -1:
                         buffer = buffer[-1:]
                         break
-                    
+
                     if sync_idx > 0:
                         buffer = buffer[sync_idx:]
-                    
-                    if len(buffer) < PACKET_SIZE:
+
+                    is_preview = (buffer[1] == SYNC_BYTE_2_PREVIEW)
+                    is_packed = (buffer[1] == SYNC_BYTE_2_PACKED)
+                    is_delta = (buffer[1] == SYNC_BYTE_2_DELTA)
+                    is_rle = (buffer[1] == SYNC_BYTE_2_RLE)
+                    is_stats = (buffer[1] == SYNC_BYTE_2_STATS)
+                    is_agg = (buffer[1] == SYNC_BYTE_2_AGG)
+                    is_log = (buffer[1] == SYNC_BYTE_2_LOG)
+                    is_bench = (buffer[1] == SYNC_BYTE_2_BENCH)
+                    is_row = (buffer[1] == SYNC_BYTE_2_ROW)
+                    is_field = (buffer[1] == SYNC_BYTE_2_FIELD)
+                    if is_log:
+                        # Variable length: the text length follows the
+                        # sync; the text is padded to a word boundary
+                        if len(buffer) < HEADER_SIZE + LOG_HDR_SIZE:
+                            break
+                        text_len = struct.unpack_from('<H', buffer,
+                                                      HEADER_SIZE)[0]
+                        payload_size = LOG_HDR_SIZE + ((text_len + 3) & ~3)
+                        packet_size = HEADER_SIZE + payload_size + FOOTER_SIZE
+                    elif is_agg:
+                        # Variable length: frame count and per-frame unit
+                        # size follow the sync; units carry their own
+                        # metadata, so there is no trailing meta block
+                        if len(buffer) < HEADER_SIZE + AGG_HDR_SIZE:
+                            break
+                        agg_count, _, agg_unit = struct.unpack_from(
+                            '<BBH', buffer, HEADER_SIZE)
+                        payload_size = AGG_HDR_SIZE + agg_count * agg_unit
+                        packet_size = HEADER_SIZE + payload_size + FOOTER_SIZE
+                    elif is_stats:
+                        packet_size, payload_size = (STATS_PACKET_SIZE,
+                                                     STATS_PAYLOAD_SIZE)
+                    elif is_bench:
+                        packet_size, payload_size = (BENCH_PACKET_SIZE,
+                                                     BENCH_PAYLOAD_SIZE)
+                    elif is_row:
+                        packet_size, payload_size = (ROW_PACKET_SIZE,
+                                                     ROW_PAYLOAD_SIZE)
+                    elif is_field:
+                        packet_size, payload_size = (FIELD_PACKET_SIZE,
+                                                     FIELD_PAYLOAD_SIZE)
+                    elif is_rle:
+                        # Variable length: the encoded size follows the
+                        # sync; tokens are padded to a word boundary
+                        if len(buffer) < HEADER_SIZE + RLE_HDR_SIZE:
+                            break
+                        enc_len = struct.unpack_from('<H', buffer,
+                                                     HEADER_SIZE)[0]
+                        payload_size = RLE_HDR_SIZE + ((enc_len + 3) & ~3)
+                        packet_size = (HEADER_SIZE + payload_size
+                                       + META_SIZE + FOOTER_SIZE)
+                    elif is_preview:
+                        packet_size, payload_size = PREVIEW_PACKET_SIZE, PREVIEW_PAYLOAD_SIZE
+                    elif is_packed:
+                        packet_size, payload_size = PACKED_PACKET_SIZE, PACKED_PAYLOAD_SIZE
+                    elif is_delta:
+                        # Variable length: the change count follows the sync
+                        if len(buffer) < HEADER_SIZE + DELTA_HDR_SIZE:
+                            break
+                        n_changed = struct.unpack_from('<H', buffer, HEADER_SIZE)[0]
+                        payload_size = DELTA_HDR_SIZE + 4 * n_changed
+                        packet_size = HEADER_SIZE + payload_size + META_SIZE + FOOTER_SIZE
+                    else:
+                        packet_size, payload_size = PACKET_SIZE, PAYLOAD_SIZE
+                    # Full frames carry a metadata block; the CRC covers
+                    # payload + metadata
+                    meta_size = 0 if (is_preview or is_stats or is_agg
+                                      or is_log or is_bench
+                                      or is_row) else META_SIZE
+
+                    if len(buffer) < packet_size:
                         break
-                    
-                    packet = buffer[:PACKET_SIZE]
-                    buffer = buffer[PACKET_SIZE:]
-                    
-                    payload = packet[HEADER_SIZE:HEADER_SIZE + PAYLOAD_SIZE]
-                    
-                    expected_checksum = struct.unpack('<H', 
-                        packet[HEADER_SIZE + PAYLOAD_SIZE:HEADER_SIZE + PAYLOAD_SIZE + 2])[0]
-                    actual_checksum = sum(payload) & 0xFFFF
-                    
-                    if expected_checksum != actual_checksum:
+
+                    packet = buffer[:packet_size]
+                    buffer = buffer[packet_size:]
+
+                    payload = packet[HEADER_SIZE:HEADER_SIZE + payload_size]
+                    checked = packet[HEADER_SIZE:HEADER_SIZE + payload_size + meta_size]
+
+                    expected_crc = struct.unpack('<I',
+                        packet[HEADER_SIZE + payload_size + meta_size:
+                               HEADER_SIZE + payload_size + meta_size + 4])[0]
+
+                    if expected_crc != (zlib.crc32(checked) & 0xFFFFFFFF):
+                        continue
+
+                    last_valid = time.time()
+                    if not self._baud_confirmed:
+                        # First valid frame at the negotiated rate: tell
+                        # the firmware to stay there
+                        self._baud_confirmed = True
+                        self.serial.write(bytes([CMD_BAUD_CONFIRM]))
+
+                    if is_stats:
+                        self._emit_stats(payload)
+                        continue
+
+                    if is_log:
+                        text = bytes(payload[LOG_HDR_SIZE:
+                                             LOG_HDR_SIZE + text_len])
+                        self.log_received.emit(
+                            text.decode('ascii', errors='replace'))
+                        continue
+
+                    if is_bench:
+                        self._emit_bench(payload)
+                        continue
+
+                    if is_agg:
+                        # One CRC-checked super-packet carrying K
+                        # payload+metadata units: decode each in turn
+                        for k in range(agg_count):
+                            start = AGG_HDR_SIZE + k * agg_unit
+                            unit = bytes(payload[start:start + agg_unit])
+                            self._handle_meta(unit[-META_SIZE:])
+                            grid_data = self._decode_frame_payload(
+                                unit[:-META_SIZE])
+                            self._frame_state = grid_data.copy()
+                            self.data_received.emit(grid_data)
+                        continue
+
+                    if is_row:
+                        # Patch the streamed row into the reconstruction
+                        # state and refresh immediately - the row-by-row
+                        # update is the point of the mode
+                        row = payload[0]
+                        if row < GRID_ROWS:
+                            self._frame_state[row] = struct.unpack_from(
+                                f'<{GRID_COLS}H', payload, ROW_HDR_SIZE)
+                        self.data_received.emit(self._frame_state.copy())
                         continue
-                    
-                    values = struct.unpack(f'<{GRID_TOTAL}H', payload)
-                    grid_data = np.array(values, dtype=np.uint16).reshape(GRID_ROWS, GRID_COLS)
-                    
+
+                    if not is_preview:
+                        self._handle_meta(
+                            packet[HEADER_SIZE + payload_size:
+                                   HEADER_SIZE + payload_size + META_SIZE])
+
+                    if is_field:
+                        # Merge this parity's rows into the reconstruction
+                        # state and refresh the whole grid - each field is
+                        # half the bytes of a frame, so the heatmap runs at
+                        # twice the full-frame rate
+                        parity = payload[0] & 1
+                        cells = struct.unpack_from(
+                            f'<{FIELD_ROWS * GRID_COLS}H', payload,
+                            FIELD_HDR_SIZE)
+                        for k in range(FIELD_ROWS):
+                            self._frame_state[parity + 2 * k] = \
+                                cells[k * GRID_COLS:(k + 1) * GRID_COLS]
+                        self.data_received.emit(self._frame_state.copy())
+                        continue
+
+                    if is_delta:
+                        # Apply changed cells to the reconstruction state;
+                        # full frames (periodic keyframes) resync it below
+                        pairs = struct.unpack(f'<{2 * n_changed}H',
+                                              payload[DELTA_HDR_SIZE:])
+                        for k in range(n_changed):
+                            idx, val = pairs[2 * k], pairs[2 * k + 1]
+                            self._frame_state.flat[idx] = val
+                        grid_data = self._frame_state.copy()
+                        self.data_received.emit(grid_data)
+                        continue
+
+                    if is_rle:
+                        # Expand (zero-run, literal-count, literals...)
+                        # tokens; the frame is complete, so it doubles
+                        # as a delta keyframe
+                        vals = np.zeros(GRID_TOTAL, dtype=np.uint16)
+                        body = payload[RLE_HDR_SIZE:RLE_HDR_SIZE + enc_len]
+                        pos = 0
+                        cell = 0
+                        while pos + 4 <= len(body) and cell <= GRID_TOTAL:
+                            zeros, lits = struct.unpack_from('<HH', body, pos)
+                            pos += 4
+                            cell += zeros
+                            if cell + lits > GRID_TOTAL or \
+                                    pos + 2 * lits > len(body):
+                                break
+                            if lits:
+                                vals[cell:cell + lits] = struct.unpack_from(
+                                    f'<{lits}H', body, pos)
+                                cell += lits
+                                pos += 2 * lits
+                        grid_data = vals.reshape(GRID_ROWS, GRID_COLS)
+                        self._frame_state = grid_data.copy()
+                        self.data_received.emit(grid_data)
+                        continue
+
+                    if is_preview:
+                        values = struct.unpack(f'<{PREVIEW_TOTAL}H', payload)
+                        preview = np.array(values, dtype=np.uint16).reshape(
+                            PREVIEW_ROWS, PREVIEW_COLS)
+                        # Nearest-neighbor upsample so downstream display
+                        # and detectors see the usual 16x32 shape
+                        grid_data = np.repeat(np.repeat(preview, 2, axis=0), 2, axis=1)
+                    else:
+                        grid_data = self._decode_frame_payload(bytes(payload))
+
+                    if not is_preview:
+                        # Full and packed frames double as delta keyframes
+                        self._frame_state = grid_data.copy()
                     self.data_received.emit(grid_data)
                 
                 time.sleep(0.001)
@@ -150,6 +1250,8 @@ class SerialReader(QThread):
         except Exception as e:
             self.error_occurred.emit(str(e))
         finally:
+            if native is not None:
+                native.close()
             if self.serial and self.serial.is_open:
                 self.serial.close()
     
@@ -174,7 +1276,7 @@ class CalibrationDialog(QDialog):
         self.setMinimumSize(500, 300)
         self.setModal(True)
         
-        self.detector = SpineDetector()
+        self.detector = make_spine_detector(GRID_ROWS, GRID_COLS)
         self._is_recording = False
         
         self._build_ui()
@@ -488,9 +1590,16 @@ class GridVisualizerWindow(QMainWindow):
         self.serial_reader: Optional[SerialReader] = None
         
         # Spine detection
-        self.spine_detector = SpineDetector()
-        self.movement_tracker = MovementTracker()
-        
+        self.spine_detector = make_spine_detector(GRID_ROWS, GRID_COLS)
+        self.movement_tracker = make_movement_tracker(GRID_ROWS, GRID_COLS)
+        # Fast feedback path: centroid history from the frame meta
+        # blocks, windowed like MovementTracker (see _on_meta_received)
+        self._meta_track = deque(maxlen=10)
+        self.upsampler = NativeUpsampler.load(GRID_ROWS, GRID_COLS,
+                                              UPSAMPLE_FACTOR)
+        # Latency probe, created lazily on first use (needs the library)
+        self.latency_harness: Optional[LatencyHarness] = None
+
         # Calibration dialog reference
         self.calibration_dialog: Optional[CalibrationDialog] = None
         
@@ -585,41 +1694,54 @@ class GridVisualizerWindow(QMainWindow):
         
         left_panel.addLayout(title_layout)
         
-        # Heatmap with overlay
-        self.heatmap_widget = pg.PlotWidget()
-        self.heatmap_widget.setAspectLocked(True)
-        self.heatmap_widget.hideAxis('left')
-        self.heatmap_widget.hideAxis('bottom')
-        
-        # Create ImageItem for heatmap
-        self.heatmap_image = pg.ImageItem()
-        self.heatmap_widget.addItem(self.heatmap_image)
-        
-        # Set colormap
-        colors = [
-            (0, 0, 128),      # Dark blue
-            (0, 0, 255),      # Blue
-            (0, 255, 255),    # Cyan
-            (0, 255, 0),      # Green
-            (255, 255, 0),    # Yellow
-            (255, 128, 0),    # Orange
-            (255, 0, 0),      # Red
-        ]
-        positions = np.linspace(0, 1, len(colors))
-        colormap = pg.ColorMap(positions, colors)
-        self.heatmap_image.setLookupTable(colormap.getLookupTable())
-        self.heatmap_image.setLevels([0, 4095])
-        
-        # Initial empty image
-        self.heatmap_image.setImage(self.grid_data.T)
-        
-        # Add landmark overlay
-        self.landmark_overlay = LandmarkOverlay()
-        self.heatmap_widget.addItem(self.landmark_overlay)
-        
-        # Click handler
-        self.heatmap_widget.scene().sigMouseClicked.connect(self._on_heatmap_click)
-        
+        # Heatmap with overlay. GRID_GUI_GL=1 opts into the native
+        # OpenGL renderer (grid texture + fragment-shader colormap +
+        # overlay geometry), which stays smooth on integrated graphics;
+        # the pyqtgraph path below remains the default and the fallback
+        gl_bridge = (NativeHeatmapGL.load()
+                     if os.environ.get('GRID_GUI_GL') == '1'
+                     and GLHeatmapWidget is not None else None)
+        if gl_bridge:
+            self.gl_heatmap = GLHeatmapWidget(gl_bridge, GRID_ROWS,
+                                              GRID_COLS)
+            self.heatmap_widget = self.gl_heatmap
+            self.heatmap_image = None
+            # Same set_landmarks/highlight surface as LandmarkOverlay
+            self.landmark_overlay = self.gl_heatmap
+            self.gl_heatmap.cell_clicked.connect(self._on_cell_selected)
+        else:
+            self.gl_heatmap = None
+            self.heatmap_widget = pg.PlotWidget()
+            self.heatmap_widget.setAspectLocked(True)
+            self.heatmap_widget.hideAxis('left')
+            self.heatmap_widget.hideAxis('bottom')
+
+            # Create ImageItem for heatmap. When the native upsampler is
+            # available the item carries a scale-down transform so the
+            # higher-resolution image still spans grid coordinates and the
+            # landmark overlay / click handling stay unchanged.
+            self.heatmap_image = pg.ImageItem()
+            if self.upsampler:
+                inv = 1.0 / self.upsampler.factor
+                self.heatmap_image.setTransform(QTransform().scale(inv, inv))
+            self.heatmap_widget.addItem(self.heatmap_image)
+
+            # Set colormap
+            positions = np.linspace(0, 1, len(HEATMAP_COLORS))
+            colormap = pg.ColorMap(positions, HEATMAP_COLORS)
+            self.heatmap_image.setLookupTable(colormap.getLookupTable())
+            self.heatmap_image.setLevels([0, 4095])
+
+            # Initial empty image
+            self.heatmap_image.setImage(self._display_image(self.grid_data))
+
+            # Add landmark overlay
+            self.landmark_overlay = LandmarkOverlay()
+            self.heatmap_widget.addItem(self.landmark_overlay)
+
+            # Click handler
+            self.heatmap_widget.scene().sigMouseClicked.connect(self._on_heatmap_click)
+
         left_panel.addWidget(self.heatmap_widget, stretch=1)
         
         # Legend
@@ -677,6 +1799,13 @@ class GridVisualizerWindow(QMainWindow):
         self.refresh_btn.setMaximumWidth(40)
         self.refresh_btn.clicked.connect(self._refresh_ports)
         port_layout.addWidget(self.refresh_btn)
+
+        port_layout.addWidget(QLabel("Baud:"))
+        self.baud_combo = QComboBox()
+        for rate in BAUD_PROFILES:
+            self.baud_combo.addItem(str(rate), rate)
+        self.baud_combo.setMaximumWidth(100)
+        port_layout.addWidget(self.baud_combo)
         controls_layout.addLayout(port_layout)
         
         # Connect/Demo buttons
@@ -707,6 +1836,29 @@ class GridVisualizerWindow(QMainWindow):
         self.save_calib_btn.setMaximumWidth(60)
         calib_layout.addWidget(self.save_calib_btn)
         controls_layout.addLayout(calib_layout)
+
+        # Device commands (require a live connection)
+        self.zero_grid_btn = QPushButton("⚖ Zero Grid")
+        self.zero_grid_btn.clicked.connect(self._zero_grid)
+        controls_layout.addWidget(self.zero_grid_btn)
+
+        stream_layout = QHBoxLayout()
+        self.stream_btn = QPushButton("⏸ Pause Stream")
+        self.stream_btn.clicked.connect(self._toggle_stream)
+        stream_layout.addWidget(self.stream_btn)
+
+        self.snapshot_btn = QPushButton("📸 Frame")
+        self.snapshot_btn.clicked.connect(self._request_frame)
+        stream_layout.addWidget(self.snapshot_btn)
+
+        self.bench_btn = QPushButton("⏱ Bench")
+        self.bench_btn.clicked.connect(self._run_benchmark)
+        stream_layout.addWidget(self.bench_btn)
+
+        self.latency_btn = QPushButton("⏲ Latency")
+        self.latency_btn.clicked.connect(self._run_latency_probe)
+        stream_layout.addWidget(self.latency_btn)
+        controls_layout.addLayout(stream_layout)
         
         right_panel.addWidget(controls_group)
         
@@ -721,8 +1873,41 @@ class GridVisualizerWindow(QMainWindow):
         stats_layout.addWidget(self.fps_label)
         stats_layout.addWidget(self.max_label)
         stats_layout.addWidget(self.avg_label)
-        
+
         right_panel.addWidget(stats_group)
+
+        # Diagnostics (fed by the firmware's 1 Hz heartbeat packet)
+        diag_group = QGroupBox("Diagnostics")
+        diag_layout = QVBoxLayout(diag_group)
+
+        self.uptime_label = QLabel("Uptime: -")
+        self.scan_time_label = QLabel("Scan time: -")
+        self.link_label = QLabel("Link stalls: -")
+        self.chips_label = QLabel("ADC chips: -")
+        self.modes_label = QLabel("Modes: -")
+        self.prof_label = QLabel("Phases: -")
+        self.prof_label.setWordWrap(True)
+        self.jitter_label = QLabel("Jitter: -")
+        self.jitter_label.setWordWrap(True)
+        self.host_link_label = QLabel("Host link: -")
+        self.host_link_label.setWordWrap(True)
+        self.log_label = QLabel("Log: -")
+        self.log_label.setWordWrap(True)
+        self.bench_label = QLabel("Bench: -")
+        self.bench_label.setWordWrap(True)
+
+        diag_layout.addWidget(self.uptime_label)
+        diag_layout.addWidget(self.scan_time_label)
+        diag_layout.addWidget(self.link_label)
+        diag_layout.addWidget(self.chips_label)
+        diag_layout.addWidget(self.modes_label)
+        diag_layout.addWidget(self.prof_label)
+        diag_layout.addWidget(self.jitter_label)
+        diag_layout.addWidget(self.host_link_label)
+        diag_layout.addWidget(self.log_label)
+        diag_layout.addWidget(self.bench_label)
+
+        right_panel.addWidget(diag_group)
         right_panel.addStretch()
         
         main_layout.addLayout(right_panel, stretch=1)
@@ -755,8 +1940,14 @@ class GridVisualizerWindow(QMainWindow):
                 self.status_bar.showMessage("No valid port selected")
                 return
             
-            self.serial_reader = SerialReader(port)
+            self.serial_reader = SerialReader(port, self.baud_combo.currentData())
             self.serial_reader.data_received.connect(self._on_data_received)
+            self.serial_reader.meta_received.connect(self._on_meta_received)
+            self.serial_reader.stats_received.connect(self._on_stats_received)
+            self.serial_reader.log_received.connect(self._on_log_received)
+            self.serial_reader.bench_received.connect(self._on_bench_received)
+            self.serial_reader.link_stats_received.connect(
+                self._on_link_stats_received)
             self.serial_reader.error_occurred.connect(self._on_serial_error)
             self.serial_reader.start()
             
@@ -796,26 +1987,292 @@ class GridVisualizerWindow(QMainWindow):
         
         self._on_data_received(data)
     
+    def _zero_grid(self):
+        """Ask the firmware to re-learn its pressure baseline."""
+        if self.serial_reader and self.serial_reader.running:
+            self.serial_reader.send_command(CMD_CALIBRATE)
+            self.status_bar.showMessage(
+                "Zeroing grid - keep it untouched for a moment...")
+        else:
+            self.status_bar.showMessage("Connect first to zero the grid")
+
+    def _toggle_stream(self):
+        """Pause or resume free-running acquisition on the device."""
+        if not (self.serial_reader and self.serial_reader.running):
+            self.status_bar.showMessage("Connect first to control streaming")
+            return
+        self.streaming = not getattr(self, 'streaming', True)
+        self.serial_reader.send_command(
+            CMD_STREAM, bytes([1 if self.streaming else 0]))
+        self.stream_btn.setText(
+            "⏸ Pause Stream" if self.streaming else "▶ Resume Stream")
+        self.status_bar.showMessage(
+            "Streaming resumed" if self.streaming
+            else "Streaming paused - device idle")
+
+    def _request_frame(self):
+        """Ask the idle device for a single frame."""
+        if self.serial_reader and self.serial_reader.running:
+            self.serial_reader.send_command(CMD_SNAPSHOT)
+        else:
+            self.status_bar.showMessage("Connect first to request a frame")
+
+    def _run_benchmark(self):
+        """Run the firmware's on-target microbenchmark suite."""
+        if self.serial_reader and self.serial_reader.running:
+            self.serial_reader.send_command(
+                CMD_BENCHMARK, struct.pack('<H', 0))
+            self.status_bar.showMessage(
+                "Benchmark running on target (stream stalls briefly)...")
+        else:
+            self.status_bar.showMessage("Connect first to run the benchmark")
+
+    def _on_bench_received(self, bench: dict):
+        """Render per-primitive cycle counts from the benchmark packet."""
+        tests = bench.get('tests', {})
+        if not tests:
+            return
+        self.bench_label.setText(
+            f"Bench ({bench['iterations']} iters, avg cycles): "
+            + "  ".join(f"{name} {avg}"
+                        for name, (_, avg, _) in tests.items()))
+        self.bench_label.setToolTip("\n".join(
+            f"{name}: min {mn} / avg {avg} / max {mx} cycles"
+            for name, (mn, avg, mx) in tests.items()))
+        self.status_bar.showMessage("Benchmark complete")
+
+    # Marker value for the latency probe: high enough to survive the
+    # display threshold, and matched on its top 12 bits so the packed
+    # wire format cannot strip it (see grid_latency.h)
+    LATENCY_MARKER = 0x0D30
+
+    def _run_latency_probe(self):
+        """Measure touch-to-pixel latency with a firmware-injected cell.
+
+        Arms the native harness on a centre cell, then asks the firmware
+        to plant the marker value there during its next scan. The decode
+        (SerialReader), process/render (_on_data_received) and present
+        (paint) taps each stamp the marker's first appearance; the
+        completed report is collected in _on_data_received.
+        """
+        if not (self.serial_reader and self.serial_reader.running):
+            self.status_bar.showMessage("Connect first to probe latency")
+            return
+        if self.latency_harness is None:
+            self.latency_harness = LatencyHarness.load(GRID_ROWS, GRID_COLS)
+            if self.latency_harness is None:
+                self.status_bar.showMessage(
+                    "Latency probe needs the native library "
+                    "(build host/ first)")
+                return
+            self.serial_reader.latency = self.latency_harness
+            if self.gl_heatmap:
+                self.gl_heatmap.latency = self.latency_harness
+        row, col = GRID_ROWS // 2, GRID_COLS // 2
+        self.latency_harness.arm(row, col, self.LATENCY_MARKER)
+        self.serial_reader.send_command(
+            CMD_INJECT, struct.pack('<BBH', row, col, self.LATENCY_MARKER))
+        self.status_bar.showMessage("Latency probe armed...")
+
+    def _show_latency_report(self, rep):
+        """Render a completed latency probe in the status bar."""
+        msg = (f"Latency: total {rep.total_ms:.1f} ms  "
+               f"(arm→decode {rep.arm_to_decode_ms:.1f}, "
+               f"process {rep.decode_to_process_ms:.1f}, "
+               f"render {rep.process_to_render_ms:.1f}, "
+               f"present {rep.render_to_present_ms:.1f})")
+        if rep.fw_scan_ms and rep.fw_inject_ms:
+            fw = (rep.fw_scan_ms - rep.fw_inject_ms) & 0xFFFFFFFF
+            msg += f"  firmware residency {fw} ms"
+        self.status_bar.showMessage(msg, 15000)
+
+    def _on_meta_received(self, meta: dict):
+        """Cache the firmware-computed frame summary and count drops."""
+        prev = getattr(self, 'frame_meta', None)
+        if prev and 'seq' in prev:
+            gap = (meta['seq'] - prev['seq']) & 0xFFFFFFFF
+            if 1 < gap < 0x80000000:
+                self.frames_dropped = \
+                    getattr(self, 'frames_dropped', 0) + gap - 1
+        self.frame_meta = meta
+
+        # Fast feedback path: the meta block already carries peak and
+        # centroid, and this signal lands before the frame data does,
+        # so the pressure/speed widgets update here - ahead of the
+        # dead-column fixup, heatmap upload and tracker work that
+        # _on_data_received has to get through first
+        self.feedback_panel.update_pressure(meta['peak'])
+        speed = 0.0
+        if meta['total_force'] < 100:  # Matches MovementTracker gating
+            self._meta_track.clear()
+        else:
+            self._meta_track.append((meta['centroid'],
+                                     meta['timestamp_ms'] / 1000.0))
+            if len(self._meta_track) >= 2:
+                (p1, t1), (p2, t2) = (self._meta_track[0],
+                                      self._meta_track[-1])
+                dt = t2 - t1
+                if dt > 0.01:
+                    speed = math.hypot(p2[0] - p1[0],
+                                       p2[1] - p1[1]) / dt
+        self.feedback_panel.update_speed(speed)
+        self._meta_drove_feedback = True
+
+    def _on_stats_received(self, stats: dict):
+        """Render the firmware heartbeat in the diagnostics panel."""
+        uptime_s = stats['uptime_ms'] / 1000.0
+        self.uptime_label.setText(
+            f"Uptime: {int(uptime_s // 60)}m {int(uptime_s % 60)}s")
+        self.scan_time_label.setText(
+            f"Scan time: {stats['scan_us'] / 1000.0:.1f} ms "
+            f"(settle {stats['settle_us']} µs)")
+        self.link_label.setText(
+            f"Link stalls: {stats['tx_stalls']}  "
+            f"cmd drops: {stats['cmd_drops']}")
+        alive = stats['alive_mask']
+        self.chips_label.setText(
+            f"ADC chips: {bin(alive).count('1')}/8 (mask {alive:#04x})")
+        flags = stats['mode_flags']
+        names = ['packed', 'delta', 'cobs', 'rle', 'adaptive', 'median']
+        active = [n for i, n in enumerate(names) if flags & (1 << i)]
+        if not flags & 0x40:
+            active.append('idle')
+        self.modes_label.setText(
+            "Modes: " + (", ".join(active) if active else "raw stream"))
+        # Per-phase averages (min/avg/max are in the tooltip) show where
+        # each frame's time actually goes
+        profile = stats.get('profile', {})
+        if profile:
+            self.prof_label.setText("Phases (µs avg): " + "  ".join(
+                f"{name} {avg}" for name, (_, avg, _) in profile.items()))
+            self.prof_label.setToolTip("\n".join(
+                f"{name}: min {mn} / avg {avg} / max {mx} µs"
+                for name, (mn, avg, mx) in profile.items()))
+        # Pacing jitter: fraction of frames whose interval deviated by
+        # <100 µs from the previous one - 100% means deterministic pacing
+        jitter = stats.get('jitter')
+        if jitter:
+            total = sum(jitter)
+            tight = 100.0 * jitter[0] / total if total else 0.0
+            self.jitter_label.setText(
+                f"Jitter: {tight:.0f}% <100 µs ({total} frames)")
+            edges = ['<%d' % b for b in JITTER_BOUNDS_US] + \
+                    ['≥%d' % JITTER_BOUNDS_US[-1]]
+            self.jitter_label.setToolTip("\n".join(
+                f"{edge} µs: {count}"
+                for edge, count in zip(edges, jitter)))
+        # Frame-rate governor: worst-case touch-to-full-rate latency of
+        # the most recent idle-to-active transition
+        ramp = stats.get('gov_ramp_ms', 0)
+        if ramp:
+            self.scan_time_label.setText(
+                self.scan_time_label.text() + f"  ramp ≤{ramp} ms")
+
+    def _on_link_stats_received(self, stats: dict):
+        """Render the host-side link quality (native decoder counters)."""
+        self.host_link_label.setText(
+            f"Host link: {stats['frames']} frames  "
+            f"CRC {stats['crc_errors']}  resync {stats['resyncs']} "
+            f"(recovered {stats['recovered_frames']})  "
+            f"missed {stats['frames_missed']} in {stats['seq_gaps']} gaps")
+        self.host_link_label.setToolTip(
+            "Inter-arrival percentiles:\n"
+            f"p50 {stats['arrival_p50_ms']:.1f} ms\n"
+            f"p90 {stats['arrival_p90_ms']:.1f} ms\n"
+            f"p99 {stats['arrival_p99_ms']:.1f} ms")
+
+    def _on_log_received(self, text: str):
+        """Show the most recent complete firmware log line."""
+        if self.latency_harness is not None:
+            self.latency_harness.note_log(text)
+        self._log_partial = getattr(self, '_log_partial', '') + text
+        *lines, self._log_partial = self._log_partial.split('\n')
+        lines = [ln.strip() for ln in lines if ln.strip()]
+        if lines:
+            self.log_label.setText(f"Log: {lines[-1]}")
+
+    def _display_image(self, data: np.ndarray) -> np.ndarray:
+        """Frame as shown: bicubically upsampled when the library is
+        present, the raw grid otherwise (transposed for pyqtgraph)."""
+        if self.upsampler:
+            return self.upsampler.apply(data).T
+        return data.T
+
+    def _interpolate_dead_columns(self, data: np.ndarray) -> np.ndarray:
+        """Fill columns the firmware flagged dead (open/shorted traces)
+        with the mean of their nearest alive neighbors. The firmware
+        zeroes them on the wire; left alone they would read as permanent
+        no-contact stripes and skew the centroid and spine detection."""
+        meta = getattr(self, 'frame_meta', None)
+        dead = meta.get('dead_cols', 0) if meta else 0
+        if not dead:
+            return data
+        data = data.copy()
+        cols = data.shape[1]
+        alive = [c for c in range(cols) if not (dead & (1 << c))]
+        if not alive:
+            return data
+        for c in range(cols):
+            if not (dead & (1 << c)):
+                continue
+            left = max((a for a in alive if a < c), default=None)
+            right = min((a for a in alive if a > c), default=None)
+            if left is not None and right is not None:
+                data[:, c] = (data[:, left].astype(np.uint32)
+                              + data[:, right]) // 2
+            else:
+                data[:, c] = data[:, left if left is not None else right]
+        return data
+
     def _on_data_received(self, data: np.ndarray):
         """Handle received grid data."""
+        lh = self.latency_harness
+        if lh is not None:
+            lh.mark_process(data)
+        data = self._interpolate_dead_columns(data)
         self.grid_data = data
         self.frame_count += 1
         current_time = time.time()
-        
-        # Update heatmap
-        self.heatmap_image.setImage(data.T, autoLevels=False)
+
+        # Update heatmap: the GL widget takes the raw grid (the GPU
+        # interpolates for display), the pyqtgraph item the upsample
+        if self.gl_heatmap:
+            self.gl_heatmap.set_frame(data)
+            if lh is not None:
+                lh.mark_render(data)
+        else:
+            self.heatmap_image.setImage(self._display_image(data),
+                                        autoLevels=False)
+            # pyqtgraph paints synchronously enough that render and
+            # present collapse into one stamp on this path
+            if lh is not None:
+                lh.mark_render(data)
+                lh.mark_present()
+        if lh is not None:
+            rep = lh.report()
+            if rep is not None:
+                self._show_latency_report(rep)
         
         # If calibrating, send frame to dialog
         if self.calibration_dialog and self.calibration_dialog._is_recording:
             self.calibration_dialog.add_frame(data)
         
-        # Update movement tracker
-        pos, speed = self.movement_tracker.update(data, current_time)
-        
-        # Update feedback
-        max_pressure = int(np.max(data))
-        self.feedback_panel.update_pressure(max_pressure)
-        self.feedback_panel.update_speed(speed)
+        # Update movement tracker with the firmware scan timestamp when
+        # available: speed stays correct under variable frame pacing
+        # (adaptive scan, ROI, delta mode) where host arrival time lags
+        meta = getattr(self, 'frame_meta', None)
+        track_time = (meta['timestamp_ms'] / 1000.0
+                      if meta and 'timestamp_ms' in meta else current_time)
+        pos, speed = self.movement_tracker.update(data, track_time)
+
+        # Update feedback; a frame that carried a meta block already
+        # drove the widgets from _on_meta_received (the fast path), so
+        # only meta-less frames (row streaming) update them here
+        max_pressure = meta['peak'] if meta else int(np.max(data))
+        if not getattr(self, '_meta_drove_feedback', False):
+            self.feedback_panel.update_pressure(max_pressure)
+            self.feedback_panel.update_speed(speed)
+        self._meta_drove_feedback = False
         
         # Get technique feedback if calibrated
         if pos and self.spine_detector.calibration.is_calibrated:
@@ -843,7 +2300,10 @@ class GridVisualizerWindow(QMainWindow):
             self.fps_label.setText(f"FPS: {fps:.1f}")
         
         self.max_label.setText(f"Max Value: {max_pressure}")
-        self.avg_label.setText(f"Avg Value: {np.mean(data):.0f}")
+        if meta:
+            self.avg_label.setText(f"Avg Value: {meta['total_force'] / GRID_TOTAL:.0f}")
+        else:
+            self.avg_label.setText(f"Avg Value: {np.mean(data):.0f}")
     
     def _on_serial_error(self, error: str):
         """Handle serial errors."""
@@ -857,12 +2317,16 @@ class GridVisualizerWindow(QMainWindow):
         mouse_point = self.heatmap_widget.plotItem.vb.mapSceneToView(pos)
         col = int(mouse_point.x())
         row = int(mouse_point.y())
-        
+
         if 0 <= row < GRID_ROWS and 0 <= col < GRID_COLS:
-            self.selected_row = row
-            self.selected_col = col
-            self.selected_label.setText(f"Selected: Row {row}, Col {col}")
-            self.waveform_history.clear()
+            self._on_cell_selected(row, col)
+
+    def _on_cell_selected(self, row: int, col: int):
+        """Switch the waveform to a clicked cell (both heatmap paths)."""
+        self.selected_row = row
+        self.selected_col = col
+        self.selected_label.setText(f"Selected: Row {row}, Col {col}")
+        self.waveform_history.clear()
     
     def _start_calibration(self):
         """Open calibration dialog."""
@@ -0,0 +1,282 @@
+"""
+================================================================================
+Native Spine Engine Bridge
+================================================================================
+
+ctypes bridge to the C++ spine detection engine in the host library
+(host/src/spine_engine.cpp). Exposes drop-in replacements for
+SpineDetector and MovementTracker: same methods, same return shapes,
+same calibration file format, so grid_gui.py can swap them in through
+the make_* factories without touching its call sites.
+
+The pure-Python classes in spine_detector.py remain the reference
+implementation and the fallback when the library has not been built.
+The native engine moves the per-frame work - centroid reductions,
+landmark search, Kalman updates - off the interpreter, which matters
+at wire rate and especially on the 40x40 grid.
+
+Author: Capstone Project
+Date: 2026-08-28
+================================================================================
+"""
+
+import ctypes
+from pathlib import Path
+from typing import List, Optional, Tuple
+
+import numpy as np
+
+from spine_detector import (
+    SpineDetector, MovementTracker, SpineCalibration, SpineLine,
+    SpinalLandmark, PalpationZones,
+)
+
+_LIB_NAMES = ('libgriddecode.so', 'libgriddecode.dylib', 'griddecode.dll')
+
+
+class _EngineLandmark(ctypes.Structure):
+    _fields_ = [('level', ctypes.c_char * 8),
+                ('type', ctypes.c_char * 24),
+                ('row', ctypes.c_float),
+                ('col', ctypes.c_float),
+                ('uncertainty', ctypes.c_float)]
+
+
+def _load_library() -> Optional[ctypes.CDLL]:
+    host_dir = Path(__file__).resolve().parent.parent / 'host'
+    for directory in (host_dir / 'build', Path(__file__).resolve().parent):
+        for name in _LIB_NAMES:
+            path = directory / name
+            if path.exists():
+                try:
+                    return _bind(ctypes.CDLL(str(path)))
+                except (OSError, AttributeError):
+                    continue
+    return None
+
+
+def _bind(lib: ctypes.CDLL) -> ctypes.CDLL:
+    lib.spine_engine_create.restype = ctypes.c_void_p
+    lib.spine_engine_create.argtypes = [ctypes.c_uint32, ctypes.c_uint32]
+    lib.spine_engine_destroy.argtypes = [ctypes.c_void_p]
+    lib.spine_engine_start_calibration.argtypes = [ctypes.c_void_p]
+    lib.spine_engine_add_calibration_frame.argtypes = [
+        ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16)]
+    lib.spine_engine_finalize_calibration.restype = ctypes.c_int
+    lib.spine_engine_finalize_calibration.argtypes = [
+        ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t]
+    lib.spine_engine_is_calibrated.restype = ctypes.c_int
+    lib.spine_engine_is_calibrated.argtypes = [ctypes.c_void_p]
+    lib.spine_engine_get_landmarks.restype = ctypes.c_int
+    lib.spine_engine_get_landmarks.argtypes = [
+        ctypes.c_void_p, ctypes.POINTER(_EngineLandmark), ctypes.c_int]
+    lib.spine_engine_get_spine_line.restype = ctypes.c_int
+    lib.spine_engine_get_spine_line.argtypes = [
+        ctypes.c_void_p, ctypes.POINTER(ctypes.c_int32),
+        ctypes.POINTER(ctypes.c_int32), ctypes.POINTER(ctypes.c_float)]
+    lib.spine_engine_update_landmark.argtypes = [
+        ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p,
+        ctypes.c_float, ctypes.c_float]
+    lib.spine_engine_nearest_landmark.restype = ctypes.c_int
+    lib.spine_engine_nearest_landmark.argtypes = [
+        ctypes.c_void_p, ctypes.c_float, ctypes.c_float,
+        ctypes.POINTER(_EngineLandmark), ctypes.POINTER(ctypes.c_float)]
+    lib.spine_engine_track.restype = ctypes.c_int
+    lib.spine_engine_track.argtypes = [
+        ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint16), ctypes.c_double,
+        ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_float),
+        ctypes.POINTER(ctypes.c_float)]
+    lib.spine_engine_save_calibration.restype = ctypes.c_int
+    lib.spine_engine_save_calibration.argtypes = [ctypes.c_void_p,
+                                                  ctypes.c_char_p]
+    lib.spine_engine_load_calibration.restype = ctypes.c_int
+    lib.spine_engine_load_calibration.argtypes = [ctypes.c_void_p,
+                                                  ctypes.c_char_p]
+    return lib
+
+
+_lib = _load_library()
+
+
+def _as_cells(frame: np.ndarray):
+    """Grid frame as a uint16 pointer the engine can read."""
+    arr = np.ascontiguousarray(frame, dtype=np.uint16)
+    return arr, arr.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
+
+
+class NativeSpineDetector:
+    """SpineDetector lookalike backed by the C++ engine.
+
+    Keeps a SpineCalibration mirror in sync with the engine so GUI code
+    that reads .calibration.landmarks / .spine_line keeps working and
+    overlays keep receiving real SpinalLandmark objects.
+    """
+
+    def __init__(self, rows: int, cols: int):
+        self._lib = _lib
+        self._eng = _lib.spine_engine_create(rows, cols)
+        if not self._eng:
+            raise OSError('spine_engine_create failed')
+        self.calibration = SpineCalibration()
+
+    def __del__(self):
+        eng = getattr(self, '_eng', None)
+        if eng:
+            self._lib.spine_engine_destroy(eng)
+            self._eng = None
+
+    # -- calibration -------------------------------------------------
+
+    def start_calibration(self):
+        self._lib.spine_engine_start_calibration(self._eng)
+        self.calibration = SpineCalibration()
+
+    def add_calibration_frame(self, frame: np.ndarray):
+        arr, ptr = _as_cells(frame)
+        self._lib.spine_engine_add_calibration_frame(self._eng, ptr)
+
+    def finalize_calibration(self) -> Tuple[bool, str]:
+        msg = ctypes.create_string_buffer(128)
+        ok = self._lib.spine_engine_finalize_calibration(
+            self._eng, msg, len(msg))
+        self._refresh_mirror()
+        return (bool(ok), msg.value.decode('utf-8', errors='replace'))
+
+    def _refresh_mirror(self):
+        """Rebuild the Python-visible calibration from engine state."""
+        cal = SpineCalibration()
+        start = ctypes.c_int32(0)
+        end = ctypes.c_int32(0)
+        coeff = (ctypes.c_float * 2)()
+        if self._lib.spine_engine_get_spine_line(
+                self._eng, ctypes.byref(start), ctypes.byref(end), coeff):
+            cal.spine_line = SpineLine(
+                start_row=start.value, end_row=end.value,
+                coefficients=(coeff[0], coeff[1]))
+        raw = (_EngineLandmark * 15)()
+        count = self._lib.spine_engine_get_landmarks(self._eng, raw, 15)
+        cal.landmarks = [
+            SpinalLandmark(
+                level=raw[i].level.decode('ascii'),
+                landmark_type=raw[i].type.decode('ascii'),
+                row=raw[i].row, col=raw[i].col,
+                uncertainty=raw[i].uncertainty)
+            for i in range(count)
+        ]
+        self.calibration = cal
+
+    # -- landmark queries --------------------------------------------
+
+    def update_landmark_estimate(self, level: str, landmark_type: str,
+                                 measured_row: float, measured_col: float):
+        self._lib.spine_engine_update_landmark(
+            self._eng, level.encode('ascii'), landmark_type.encode('ascii'),
+            measured_row, measured_col)
+        self._refresh_mirror()
+
+    def find_nearest_landmark(self, row: float,
+                              col: float) -> Tuple[Optional[SpinalLandmark],
+                                                   float]:
+        out = _EngineLandmark()
+        dist = ctypes.c_float(0)
+        if not self._lib.spine_engine_nearest_landmark(
+                self._eng, row, col, ctypes.byref(out), ctypes.byref(dist)):
+            return (None, float('inf'))
+        # Hand back the mirror's object so overlay highlighting by
+        # identity keeps working
+        for lm in self.calibration.landmarks:
+            if (lm.level == out.level.decode('ascii') and
+                    lm.landmark_type == out.type.decode('ascii')):
+                return (lm, dist.value)
+        return (None, float('inf'))
+
+    def get_technique_feedback(self, row: float, col: float,
+                               pressure: int) -> dict:
+        landmark, distance = self.find_nearest_landmark(row, col)
+        pressure_zone = PalpationZones.get_zone(pressure)
+        on_target = distance <= 3.0
+
+        if landmark is None:
+            feedback = "No calibration - please calibrate first"
+        elif on_target:
+            feedback = f"✓ On target: {landmark.level} ({landmark.landmark_type})"
+        else:
+            dr = landmark.row - row
+            dc = landmark.col - col
+            directions = []
+            if abs(dr) > 1:
+                directions.append("up" if dr < 0 else "down")
+            if abs(dc) > 1:
+                directions.append("left" if dc < 0 else "right")
+            direction_str = " and ".join(directions) if directions else ""
+            feedback = f"Move {direction_str} toward {landmark.level}"
+
+        return {
+            "nearest_landmark": landmark,
+            "distance_to_landmark": distance,
+            "on_target": on_target,
+            "pressure_zone": pressure_zone,
+            "feedback": feedback,
+        }
+
+    # -- persistence (engine-side, Python-compatible JSON) -----------
+
+    def save_calibration(self, filepath: str):
+        self._lib.spine_engine_save_calibration(
+            self._eng, str(filepath).encode())
+
+    def load_calibration(self, filepath: str) -> bool:
+        ok = bool(self._lib.spine_engine_load_calibration(
+            self._eng, str(filepath).encode()))
+        if ok:
+            self._refresh_mirror()
+        return ok
+
+
+class NativeMovementTracker:
+    """MovementTracker lookalike backed by the engine's centroid path."""
+
+    def __init__(self, rows: int, cols: int):
+        self._lib = _lib
+        self._eng = _lib.spine_engine_create(rows, cols)
+        if not self._eng:
+            raise OSError('spine_engine_create failed')
+
+    def __del__(self):
+        eng = getattr(self, '_eng', None)
+        if eng:
+            self._lib.spine_engine_destroy(eng)
+            self._eng = None
+
+    def update(self, frame: np.ndarray,
+               timestamp: float) -> Tuple[Optional[Tuple[float, float]],
+                                          float]:
+        arr, ptr = _as_cells(frame)
+        row = ctypes.c_float(0)
+        col = ctypes.c_float(0)
+        speed = ctypes.c_float(0)
+        if not self._lib.spine_engine_track(
+                self._eng, ptr, timestamp, ctypes.byref(row),
+                ctypes.byref(col), ctypes.byref(speed)):
+            return (None, 0.0)
+        return ((row.value, col.value), speed.value)
+
+
+def make_spine_detector(rows: int, cols: int):
+    """Native detector when the library is present, else pure Python."""
+    if _lib is not None:
+        try:
+            return NativeSpineDetector(rows, cols)
+        except OSError:
+            pass
+    return SpineDetector()
+
+
+def make_movement_tracker(rows: int, cols: int):
+    """Native tracker when the library is present, else pure Python."""
+    if _lib is not None:
+        try:
+            return NativeMovementTracker(rows, cols)
+        except OSError:
+            pass
+    return MovementTracker()
@@ -0,0 +1,169 @@
+/**
+ ******************************************************************************
+ * @file           : grid_decoder.h
+ * @brief          : Native frame decoder for the grid serial protocol
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Host-side C API for decoding the binary stream the firmware produces
+ * (wire format defined in Core/Inc/grid_scan.h). The GUI's Python reader
+ * thread used to scan for sync bytes, verify CRCs and struct-unpack 512
+ * cells per frame in pure Python; at 25+ fps that thread alone ate a
+ * core on the clinic laptops. This library does the byte work natively:
+ * sync search and resync, CRC-32 verification, COBS deframing, and
+ * reconstruction of every frame flavour (full, 12-bit packed, delta,
+ * RLE, aggregate, preview, streamed rows) into a contiguous uint16
+ * cell buffer.
+ *
+ * Usage is feed/poll: push raw serial bytes in with grid_decoder_feed,
+ * then drain events with grid_decoder_poll until it returns 0. Frame
+ * events hand out the decoder's own reconstruction buffer, so delta and
+ * RLE frames always surface as complete grids, exactly like the Python
+ * parser's keyframe state. Stats, log and benchmark packets are CRC
+ * checked here but handed back raw - they arrive at 1 Hz and the GUI
+ * already knows how to unpack them.
+ *
+ * Input is a single-producer single-consumer ring buffer. For bulk
+ * serial reads that skip the feed copy entirely, reserve space with
+ * grid_decoder_reserve, read straight into it, and publish with
+ * grid_decoder_commit; on platforms with a mirrored mapping the ring is
+ * lock-free across a producer thread and a consumer (poll) thread.
+ * Packets are parsed in place - the sync search resumes where it left
+ * off instead of rescanning, and meta/aux event pointers are views into
+ * the ring, kept alive until the next poll by deferred consumption.
+ *
+ * Built as a shared library (see host/CMakeLists.txt); the GUI loads it
+ * through ctypes and falls back to the pure-Python parser when it is
+ * not present.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_DECODER_H
+#define GRID_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Event types produced by grid_decoder_poll */
+enum {
+    GRID_DEC_EV_NONE    = 0,
+    GRID_DEC_EV_FRAME   = 1,  /**< Full-resolution frame (keyframe state) */
+    GRID_DEC_EV_PREVIEW = 2,  /**< Preview, upsampled to full resolution */
+    GRID_DEC_EV_STATS   = 3,  /**< Heartbeat stats, raw payload in aux */
+    GRID_DEC_EV_LOG     = 4,  /**< Firmware log text in aux */
+    GRID_DEC_EV_BENCH   = 5,  /**< Microbenchmark results, raw in aux */
+};
+
+/** Size of the frame metadata block (matches PACKET_META_SIZE) */
+#define GRID_DEC_META_SIZE 24u
+
+/** Opaque decoder instance */
+typedef struct GridDecoder GridDecoder;
+
+/**
+ * One decoded packet. Pointers reference decoder-owned storage and stay
+ * valid until the next grid_decoder_* call on the same instance.
+ */
+typedef struct {
+    int32_t type;            /**< GRID_DEC_EV_* */
+    uint32_t rows;           /**< Cell buffer geometry (frame/preview) */
+    uint32_t cols;
+    const uint16_t *cells;   /**< rows*cols cell values, or NULL */
+    const uint8_t *meta;     /**< 24-byte metadata block, or NULL */
+    const uint8_t *aux;      /**< Raw payload (stats/log/bench), or NULL */
+    uint32_t aux_len;
+} GridDecoderEvent;
+
+/**
+ * @brief  Create a decoder for the given grid geometry
+ * @param  rows/cols: full-resolution grid dimensions (both even)
+ * @retval Decoder instance, or NULL on bad arguments / allocation
+ */
+GridDecoder *grid_decoder_create(uint32_t rows, uint32_t cols);
+
+/** @brief  Destroy a decoder and release its buffers */
+void grid_decoder_destroy(GridDecoder *dec);
+
+/**
+ * @brief  Enable or disable COBS deframing of the input stream
+ * @note   Matches the firmware's negotiated COBS mode: chunks are
+ *         delimited by 0x00 and malformed chunks are discarded whole,
+ *         so a dropped byte never shears packet alignment
+ */
+void grid_decoder_set_cobs(GridDecoder *dec, int enabled);
+
+/** @brief  Drop all buffered bytes and pending state (baud fallback) */
+void grid_decoder_reset(GridDecoder *dec);
+
+/**
+ * @brief  Append raw serial bytes to the decoder
+ * @retval Number of bytes consumed (len, or less if the ring is full)
+ */
+size_t grid_decoder_feed(GridDecoder *dec, const uint8_t *data, size_t len);
+
+/**
+ * @brief  Reserve contiguous ring space for a bulk serial read
+ * @param  avail: out, number of bytes that may be written at the
+ *         returned pointer (0 when the ring is full)
+ * @retval Write pointer, or NULL (ring full / COBS mode, where the
+ *         stream must pass through grid_decoder_feed for deframing)
+ * @note   Producer side of the SPSC ring: safe to call from a reader
+ *         thread while another thread polls
+ */
+uint8_t *grid_decoder_reserve(GridDecoder *dec, size_t *avail);
+
+/**
+ * @brief  Publish len bytes previously written via grid_decoder_reserve
+ */
+void grid_decoder_commit(GridDecoder *dec, size_t len);
+
+/**
+ * @brief  Decode the next complete packet, if any
+ * @param  event: filled in on success
+ * @retval 1 when an event was produced, 0 when more bytes are needed
+ */
+int grid_decoder_poll(GridDecoder *dec, GridDecoderEvent *event);
+
+/** @brief  Cumulative packets dropped on CRC mismatch */
+uint32_t grid_decoder_crc_errors(const GridDecoder *dec);
+
+/** @brief  Cumulative times the sync search skipped garbage bytes */
+uint32_t grid_decoder_resyncs(const GridDecoder *dec);
+
+/** Inter-arrival histogram bins (1 ms each, last bin overflow) */
+#define GRID_DEC_JITTER_BINS 256u
+
+/** Link-quality summary, accumulated per decoded frame */
+typedef struct {
+    uint32_t frames;         /**< Frames decoded */
+    uint32_t crcErrors;      /**< Packets dropped on CRC mismatch */
+    uint32_t resyncs;        /**< Sync losses (garbage byte skips) */
+    uint32_t recoveredFrames;/**< Frames decoded right after a resync */
+    uint32_t seqGaps;        /**< Firmware sequence-number gap events */
+    uint32_t framesMissed;   /**< Frames the gaps add up to */
+    float arrivalP50Ms;      /**< Inter-arrival percentiles; for a
+                                  healthy 25 fps link p50 is ~40 ms
+                                  and p99 close behind - a long tail
+                                  is the "it felt laggy" signature */
+    float arrivalP90Ms;
+    float arrivalP99Ms;
+} GridLinkStats;
+
+/**
+ * @brief  Snapshot the link-quality counters
+ * @note   Counters are cleared only by grid_decoder destroy/create;
+ *         sample twice and difference for a windowed view
+ */
+void grid_decoder_link_stats(const GridDecoder *dec, GridLinkStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_DECODER_H */
@@ -0,0 +1,133 @@
+/**
+ ******************************************************************************
+ * @file           : grid_fusion.h
+ * @brief          : Multi-device frame fusion for the host library
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Fuses the frame streams of several boards into one combined stream,
+ * for rigs that tile panels into a larger field (two 16x32 panels
+ * stacked row-wise make the full-back 32x32). Each device gets its own
+ * GridDecoder fed from its own serial thread; a poll call aligns
+ * frames across devices by firmware scan timestamp and emits a single
+ * combined frame, so everything downstream - pipeline hooks, the GUI,
+ * session recording - consumes the fused stream exactly like a single
+ * larger device.
+ *
+ * The boards' millisecond uptime counters start at independent zeros
+ * and drift apart (crystal tolerance is ~20 ppm each way, seconds per
+ * day). Per device, a clock model maps device timestamps onto the
+ * host steady clock: the offset tracks the minimum observed
+ * (arrival jitter only ever adds delay, so the smallest sample is the
+ * cleanest), and the drift term is an exponentially-forgetting linear
+ * fit of offset against device time. Matching then happens in
+ * corrected host time, so fused frames stay temporally coherent over
+ * hours regardless of when each board booted.
+ *
+ * Alignment takes the first device as the reference stream: its oldest
+ * pending frame is matched against the closest frame of every other
+ * device; the set is emitted once every member lies within the
+ * tolerance window (default half the 40 ms frame interval). A
+ * reference frame whose partners never arrive is dropped and counted,
+ * never emitted with holes. Only full-resolution frames carrying
+ * metadata participate - previews and streamed rows have no scan
+ * timestamp to align on.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_FUSION_H
+#define GRID_FUSION_H
+
+#include "grid_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Most devices a fusion instance supports (two panels today) */
+#define GRID_FUSION_MAX_DEVICES 4u
+
+/** Opaque fusion instance */
+typedef struct GridFusion GridFusion;
+
+/** Per-fused-frame bookkeeping */
+typedef struct {
+    uint32_t seq;            /**< Fused frame counter */
+    uint32_t skewMs;         /**< Worst corrected-timestamp spread in
+                                  the fused set, milliseconds */
+    uint32_t devSeq[GRID_FUSION_MAX_DEVICES]; /**< Source sequence
+                                  numbers, per device */
+} GridFusionFrameInfo;
+
+/**
+ * @brief  Create a fusion instance
+ * @param  rows/cols: per-device grid geometry (all devices identical)
+ * @param  deviceCount: 2..GRID_FUSION_MAX_DEVICES
+ * @param  stackRows: 1 tiles devices along rows (panels one above the
+ *         other, fused frame deviceCount*rows x cols); 0 tiles along
+ *         columns (side by side, rows x deviceCount*cols)
+ * @param  cobs: COBS deframing on every device's input
+ * @retval Fusion instance, or NULL on bad arguments / allocation
+ */
+GridFusion *grid_fusion_create(uint32_t rows, uint32_t cols,
+                               uint32_t deviceCount, int stackRows,
+                               int cobs);
+
+/** @brief  Destroy the instance and its per-device decoders */
+void grid_fusion_destroy(GridFusion *f);
+
+/** @brief  Fused frame geometry (what poll writes into cells) */
+uint32_t grid_fusion_rows(const GridFusion *f);
+uint32_t grid_fusion_cols(const GridFusion *f);
+
+/**
+ * @brief  Append raw serial bytes from one device
+ * @note   Thread-safe per device: each device's serial thread feeds
+ *         its own index concurrently. Complete frames are drained and
+ *         timestamped against the host clock inside this call
+ * @retval Bytes consumed (see grid_decoder_feed)
+ */
+size_t grid_fusion_feed(GridFusion *f, uint32_t device,
+                        const uint8_t *data, size_t len);
+
+/**
+ * @brief  Emit the next aligned fused frame, if one is ready
+ * @param  cells: caller buffer of grid_fusion_rows*grid_fusion_cols
+ *         uint16; info: may be NULL
+ * @retval 1 when a fused frame was copied out, 0 when alignment is
+ *         still waiting on a device
+ */
+int grid_fusion_poll(GridFusion *f, uint16_t *cells,
+                     GridFusionFrameInfo *info);
+
+/**
+ * @brief  Set the alignment tolerance window
+ * @param  ms: largest corrected-timestamp spread still fused as one
+ *         frame (default 20, half the nominal frame interval)
+ */
+void grid_fusion_set_tolerance(GridFusion *f, uint32_t ms);
+
+/**
+ * @brief  Current clock-model offset for a device
+ * @retval Host-minus-device time in milliseconds, 0 before the first
+ *         frame of that device
+ */
+double grid_fusion_clock_offset(const GridFusion *f, uint32_t device);
+
+/**
+ * @brief  Current clock-drift estimate for a device
+ * @retval Parts per million of device clock against the host clock,
+ *         0 until the fit has enough samples
+ */
+double grid_fusion_clock_drift(const GridFusion *f, uint32_t device);
+
+/** @brief  Reference frames dropped because a partner never arrived */
+uint32_t grid_fusion_drops(const GridFusion *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_FUSION_H */
@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ * @file           : grid_history.h
+ * @brief          : Multi-resolution waveform history store
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Full-session force history for every cell at once, replacing the
+ * GUI's single-cell 200-sample deque. Each appended frame lands in a
+ * set of tiered ring buffers: tier 0 keeps recent samples at full wire
+ * rate, and each coarser tier stores min/max pairs over progressively
+ * longer buckets, so a 25 Hz stream covers hours in a few megabytes
+ * while peaks survive the decimation. Append is a fixed amount of work
+ * per cell per frame, cheap enough to run on every frame for all 512
+ * cells - which is what lets the clinician pick any cell after the
+ * fact instead of having to select it before pressing.
+ *
+ * Queries are phrased in absolute frame numbers (frame 0 is the first
+ * append) and return at most maxPoints min/max envelope points drawn
+ * from the finest tier that still covers the requested range, which is
+ * exactly the shape a plot widget wants: zoomed-in views get raw
+ * samples, zoomed-out views get an envelope, both bounded in size.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_HISTORY_H
+#define GRID_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque history store */
+typedef struct GridHistory GridHistory;
+
+/**
+ * @brief  Create a history store
+ * @param  cellCount: cells per frame (rows*cols)
+ * @param  tier0Capacity: full-rate samples retained per cell; 0 picks
+ *         the default (2048, ~82 s at 25 Hz). Coarser tiers share the
+ *         same bucket capacity at 8x and 64x decimation, so the store
+ *         spans tier0Capacity*64 frames in total
+ * @retval History store, or NULL on bad arguments / allocation
+ */
+GridHistory *grid_history_create(uint32_t cellCount,
+                                 uint32_t tier0Capacity);
+
+/** @brief  Destroy the store */
+void grid_history_destroy(GridHistory *h);
+
+/**
+ * @brief  Append one frame of all cells
+ * @param  cells: cellCount values in frame order
+ * @note   Single-writer; call from the thread that owns the decoder
+ */
+void grid_history_append(GridHistory *h, const uint16_t *cells);
+
+/** @brief  Total frames appended since creation */
+uint64_t grid_history_frames(const GridHistory *h);
+
+/** @brief  Oldest frame number any tier still retains */
+uint64_t grid_history_oldest(const GridHistory *h);
+
+/**
+ * @brief  Min/max envelope of one cell over a frame range
+ * @param  cell: cell index; startFrame/endFrame: inclusive absolute
+ *         frame range, clamped to what is retained
+ * @param  maxPoints: most points to emit (capacity of the out arrays)
+ * @param  frameIdx: per point, first frame the point covers; may be
+ *         NULL when the caller derives time from spacing
+ * @param  mins/maxs: per point, value envelope over the frames the
+ *         point covers (equal for full-rate points)
+ * @retval Points written, 0 when the range holds no retained frames
+ */
+uint32_t grid_history_query(const GridHistory *h, uint32_t cell,
+                            uint64_t startFrame, uint64_t endFrame,
+                            uint32_t maxPoints, uint64_t *frameIdx,
+                            uint16_t *mins, uint16_t *maxs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_HISTORY_H */
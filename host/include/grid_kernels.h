@@ -0,0 +1,96 @@
+/**
+ ******************************************************************************
+ * @file           : grid_kernels.h
+ * @brief          : Vectorized per-frame math for the host library
+ ******************************************************************************
+ *
+ * Batch kernels for the elementwise work the GUI used to do per frame
+ * in NumPy - palpation-zone classification, baseline-relative scaling,
+ * and the min/max/sum/centroid reductions. Each call crosses into
+ * native code once and sweeps the whole cell buffer with SIMD (AVX2 or
+ * SSE2 on x86, NEON on ARM, scalar elsewhere), so a 512-cell frame is
+ * a few microseconds instead of a stack of per-call NumPy dispatches.
+ * The instruction set is chosen at compile time; build with
+ * -DGRIDDECODE_NATIVE_ARCH=ON to unlock AVX2 on machines that have it.
+ *
+ * Zone semantics match PalpationZones.get_zone in gui/spine_detector.py
+ * exactly - the Python thresholds are passed in, not duplicated here.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_KERNELS_H
+#define GRID_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Zone indices produced by grid_kernels_classify */
+enum {
+    GRID_ZONE_NO_CONTACT = 0,
+    GRID_ZONE_LIGHT      = 1,
+    GRID_ZONE_WARMING    = 2,
+    GRID_ZONE_OPTIMAL    = 3,
+    GRID_ZONE_FIRM       = 4,
+    GRID_ZONE_EXCESSIVE  = 5,
+};
+
+/** Whole-frame reductions computed in one sweep */
+typedef struct {
+    uint16_t minVal;       /**< Smallest cell value */
+    uint16_t maxVal;       /**< Largest cell value */
+    uint32_t maxIdx;       /**< Flat index of the first maximum */
+    uint64_t sum;          /**< Total of all cells */
+    float centroidRow;     /**< Pressure-weighted centre, 0 when empty */
+    float centroidCol;
+} GridKernelsReduce;
+
+/**
+ * @brief  Classify every cell into a palpation zone
+ * @param  cells/zones: input values and output zone indices, n each
+ * @param  thresholds: the five PalpationZones cutoffs in order
+ *         {MIN_CONTACT, LIGHT_TOUCH, OPTIMAL_MIN, OPTIMAL_MAX, TOO_HARD};
+ *         boundary handling (< for the first three, <= for the last
+ *         two) matches PalpationZones.get_zone
+ */
+void grid_kernels_classify(const uint16_t *cells, uint8_t *zones,
+                           size_t n, const uint16_t thresholds[5]);
+
+/**
+ * @brief  Baseline-relative scaling: out = sat((cells - offset) * gain)
+ * @param  gain: 8.8 fixed point (256 = 1.0); results saturate to
+ *         [0, 65535], values below offset clamp to 0
+ */
+void grid_kernels_scale(const uint16_t *cells, uint16_t *out, size_t n,
+                        uint16_t offset, uint16_t gain);
+
+/**
+ * @brief  Min/max/sum and pressure-weighted centroid in one sweep
+ * @param  cells: rows*cols values, row-major
+ */
+void grid_kernels_reduce(const uint16_t *cells, uint32_t rows,
+                         uint32_t cols, GridKernelsReduce *out);
+
+/**
+ * @brief  Catmull-Rom bicubic upsample of a frame for display
+ * @param  cells: rows*cols input, row-major
+ * @param  out: (rows*factor)*(cols*factor) destination
+ * @param  factor: integer scale, clamped to [1, 8]; 8 turns the 16x32
+ *         grid into the 128x256 heatmap the GUI shows
+ * @note   Separable two-pass filter in 12.12 fixed point; undershoot
+ *         from the cubic's negative lobes clamps at 0 so the heatmap
+ *         palette never wraps
+ */
+void grid_kernels_upsample(const uint16_t *cells, uint32_t rows,
+                           uint32_t cols, uint16_t *out,
+                           uint32_t factor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_KERNELS_H */
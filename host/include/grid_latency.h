@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file           : grid_latency.h
+ * @brief          : End-to-end latency measurement harness
+ ******************************************************************************
+ *
+ * Measures the real touch-to-display latency instead of estimating it.
+ * The firmware side is GRID_CMD_INJECT: it forces a synthetic marker
+ * value into one cell exactly where the scan pipeline writes its
+ * output, and reports the injection tick on the log channel
+ * ("latinj t=<hex ms>"). This module arms on the same cell and value,
+ * then timestamps the first appearance of the marker at each host
+ * stage - decode, process, renderer fetch, frame present - and folds
+ * everything into a per-stage breakdown report.
+ *
+ * The taps are stage-agnostic marks, so both consumers fit: the C++
+ * pipeline calls the decode and process marks from its own threads
+ * (grid_pipeline_set_latency), while the GUI marks the stages of its
+ * ctypes path itself and calls the present mark from the GL widget's
+ * frame-present callback. Marks on a frame without the marker are
+ * free (one cell compare); a stage that is never marked inherits the
+ * previous stage's timestamp and reports as zero.
+ *
+ * Value matching tolerates the low four bits so the marker survives
+ * the 12-bit packed wire format. Pick a marker value well above the
+ * noise floor and off the grid's current activity (e.g. 0x0D30) so
+ * real pressure cannot fake a match.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_LATENCY_H
+#define GRID_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque harness instance */
+typedef struct GridLatency GridLatency;
+
+/** Per-stage breakdown of one completed probe (milliseconds) */
+typedef struct {
+    double armToDecodeMs;     /**< Inject command sent -> marker frame
+                                   decoded (wire + firmware residency) */
+    double decodeToProcessMs; /**< Decode -> process stage published */
+    double processToRenderMs; /**< Publish -> renderer fetched the frame */
+    double renderToPresentMs; /**< Fetch -> frame-present callback */
+    double totalMs;           /**< Arm -> present */
+    uint32_t fwInjectMs;      /**< Firmware tick at injection (its clock;
+                                   0 when the log line never arrived) */
+    uint32_t fwScanMs;        /**< Firmware tick when the marker frame
+                                   sealed (from the meta block; 0 when
+                                   the frame carried no metadata) */
+} GridLatencyReport;
+
+/**
+ * @brief  Create a harness for the given grid geometry
+ * @retval Harness, or NULL on bad arguments / allocation
+ */
+GridLatency *grid_latency_create(uint32_t rows, uint32_t cols);
+
+/** @brief  Release the harness */
+void grid_latency_destroy(GridLatency *lat);
+
+/**
+ * @brief  Arm a probe; call immediately before writing the matching
+ *         GRID_CMD_INJECT to the serial port
+ * @note   Re-arming discards any probe still in flight
+ */
+void grid_latency_arm(GridLatency *lat, uint32_t row, uint32_t col,
+                      uint16_t value);
+
+/**
+ * @brief  Decode-stage mark: a frame just left the decoder
+ * @param  meta: the frame's metadata block (GRID_DEC_META_SIZE bytes)
+ *         or NULL; supplies the firmware scan tick for the report
+ */
+void grid_latency_mark_decode(GridLatency *lat, const uint16_t *cells,
+                              const uint8_t *meta);
+
+/** @brief  Process-stage mark: the frame cleared per-frame processing */
+void grid_latency_mark_process(GridLatency *lat, const uint16_t *cells);
+
+/** @brief  Render-stage mark: the renderer fetched the frame */
+void grid_latency_mark_render(GridLatency *lat, const uint16_t *cells);
+
+/**
+ * @brief  Present mark: the displayed image actually swapped
+ * @note   Completes the probe when the render stage saw the marker;
+ *         harmless to call every frame from a frame-present callback
+ */
+void grid_latency_mark_present(GridLatency *lat);
+
+/**
+ * @brief  Feed firmware log text so the "latinj" line can be picked up
+ * @note   Text may arrive in fragments; the harness reassembles lines
+ */
+void grid_latency_note_log(GridLatency *lat, const char *text,
+                           size_t len);
+
+/**
+ * @brief  Collect a completed probe, if any
+ * @retval 1 when a report was copied out (the probe is consumed),
+ *         0 while none has completed
+ */
+int grid_latency_report(GridLatency *lat, GridLatencyReport *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_LATENCY_H */
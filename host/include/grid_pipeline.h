@@ -0,0 +1,187 @@
+/**
+ ******************************************************************************
+ * @file           : grid_pipeline.h
+ * @brief          : Threaded decode/process pipeline for the host library
+ ******************************************************************************
+ *
+ * Runs the grid_decoder behind a three-stage pipeline so that reading,
+ * decoding and per-frame processing no longer serialize on one thread:
+ *
+ *   serial reader (caller) -> decode thread -> process thread -> caller
+ *
+ * The caller's serial thread is the read stage: it pushes bytes with
+ * grid_pipeline_feed or the reserve/commit pair, exactly like the bare
+ * decoder. A decode thread drains the decoder and hands complete frames
+ * to a process thread over a lock-free SPSC queue; the process thread
+ * runs an optional per-frame hook (native kernels plug in here) and
+ * publishes each frame twice:
+ *
+ *  - the analysis queue, which preserves EVERY frame in order - when it
+ *    fills, the pipeline waits rather than drop, so movement tracking
+ *    and spine detection never see a gap;
+ *  - the render mailbox, which only ever holds the freshest frame -
+ *    frames overwritten before the renderer fetched them are counted in
+ *    grid_pipeline_render_drops. Dropping happens at this stage only.
+ *
+ * Frames cross the API boundary by copy into caller-provided buffers
+ * (a frame is 1-3 KB; the copy is nanoseconds against the safety of not
+ * handing out pointers owned by a running thread). Stats, log and bench
+ * packets arrive out of band through grid_pipeline_next_aux.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_PIPELINE_H
+#define GRID_PIPELINE_H
+
+#include "grid_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque pipeline instance */
+typedef struct GridPipeline GridPipeline;
+
+/** Per-frame bookkeeping returned beside the cell buffer */
+typedef struct {
+    uint32_t seq;                      /**< Pipeline frame counter */
+    int32_t type;                      /**< GRID_DEC_EV_FRAME / _PREVIEW */
+    uint8_t meta[GRID_DEC_META_SIZE];  /**< Frame metadata, zeroed when
+                                            the packet carried none */
+} GridPipelineFrameInfo;
+
+/**
+ * Per-frame processing hook, run on the process thread before the
+ * frame is published. May modify the cells in place.
+ */
+typedef void (*GridPipelineHook)(uint16_t *cells, uint32_t rows,
+                                 uint32_t cols, void *user);
+
+/**
+ * @brief  Create a pipeline (starts the decode and process threads)
+ * @param  rows/cols: grid geometry, cobs: COBS deframing on the input
+ * @retval Pipeline instance, or NULL on bad arguments / allocation
+ */
+GridPipeline *grid_pipeline_create(uint32_t rows, uint32_t cols, int cobs);
+
+/** @brief  Stop both threads and release everything */
+void grid_pipeline_destroy(GridPipeline *pipe);
+
+/** @brief  Drop buffered input (baud fallback); queued frames drain out */
+void grid_pipeline_reset(GridPipeline *pipe);
+
+/** @brief  Install the per-frame processing hook (NULL to remove) */
+void grid_pipeline_set_hook(GridPipeline *pipe, GridPipelineHook hook,
+                            void *user);
+
+/**
+ * @brief  Attach an end-to-end latency harness (NULL to detach)
+ * @note   The decode, process and render-fetch stages then mark the
+ *         harness from the pipeline's own paths, and firmware log
+ *         packets are fed to it for the injection tick; the caller
+ *         adds only the frame-present mark (see grid_latency.h).
+ *         The harness must outlive its attachment
+ */
+struct GridLatency;
+void grid_pipeline_set_latency(GridPipeline *pipe,
+                               struct GridLatency *lat);
+
+/** @brief  Append raw serial bytes (read stage; same as the decoder) */
+size_t grid_pipeline_feed(GridPipeline *pipe, const uint8_t *data,
+                          size_t len);
+
+/** @brief  Reserve ring space for a bulk serial read (NULL in COBS mode) */
+uint8_t *grid_pipeline_reserve(GridPipeline *pipe, size_t *avail);
+
+/** @brief  Publish bytes written via grid_pipeline_reserve */
+void grid_pipeline_commit(GridPipeline *pipe, size_t len);
+
+/**
+ * @brief  Take the next frame off the analysis queue (every frame)
+ * @param  cells: caller buffer of rows*cols uint16, info: may be NULL
+ * @param  timeout_ms: how long to wait for a frame; 0 = return at once
+ * @retval 1 when a frame was copied out, 0 on timeout
+ */
+int grid_pipeline_next_analysis(GridPipeline *pipe, uint16_t *cells,
+                                GridPipelineFrameInfo *info,
+                                uint32_t timeout_ms);
+
+/**
+ * @brief  Fetch the freshest frame for display, never waiting
+ * @retval 1 when a frame newer than the last fetch was copied out,
+ *         0 when the renderer is already up to date
+ */
+int grid_pipeline_latest_render(GridPipeline *pipe, uint16_t *cells,
+                                GridPipelineFrameInfo *info);
+
+/** Feedback scalars published ahead of full-frame processing */
+typedef struct {
+    uint32_t seq;          /**< Matches the frame's pipeline counter */
+    uint16_t peak;         /**< Highest cell value */
+    uint8_t peakRow;       /**< Location of the peak */
+    uint8_t peakCol;
+    uint32_t totalForce;   /**< Sum of all cells */
+    float centroidRow;     /**< Pressure-weighted centre, 0 when empty */
+    float centroidCol;
+} GridPipelineMetrics;
+
+/**
+ * @brief  Freshest feedback scalars, never waiting
+ * @note   Published on the decode thread the moment a frame decodes -
+ *         before the processing hook, the queues and the render copy -
+ *         so pressure/speed widgets polling here run 1-2 frame periods
+ *         ahead of the heatmap. Taken from the firmware meta block when
+ *         the frame carries one, else one reduce sweep over the cells.
+ * @retval 1 when metrics newer than the last fetch were copied out,
+ *         0 when the caller is already up to date
+ */
+int grid_pipeline_latest_metrics(GridPipeline *pipe,
+                                 GridPipelineMetrics *out);
+
+/**
+ * @brief  Next out-of-band packet (stats/log/bench), if any
+ * @param  type: out, GRID_DEC_EV_*; buf/cap: payload destination
+ * @param  len: out, payload size (truncated to cap)
+ * @retval 1 when a packet was copied out, 0 when none pending
+ */
+int grid_pipeline_next_aux(GridPipeline *pipe, int32_t *type,
+                           uint8_t *buf, size_t cap, uint32_t *len);
+
+/**
+ * @brief  Snapshot the decoder's link-quality counters
+ *         (see GridLinkStats in grid_decoder.h)
+ */
+void grid_pipeline_link_stats(const GridPipeline *pipe,
+                              GridLinkStats *out);
+
+/**
+ * @brief  Start recording every processed frame to a .gsf session file
+ * @note   The tap sits on the process thread and hands frames to the
+ *         session writer's own thread (see session_writer.h), so
+ *         recording adds one queue copy and no I/O to the live path
+ * @retval 1 when the file was opened, 0 on failure or already recording
+ */
+int grid_pipeline_start_recording(GridPipeline *pipe, const char *path);
+
+/** @brief  Finish the session file (index + header patch) and write a
+ *          <path>.link.json sidecar of link quality over the recording */
+void grid_pipeline_stop_recording(GridPipeline *pipe);
+
+/** @brief  Frames the recorder dropped because the disk fell behind */
+uint64_t grid_pipeline_recording_drops(const GridPipeline *pipe);
+
+/** @brief  Frames overwritten in the render mailbox before display */
+uint32_t grid_pipeline_render_drops(const GridPipeline *pipe);
+
+/** @brief  Decoder CRC failures (see grid_decoder_crc_errors) */
+uint32_t grid_pipeline_crc_errors(const GridPipeline *pipe);
+
+/** @brief  Decoder resync count (see grid_decoder_resyncs) */
+uint32_t grid_pipeline_resyncs(const GridPipeline *pipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_PIPELINE_H */
@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ * @file           : grid_serial.h
+ * @brief          : Bulk serial reader feeding the decode pipeline
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Native replacement for the GUI's Python serial thread. The Python
+ * loop issues small read() calls at high frequency, and on the worst
+ * clinic machines (Windows laptops) the per-call overhead alone backs
+ * up the receive path above ~30 fps. This reader owns the port and a
+ * thread that reads in bulk - tens of kilobytes per call, several
+ * frames at a time - directly into the pipeline's reserve/commit ring,
+ * so the OS boundary is crossed once per burst and the bytes are never
+ * copied on the way in.
+ *
+ * On POSIX the port runs raw with VMIN/VTIME tuned so the driver
+ * itself batches (poll() waits for data, then one read drains what
+ * has accumulated); on Windows the same loop runs over OVERLAPPED
+ * ReadFile with a wait handle. In COBS mode the pipeline exposes no
+ * ring to reserve into, so the reader falls back to a local bulk
+ * buffer and one feed call per read - still one syscall per burst.
+ *
+ * Byte and read-call counters expose the achieved batching (bytes per
+ * syscall) so burst sizes can be tuned per deployment site.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_SERIAL_H
+#define GRID_SERIAL_H
+
+#include "grid_pipeline.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque serial reader */
+typedef struct GridSerial GridSerial;
+
+/**
+ * @brief  Open and configure a serial port
+ * @param  device: "/dev/ttyACM0", "COM5", ...
+ * @param  baud: line rate; common rates map to native constants and
+ *         arbitrary ones use the OS custom-rate path where available
+ * @retval Reader, or NULL when the port cannot be opened/configured
+ */
+GridSerial *grid_serial_open(const char *device, uint32_t baud);
+
+/** @brief  Stop the reader if running and close the port */
+void grid_serial_close(GridSerial *s);
+
+/**
+ * @brief  Start the reader thread pumping into a pipeline
+ * @note   The pipeline must outlive the reader or be detached first
+ *         with grid_serial_stop
+ * @retval 1 when started, 0 when already running or bad arguments
+ */
+int grid_serial_start(GridSerial *s, GridPipeline *pipe);
+
+/** @brief  Stop the reader thread (the port stays open) */
+void grid_serial_stop(GridSerial *s);
+
+/**
+ * @brief  Reconfigure the line rate in place (baud fallback)
+ * @note   Safe while the reader runs; pair with grid_pipeline_reset
+ *         when the firmware end renegotiates
+ * @retval 1 on success
+ */
+int grid_serial_set_baud(GridSerial *s, uint32_t baud);
+
+/** @brief  Total bytes delivered to the pipeline */
+uint64_t grid_serial_bytes(const GridSerial *s);
+
+/** @brief  Read syscalls issued; bytes/reads is the achieved batching */
+uint64_t grid_serial_reads(const GridSerial *s);
+
+/** @brief  Read errors observed (port unplugged, overruns) */
+uint32_t grid_serial_errors(const GridSerial *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_SERIAL_H */
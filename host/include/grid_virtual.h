@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file           : grid_virtual.h
+ * @brief          : Virtual grid device for hardware-free load testing
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Emits protocol-exact byte streams - the same full-frame packet layout
+ * the firmware produces (see Core/Inc/grid_scan.h: sync pair, cells,
+ * 24-byte meta block with sequence numbers, CRC-32 footer) - without a
+ * board on the desk. Scenes are synthetic workloads: an idle grid with
+ * sensor-floor noise, a pressure blob wandering the surface, and a
+ * spine ridge with a palpating blob on top of it, shaped so the GUI's
+ * SpineDetector locks on just as it would on a person.
+ *
+ * Two delivery paths share one generator:
+ *
+ *  - pull: grid_virtual_next_packet fills a caller buffer with the next
+ *    frame, as fast as the caller asks - this is the benchmark and soak
+ *    loop, good for thousands of frames per second in-process;
+ *  - pty (POSIX): grid_virtual_start opens a pseudo-terminal and paces
+ *    frames at the configured rate from its own thread, so the full
+ *    GUI serial path can be soak-tested by pointing it at the returned
+ *    device path, at 10x wire rate if asked.
+ *
+ * Corruption injection flips a byte in a configurable fraction of
+ * packets (and shears the sync pair on a quarter of those), exercising
+ * the decoder's CRC drop and resync paths with known ground truth.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_VIRTUAL_H
+#define GRID_VIRTUAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Synthetic workloads */
+enum {
+    GRID_VIRT_SCENE_IDLE  = 0,  /**< Sensor-floor noise only */
+    GRID_VIRT_SCENE_BLOB  = 1,  /**< One pressure blob on a slow orbit */
+    GRID_VIRT_SCENE_SPINE = 2,  /**< Spine ridge + palpating blob */
+};
+
+/** Opaque virtual device */
+typedef struct GridVirtualDevice GridVirtualDevice;
+
+/**
+ * @brief  Create a virtual device for the given grid geometry
+ * @retval Device, or NULL on bad arguments / allocation
+ */
+GridVirtualDevice *grid_virtual_create(uint32_t rows, uint32_t cols);
+
+/** @brief  Stop the pty thread if running and release everything */
+void grid_virtual_destroy(GridVirtualDevice *dev);
+
+/** @brief  Select the scene (GRID_VIRT_SCENE_*, default blob) */
+void grid_virtual_set_scene(GridVirtualDevice *dev, int scene);
+
+/** @brief  Frame rate for the pty path (default 25, up to thousands) */
+void grid_virtual_set_fps(GridVirtualDevice *dev, double fps);
+
+/**
+ * @brief  Corrupt this fraction of packets (0..1, default 0)
+ * @note   Sequence numbers still advance over damaged packets, so the
+ *         decoder's seq-gap accounting can be checked against the
+ *         injected rate
+ */
+void grid_virtual_set_corruption(GridVirtualDevice *dev, double rate);
+
+/** @brief  Reseed the scene and corruption RNG (runs are reproducible) */
+void grid_virtual_set_seed(GridVirtualDevice *dev, uint64_t seed);
+
+/**
+ * @brief  Generate the next frame packet into a caller buffer
+ * @param  buf/cap: destination; a full packet for the device geometry
+ *         must fit (header + cells + meta + footer)
+ * @retval Packet size in bytes, 0 when cap is too small
+ */
+size_t grid_virtual_next_packet(GridVirtualDevice *dev, uint8_t *buf,
+                                size_t cap);
+
+/**
+ * @brief  Start serving frames over a pseudo-terminal (POSIX only)
+ * @param  path/cap: out, the slave device path to hand to the reader
+ *         (e.g. grid_serial_open or the GUI's port box)
+ * @retval 1 when the pty is up and pacing, 0 on failure / unsupported
+ */
+int grid_virtual_start(GridVirtualDevice *dev, char *path, size_t cap);
+
+/** @brief  Stop the pty thread and close the pseudo-terminal */
+void grid_virtual_stop(GridVirtualDevice *dev);
+
+/** @brief  Frames generated so far (both paths) */
+uint64_t grid_virtual_frames(const GridVirtualDevice *dev);
+
+/** @brief  Packets deliberately damaged so far */
+uint64_t grid_virtual_corrupted(const GridVirtualDevice *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_VIRTUAL_H */
@@ -0,0 +1,117 @@
+/**
+ ******************************************************************************
+ * @file           : grid_zones.h
+ * @brief          : Table-driven palpation zone classifier with hysteresis
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Native replacement for the PalpationZones threshold checks in
+ * gui/spine_detector.py. Classification is a single indexed load: for
+ * each zone a channel can currently be in, a precomputed 64 K table
+ * maps every 16-bit pressure value to the zone the channel moves to,
+ * with the hysteresis bands baked into the tables - a channel only
+ * leaves its zone once the value clears the boundary by that
+ * boundary's margin, which kills the feedback color flicker at zone
+ * edges.
+ *
+ * The classifier is stateful per channel (one channel per tracked
+ * landmark, or per cell if the caller wants a map) and emits
+ * zone-TRANSITION events rather than per-frame states: each event
+ * carries the channel, the zones left and entered, the value and
+ * timestamp that triggered it, and how long the channel dwelt in the
+ * zone it left. Events are what the feedback UI and the session log
+ * consume; recomputing an unchanged zone 25 times a second was pure
+ * waste.
+ *
+ * Default thresholds are the PalpationZones stub values; override them
+ * from the Python constants so those remain the single source.
+ *
+ ******************************************************************************
+ */
+
+#ifndef GRID_ZONES_H
+#define GRID_ZONES_H
+
+#include "grid_kernels.h" /* GRID_ZONE_* identifiers */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Zones and the boundaries between adjacent ones (the GRID_ZONE_*
+ *  identifiers themselves live in grid_kernels.h) */
+#define GRID_ZONE_COUNT 6
+#define GRID_ZONE_BOUNDARIES (GRID_ZONE_COUNT - 1)
+
+/** Opaque classifier instance */
+typedef struct GridZones GridZones;
+
+/** One zone transition */
+typedef struct {
+    uint32_t channel;        /**< Which tracked channel moved */
+    uint8_t fromZone;        /**< GRID_ZONE_* left */
+    uint8_t toZone;          /**< GRID_ZONE_* entered */
+    uint16_t value;          /**< Pressure value that triggered it */
+    double timestamp;        /**< Caller's timestamp of that value, s */
+    double dwellSec;         /**< Time spent in fromZone */
+} GridZoneEvent;
+
+/**
+ * @brief  Create a classifier
+ * @param  channelCount: independent channels to track (15 landmarks,
+ *         or rows*cols for a whole-grid map)
+ * @retval Classifier, or NULL on bad arguments / allocation
+ */
+GridZones *grid_zones_create(uint32_t channelCount);
+
+/** @brief  Destroy the classifier */
+void grid_zones_destroy(GridZones *z);
+
+/**
+ * @brief  Replace the zone boundaries and rebuild the tables
+ * @param  thresholds: GRID_ZONE_BOUNDARIES ascending ADC values
+ *         (MIN_CONTACT, LIGHT_TOUCH, OPTIMAL_MIN, OPTIMAL_MAX,
+ *         TOO_HARD in PalpationZones terms)
+ * @param  hysteresis: per-boundary margins in ADC counts; NULL keeps
+ *         the default of 32 counts everywhere. A channel crosses
+ *         boundary i upward at thresholds[i] + hysteresis[i] and back
+ *         down at thresholds[i] - hysteresis[i]
+ * @retval 1 on success, 0 when the thresholds are not ascending or the
+ *         hysteresis bands of adjacent boundaries overlap
+ */
+int grid_zones_set_thresholds(GridZones *z,
+                              const uint16_t thresholds[GRID_ZONE_BOUNDARIES],
+                              const uint16_t hysteresis[GRID_ZONE_BOUNDARIES]);
+
+/**
+ * @brief  Feed one value of one channel
+ * @note   A transition, if any, is queued for grid_zones_next_event.
+ *         No allocation, one table load on the hot path
+ */
+void grid_zones_update(GridZones *z, uint32_t channel, uint16_t value,
+                       double timestamp);
+
+/** @brief  Zone a channel is currently in (GRID_ZONE_NO_CONTACT before
+ *          its first update) */
+uint8_t grid_zones_state(const GridZones *z, uint32_t channel);
+
+/**
+ * @brief  Pop the oldest queued transition
+ * @retval 1 when an event was written, 0 when none pending
+ */
+int grid_zones_next_event(GridZones *z, GridZoneEvent *ev);
+
+/** @brief  Events discarded because the queue was full (oldest first) */
+uint32_t grid_zones_event_drops(const GridZones *z);
+
+/** @brief  Zone name string ("optimal", ...); "?" for a bad id */
+const char *grid_zones_name(uint8_t zone);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GRID_ZONES_H */
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file           : heatmap_gl.h
+ * @brief          : OpenGL heatmap renderer for the live display
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Native renderer behind the GUI's pressure heatmap. PyQtGraph's
+ * ImageItem repaints the full heatmap through Qt's raster pipeline
+ * every frame, which stutters on integrated graphics once the landmark
+ * overlay is active. This module instead uploads the raw grid as a
+ * 16-bit single-channel texture, applies the colormap in a fragment
+ * shader against a 256-entry lookup texture, and draws the overlays
+ * (spine line, landmark markers) as geometry - per-frame CPU cost is
+ * one rows*cols*2 byte texture upload regardless of display size, so
+ * the upsampled modes and the 40x40 target render for free.
+ *
+ * The module owns no window or context: the GUI hosts a QOpenGLWidget
+ * and calls in with that context current (create from initializeGL,
+ * upload/render from paintGL). GL entry points are resolved at runtime
+ * from the system GL library, so the shared library builds and loads on
+ * machines without GL development packages; heatmap_gl_create returns
+ * NULL where GL is unavailable and the GUI falls back to the
+ * pyqtgraph path, the same pattern as the rest of this library.
+ *
+ * Coordinates everywhere are grid cells: x in [0, cols], y in [0,
+ * rows], y down - the same frame the detectors and the Python overlay
+ * code already use. The renderer letterboxes the grid into the
+ * viewport preserving aspect ratio.
+ *
+ ******************************************************************************
+ */
+
+#ifndef HEATMAP_GL_H
+#define HEATMAP_GL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque renderer instance (one per GL context) */
+typedef struct HeatmapGL HeatmapGL;
+
+/**
+ * @brief  Create a renderer for the given grid geometry
+ * @note   A GL context must be current; shaders, textures and buffers
+ *         are created in it and the instance must only be used while
+ *         that context is current
+ * @retval Renderer, or NULL when GL is unavailable or too old (needs
+ *         desktop GL 2.1 with shaders)
+ */
+HeatmapGL *heatmap_gl_create(uint32_t rows, uint32_t cols);
+
+/** @brief  Destroy the renderer and its GL objects (context current) */
+void heatmap_gl_destroy(HeatmapGL *h);
+
+/**
+ * @brief  Replace the colormap
+ * @param  rgb: count entries of 3 bytes (R, G, B), sampled linearly
+ *         over the value range; count is clamped to [2, 256]
+ */
+void heatmap_gl_set_colormap(HeatmapGL *h, const uint8_t *rgb,
+                             uint32_t count);
+
+/**
+ * @brief  Set the cell value mapped to the top of the colormap
+ * @param  maxValue: values at or above this saturate (default 4095)
+ */
+void heatmap_gl_set_range(HeatmapGL *h, float maxValue);
+
+/**
+ * @brief  Upload one frame of cell values (rows*cols, row-major)
+ */
+void heatmap_gl_upload(HeatmapGL *h, const uint16_t *cells);
+
+/**
+ * @brief  Replace the overlay line list
+ * @param  verts: vertexCount vertices of 6 floats (x, y, r, g, b, a),
+ *         consecutive pairs forming independent segments; NULL or 0
+ *         clears the overlay
+ */
+void heatmap_gl_set_lines(HeatmapGL *h, const float *verts,
+                          uint32_t vertexCount);
+
+/**
+ * @brief  Replace the overlay marker list
+ * @param  verts: vertexCount vertices of 6 floats (x, y, r, g, b, a),
+ *         each drawn as a filled square of @p pxSize pixels
+ */
+void heatmap_gl_set_markers(HeatmapGL *h, const float *verts,
+                            uint32_t vertexCount, float pxSize);
+
+/**
+ * @brief  Draw the heatmap and overlays into the current viewport
+ * @param  fbWidth/fbHeight: framebuffer size in pixels (device pixels,
+ *         not logical - pass QOpenGLWidget size * devicePixelRatio)
+ * @retval 0 on success, -1 on a GL error during the draw
+ */
+int heatmap_gl_render(HeatmapGL *h, int fbWidth, int fbHeight);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEATMAP_GL_H */
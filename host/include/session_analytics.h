@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file           : session_analytics.h
+ * @brief          : Offline session analytics over recorded sessions
+ * @author         : Capstone Project
+ * @date           : 2026-08-28
+ ******************************************************************************
+ *
+ * Summary metrics for a whole recorded session, beyond the single-pass
+ * totals session_replay_analyze produces: the center-of-pressure
+ * trajectory frame by frame, per-vertebra force-time integrals over
+ * each landmark's neighbourhood, and how session time distributes
+ * across the SpeedZones scanning-speed bands. These used to be ad-hoc
+ * NumPy passes over pickled frames taking minutes; here the per-frame
+ * work (reductions and landmark-region sums) fans out across a pool of
+ * worker threads over the memory-mapped file, so a 40-minute session
+ * reduces in seconds.
+ *
+ * Two phases: the parallel phase computes independent per-frame
+ * quantities straight from the mapped records; a cheap serial phase
+ * then chains them in time order - trapezoidal force-time integration,
+ * centroid-to-centroid speeds and their zone dwell times. The report
+ * is an immutable snapshot the caller queries and frees; the replay
+ * instance is only read while run() executes.
+ *
+ * This is the computation backbone for the clinician-facing progress
+ * reports; the GUI renders the trajectory and tables, it no longer
+ * computes them.
+ *
+ ******************************************************************************
+ */
+
+#ifndef SESSION_ANALYTICS_H
+#define SESSION_ANALYTICS_H
+
+#include "session_replay.h"
+#include "spine_engine.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque analytics report */
+typedef struct SessionAnalyticsReport SessionAnalyticsReport;
+
+/** Per-landmark session metrics (one per SpineEngineLandmark) */
+typedef struct {
+    char level[8];           /**< "L1".."L5" */
+    char type[24];           /**< "spinous" / "transverse_left" / "..." */
+    double forceTimeIntegral;/**< Integral of the landmark region's
+                                  summed pressure over time, ADC*s */
+    double contactSec;       /**< Time the region saw contact */
+    uint16_t peak;           /**< Largest single cell value seen there */
+} SessionLandmarkMetrics;
+
+/** SpeedZones band indices (comparison chain of SpeedZones.get_zone) */
+enum {
+    SESSION_SPEED_STATIONARY = 0,
+    SESSION_SPEED_SLOW,
+    SESSION_SPEED_OPTIMAL,
+    SESSION_SPEED_FAST,
+    SESSION_SPEED_TOO_FAST,
+    SESSION_SPEED_BANDS
+};
+
+/**
+ * @brief  Analyze a session
+ * @param  rep: open replay instance; read-only during the call
+ * @param  eng: calibrated engine supplying landmark positions; NULL
+ *         skips the per-vertebra metrics
+ * @param  speedZones: the five SpeedZones values {STATIONARY, SLOW,
+ *         OPTIMAL_MIN, OPTIMAL_MAX, FAST} in cells/second; NULL uses
+ *         the Python defaults. Banding follows SpeedZones.get_zone
+ * @param  threads: worker threads; 0 picks the hardware concurrency
+ * @retval Report, or NULL on bad arguments / allocation
+ */
+SessionAnalyticsReport *session_analytics_run(const SessionReplay *rep,
+                                              const SpineEngine *eng,
+                                              const float speedZones[5],
+                                              uint32_t threads);
+
+/** @brief  Free the report */
+void session_analytics_free(SessionAnalyticsReport *r);
+
+/** @brief  Points in the center-of-pressure trajectory (one per
+ *          contact frame, in session order) */
+uint64_t session_analytics_cop_points(const SessionAnalyticsReport *r);
+
+/**
+ * @brief  Copy out a slice of the trajectory
+ * @param  start: first point; count: points wanted
+ * @param  timeS/row/col/pressure: out arrays of count entries; any may
+ *         be NULL when not wanted. Pressure is the frame's cell sum
+ * @retval Points written (less than count at the trajectory's end)
+ */
+uint32_t session_analytics_cop(const SessionAnalyticsReport *r,
+                               uint64_t start, uint32_t count,
+                               double *timeS, float *row, float *col,
+                               float *pressure);
+
+/**
+ * @brief  Copy out the per-landmark metrics
+ * @retval Entries written (at most cap; 15 when the engine was
+ *         calibrated, 0 when run without one)
+ */
+int session_analytics_landmarks(const SessionAnalyticsReport *r,
+                                SessionLandmarkMetrics *out, int cap);
+
+/** @brief  Seconds of contact time spent in each speed band */
+void session_analytics_speed_seconds(const SessionAnalyticsReport *r,
+                                     double out[SESSION_SPEED_BANDS]);
+
+/** @brief  Mean scanning speed over contact, cells/second */
+double session_analytics_mean_speed(const SessionAnalyticsReport *r);
+
+/** @brief  Peak scanning speed, cells/second */
+double session_analytics_max_speed(const SessionAnalyticsReport *r);
+
+/** @brief  Wall time the analysis itself took, seconds */
+double session_analytics_elapsed(const SessionAnalyticsReport *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SESSION_ANALYTICS_H */
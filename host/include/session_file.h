@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file           : session_file.h
+ * @brief          : On-disk session recording format (.gsf)
+ ******************************************************************************
+ *
+ * Binary layout for recorded palpation sessions. Everything is little-
+ * endian, fixed width and naturally aligned so a reader can mmap the
+ * file and walk records in place:
+ *
+ *   [FileHeader 64 B][Record 0][Record 1]...[IndexEntry...]
+ *
+ * Records are fixed size (header + cells + meta, padded to 8 bytes),
+ * so record N lives at a computable offset - random access needs no
+ * scan. Timestamps are monotonically non-decreasing, and a sparse
+ * index (one entry per second of session) is appended on clean close
+ * for O(1) seek-by-time; its offset and the final record count are
+ * patched into the header last. A file whose recordCount is still 0
+ * was cut off mid-recording - readers derive the count from the file
+ * size and treat the index as absent, so a crash loses nothing but
+ * the index.
+ *
+ * SESSION_FLAG_COMPRESSED files group records into fixed-count chunks
+ * (chunkRecords each, only the final chunk short), each stored as a
+ * chunk header plus an encoded payload. Cells are delta-preconditioned
+ * against the previous record within the chunk - the first record of
+ * every chunk is stored verbatim, so chunks decode independently - and
+ * the payload codec is per chunk: verbatim when encoding would not
+ * shrink it, the built-in zero-run encoder, or zstd when the library
+ * is present at record time. Record numbering and the seek index are
+ * unchanged; a chunk directory of file offsets appended on clean close
+ * (and rebuildable by walking chunk headers after a crash) makes
+ * record N's chunk a division plus one lookup.
+ *
+ * Shared by the writer (session_writer.h) and the replay engine.
+ *
+ ******************************************************************************
+ */
+
+#ifndef SESSION_FILE_H
+#define SESSION_FILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** "GSF1" little-endian */
+#define SESSION_FILE_MAGIC 0x31465347u
+#define SESSION_FILE_VERSION 1u
+
+/** Header flag: index block present at indexOffset */
+#define SESSION_FLAG_INDEXED 0x0001u
+
+/** Header flag: records stored as compressed chunks */
+#define SESSION_FLAG_COMPRESSED 0x0002u
+
+/** Chunk payload codecs */
+#define SESSION_CODEC_STORE 0u      /**< Verbatim (encoding grew it) */
+#define SESSION_CODEC_DELTA_RLE 1u  /**< Delta cells + zero-run bytes */
+#define SESSION_CODEC_DELTA_ZSTD 2u /**< Delta cells + zstd */
+
+/** File header, 64 bytes at offset 0 */
+typedef struct {
+    uint32_t magic;        /**< SESSION_FILE_MAGIC */
+    uint16_t version;      /**< SESSION_FILE_VERSION */
+    uint16_t headerSize;   /**< sizeof(SessionFileHeader) */
+    uint16_t rows;         /**< Grid geometry of every record */
+    uint16_t cols;
+    uint16_t flags;        /**< SESSION_FLAG_* */
+    uint16_t chunkRecords; /**< Records per full chunk, 0 uncompressed */
+    uint32_t recordSize;   /**< Fixed byte size of one record */
+    uint32_t metaSize;     /**< Metadata bytes per record (24) */
+    uint64_t startWallUs;  /**< Unix epoch microseconds at first record */
+    uint64_t recordCount;  /**< Patched on close; 0 while recording */
+    uint64_t indexOffset;  /**< Byte offset of the index, 0 if none */
+    uint64_t indexCount;   /**< Entries in the index */
+    uint64_t chunkDirOffset; /**< Byte offset of the chunk directory,
+                                  0 if none (uncompressed or crashed) */
+} SessionFileHeader;
+
+/** Per-record header, immediately followed by cells then meta */
+typedef struct {
+    uint64_t stampUs;      /**< Microseconds since startWallUs */
+    uint32_t seq;          /**< Pipeline frame counter */
+    uint16_t type;         /**< GRID_DEC_EV_FRAME or _PREVIEW */
+    uint16_t flags;        /**< Reserved, 0 */
+} SessionRecordHeader;
+
+/** Sparse seek index entry (one per second of session) */
+typedef struct {
+    uint64_t stampUs;      /**< Timestamp of the indexed record */
+    uint64_t recordIdx;    /**< Its record number */
+} SessionIndexEntry;
+
+/** Chunk header, immediately followed by compBytes of payload */
+typedef struct {
+    uint64_t firstStampUs; /**< Timestamp of the chunk's first record */
+    uint32_t records;      /**< Records in the chunk */
+    uint32_t rawBytes;     /**< Decoded size (records * recordSize) */
+    uint32_t compBytes;    /**< Payload size as stored */
+    uint16_t codec;        /**< SESSION_CODEC_* */
+    uint16_t reserved;
+} SessionChunkHeader;
+
+/** The chunk directory is a uint64_t chunk count followed by that many
+ *  uint64_t file offsets, one per chunk in record order */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SESSION_FILE_H */
@@ -0,0 +1,130 @@
+/**
+ ******************************************************************************
+ * @file           : session_replay.h
+ * @brief          : Replay and batch re-analysis of recorded sessions
+ ******************************************************************************
+ *
+ * Reads .gsf session files (session_file.h) through a memory mapping:
+ * records are handed out as views into the mapped file, so scrubbing
+ * and fast-forward never copy or re-parse anything. Compressed
+ * sessions decode lazily, one chunk on first touch, into a cache held
+ * until close - the record API and its pointer lifetimes are identical
+ * for both forms. Files cut off by a crash (recordCount still 0) open
+ * fine - the count is derived from the file size (or by walking chunk
+ * headers) and the seek index is rebuilt from record headers.
+ *
+ * Two ways to consume a session:
+ *
+ *  - the playback cursor: tick it with wall-clock deltas at any rate
+ *    (1x review, 16x+ fast-forward) and display the record it returns;
+ *    at high rates intermediate records are skipped naturally, and
+ *    seek-by-time scrubbing is O(1) through the sparse index;
+ *
+ *  - batch analysis: run the spine engine across every record at full
+ *    native speed and get whole-session summary metrics (contact time,
+ *    pressure zones, scanning speed, on-target percentage) - a
+ *    40-minute session takes seconds, which is what makes offline
+ *    re-analysis after recalibration practical.
+ *
+ ******************************************************************************
+ */
+
+#ifndef SESSION_REPLAY_H
+#define SESSION_REPLAY_H
+
+#include "spine_engine.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque replay instance */
+typedef struct SessionReplay SessionReplay;
+
+/** Whole-session summary produced by session_replay_analyze */
+typedef struct {
+    uint64_t frames;           /**< Records analyzed */
+    uint64_t contactFrames;    /**< Frames with significant pressure */
+    double durationS;          /**< Last record timestamp, seconds */
+    double meanPeak;           /**< Mean peak pressure over contact */
+    uint16_t maxPeak;          /**< Largest cell value in the session */
+    double meanSpeed;          /**< Mean scanning speed, cells/second */
+    double optimalPressurePct; /**< Contact time in the optimal zone */
+    double onTargetPct;        /**< Contact time within 3 cells of a
+                                    landmark (0 when not calibrated) */
+} SessionAnalysis;
+
+/**
+ * @brief  Map a session file for replay
+ * @retval Replay instance, or NULL when the file is missing or not a
+ *         valid .gsf for this library version
+ */
+SessionReplay *session_replay_open(const char *path);
+
+/** @brief  Unmap and release */
+void session_replay_close(SessionReplay *rep);
+
+uint32_t session_replay_rows(const SessionReplay *rep);
+uint32_t session_replay_cols(const SessionReplay *rep);
+
+/** @brief  Number of records in the file */
+uint64_t session_replay_count(const SessionReplay *rep);
+
+/** @brief  Timestamp of the last record, microseconds */
+uint64_t session_replay_duration_us(const SessionReplay *rep);
+
+/**
+ * @brief  Fetch record idx as views into the mapped file
+ * @param  cells/meta: out, pointers valid until close; any out
+ *         pointer may be NULL when not wanted
+ * @retval 1 on success, 0 when idx is out of range
+ */
+int session_replay_record(const SessionReplay *rep, uint64_t idx,
+                          const uint16_t **cells, const uint8_t **meta,
+                          uint64_t *stampUs, uint32_t *seq,
+                          int32_t *type);
+
+/**
+ * @brief  First record at or after a session timestamp (scrubbing)
+ * @retval Record index, clamped to the last record
+ */
+uint64_t session_replay_seek_time(const SessionReplay *rep,
+                                  uint64_t stampUs);
+
+/** @brief  Move the playback cursor to a session timestamp */
+void session_replay_set_position(SessionReplay *rep, uint64_t stampUs);
+
+/** @brief  Set the playback rate (1.0 real time, 16.0 fast-forward) */
+void session_replay_set_rate(SessionReplay *rep, double rate);
+
+/**
+ * @brief  Advance playback by a wall-clock delta
+ * @param  wallDeltaS: seconds elapsed since the previous tick
+ * @param  recordIdx: out, the record now due for display
+ * @retval 1 when a record newer than the last tick is due, 0 when
+ *         nothing new is due yet or the session has ended
+ */
+int session_replay_tick(SessionReplay *rep, double wallDeltaS,
+                        uint64_t *recordIdx);
+
+/** @brief  1 once the cursor has passed the final record */
+int session_replay_at_end(const SessionReplay *rep);
+
+/**
+ * @brief  Run the spine engine over every record and summarize
+ * @param  eng: tracker/landmark engine, may be NULL (pressure metrics
+ *         only); its movement history is used from its current state
+ * @param  zones: the five PalpationZones cutoffs (see grid_kernels.h)
+ * @retval 1 on success, 0 on bad arguments
+ */
+int session_replay_analyze(const SessionReplay *rep, SpineEngine *eng,
+                           const uint16_t zones[5], SessionAnalysis *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SESSION_REPLAY_H */
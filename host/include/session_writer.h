@@ -0,0 +1,90 @@
+/**
+ ******************************************************************************
+ * @file           : session_writer.h
+ * @brief          : Append-only session recording writer
+ ******************************************************************************
+ *
+ * Writes the .gsf session format (session_file.h). Appends are
+ * non-blocking: the frame is copied into a lock-free queue slot and a
+ * dedicated writer thread does the file I/O, so recording never adds a
+ * flush stall to the thread that produces frames. When the queue is
+ * full (disk hopelessly behind) the record is dropped and counted
+ * rather than ever stalling the caller - the live display always wins.
+ *
+ * Recording is compressed by default: the writer thread groups
+ * records into chunks, delta-preconditions the cells and encodes each
+ * chunk in the background (zstd when the system has it, the built-in
+ * zero-run codec otherwise) - a raw hour is ~100 MB, compressed
+ * typically 5-10, and the append path is identical either way. The
+ * replay engine reads both forms transparently; open_ex turns
+ * compression off for tools that want byte-offset access to the raw
+ * records.
+ *
+ * The pipeline tap in grid_pipeline.h drives this automatically; the
+ * standalone API here also serves offline tools (format conversion,
+ * re-recording filtered sessions).
+ *
+ ******************************************************************************
+ */
+
+#ifndef SESSION_WRITER_H
+#define SESSION_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque writer instance */
+typedef struct SessionWriter SessionWriter;
+
+/**
+ * @brief  Create a session file and start the writer thread
+ * @note   Records are chunk-compressed; same as open_ex(..., 1)
+ * @retval Writer instance, or NULL on bad arguments / open failure
+ */
+SessionWriter *session_writer_open(const char *path, uint32_t rows,
+                                   uint32_t cols);
+
+/**
+ * @brief  Create a session file, choosing the storage form
+ * @param  compress: 0 writes plain fixed-offset records
+ */
+SessionWriter *session_writer_open_ex(const char *path, uint32_t rows,
+                                      uint32_t cols, int compress);
+
+/**
+ * @brief  Queue one frame for appending (non-blocking)
+ * @param  cells: rows*cols values; meta: 24-byte block or NULL
+ * @param  stampUs: microseconds since recording start, non-decreasing
+ * @retval 1 when queued, 0 when dropped because the queue was full
+ */
+int session_writer_append(SessionWriter *w, const uint16_t *cells,
+                          const uint8_t *meta, uint64_t stampUs,
+                          uint32_t seq, int32_t type);
+
+/** @brief  Records dropped because the writer fell behind */
+uint64_t session_writer_dropped(const SessionWriter *w);
+
+/** @brief  Records accepted so far (queued or written) */
+uint64_t session_writer_count(const SessionWriter *w);
+
+/** @brief  Bytes on disk so far (header and flushed chunks/records);
+ *          against count * record size this is the live compression
+ *          ratio */
+uint64_t session_writer_disk_bytes(const SessionWriter *w);
+
+/**
+ * @brief  Drain the queue, append the seek index, patch the header
+ *         and release the writer
+ * @retval 1 when the file closed clean, 0 on I/O failure
+ */
+int session_writer_close(SessionWriter *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SESSION_WRITER_H */
@@ -0,0 +1,137 @@
+/**
+ ******************************************************************************
+ * @file           : spine_engine.h
+ * @brief          : Native spine detection and landmark tracking engine
+ ******************************************************************************
+ *
+ * C++ port of the algorithms in gui/spine_detector.py: spine-line
+ * detection from the calibration drag, L1-L5 landmark generation with
+ * transverse processes, per-landmark Kalman refinement, and pressure-
+ * centroid movement tracking. The Python module remains the reference
+ * implementation and the fallback; this engine exists so the per-frame
+ * work (centroid reductions, landmark search, filter updates) runs at
+ * wire rate with headroom for the 40x40 grid.
+ *
+ * The calibration file format is the same JSON the Python side reads
+ * and writes - files are interchangeable between the two in both
+ * directions. Feedback strings stay in the GUI (they carry unicode and
+ * palette colors); the engine returns positions, distances and flags.
+ *
+ * Thresholds default to the PalpationZones stub values and can be
+ * overridden so the Python constants remain the single source.
+ *
+ ******************************************************************************
+ */
+
+#ifndef SPINE_ENGINE_H
+#define SPINE_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque engine instance */
+typedef struct SpineEngine SpineEngine;
+
+/** One vertebra landmark (matches SpinalLandmark in spine_detector.py) */
+typedef struct {
+    char level[8];           /**< "L1".."L5" */
+    char type[24];           /**< "spinous" / "transverse_left" / "..." */
+    float row;               /**< Grid position, fractional cells */
+    float col;
+    float uncertainty;       /**< Position uncertainty in cells */
+} SpineEngineLandmark;
+
+/**
+ * @brief  Create an engine for the given grid geometry
+ * @retval Engine instance, or NULL on bad arguments / allocation
+ */
+SpineEngine *spine_engine_create(uint32_t rows, uint32_t cols);
+
+/** @brief  Release the engine */
+void spine_engine_destroy(SpineEngine *eng);
+
+/**
+ * @brief  Override the pressure threshold for valid calibration presses
+ *         (defaults to MIN_CALIBRATION_PRESSURE = 300)
+ */
+void spine_engine_set_min_pressure(SpineEngine *eng, uint16_t threshold);
+
+/** @brief  Discard any calibration and begin collecting drag frames */
+void spine_engine_start_calibration(SpineEngine *eng);
+
+/** @brief  Fold one drag frame (rows*cols cells) into the calibration */
+void spine_engine_add_calibration_frame(SpineEngine *eng,
+                                        const uint16_t *cells);
+
+/**
+ * @brief  Detect the spine line and generate the 15 landmarks
+ * @param  msg: human-readable result, always NUL-terminated
+ * @retval 1 on success, 0 with the failure reason in msg
+ */
+int spine_engine_finalize_calibration(SpineEngine *eng, char *msg,
+                                      size_t msgCap);
+
+/** @brief  1 when a spine line and all 15 landmarks are present */
+int spine_engine_is_calibrated(const SpineEngine *eng);
+
+/**
+ * @brief  Copy out the current landmarks
+ * @retval Number written (at most cap; 15 when calibrated)
+ */
+int spine_engine_get_landmarks(const SpineEngine *eng,
+                               SpineEngineLandmark *out, int cap);
+
+/**
+ * @brief  Fetch the fitted spine line
+ * @param  coeff: out, {slope, intercept} of col = slope*row + intercept
+ * @retval 1 when calibrated, 0 otherwise
+ */
+int spine_engine_get_spine_line(const SpineEngine *eng, int32_t *startRow,
+                                int32_t *endRow, float coeff[2]);
+
+/**
+ * @brief  Kalman-refine one landmark from a press near it
+ * @note   Mirrors SpineDetector.update_landmark_estimate: stationary-
+ *         target filter with measurement noise that anneals as
+ *         confidence accumulates
+ */
+void spine_engine_update_landmark(SpineEngine *eng, const char *level,
+                                  const char *type, float measuredRow,
+                                  float measuredCol);
+
+/**
+ * @brief  Landmark nearest to a position
+ * @param  dist: out, Euclidean distance in cells
+ * @retval 1 when calibrated and a landmark was written, 0 otherwise
+ */
+int spine_engine_nearest_landmark(const SpineEngine *eng, float row,
+                                  float col, SpineEngineLandmark *out,
+                                  float *dist);
+
+/**
+ * @brief  Movement-tracker update with a new frame
+ * @param  timestamp: seconds (firmware scan time preferred)
+ * @param  row/col: out, pressure centroid; speed: out, cells/second
+ *         over the tracker's history window
+ * @retval 1 when significant pressure was present, 0 for no contact
+ */
+int spine_engine_track(SpineEngine *eng, const uint16_t *cells,
+                       double timestamp, float *row, float *col,
+                       float *speed);
+
+/** @brief  Save the calibration as JSON (Python-compatible format) */
+int spine_engine_save_calibration(const SpineEngine *eng,
+                                  const char *path);
+
+/** @brief  Load a calibration JSON written by either implementation */
+int spine_engine_load_calibration(SpineEngine *eng, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_ENGINE_H */
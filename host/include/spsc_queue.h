@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file           : spsc_queue.h
+ * @brief          : Lock-free single-producer single-consumer slot queue
+ ******************************************************************************
+ *
+ * Fixed-capacity ring of in-place slots for handing frames between the
+ * pipeline threads (see grid_pipeline.cpp). The producer claims a slot,
+ * fills it, then publishes; the consumer reads the front slot and pops.
+ * Writing in place means a queued frame is never copied an extra time
+ * just to cross the thread boundary - the slot's buffers are allocated
+ * once at startup and reused forever.
+ *
+ * Exactly one producer thread and one consumer thread per queue; the
+ * two atomic positions are the only shared state, so neither side ever
+ * blocks the other.
+ *
+ ******************************************************************************
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscQueue {
+public:
+    /** @param capacity: slot count, rounded up to a power of two */
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t cap = 1;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        slots_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    /** Producer: next free slot to fill in place, or nullptr when full */
+    T *claim()
+    {
+        uint64_t t = tail_.load(std::memory_order_relaxed);
+        uint64_t h = head_.load(std::memory_order_acquire);
+        if (t - h > mask_) {
+            return nullptr;
+        }
+        return &slots_[t & mask_];
+    }
+
+    /** Producer: make the claimed slot visible to the consumer */
+    void publish()
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+    /** Consumer: oldest published slot, or nullptr when empty */
+    T *front()
+    {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        uint64_t t = tail_.load(std::memory_order_acquire);
+        if (h == t) {
+            return nullptr;
+        }
+        return &slots_[h & mask_];
+    }
+
+    /** Consumer: release the front slot back to the producer */
+    void pop()
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    /** Single-threaded slot setup at startup (e.g. sizing buffers) */
+    template <typename Fn>
+    void forEachSlot(Fn fn)
+    {
+        for (T &slot : slots_) {
+            fn(slot);
+        }
+    }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> tail_{0};
+};
+
+#endif /* SPSC_QUEUE_H */
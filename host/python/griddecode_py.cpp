@@ -0,0 +1,662 @@
+/**
+ ******************************************************************************
+ * @file           : griddecode_py.cpp
+ * @brief          : pybind11 module exposing the host library to the GUI
+ ******************************************************************************
+ *
+ * Python-facing layer over grid_decoder / grid_pipeline / grid_kernels /
+ * spine_engine, built as the extension module `griddecode_py` when
+ * -DGRIDDECODE_PYTHON_BINDINGS=ON and pybind11 is installed. The ctypes
+ * path in gui/grid_gui.py keeps working; this module exists so the GUI
+ * can migrate one seam at a time without struct-packing glue.
+ *
+ * The binding rules that keep the hot path free of Python overhead:
+ *
+ *  - frame cells are zero-copy NumPy views over decoder-owned buffers,
+ *    cached per underlying pointer so steady-state polling returns the
+ *    SAME ndarray object every frame (no per-frame allocation); views
+ *    are read-only and hold a reference to their decoder;
+ *  - pipeline frame fetches copy into a caller-provided reusable array
+ *    (the GUI allocates two arrays at startup, analysis and render, and
+ *    they live for the session);
+ *  - the GIL is released around every feed, poll, wait and kernel sweep,
+ *    so the decode threads never stall the Qt event loop.
+ *
+ * Strings, landmark lists and calibration results are plain Python
+ * objects - they are touched at human rate, not frame rate.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_decoder.h"
+#include "grid_kernels.h"
+#include "grid_pipeline.h"
+#include "spine_engine.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace {
+
+/* Validate a caller-provided destination array: exact dtype, writable,
+ * C-contiguous, exactly n elements. Out-params are never cast or
+ * reallocated - a silent copy would defeat the reuse contract. */
+template <typename T>
+T *checkedOut(py::array &arr, size_t n, const char *what)
+{
+    if (!py::isinstance<py::array_t<T>>(arr)) {
+        throw py::type_error(std::string(what) + ": wrong dtype");
+    }
+    py::buffer_info info = arr.request(true);
+    size_t total = 1;
+    for (py::ssize_t d : info.shape) {
+        total *= static_cast<size_t>(d);
+    }
+    if (total != n) {
+        throw std::invalid_argument(std::string(what) + ": wrong size");
+    }
+    py::ssize_t expect = static_cast<py::ssize_t>(sizeof(T));
+    for (py::ssize_t i = info.ndim - 1; i >= 0; i--) {
+        if (info.strides[i] != expect) {
+            throw std::invalid_argument(std::string(what) +
+                                        ": not C-contiguous");
+        }
+        expect *= info.shape[i];
+    }
+    return static_cast<T *>(info.ptr);
+}
+
+/* Read-only flat uint16 input of exactly n cells (forcecast would hide
+ * an accidental float array from the GUI; reject instead) */
+const uint16_t *checkedCells(const py::array &arr, size_t n)
+{
+    if (!py::isinstance<py::array_t<uint16_t>>(arr)) {
+        throw py::type_error("cells: expected uint16 array");
+    }
+    py::buffer_info info = arr.request();
+    size_t total = 1;
+    for (py::ssize_t d : info.shape) {
+        total *= static_cast<size_t>(d);
+    }
+    if (total != n) {
+        throw std::invalid_argument("cells: wrong size");
+    }
+    py::ssize_t expect = static_cast<py::ssize_t>(sizeof(uint16_t));
+    for (py::ssize_t i = info.ndim - 1; i >= 0; i--) {
+        if (info.strides[i] != expect) {
+            throw std::invalid_argument("cells: not C-contiguous");
+        }
+        expect *= info.shape[i];
+    }
+    return static_cast<const uint16_t *>(info.ptr);
+}
+
+void makeReadOnly(py::array &arr)
+{
+    py::detail::array_proxy(arr.ptr())->flags &=
+        ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+}
+
+/* ------------------------------------------------------------------ */
+/* Decoder                                                            */
+/* ------------------------------------------------------------------ */
+
+class PyDecoder {
+public:
+    PyDecoder(uint32_t rows, uint32_t cols)
+    {
+        dec_ = grid_decoder_create(rows, cols);
+        if (dec_ == nullptr) {
+            throw std::invalid_argument("bad grid geometry");
+        }
+    }
+
+    ~PyDecoder() { grid_decoder_destroy(dec_); }
+
+    PyDecoder(const PyDecoder &) = delete;
+    PyDecoder &operator=(const PyDecoder &) = delete;
+
+    void setCobs(bool enabled)
+    {
+        grid_decoder_set_cobs(dec_, enabled ? 1 : 0);
+    }
+
+    void reset()
+    {
+        py::gil_scoped_release rel;
+        grid_decoder_reset(dec_);
+        haveEvent_ = false;
+    }
+
+    size_t feed(py::buffer data)
+    {
+        py::buffer_info info = data.request();
+        const auto *p = static_cast<const uint8_t *>(info.ptr);
+        size_t len = static_cast<size_t>(info.size) * info.itemsize;
+        py::gil_scoped_release rel;
+        return grid_decoder_feed(dec_, p, len);
+    }
+
+    int poll()
+    {
+        int got;
+        {
+            py::gil_scoped_release rel;
+            got = grid_decoder_poll(dec_, &event_);
+        }
+        haveEvent_ = (got != 0);
+        return haveEvent_ ? event_.type : GRID_DEC_EV_NONE;
+    }
+
+    /* Zero-copy view over the decoder's reconstruction buffer. The
+     * decoder reuses the same buffer for every full frame (and another
+     * for previews), so the ndarray built on first sight of a pointer
+     * is handed back unchanged on every later frame. */
+    py::object cells(py::object self)
+    {
+        if (!haveEvent_ || event_.cells == nullptr) {
+            return py::none();
+        }
+        if (event_.cells != viewPtr_) {
+            py::array view(
+                py::dtype::of<uint16_t>(),
+                {static_cast<py::ssize_t>(event_.rows),
+                 static_cast<py::ssize_t>(event_.cols)},
+                {static_cast<py::ssize_t>(event_.cols *
+                                          sizeof(uint16_t)),
+                 static_cast<py::ssize_t>(sizeof(uint16_t))},
+                event_.cells, self);
+            makeReadOnly(view);
+            view_ = view;
+            viewPtr_ = event_.cells;
+        }
+        return view_;
+    }
+
+    py::object meta() const
+    {
+        if (!haveEvent_ || event_.meta == nullptr) {
+            return py::none();
+        }
+        return py::bytes(reinterpret_cast<const char *>(event_.meta),
+                         GRID_DEC_META_SIZE);
+    }
+
+    py::object aux() const
+    {
+        if (!haveEvent_ || event_.aux == nullptr) {
+            return py::none();
+        }
+        return py::bytes(reinterpret_cast<const char *>(event_.aux),
+                         event_.aux_len);
+    }
+
+    uint32_t crcErrors() const { return grid_decoder_crc_errors(dec_); }
+    uint32_t resyncs() const { return grid_decoder_resyncs(dec_); }
+
+private:
+    GridDecoder *dec_ = nullptr;
+    GridDecoderEvent event_{};
+    bool haveEvent_ = false;
+    const uint16_t *viewPtr_ = nullptr;
+    py::object view_;
+};
+
+/* ------------------------------------------------------------------ */
+/* Pipeline                                                           */
+/* ------------------------------------------------------------------ */
+
+class PyPipeline {
+public:
+    PyPipeline(uint32_t rows, uint32_t cols, bool cobs)
+        : rows_(rows), cols_(cols)
+    {
+        pipe_ = grid_pipeline_create(rows, cols, cobs ? 1 : 0);
+        if (pipe_ == nullptr) {
+            throw std::invalid_argument("bad grid geometry");
+        }
+    }
+
+    ~PyPipeline()
+    {
+        py::gil_scoped_release rel;
+        grid_pipeline_destroy(pipe_);
+    }
+
+    PyPipeline(const PyPipeline &) = delete;
+    PyPipeline &operator=(const PyPipeline &) = delete;
+
+    void reset()
+    {
+        py::gil_scoped_release rel;
+        grid_pipeline_reset(pipe_);
+    }
+
+    size_t feed(py::buffer data)
+    {
+        py::buffer_info info = data.request();
+        const auto *p = static_cast<const uint8_t *>(info.ptr);
+        size_t len = static_cast<size_t>(info.size) * info.itemsize;
+        py::gil_scoped_release rel;
+        return grid_pipeline_feed(pipe_, p, len);
+    }
+
+    /* Copy the next in-order frame into the caller's reusable array.
+     * Returns (seq, type, meta) or None on timeout. */
+    py::object nextAnalysis(py::array out, uint32_t timeoutMs)
+    {
+        uint16_t *dst = checkedOut<uint16_t>(
+            out, static_cast<size_t>(rows_) * cols_, "out");
+        GridPipelineFrameInfo info;
+        int got;
+        {
+            py::gil_scoped_release rel;
+            got = grid_pipeline_next_analysis(pipe_, dst, &info,
+                                              timeoutMs);
+        }
+        if (!got) {
+            return py::none();
+        }
+        return py::make_tuple(
+            info.seq, info.type,
+            py::bytes(reinterpret_cast<const char *>(info.meta),
+                      GRID_DEC_META_SIZE));
+    }
+
+    /* Freshest frame for display; never waits. Same result shape. */
+    py::object latestRender(py::array out)
+    {
+        uint16_t *dst = checkedOut<uint16_t>(
+            out, static_cast<size_t>(rows_) * cols_, "out");
+        GridPipelineFrameInfo info;
+        int got;
+        {
+            py::gil_scoped_release rel;
+            got = grid_pipeline_latest_render(pipe_, dst, &info);
+        }
+        if (!got) {
+            return py::none();
+        }
+        return py::make_tuple(
+            info.seq, info.type,
+            py::bytes(reinterpret_cast<const char *>(info.meta),
+                      GRID_DEC_META_SIZE));
+    }
+
+    /* (type, payload) or None - stats/log/bench arrive at 1 Hz */
+    py::object nextAux()
+    {
+        uint8_t buf[512];
+        int32_t type = 0;
+        uint32_t len = 0;
+        int got;
+        {
+            py::gil_scoped_release rel;
+            got = grid_pipeline_next_aux(pipe_, &type, buf, sizeof(buf),
+                                         &len);
+        }
+        if (!got) {
+            return py::none();
+        }
+        return py::make_tuple(
+            type,
+            py::bytes(reinterpret_cast<const char *>(buf), len));
+    }
+
+    bool startRecording(const std::string &path)
+    {
+        py::gil_scoped_release rel;
+        return grid_pipeline_start_recording(pipe_, path.c_str()) != 0;
+    }
+
+    void stopRecording()
+    {
+        py::gil_scoped_release rel;
+        grid_pipeline_stop_recording(pipe_);
+    }
+
+    uint64_t recordingDrops() const
+    {
+        return grid_pipeline_recording_drops(pipe_);
+    }
+
+    uint32_t renderDrops() const
+    {
+        return grid_pipeline_render_drops(pipe_);
+    }
+
+    uint32_t crcErrors() const { return grid_pipeline_crc_errors(pipe_); }
+    uint32_t resyncs() const { return grid_pipeline_resyncs(pipe_); }
+
+    uint32_t rows() const { return rows_; }
+    uint32_t cols() const { return cols_; }
+
+private:
+    GridPipeline *pipe_ = nullptr;
+    uint32_t rows_;
+    uint32_t cols_;
+};
+
+/* ------------------------------------------------------------------ */
+/* Spine engine                                                       */
+/* ------------------------------------------------------------------ */
+
+class PySpineEngine {
+public:
+    PySpineEngine(uint32_t rows, uint32_t cols)
+        : rows_(rows), cols_(cols)
+    {
+        eng_ = spine_engine_create(rows, cols);
+        if (eng_ == nullptr) {
+            throw std::invalid_argument("bad grid geometry");
+        }
+    }
+
+    ~PySpineEngine() { spine_engine_destroy(eng_); }
+
+    PySpineEngine(const PySpineEngine &) = delete;
+    PySpineEngine &operator=(const PySpineEngine &) = delete;
+
+    void setMinPressure(uint16_t threshold)
+    {
+        spine_engine_set_min_pressure(eng_, threshold);
+    }
+
+    void startCalibration() { spine_engine_start_calibration(eng_); }
+
+    void addCalibrationFrame(const py::array &cells)
+    {
+        const uint16_t *p =
+            checkedCells(cells, static_cast<size_t>(rows_) * cols_);
+        py::gil_scoped_release rel;
+        spine_engine_add_calibration_frame(eng_, p);
+    }
+
+    /* (ok, message) - mirrors SpineDetector.finalize_calibration */
+    py::tuple finalizeCalibration()
+    {
+        char msg[128];
+        int ok;
+        {
+            py::gil_scoped_release rel;
+            ok = spine_engine_finalize_calibration(eng_, msg,
+                                                   sizeof(msg));
+        }
+        return py::make_tuple(ok != 0, py::str(msg));
+    }
+
+    bool isCalibrated() const
+    {
+        return spine_engine_is_calibrated(eng_) != 0;
+    }
+
+    /* List of landmark dicts in the shape spine_detector.py uses */
+    py::list landmarks() const
+    {
+        SpineEngineLandmark lm[15];
+        int n = spine_engine_get_landmarks(eng_, lm, 15);
+        py::list out;
+        for (int i = 0; i < n; i++) {
+            py::dict d;
+            d["level"] = py::str(lm[i].level);
+            d["type"] = py::str(lm[i].type);
+            d["position"] = py::make_tuple(lm[i].row, lm[i].col);
+            d["uncertainty"] = lm[i].uncertainty;
+            out.append(d);
+        }
+        return out;
+    }
+
+    /* (start_row, end_row, (slope, intercept)) or None */
+    py::object spineLine() const
+    {
+        int32_t startRow = 0;
+        int32_t endRow = 0;
+        float coeff[2] = {0.0f, 0.0f};
+        if (!spine_engine_get_spine_line(eng_, &startRow, &endRow,
+                                         coeff)) {
+            return py::none();
+        }
+        return py::make_tuple(startRow, endRow,
+                              py::make_tuple(coeff[0], coeff[1]));
+    }
+
+    void updateLandmark(const std::string &level,
+                        const std::string &type, float row, float col)
+    {
+        spine_engine_update_landmark(eng_, level.c_str(), type.c_str(),
+                                     row, col);
+    }
+
+    /* (landmark_dict, distance) or None */
+    py::object nearestLandmark(float row, float col) const
+    {
+        SpineEngineLandmark lm;
+        float dist = 0.0f;
+        if (!spine_engine_nearest_landmark(eng_, row, col, &lm,
+                                           &dist)) {
+            return py::none();
+        }
+        py::dict d;
+        d["level"] = py::str(lm.level);
+        d["type"] = py::str(lm.type);
+        d["position"] = py::make_tuple(lm.row, lm.col);
+        d["uncertainty"] = lm.uncertainty;
+        return py::make_tuple(d, dist);
+    }
+
+    /* ((row, col), speed) or (None, 0.0) - MovementTracker.update */
+    py::tuple track(const py::array &cells, double timestamp)
+    {
+        const uint16_t *p =
+            checkedCells(cells, static_cast<size_t>(rows_) * cols_);
+        float row = 0.0f;
+        float col = 0.0f;
+        float speed = 0.0f;
+        int contact;
+        {
+            py::gil_scoped_release rel;
+            contact =
+                spine_engine_track(eng_, p, timestamp, &row, &col,
+                                   &speed);
+        }
+        if (!contact) {
+            return py::make_tuple(py::none(), 0.0f);
+        }
+        return py::make_tuple(py::make_tuple(row, col), speed);
+    }
+
+    bool saveCalibration(const std::string &path) const
+    {
+        return spine_engine_save_calibration(eng_, path.c_str()) != 0;
+    }
+
+    bool loadCalibration(const std::string &path)
+    {
+        return spine_engine_load_calibration(eng_, path.c_str()) != 0;
+    }
+
+private:
+    SpineEngine *eng_ = nullptr;
+    uint32_t rows_;
+    uint32_t cols_;
+};
+
+/* ------------------------------------------------------------------ */
+/* Kernels                                                            */
+/* ------------------------------------------------------------------ */
+
+uint16_t thresholdAt(const py::sequence &thresholds, size_t i)
+{
+    return py::cast<uint16_t>(thresholds[i]);
+}
+
+py::array kernelClassify(const py::array &cells,
+                         const py::sequence &thresholds, py::object out)
+{
+    py::buffer_info info = cells.request();
+    size_t n = 1;
+    for (py::ssize_t d : info.shape) {
+        n *= static_cast<size_t>(d);
+    }
+    const uint16_t *src = checkedCells(cells, n);
+    if (py::len(thresholds) != 5) {
+        throw std::invalid_argument("thresholds: expected 5 cutoffs");
+    }
+    uint16_t th[5];
+    for (size_t i = 0; i < 5; i++) {
+        th[i] = thresholdAt(thresholds, i);
+    }
+
+    py::array dest;
+    if (out.is_none()) {
+        dest = py::array_t<uint8_t>(info.shape);
+    } else {
+        dest = py::cast<py::array>(out);
+    }
+    uint8_t *dst = checkedOut<uint8_t>(dest, n, "out");
+    {
+        py::gil_scoped_release rel;
+        grid_kernels_classify(src, dst, n, th);
+    }
+    return dest;
+}
+
+py::array kernelScale(const py::array &cells, uint16_t offset,
+                      uint16_t gain, py::object out)
+{
+    py::buffer_info info = cells.request();
+    size_t n = 1;
+    for (py::ssize_t d : info.shape) {
+        n *= static_cast<size_t>(d);
+    }
+    const uint16_t *src = checkedCells(cells, n);
+
+    py::array dest;
+    if (out.is_none()) {
+        dest = py::array_t<uint16_t>(info.shape);
+    } else {
+        dest = py::cast<py::array>(out);
+    }
+    uint16_t *dst = checkedOut<uint16_t>(dest, n, "out");
+    {
+        py::gil_scoped_release rel;
+        grid_kernels_scale(src, dst, n, offset, gain);
+    }
+    return dest;
+}
+
+GridKernelsReduce kernelReduce(const py::array &cells)
+{
+    py::buffer_info info = cells.request();
+    if (info.ndim != 2) {
+        throw std::invalid_argument("cells: expected a 2-D grid");
+    }
+    auto rows = static_cast<uint32_t>(info.shape[0]);
+    auto cols = static_cast<uint32_t>(info.shape[1]);
+    const uint16_t *src =
+        checkedCells(cells, static_cast<size_t>(rows) * cols);
+    GridKernelsReduce red;
+    {
+        py::gil_scoped_release rel;
+        grid_kernels_reduce(src, rows, cols, &red);
+    }
+    return red;
+}
+
+} // namespace
+
+PYBIND11_MODULE(griddecode_py, m)
+{
+    m.doc() = "Native grid decoder, pipeline, kernels and spine engine";
+
+    m.attr("EV_NONE") = static_cast<int>(GRID_DEC_EV_NONE);
+    m.attr("EV_FRAME") = static_cast<int>(GRID_DEC_EV_FRAME);
+    m.attr("EV_PREVIEW") = static_cast<int>(GRID_DEC_EV_PREVIEW);
+    m.attr("EV_STATS") = static_cast<int>(GRID_DEC_EV_STATS);
+    m.attr("EV_LOG") = static_cast<int>(GRID_DEC_EV_LOG);
+    m.attr("EV_BENCH") = static_cast<int>(GRID_DEC_EV_BENCH);
+    m.attr("META_SIZE") = static_cast<int>(GRID_DEC_META_SIZE);
+
+    py::class_<PyDecoder>(m, "Decoder")
+        .def(py::init<uint32_t, uint32_t>(), py::arg("rows"),
+             py::arg("cols"))
+        .def("set_cobs", &PyDecoder::setCobs, py::arg("enabled"))
+        .def("reset", &PyDecoder::reset)
+        .def("feed", &PyDecoder::feed, py::arg("data"))
+        .def("poll", &PyDecoder::poll)
+        .def("cells", &PyDecoder::cells)
+        .def("meta", &PyDecoder::meta)
+        .def("aux", &PyDecoder::aux)
+        .def_property_readonly("crc_errors", &PyDecoder::crcErrors)
+        .def_property_readonly("resyncs", &PyDecoder::resyncs);
+
+    py::class_<PyPipeline>(m, "Pipeline")
+        .def(py::init<uint32_t, uint32_t, bool>(), py::arg("rows"),
+             py::arg("cols"), py::arg("cobs") = false)
+        .def("reset", &PyPipeline::reset)
+        .def("feed", &PyPipeline::feed, py::arg("data"))
+        .def("next_analysis", &PyPipeline::nextAnalysis, py::arg("out"),
+             py::arg("timeout_ms") = 0)
+        .def("latest_render", &PyPipeline::latestRender, py::arg("out"))
+        .def("next_aux", &PyPipeline::nextAux)
+        .def("start_recording", &PyPipeline::startRecording,
+             py::arg("path"))
+        .def("stop_recording", &PyPipeline::stopRecording)
+        .def_property_readonly("recording_drops",
+                               &PyPipeline::recordingDrops)
+        .def_property_readonly("render_drops", &PyPipeline::renderDrops)
+        .def_property_readonly("crc_errors", &PyPipeline::crcErrors)
+        .def_property_readonly("resyncs", &PyPipeline::resyncs)
+        .def_property_readonly("rows", &PyPipeline::rows)
+        .def_property_readonly("cols", &PyPipeline::cols);
+
+    py::class_<PySpineEngine>(m, "SpineEngine")
+        .def(py::init<uint32_t, uint32_t>(), py::arg("rows"),
+             py::arg("cols"))
+        .def("set_min_pressure", &PySpineEngine::setMinPressure,
+             py::arg("threshold"))
+        .def("start_calibration", &PySpineEngine::startCalibration)
+        .def("add_calibration_frame",
+             &PySpineEngine::addCalibrationFrame, py::arg("cells"))
+        .def("finalize_calibration",
+             &PySpineEngine::finalizeCalibration)
+        .def_property_readonly("is_calibrated",
+                               &PySpineEngine::isCalibrated)
+        .def("landmarks", &PySpineEngine::landmarks)
+        .def("spine_line", &PySpineEngine::spineLine)
+        .def("update_landmark", &PySpineEngine::updateLandmark,
+             py::arg("level"), py::arg("type"), py::arg("row"),
+             py::arg("col"))
+        .def("nearest_landmark", &PySpineEngine::nearestLandmark,
+             py::arg("row"), py::arg("col"))
+        .def("track", &PySpineEngine::track, py::arg("cells"),
+             py::arg("timestamp"))
+        .def("save_calibration", &PySpineEngine::saveCalibration,
+             py::arg("path"))
+        .def("load_calibration", &PySpineEngine::loadCalibration,
+             py::arg("path"));
+
+    py::class_<GridKernelsReduce>(m, "Reduce")
+        .def_readonly("min_val", &GridKernelsReduce::minVal)
+        .def_readonly("max_val", &GridKernelsReduce::maxVal)
+        .def_readonly("max_idx", &GridKernelsReduce::maxIdx)
+        .def_readonly("sum", &GridKernelsReduce::sum)
+        .def_readonly("centroid_row", &GridKernelsReduce::centroidRow)
+        .def_readonly("centroid_col", &GridKernelsReduce::centroidCol);
+
+    m.def("classify", &kernelClassify, py::arg("cells"),
+          py::arg("thresholds"), py::arg("out") = py::none(),
+          "Palpation-zone classification (grid_kernels_classify)");
+    m.def("scale", &kernelScale, py::arg("cells"), py::arg("offset"),
+          py::arg("gain"), py::arg("out") = py::none(),
+          "Baseline-relative scaling, 8.8 fixed-point gain");
+    m.def("reduce", &kernelReduce, py::arg("cells"),
+          "Min/max/sum/centroid in one sweep (grid_kernels_reduce)");
+}
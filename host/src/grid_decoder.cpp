@@ -0,0 +1,927 @@
+/**
+ ******************************************************************************
+ * @file           : grid_decoder.cpp
+ * @brief          : Native frame decoder implementation
+ ******************************************************************************
+ *
+ * Mirrors the wire format in Core/Inc/grid_scan.h and the parsing rules
+ * of the GUI's pure-Python reader. One deliberate improvement over the
+ * Python parser: a packet failing its CRC is not skipped whole (a
+ * corrupt length field would swallow good bytes) - only its two sync
+ * bytes are dropped and the search resumes, so recovery never costs
+ * more than one packet.
+ *
+ * The input path is a single-producer single-consumer ring. Where the
+ * platform allows it (memfd/shm + double mmap) the ring's backing pages
+ * are mapped twice back to back, so the valid region is always
+ * contiguous in virtual memory even across the wrap - packets are
+ * parsed in place with no reassembly copies, and producer/consumer
+ * synchronize through two atomic positions with no lock. Without the
+ * mirror the ring degrades to a sliding linear buffer (same API,
+ * single-threaded use). Consumption is deferred by one poll so that
+ * meta/aux event pointers into the ring stay valid while the caller
+ * looks at them.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_decoder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GRID_DEC_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#else
+#define GRID_DEC_HAVE_MMAP 0
+#endif
+
+namespace {
+
+/* Wire constants, kept in lockstep with Core/Inc/grid_scan.h */
+constexpr uint8_t kSync1 = 0xAA;
+constexpr uint8_t kSyncFull = 0x55;
+constexpr uint8_t kSyncPreview = 0x56;
+constexpr uint8_t kSyncPacked = 0x57;
+constexpr uint8_t kSyncDelta = 0x58;
+constexpr uint8_t kSyncRle = 0x59;
+constexpr uint8_t kSyncStats = 0x5A;
+constexpr uint8_t kSyncAgg = 0x5B;
+constexpr uint8_t kSyncLog = 0x5C;
+constexpr uint8_t kSyncBench = 0x5D;
+constexpr uint8_t kSyncRow = 0x5E;
+constexpr uint8_t kSyncField = 0x5F;
+
+constexpr size_t kHeaderSize = 2;
+constexpr size_t kMetaSize = GRID_DEC_META_SIZE;
+constexpr size_t kFooterSize = 6;      /* CRC32 LE + CR + LF */
+constexpr size_t kVarHdrSize = 4;      /* log/agg/rle/delta sub-header */
+
+/* PACKET_STATS_PAYLOAD_SIZE / PACKET_BENCH_PAYLOAD_SIZE */
+constexpr size_t kStatsPayloadSize = 80;
+constexpr size_t kBenchPayloadSize = 64;
+
+/* Ring capacity (power of two, page multiple): ~200 full frame packets,
+ * several seconds of stream even at the 2 Mbaud profile */
+constexpr size_t kRingCapacity = size_t{1} << 18;
+
+inline uint16_t readU16(const uint8_t *p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readU32(const uint8_t *p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/* CRC-32 (IEEE, zlib-compatible), table-driven - same polynomial the
+ * MCU's hardware unit is coaxed into (see GRID_CrcBlock) */
+uint32_t crc32(const uint8_t *data, size_t len)
+{
+    static uint32_t table[256];
+    static bool init = false;
+    if (!init) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[n] = c;
+        }
+        init = true;
+    }
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        c = table[(c ^ data[i]) & 0xFFu] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+/**
+ * SPSC byte ring. Mirrored mode maps the same physical pages twice back
+ * to back, so [head, tail) is always one contiguous span of virtual
+ * memory and both sides work lock-free through the atomic positions.
+ * Fallback mode keeps a double-size linear buffer and slides the
+ * unconsumed remainder to the front when the write cursor hits the end
+ * (amortized one small move per traversal, single-threaded use only).
+ */
+class ByteRing {
+public:
+    ~ByteRing()
+    {
+#if GRID_DEC_HAVE_MMAP
+        if (mirrored_) {
+            munmap(base_, 2 * cap_);
+            base_ = nullptr;
+        }
+#endif
+        std::free(linear_);
+    }
+
+    bool init(size_t capacity)
+    {
+        cap_ = capacity;
+#if GRID_DEC_HAVE_MMAP
+        if (initMirror()) {
+            return true;
+        }
+#endif
+        linear_ = static_cast<uint8_t *>(std::malloc(2 * cap_));
+        base_ = linear_;
+        return base_ != nullptr;
+    }
+
+    /* Producer: contiguous space for a bulk write */
+    uint8_t *reserve(size_t *avail)
+    {
+        uint64_t h = head_.load(std::memory_order_acquire);
+        uint64_t t = tail_.load(std::memory_order_relaxed);
+
+        if (mirrored_) {
+            *avail = cap_ - static_cast<size_t>(t - h);
+            return base_ + (t & (cap_ - 1));
+        }
+
+        /* Linear fallback: slide the live region home when the write
+         * cursor has exhausted the slack half */
+        if (static_cast<size_t>(t) == 2 * cap_) {
+            std::memmove(base_, base_ + h, static_cast<size_t>(t - h));
+            t -= h;
+            h = 0;
+            head_.store(0, std::memory_order_relaxed);
+            tail_.store(t, std::memory_order_relaxed);
+        }
+        size_t used = static_cast<size_t>(t - h);
+        size_t space = 2 * cap_ - static_cast<size_t>(t);
+        size_t budget = (used < cap_) ? (cap_ - used) : 0;
+        *avail = (space < budget) ? space : budget;
+        return base_ + t;
+    }
+
+    void commit(size_t n)
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + n,
+                    std::memory_order_release);
+    }
+
+    /* Consumer: the valid region, always contiguous */
+    const uint8_t *window(size_t *avail)
+    {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        uint64_t t = tail_.load(std::memory_order_acquire);
+        *avail = static_cast<size_t>(t - h);
+        return base_ + (mirrored_ ? (h & (cap_ - 1))
+                                  : static_cast<size_t>(h));
+    }
+
+    void consume(size_t n)
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + n,
+                    std::memory_order_release);
+    }
+
+    void clear()
+    {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_release);
+    }
+
+    size_t capacity() const { return cap_; }
+
+private:
+#if GRID_DEC_HAVE_MMAP
+    bool initMirror()
+    {
+        int fd = -1;
+#if defined(__linux__)
+        fd = static_cast<int>(syscall(SYS_memfd_create, "griddecode", 0));
+#else
+        char name[64];
+        std::snprintf(name, sizeof(name), "/griddecode-%d", getpid());
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            shm_unlink(name);
+        }
+#endif
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(cap_)) != 0) {
+            close(fd);
+            return false;
+        }
+
+        /* Reserve a 2x window, then pin the file into both halves */
+        void *span = mmap(nullptr, 2 * cap_, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (span == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        uint8_t *b = static_cast<uint8_t *>(span);
+        if (mmap(b, cap_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+            mmap(b + cap_, cap_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            munmap(span, 2 * cap_);
+            close(fd);
+            return false;
+        }
+        close(fd);
+        base_ = b;
+        mirrored_ = true;
+        return true;
+    }
+#endif
+
+    uint8_t *base_ = nullptr;
+    uint8_t *linear_ = nullptr;     /* Owned allocation (fallback mode) */
+    size_t cap_ = 0;
+    bool mirrored_ = false;
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> tail_{0};
+};
+
+} // namespace
+
+struct GridDecoder {
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    uint32_t total = 0;
+
+    bool cobs = false;
+
+    /* Raw bytes awaiting COBS chunk completion (COBS mode only) */
+    std::vector<uint8_t> raw;
+
+    /* Deframed byte stream; packets are parsed in place */
+    ByteRing ring;
+
+    /* Bytes of the ring window already handed out through an event;
+     * consumed at the top of the next poll so views stay valid */
+    size_t pendingConsume = 0;
+
+    /* Sync-search resume point: bytes from the window start already
+     * known to hold no sync pair (never rescanned) */
+    size_t scanned = 0;
+
+    /* Keyframe reconstruction state (deltas and RLE resolve into it) */
+    std::vector<uint16_t> state;
+    /* Preview frames decode here so they never disturb the keyframe */
+    std::vector<uint16_t> preview;
+
+    /* Aggregate packet mid-drain: units left to surface, offsets
+     * relative to the window start (the packet stays unconsumed) */
+    size_t aggRemaining = 0;
+    size_t aggUnitSize = 0;
+    size_t aggOffset = 0;
+    size_t aggPacketSize = 0;
+
+    uint32_t crcErrors = 0;
+    uint32_t resyncs = 0;
+
+    /* Link-quality accounting (updated per decoded frame) */
+    uint32_t linkFrames = 0;
+    uint32_t linkRecovered = 0;    /* Frames right after a resync */
+    uint32_t linkLastResyncs = 0;
+    uint32_t linkSeqGaps = 0;
+    uint32_t linkFramesMissed = 0;
+    bool linkHaveSeq = false;
+    uint32_t linkLastSeq = 0;
+    bool linkHaveArrival = false;
+    double linkPrevArrivalMs = 0;
+    /* Inter-arrival histogram, 1 ms bins, last bin is overflow */
+    uint32_t linkHist[GRID_DEC_JITTER_BINS] = {0};
+    uint64_t linkHistCount = 0;
+};
+
+namespace {
+
+inline bool isSync2(uint8_t b)
+{
+    return b >= kSyncFull && b <= kSyncField;
+}
+
+/* Decode one COBS chunk (delimiter already stripped) into the ring;
+ * malformed chunks are discarded whole so alignment survives a dropped
+ * byte. Written through reserve/commit, published only when valid. */
+void cobsDecodeChunk(GridDecoder *d, const uint8_t *p, size_t n)
+{
+    size_t space = 0;
+    uint8_t *out = d->ring.reserve(&space);
+    if (out == nullptr || space < n) {
+        return;                     /* Ring full: drop the chunk */
+    }
+
+    size_t w = 0;
+    size_t i = 0;
+    while (i < n) {
+        uint8_t code = p[i];
+        if (code == 0 || i + code > n) {
+            return;                 /* Malformed: nothing committed */
+        }
+        std::memcpy(out + w, p + i + 1, code - 1u);
+        w += code - 1u;
+        i += code;
+        if (code < 0xFF && i < n) {
+            out[w++] = 0;
+        }
+    }
+    d->ring.commit(w);
+}
+
+/* Expand one frame payload (16-bit raw or 12-bit packed, distinguished
+ * by length) into out[total]; returns false on a size mismatch */
+bool decodeFramePayload(const GridDecoder *d, const uint8_t *body,
+                        size_t len, uint16_t *out)
+{
+    if (len == static_cast<size_t>(d->total) * 2) {
+        for (uint32_t i = 0; i < d->total; i++) {
+            out[i] = readU16(body + 2 * i);
+        }
+        return true;
+    }
+    if (len == static_cast<size_t>(d->total) * 3 / 2) {
+        /* Two cells per 3-byte triplet; values were sent as val >> 4,
+         * so shift back up for consistent scaling */
+        for (uint32_t i = 0; i < d->total / 2; i++) {
+            const uint8_t *t = body + 3 * i;
+            uint16_t a = static_cast<uint16_t>(t[0] | ((t[1] & 0x0F) << 8));
+            uint16_t b = static_cast<uint16_t>((t[1] >> 4) | (t[2] << 4));
+            out[2 * i] = static_cast<uint16_t>(a << 4);
+            out[2 * i + 1] = static_cast<uint16_t>(b << 4);
+        }
+        return true;
+    }
+    return false;
+}
+
+/* Surface the next queued aggregate unit as a frame event */
+bool emitAggUnit(GridDecoder *d, const uint8_t *window,
+                 GridDecoderEvent *event)
+{
+    const uint8_t *unit = window + d->aggOffset;
+    size_t bodyLen = d->aggUnitSize - kMetaSize;
+
+    bool ok = decodeFramePayload(d, unit, bodyLen, d->state.data());
+    const uint8_t *meta = unit + bodyLen;
+
+    d->aggOffset += d->aggUnitSize;
+    d->aggRemaining--;
+    if (d->aggRemaining == 0) {
+        d->pendingConsume = d->aggPacketSize;
+    }
+
+    if (!ok) {
+        return false;
+    }
+    event->type = GRID_DEC_EV_FRAME;
+    event->rows = d->rows;
+    event->cols = d->cols;
+    event->cells = d->state.data();
+    event->meta = meta;
+    event->aux = nullptr;
+    event->aux_len = 0;
+    return true;
+}
+
+/* Fold one decoded frame into the link accounting: recovery after a
+ * resync, firmware sequence-number gaps, and the inter-arrival
+ * histogram the percentiles are read from */
+void recordFrameLink(GridDecoder *d, const uint8_t *meta)
+{
+    d->linkFrames++;
+    if (d->resyncs != d->linkLastResyncs) {
+        d->linkRecovered++;
+        d->linkLastResyncs = d->resyncs;
+    }
+    if (meta != nullptr) {
+        uint32_t seq = readU32(meta + 12);
+        if (d->linkHaveSeq) {
+            uint32_t gap = seq - d->linkLastSeq;
+            if (gap > 1 && gap < 0x80000000u) {
+                d->linkSeqGaps++;
+                d->linkFramesMissed += gap - 1;
+            }
+        }
+        d->linkHaveSeq = true;
+        d->linkLastSeq = seq;
+    }
+    double now = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+    if (d->linkHaveArrival) {
+        double delta = now - d->linkPrevArrivalMs;
+        size_t bin = (delta < 0) ? 0 : static_cast<size_t>(delta);
+        if (bin >= GRID_DEC_JITTER_BINS) {
+            bin = GRID_DEC_JITTER_BINS - 1;
+        }
+        d->linkHist[bin]++;
+        d->linkHistCount++;
+    }
+    d->linkHaveArrival = true;
+    d->linkPrevArrivalMs = now;
+}
+
+} // namespace
+
+GridDecoder *grid_decoder_create(uint32_t rows, uint32_t cols)
+{
+    if (rows == 0 || cols == 0 || (rows & 1) || (cols & 1)) {
+        return nullptr;
+    }
+    auto *d = new (std::nothrow) GridDecoder();
+    if (d == nullptr) {
+        return nullptr;
+    }
+    if (!d->ring.init(kRingCapacity)) {
+        delete d;
+        return nullptr;
+    }
+    d->rows = rows;
+    d->cols = cols;
+    d->total = rows * cols;
+    d->state.assign(d->total, 0);
+    d->preview.assign(d->total, 0);
+    return d;
+}
+
+void grid_decoder_destroy(GridDecoder *dec)
+{
+    delete dec;
+}
+
+void grid_decoder_set_cobs(GridDecoder *dec, int enabled)
+{
+    if (dec != nullptr) {
+        dec->cobs = (enabled != 0);
+    }
+}
+
+void grid_decoder_reset(GridDecoder *dec)
+{
+    if (dec == nullptr) {
+        return;
+    }
+    dec->raw.clear();
+    dec->ring.clear();
+    dec->pendingConsume = 0;
+    dec->scanned = 0;
+    dec->aggRemaining = 0;
+}
+
+uint8_t *grid_decoder_reserve(GridDecoder *dec, size_t *avail)
+{
+    if (dec == nullptr || avail == nullptr) {
+        return nullptr;
+    }
+    if (dec->cobs) {
+        /* COBS bytes must pass through feed() for deframing */
+        *avail = 0;
+        return nullptr;
+    }
+    uint8_t *p = dec->ring.reserve(avail);
+    return (*avail > 0) ? p : nullptr;
+}
+
+void grid_decoder_commit(GridDecoder *dec, size_t len)
+{
+    if (dec != nullptr && len > 0) {
+        dec->ring.commit(len);
+    }
+}
+
+size_t grid_decoder_feed(GridDecoder *dec, const uint8_t *data, size_t len)
+{
+    if (dec == nullptr || data == nullptr) {
+        return 0;
+    }
+    if (!dec->cobs) {
+        size_t space = 0;
+        uint8_t *p = dec->ring.reserve(&space);
+        size_t n = (len < space) ? len : space;
+        if (p != nullptr && n > 0) {
+            std::memcpy(p, data, n);
+            dec->ring.commit(n);
+        }
+        return n;
+    }
+
+    dec->raw.insert(dec->raw.end(), data, data + len);
+    size_t start = 0;
+    for (size_t i = 0; i < dec->raw.size(); i++) {
+        if (dec->raw[i] == 0) {      /* COBS delimiter */
+            cobsDecodeChunk(dec, dec->raw.data() + start, i - start);
+            start = i + 1;
+        }
+    }
+    dec->raw.erase(dec->raw.begin(),
+                   dec->raw.begin() + static_cast<long>(start));
+    return len;
+}
+
+int grid_decoder_poll(GridDecoder *dec, GridDecoderEvent *event)
+{
+    if (dec == nullptr || event == nullptr) {
+        return 0;
+    }
+    std::memset(event, 0, sizeof(*event));
+    event->type = GRID_DEC_EV_NONE;
+
+    size_t avail = 0;
+    const uint8_t *win = dec->ring.window(&avail);
+
+    /* Drain a validated aggregate packet one unit per poll (the packet
+     * body stays unconsumed in the ring until the last unit) */
+    while (dec->aggRemaining > 0) {
+        if (emitAggUnit(dec, win, event)) {
+            return 1;
+        }
+    }
+
+    /* Now that the caller is done with last poll's views, retire them */
+    if (dec->pendingConsume > 0) {
+        dec->ring.consume(dec->pendingConsume);
+        dec->pendingConsume = 0;
+        dec->scanned = 0;
+        win = dec->ring.window(&avail);
+    }
+
+    const size_t payloadFull = static_cast<size_t>(dec->total) * 2;
+    const size_t payloadPacked = static_cast<size_t>(dec->total) * 3 / 2;
+    const size_t payloadPreview = payloadFull / 4;
+
+    for (;;) {
+        if (avail < kHeaderSize) {
+            return 0;
+        }
+        const uint8_t *p = win;
+
+        /* Incremental sync search: resume where the last pass stopped
+         * instead of rescanning bytes already known to be clean */
+        size_t skip = dec->scanned;
+        while (skip + 1 < avail &&
+               !(p[skip] == kSync1 && isSync2(p[skip + 1]))) {
+            skip++;
+        }
+        if (skip + 1 >= avail) {
+            /* No sync pair yet: remember the clean prefix, but keep the
+             * final byte unjudged (it may be half a split pair) */
+            dec->scanned = skip;
+            if (skip > 0) {
+                dec->ring.consume(skip);
+                dec->scanned = 0;
+                dec->resyncs++;
+            }
+            return 0;
+        }
+        if (skip > 0) {
+            dec->ring.consume(skip);
+            dec->resyncs++;
+            win = dec->ring.window(&avail);
+            p = win;
+        }
+        dec->scanned = 0;
+
+        /* Work out this packet's size (some types carry their length) */
+        uint8_t type = p[1];
+        size_t payloadSize = 0;
+        size_t metaSize = 0;
+
+        switch (type) {
+        case kSyncFull:
+            payloadSize = payloadFull;
+            metaSize = kMetaSize;
+            break;
+        case kSyncPacked:
+            payloadSize = payloadPacked;
+            metaSize = kMetaSize;
+            break;
+        case kSyncPreview:
+            payloadSize = payloadPreview;
+            break;
+        case kSyncStats:
+            payloadSize = kStatsPayloadSize;
+            break;
+        case kSyncBench:
+            payloadSize = kBenchPayloadSize;
+            break;
+        case kSyncRow:
+            /* row + pad + sequence, then one row of cells */
+            payloadSize = kVarHdrSize +
+                          static_cast<size_t>(dec->cols) * 2;
+            break;
+        case kSyncField:
+            /* parity + pad + sequence, then half the rows of cells */
+            payloadSize = kVarHdrSize +
+                          static_cast<size_t>(dec->rows / 2) *
+                              dec->cols * 2;
+            metaSize = kMetaSize;
+            break;
+        case kSyncDelta:
+            if (avail < kHeaderSize + kVarHdrSize) {
+                return 0;
+            }
+            payloadSize = kVarHdrSize + 4u * readU16(p + kHeaderSize);
+            metaSize = kMetaSize;
+            break;
+        case kSyncRle:
+            if (avail < kHeaderSize + kVarHdrSize) {
+                return 0;
+            }
+            payloadSize = kVarHdrSize +
+                          ((readU16(p + kHeaderSize) + 3u) & ~size_t{3});
+            metaSize = kMetaSize;
+            break;
+        case kSyncLog:
+            if (avail < kHeaderSize + kVarHdrSize) {
+                return 0;
+            }
+            payloadSize = kVarHdrSize +
+                          ((readU16(p + kHeaderSize) + 3u) & ~size_t{3});
+            break;
+        case kSyncAgg:
+            if (avail < kHeaderSize + kVarHdrSize) {
+                return 0;
+            }
+            payloadSize = kVarHdrSize +
+                          static_cast<size_t>(p[kHeaderSize]) *
+                              readU16(p + kHeaderSize + 2);
+            break;
+        default:
+            /* Unreachable: isSync2 gated the type */
+            dec->ring.consume(1);
+            win = dec->ring.window(&avail);
+            continue;
+        }
+
+        size_t packetSize = kHeaderSize + payloadSize + metaSize +
+                            kFooterSize;
+        if (packetSize > dec->ring.capacity() / 2) {
+            /* A length field this large is corruption - it could never
+             * complete. Drop the sync pair and resume */
+            dec->crcErrors++;
+            dec->ring.consume(kHeaderSize);
+            win = dec->ring.window(&avail);
+            continue;
+        }
+        if (avail < packetSize) {
+            return 0;
+        }
+
+        /* CRC covers payload plus (for full frame flavours) metadata */
+        const uint8_t *payload = p + kHeaderSize;
+        uint32_t expected = readU32(payload + payloadSize + metaSize);
+        if (crc32(payload, payloadSize + metaSize) != expected) {
+            /* Drop only the sync pair: a corrupt length field must not
+             * be allowed to swallow the packets behind it */
+            dec->crcErrors++;
+            dec->ring.consume(kHeaderSize);
+            win = dec->ring.window(&avail);
+            continue;
+        }
+
+        /* Metadata is a view into the ring; pendingConsume keeps the
+         * bytes alive until the caller's next poll */
+        const uint8_t *meta =
+            (metaSize != 0) ? payload + payloadSize : nullptr;
+
+        switch (type) {
+        case kSyncFull:
+        case kSyncPacked:
+            decodeFramePayload(dec, payload, payloadSize,
+                               dec->state.data());
+            event->type = GRID_DEC_EV_FRAME;
+            event->cells = dec->state.data();
+            event->meta = meta;
+            break;
+
+        case kSyncDelta: {
+            /* Apply changed cells to the keyframe state */
+            uint16_t count = readU16(payload);
+            const uint8_t *pair = payload + kVarHdrSize;
+            for (uint16_t k = 0; k < count; k++, pair += 4) {
+                uint16_t idx = readU16(pair);
+                if (idx < dec->total) {
+                    dec->state[idx] = readU16(pair + 2);
+                }
+            }
+            event->type = GRID_DEC_EV_FRAME;
+            event->cells = dec->state.data();
+            event->meta = meta;
+            break;
+        }
+
+        case kSyncRle: {
+            /* Expand (zero-run, literal-count, literals...) tokens; a
+             * complete frame, so it doubles as a delta keyframe */
+            uint16_t encLen = readU16(payload);
+            const uint8_t *body = payload + kVarHdrSize;
+            std::memset(dec->state.data(), 0,
+                        dec->state.size() * sizeof(uint16_t));
+            size_t pos = 0;
+            size_t cell = 0;
+            while (pos + 4 <= encLen && cell <= dec->total) {
+                uint16_t zeros = readU16(body + pos);
+                uint16_t lits = readU16(body + pos + 2);
+                pos += 4;
+                cell += zeros;
+                if (cell + lits > dec->total || pos + 2u * lits > encLen) {
+                    break;
+                }
+                for (uint16_t k = 0; k < lits; k++) {
+                    dec->state[cell + k] = readU16(body + pos + 2 * k);
+                }
+                cell += lits;
+                pos += 2u * lits;
+            }
+            event->type = GRID_DEC_EV_FRAME;
+            event->cells = dec->state.data();
+            event->meta = meta;
+            break;
+        }
+
+        case kSyncPreview: {
+            /* Nearest-neighbour upsample so downstream consumers see
+             * the usual full-grid shape (matches the Python parser) */
+            uint32_t prows = dec->rows / 2;
+            uint32_t pcols = dec->cols / 2;
+            for (uint32_t r = 0; r < prows; r++) {
+                for (uint32_t c = 0; c < pcols; c++) {
+                    uint16_t v = readU16(payload + 2 * (r * pcols + c));
+                    uint16_t *q0 = dec->preview.data() +
+                                   (2 * r) * dec->cols + 2 * c;
+                    uint16_t *q1 = q0 + dec->cols;
+                    q0[0] = q0[1] = q1[0] = q1[1] = v;
+                }
+            }
+            event->type = GRID_DEC_EV_PREVIEW;
+            event->cells = dec->preview.data();
+            break;
+        }
+
+        case kSyncRow: {
+            /* Streamed row: patch it into the keyframe state and
+             * surface the whole grid immediately - per-row refresh is
+             * the point of the mode. No metadata ships row-streamed */
+            uint32_t row = payload[0];
+            if (row < dec->rows) {
+                for (uint32_t c = 0; c < dec->cols; c++) {
+                    dec->state[row * dec->cols + c] =
+                        readU16(payload + kVarHdrSize + 2 * c);
+                }
+            }
+            event->type = GRID_DEC_EV_FRAME;
+            event->cells = dec->state.data();
+            break;
+        }
+
+        case kSyncField: {
+            /* Interlaced half-frame: merge this parity's rows into the
+             * keyframe state and surface the whole grid - field-rate
+             * refresh at unchanged baud is the point of the mode */
+            uint32_t parity = payload[0] & 1u;
+            const uint8_t *cell = payload + kVarHdrSize;
+            for (uint32_t r = parity; r < dec->rows; r += 2) {
+                for (uint32_t c = 0; c < dec->cols; c++, cell += 2) {
+                    dec->state[r * dec->cols + c] = readU16(cell);
+                }
+            }
+            event->type = GRID_DEC_EV_FRAME;
+            event->cells = dec->state.data();
+            event->meta = meta;
+            break;
+        }
+
+        case kSyncStats:
+        case kSyncBench:
+            /* Raw payload as a ring view - the GUI unpacks these */
+            event->type = (type == kSyncStats) ? GRID_DEC_EV_STATS
+                                               : GRID_DEC_EV_BENCH;
+            event->aux = payload;
+            event->aux_len = static_cast<uint32_t>(payloadSize);
+            break;
+
+        case kSyncLog: {
+            uint16_t textLen = readU16(payload);
+            if (static_cast<size_t>(textLen) >
+                    payloadSize - kVarHdrSize) {
+                textLen = static_cast<uint16_t>(payloadSize - kVarHdrSize);
+            }
+            event->type = GRID_DEC_EV_LOG;
+            event->aux = payload + kVarHdrSize;
+            event->aux_len = textLen;
+            break;
+        }
+
+        case kSyncAgg: {
+            /* Queue the units, then surface them one poll at a time;
+             * the packet is only consumed after its last unit */
+            size_t count = p[kHeaderSize];
+            size_t unit = readU16(p + kHeaderSize + 2);
+            if (count > 0 && unit > kMetaSize) {
+                dec->aggRemaining = count;
+                dec->aggUnitSize = unit;
+                dec->aggOffset = kHeaderSize + kVarHdrSize;
+                dec->aggPacketSize = packetSize;
+            } else {
+                dec->pendingConsume = packetSize;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        event->rows = dec->rows;
+        event->cols = dec->cols;
+
+        if (event->type != GRID_DEC_EV_NONE) {
+            dec->pendingConsume = packetSize;
+            if (event->type == GRID_DEC_EV_FRAME) {
+                recordFrameLink(dec, event->meta);
+            }
+            return 1;
+        }
+        while (dec->aggRemaining > 0) {
+            if (emitAggUnit(dec, win, event)) {
+                recordFrameLink(dec, event->meta);
+                return 1;
+            }
+        }
+        /* Valid but eventless (e.g. empty aggregate): keep parsing */
+        if (dec->pendingConsume > 0) {
+            dec->ring.consume(dec->pendingConsume);
+            dec->pendingConsume = 0;
+        }
+        win = dec->ring.window(&avail);
+    }
+}
+
+uint32_t grid_decoder_crc_errors(const GridDecoder *dec)
+{
+    return (dec != nullptr) ? dec->crcErrors : 0;
+}
+
+uint32_t grid_decoder_resyncs(const GridDecoder *dec)
+{
+    return (dec != nullptr) ? dec->resyncs : 0;
+}
+
+namespace {
+
+/* Percentile out of the 1 ms inter-arrival histogram: the bin whose
+ * cumulative count crosses the rank, as its midpoint */
+float histPercentile(const GridDecoder *dec, double p)
+{
+    if (dec->linkHistCount == 0) {
+        return 0.0f;
+    }
+    uint64_t rank = static_cast<uint64_t>(
+        p * static_cast<double>(dec->linkHistCount - 1));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < GRID_DEC_JITTER_BINS; b++) {
+        seen += dec->linkHist[b];
+        if (seen > rank) {
+            return static_cast<float>(b) + 0.5f;
+        }
+    }
+    return static_cast<float>(GRID_DEC_JITTER_BINS);
+}
+
+} // namespace
+
+void grid_decoder_link_stats(const GridDecoder *dec, GridLinkStats *out)
+{
+    if (out == nullptr) {
+        return;
+    }
+    std::memset(out, 0, sizeof(*out));
+    if (dec == nullptr) {
+        return;
+    }
+    out->frames = dec->linkFrames;
+    out->crcErrors = dec->crcErrors;
+    out->resyncs = dec->resyncs;
+    out->recoveredFrames = dec->linkRecovered;
+    out->seqGaps = dec->linkSeqGaps;
+    out->framesMissed = dec->linkFramesMissed;
+    out->arrivalP50Ms = histPercentile(dec, 0.50);
+    out->arrivalP90Ms = histPercentile(dec, 0.90);
+    out->arrivalP99Ms = histPercentile(dec, 0.99);
+}
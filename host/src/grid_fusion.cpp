@@ -0,0 +1,408 @@
+/**
+ ******************************************************************************
+ * @file           : grid_fusion.cpp
+ * @brief          : Multi-device frame fusion implementation
+ ******************************************************************************
+ *
+ * Per device: a GridDecoder, a small deque of pending decoded frames
+ * (each stamped with its host arrival time), and the clock model. Feed
+ * calls drain the device's decoder under that device's mutex, so every
+ * serial thread runs independently; poll takes the mutexes one at a
+ * time and never holds two at once.
+ *
+ * Clock model per device, mapping device uptime d onto host time h:
+ *
+ *   offset(d) = base + drift * d,   h ~= d + offset(d)
+ *
+ * Offset samples o = h_arrival - d carry one-sided jitter (USB and
+ * scheduling only ever delay arrival), so base snaps down to any
+ * smaller sample and creeps up slowly otherwise. Drift comes from an
+ * exponentially-forgetting least-squares fit of o against d - crystal
+ * drift is tens of ppm, visible within a minute of samples, and the
+ * forgetting factor lets the fit follow thermal changes.
+ *
+ * Matching walks the reference deque front: frames older than the
+ * tolerance with no partner on some device are dropped (counted);
+ * otherwise the closest-in-corrected-time partner from each device
+ * must lie inside the tolerance for the set to fuse. Older partner
+ * frames are discarded on a match - the streams only move forward.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_fusion.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+/* Pending frames kept per device; at 25 fps this is ~300 ms of slack
+ * before the oldest is discarded */
+constexpr size_t kPendingDepth = 8;
+
+/* Metadata offsets (PACKET_META_SIZE layout in Core/Inc/grid_scan.h) */
+constexpr size_t kMetaSeqOffset = 12;
+constexpr size_t kMetaStampOffset = 16;
+
+/* Clock model tuning: slow upward creep against one-sided jitter, and
+ * a forgetting factor giving the drift fit a ~1000-sample memory */
+constexpr double kOffsetCreep = 0.005;
+constexpr double kFitForget = 0.999;
+constexpr double kFitMinSamples = 50.0;
+
+double hostNowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(
+               steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint32_t readU32(const uint8_t *p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+struct PendingFrame {
+    std::vector<uint16_t> cells;
+    uint32_t seq = 0;
+    double correctedMs = 0;     /* Device stamp mapped onto host time */
+};
+
+struct ClockModel {
+    bool primed = false;
+    double base = 0;            /* Offset at devRef */
+    double devRef = 0;          /* Device time the fit is centred on */
+    /* Forgetting least-squares accumulators for offset vs (d-devRef) */
+    double sw = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    double drift = 0;           /* d(offset)/d(deviceMs) */
+
+    /* Fold one offset sample and return the corrected host time */
+    double update(double devMs, double hostMs)
+    {
+        const double o = hostMs - devMs;
+        if (!primed) {
+            primed = true;
+            base = o;
+            devRef = devMs;
+        } else if (o < base + drift * (devMs - devRef)) {
+            /* A cleaner (less delayed) sample: snap the base down */
+            base = o - drift * (devMs - devRef);
+        } else {
+            base += kOffsetCreep * (o - (base + drift * (devMs - devRef)));
+        }
+
+        const double x = devMs - devRef;
+        sw = sw * kFitForget + 1.0;
+        sx = sx * kFitForget + x;
+        sy = sy * kFitForget + o;
+        sxx = sxx * kFitForget + x * x;
+        sxy = sxy * kFitForget + x * o;
+        const double denom = sw * sxx - sx * sx;
+        if (sw >= kFitMinSamples && denom > 0) {
+            drift = (sw * sxy - sx * sy) / denom;
+        }
+        return devMs + base + drift * (devMs - devRef);
+    }
+
+    double offset() const { return primed ? base : 0.0; }
+    double driftPpm() const { return drift * 1e6; }
+};
+
+struct Device {
+    GridDecoder *dec = nullptr;
+    std::mutex mtx;             /* Guards dec, pending and clock */
+    std::deque<PendingFrame> pending;
+    ClockModel clock;
+    uint32_t overflowDrops = 0;
+};
+
+} // namespace
+
+struct GridFusion {
+    uint32_t rows = 0, cols = 0;
+    uint32_t deviceCount = 0;
+    int stackRows = 1;
+    uint32_t fusedRows = 0, fusedCols = 0;
+    double toleranceMs = 20.0;
+
+    Device devices[GRID_FUSION_MAX_DEVICES];
+
+    uint32_t fusedSeq = 0;
+    uint32_t drops = 0;
+};
+
+namespace {
+
+/* Drain every complete frame out of one device's decoder (its mutex
+ * held by the caller). Frames without metadata - previews, streamed
+ * rows - have no scan timestamp and do not take part in fusion */
+void drainDevice(GridFusion *f, Device &dev)
+{
+    GridDecoderEvent ev;
+    const double now = hostNowMs();
+    while (grid_decoder_poll(dev.dec, &ev)) {
+        if (ev.type != GRID_DEC_EV_FRAME || ev.cells == nullptr ||
+            ev.meta == nullptr) {
+            continue;
+        }
+        if (dev.pending.size() >= kPendingDepth) {
+            dev.pending.pop_front();
+            dev.overflowDrops++;
+        }
+        PendingFrame pf;
+        pf.cells.assign(ev.cells,
+                        ev.cells + static_cast<size_t>(f->rows) * f->cols);
+        pf.seq = readU32(ev.meta + kMetaSeqOffset);
+        pf.correctedMs = dev.clock.update(
+            static_cast<double>(readU32(ev.meta + kMetaStampOffset)), now);
+        dev.pending.push_back(std::move(pf));
+    }
+}
+
+/* Copy one device's frame into its tile of the fused buffer */
+void blit(GridFusion *f, uint32_t device, const uint16_t *src,
+          uint16_t *dst)
+{
+    if (f->stackRows) {
+        std::memcpy(dst + static_cast<size_t>(device) * f->rows * f->cols,
+                    src, static_cast<size_t>(f->rows) * f->cols *
+                             sizeof(uint16_t));
+    } else {
+        for (uint32_t r = 0; r < f->rows; r++) {
+            std::memcpy(dst + static_cast<size_t>(r) * f->fusedCols +
+                            static_cast<size_t>(device) * f->cols,
+                        src + static_cast<size_t>(r) * f->cols,
+                        f->cols * sizeof(uint16_t));
+        }
+    }
+}
+
+} // namespace
+
+extern "C" GridFusion *grid_fusion_create(uint32_t rows, uint32_t cols,
+                                          uint32_t deviceCount,
+                                          int stackRows, int cobs)
+{
+    if (rows == 0 || cols == 0 || deviceCount < 2 ||
+        deviceCount > GRID_FUSION_MAX_DEVICES) {
+        return nullptr;
+    }
+    auto *f = new (std::nothrow) GridFusion();
+    if (f == nullptr) {
+        return nullptr;
+    }
+    f->rows = rows;
+    f->cols = cols;
+    f->deviceCount = deviceCount;
+    f->stackRows = stackRows ? 1 : 0;
+    f->fusedRows = stackRows ? rows * deviceCount : rows;
+    f->fusedCols = stackRows ? cols : cols * deviceCount;
+
+    for (uint32_t i = 0; i < deviceCount; i++) {
+        f->devices[i].dec = grid_decoder_create(rows, cols);
+        if (f->devices[i].dec == nullptr) {
+            grid_fusion_destroy(f);
+            return nullptr;
+        }
+        grid_decoder_set_cobs(f->devices[i].dec, cobs);
+    }
+    return f;
+}
+
+extern "C" void grid_fusion_destroy(GridFusion *f)
+{
+    if (f == nullptr) {
+        return;
+    }
+    for (uint32_t i = 0; i < GRID_FUSION_MAX_DEVICES; i++) {
+        if (f->devices[i].dec != nullptr) {
+            grid_decoder_destroy(f->devices[i].dec);
+        }
+    }
+    delete f;
+}
+
+extern "C" uint32_t grid_fusion_rows(const GridFusion *f)
+{
+    return (f != nullptr) ? f->fusedRows : 0;
+}
+
+extern "C" uint32_t grid_fusion_cols(const GridFusion *f)
+{
+    return (f != nullptr) ? f->fusedCols : 0;
+}
+
+extern "C" size_t grid_fusion_feed(GridFusion *f, uint32_t device,
+                                   const uint8_t *data, size_t len)
+{
+    if (f == nullptr || device >= f->deviceCount || data == nullptr) {
+        return 0;
+    }
+    Device &dev = f->devices[device];
+    std::lock_guard<std::mutex> lock(dev.mtx);
+    size_t consumed = grid_decoder_feed(dev.dec, data, len);
+    drainDevice(f, dev);
+    return consumed;
+}
+
+extern "C" int grid_fusion_poll(GridFusion *f, uint16_t *cells,
+                                GridFusionFrameInfo *info)
+{
+    if (f == nullptr || cells == nullptr) {
+        return 0;
+    }
+
+    for (;;) {
+        Device &ref = f->devices[0];
+
+        /* Peek the oldest reference frame */
+        PendingFrame refFrame;
+        {
+            std::lock_guard<std::mutex> lock(ref.mtx);
+            if (ref.pending.empty()) {
+                return 0;
+            }
+            refFrame = ref.pending.front();
+        }
+
+        /* Find each partner device's closest frame in corrected time */
+        double worstSkew = 0;
+        bool complete = true;
+        bool refStale = true;
+        uint32_t devSeq[GRID_FUSION_MAX_DEVICES] = {refFrame.seq};
+        size_t matchIdx[GRID_FUSION_MAX_DEVICES] = {0};
+
+        for (uint32_t i = 1; i < f->deviceCount; i++) {
+            Device &dev = f->devices[i];
+            std::lock_guard<std::mutex> lock(dev.mtx);
+
+            double best = -1;
+            size_t bestIdx = 0;
+            for (size_t k = 0; k < dev.pending.size(); k++) {
+                double skew = std::fabs(dev.pending[k].correctedMs -
+                                        refFrame.correctedMs);
+                if (best < 0 || skew < best) {
+                    best = skew;
+                    bestIdx = k;
+                }
+            }
+            if (best < 0 || best > f->toleranceMs) {
+                complete = false;
+                /* Stale only if the device's stream has moved past the
+                 * reference frame - otherwise keep waiting for it */
+                bool movedPast = false;
+                for (const PendingFrame &p : dev.pending) {
+                    if (p.correctedMs >
+                        refFrame.correctedMs + f->toleranceMs) {
+                        movedPast = true;
+                        break;
+                    }
+                }
+                if (!movedPast) {
+                    refStale = false;
+                }
+            } else {
+                if (best > worstSkew) {
+                    worstSkew = best;
+                }
+                devSeq[i] = dev.pending[bestIdx].seq;
+                matchIdx[i] = bestIdx;
+            }
+        }
+
+        if (!complete) {
+            if (refStale) {
+                /* Every unmatched device has already streamed past this
+                 * reference frame: its partners are gone for good */
+                std::lock_guard<std::mutex> lock(ref.mtx);
+                if (!ref.pending.empty() &&
+                    ref.pending.front().seq == refFrame.seq) {
+                    ref.pending.pop_front();
+                    f->drops++;
+                }
+                continue;       /* Try the next reference frame */
+            }
+            return 0;           /* Still waiting on a partner */
+        }
+
+        /* Assemble: reference tile plus each matched partner; matched
+         * and older partner frames leave the deques (streams only move
+         * forward) */
+        blit(f, 0, refFrame.cells.data(), cells);
+        {
+            std::lock_guard<std::mutex> lock(ref.mtx);
+            if (!ref.pending.empty() &&
+                ref.pending.front().seq == refFrame.seq) {
+                ref.pending.pop_front();
+            }
+        }
+        for (uint32_t i = 1; i < f->deviceCount; i++) {
+            Device &dev = f->devices[i];
+            std::lock_guard<std::mutex> lock(dev.mtx);
+            size_t idx = matchIdx[i];
+            if (idx < dev.pending.size() &&
+                dev.pending[idx].seq == devSeq[i]) {
+                blit(f, i, dev.pending[idx].cells.data(), cells);
+                dev.pending.erase(dev.pending.begin(),
+                                  dev.pending.begin() +
+                                      static_cast<long>(idx) + 1);
+            } else {
+                /* Raced with a feed-side overflow; fill from whatever
+                 * is oldest rather than leave the tile stale */
+                if (!dev.pending.empty()) {
+                    blit(f, i, dev.pending.front().cells.data(), cells);
+                    dev.pending.pop_front();
+                }
+            }
+        }
+
+        if (info != nullptr) {
+            info->seq = f->fusedSeq;
+            info->skewMs = static_cast<uint32_t>(worstSkew + 0.5);
+            for (uint32_t i = 0; i < GRID_FUSION_MAX_DEVICES; i++) {
+                info->devSeq[i] = (i < f->deviceCount) ? devSeq[i] : 0;
+            }
+        }
+        f->fusedSeq++;
+        return 1;
+    }
+}
+
+extern "C" void grid_fusion_set_tolerance(GridFusion *f, uint32_t ms)
+{
+    if (f != nullptr && ms > 0) {
+        f->toleranceMs = static_cast<double>(ms);
+    }
+}
+
+extern "C" double grid_fusion_clock_offset(const GridFusion *f,
+                                           uint32_t device)
+{
+    if (f == nullptr || device >= f->deviceCount) {
+        return 0;
+    }
+    return f->devices[device].clock.offset();
+}
+
+extern "C" double grid_fusion_clock_drift(const GridFusion *f,
+                                          uint32_t device)
+{
+    if (f == nullptr || device >= f->deviceCount) {
+        return 0;
+    }
+    return f->devices[device].clock.driftPpm();
+}
+
+extern "C" uint32_t grid_fusion_drops(const GridFusion *f)
+{
+    return (f != nullptr) ? f->drops : 0;
+}
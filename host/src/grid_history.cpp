@@ -0,0 +1,284 @@
+/**
+ ******************************************************************************
+ * @file           : grid_history.cpp
+ * @brief          : Multi-resolution waveform history implementation
+ ******************************************************************************
+ *
+ * Three tiers, each a bucket-major ring of cellCount-wide rows:
+ *
+ *   tier 0:  every frame, raw values       (1 frame / bucket)
+ *   tier 1:  min/max over  8-frame buckets
+ *   tier 2:  min/max over 64-frame buckets
+ *
+ * All tiers share the same bucket capacity, so each coarser tier
+ * reaches 8x further back in time for the same memory. Append memcpys
+ * the frame into tier 0's current slot and folds it into the coarser
+ * tiers' partial-bucket accumulators; a completed bucket is one more
+ * memcpy into its ring slot. That is the whole per-frame cost - no
+ * allocation, no per-cell branching beyond the min/max fold.
+ *
+ * Queries pick the finest tier whose retention still reaches the
+ * requested start frame, then group consecutive buckets as needed to
+ * stay under maxPoints, taking the min/max across each group. The
+ * coarser tiers' partial accumulator is queried like a normal bucket
+ * so the envelope always extends to the newest frame.
+ *
+ * Single-writer, and queries are expected from the same thread (the
+ * GUI's poll loop both appends and plots); there is no locking here.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_history.h"
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kDefaultTier0Capacity = 2048;
+constexpr uint32_t kTierCount = 3;
+constexpr uint32_t kTierFactor[kTierCount] = {1, 8, 64};
+
+struct Tier {
+    uint32_t factor = 1;
+    /* Ring of completed buckets, bucket-major: slot*cellCount + cell.
+     * Tier 0 stores raw values in mins and leaves maxs empty */
+    std::vector<uint16_t> mins;
+    std::vector<uint16_t> maxs;
+    /* Partial-bucket accumulators (factor > 1 only) */
+    std::vector<uint16_t> curMin;
+    std::vector<uint16_t> curMax;
+    uint32_t curCount = 0;      /* Frames folded into the partial bucket */
+};
+
+} // namespace
+
+struct GridHistory {
+    uint32_t cellCount = 0;
+    uint32_t capacity = 0;      /* Buckets per tier */
+    uint64_t frames = 0;        /* Total frames appended */
+    Tier tiers[kTierCount];
+};
+
+namespace {
+
+/* Completed buckets a tier has ever produced */
+uint64_t tierBuckets(const GridHistory *h, uint32_t t)
+{
+    return h->frames / h->tiers[t].factor;
+}
+
+/* Oldest bucket number the tier's ring still holds */
+uint64_t tierOldestBucket(const GridHistory *h, uint32_t t)
+{
+    uint64_t done = tierBuckets(h, t);
+    return (done > h->capacity) ? done - h->capacity : 0;
+}
+
+/* Oldest frame the tier can answer for (partial bucket included) */
+uint64_t tierOldestFrame(const GridHistory *h, uint32_t t)
+{
+    return tierOldestBucket(h, t) * h->tiers[t].factor;
+}
+
+/* Min/max of one cell over one bucket; bucket == tierBuckets() reads
+ * the partial accumulator */
+void readBucket(const GridHistory *h, uint32_t t, uint64_t bucket,
+                uint32_t cell, uint16_t *mn, uint16_t *mx)
+{
+    const Tier &tier = h->tiers[t];
+    if (bucket == tierBuckets(h, t)) {
+        *mn = tier.curMin[cell];
+        *mx = tier.curMax[cell];
+        return;
+    }
+    size_t slot = static_cast<size_t>(bucket % h->capacity) * h->cellCount +
+                  cell;
+    if (t == 0) {
+        *mn = *mx = tier.mins[slot];
+    } else {
+        *mn = tier.mins[slot];
+        *mx = tier.maxs[slot];
+    }
+}
+
+} // namespace
+
+extern "C" GridHistory *grid_history_create(uint32_t cellCount,
+                                            uint32_t tier0Capacity)
+{
+    if (cellCount == 0) {
+        return nullptr;
+    }
+    if (tier0Capacity == 0) {
+        tier0Capacity = kDefaultTier0Capacity;
+    }
+    auto *h = new (std::nothrow) GridHistory();
+    if (h == nullptr) {
+        return nullptr;
+    }
+    h->cellCount = cellCount;
+    h->capacity = tier0Capacity;
+    try {
+        for (uint32_t t = 0; t < kTierCount; t++) {
+            Tier &tier = h->tiers[t];
+            tier.factor = kTierFactor[t];
+            size_t ring = static_cast<size_t>(tier0Capacity) * cellCount;
+            tier.mins.resize(ring);
+            if (t > 0) {
+                tier.maxs.resize(ring);
+                tier.curMin.resize(cellCount);
+                tier.curMax.resize(cellCount);
+            }
+        }
+    } catch (const std::bad_alloc &) {
+        delete h;
+        return nullptr;
+    }
+    return h;
+}
+
+extern "C" void grid_history_destroy(GridHistory *h)
+{
+    delete h;
+}
+
+extern "C" void grid_history_append(GridHistory *h, const uint16_t *cells)
+{
+    if (h == nullptr || cells == nullptr) {
+        return;
+    }
+
+    /* Tier 0: the frame is the bucket */
+    size_t slot = static_cast<size_t>(h->frames % h->capacity) * h->cellCount;
+    std::memcpy(h->tiers[0].mins.data() + slot, cells,
+                h->cellCount * sizeof(uint16_t));
+
+    /* Coarser tiers: fold into the partial bucket, flush when full */
+    for (uint32_t t = 1; t < kTierCount; t++) {
+        Tier &tier = h->tiers[t];
+        if (tier.curCount == 0) {
+            std::memcpy(tier.curMin.data(), cells,
+                        h->cellCount * sizeof(uint16_t));
+            std::memcpy(tier.curMax.data(), cells,
+                        h->cellCount * sizeof(uint16_t));
+        } else {
+            for (uint32_t c = 0; c < h->cellCount; c++) {
+                if (cells[c] < tier.curMin[c]) {
+                    tier.curMin[c] = cells[c];
+                }
+                if (cells[c] > tier.curMax[c]) {
+                    tier.curMax[c] = cells[c];
+                }
+            }
+        }
+        if (++tier.curCount == tier.factor) {
+            uint64_t bucket = h->frames / tier.factor;
+            size_t dst =
+                static_cast<size_t>(bucket % h->capacity) * h->cellCount;
+            std::memcpy(tier.mins.data() + dst, tier.curMin.data(),
+                        h->cellCount * sizeof(uint16_t));
+            std::memcpy(tier.maxs.data() + dst, tier.curMax.data(),
+                        h->cellCount * sizeof(uint16_t));
+            tier.curCount = 0;
+        }
+    }
+
+    h->frames++;
+}
+
+extern "C" uint64_t grid_history_frames(const GridHistory *h)
+{
+    return (h != nullptr) ? h->frames : 0;
+}
+
+extern "C" uint64_t grid_history_oldest(const GridHistory *h)
+{
+    if (h == nullptr) {
+        return 0;
+    }
+    return tierOldestFrame(h, kTierCount - 1);
+}
+
+extern "C" uint32_t grid_history_query(const GridHistory *h, uint32_t cell,
+                                       uint64_t startFrame,
+                                       uint64_t endFrame, uint32_t maxPoints,
+                                       uint64_t *frameIdx, uint16_t *mins,
+                                       uint16_t *maxs)
+{
+    if (h == nullptr || cell >= h->cellCount || maxPoints == 0 ||
+        mins == nullptr || maxs == nullptr || h->frames == 0) {
+        return 0;
+    }
+    if (endFrame >= h->frames) {
+        endFrame = h->frames - 1;
+    }
+    uint64_t oldest = grid_history_oldest(h);
+    if (startFrame < oldest) {
+        startFrame = oldest;
+    }
+    if (startFrame > endFrame) {
+        return 0;
+    }
+
+    /* Finest tier whose retention reaches back to startFrame */
+    uint32_t t = kTierCount - 1;
+    for (uint32_t i = 0; i < kTierCount; i++) {
+        if (tierOldestFrame(h, i) <= startFrame) {
+            t = i;
+            break;
+        }
+    }
+    const uint32_t factor = h->tiers[t].factor;
+
+    uint64_t b0 = startFrame / factor;
+    uint64_t b1 = endFrame / factor;
+    uint64_t oldestBucket = tierOldestBucket(h, t);
+    if (b0 < oldestBucket) {
+        b0 = oldestBucket;
+    }
+    /* The coarse tiers' partial accumulator counts as one extra bucket;
+     * tier 0 never has one */
+    uint64_t newestBucket = tierBuckets(h, t);
+    if (t == 0 || h->tiers[t].curCount == 0) {
+        newestBucket--;
+    }
+    if (b1 > newestBucket) {
+        b1 = newestBucket;
+    }
+    if (b0 > b1) {
+        return 0;
+    }
+
+    /* Group buckets so the answer fits in maxPoints */
+    uint64_t nBuckets = b1 - b0 + 1;
+    uint64_t group = (nBuckets + maxPoints - 1) / maxPoints;
+    uint32_t written = 0;
+    for (uint64_t b = b0; b <= b1; b += group) {
+        uint64_t gEnd = b + group - 1;
+        if (gEnd > b1) {
+            gEnd = b1;
+        }
+        uint16_t mn, mx;
+        readBucket(h, t, b, cell, &mn, &mx);
+        for (uint64_t k = b + 1; k <= gEnd; k++) {
+            uint16_t km, kx;
+            readBucket(h, t, k, cell, &km, &kx);
+            if (km < mn) {
+                mn = km;
+            }
+            if (kx > mx) {
+                mx = kx;
+            }
+        }
+        if (frameIdx != nullptr) {
+            frameIdx[written] = b * factor;
+        }
+        mins[written] = mn;
+        maxs[written] = mx;
+        written++;
+    }
+    return written;
+}
@@ -0,0 +1,247 @@
+/**
+ ******************************************************************************
+ * @file           : grid_latency.cpp
+ * @brief          : End-to-end latency measurement harness implementation
+ ******************************************************************************
+ *
+ * One probe lives at a time. Arming stamps the reference time and a
+ * generation counter; each stage mark compares the armed cell against
+ * the marker value (top 12 bits, so the packed wire format cannot hide
+ * it) and stamps its stage once. The present mark completes the probe
+ * when the render stage has already seen the marker - present callbacks
+ * fire every frame, so an un-marked present is ignored.
+ *
+ * Marks arrive from different threads (pipeline decode/process threads,
+ * the GUI thread, the GL paint callback), so every entry point takes
+ * the one mutex. The critical sections are a cell compare and a clock
+ * read - nanoseconds against the millisecond scales being measured.
+ *
+ * The firmware's "latinj t=<hex>" log line may arrive split across log
+ * packets; a small tail buffer reassembles lines before parsing.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_latency.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/* Meta block offset of the firmware scan-complete tick (u32 LE) */
+constexpr size_t kMetaScanMsOffset = 16;
+
+constexpr int kStageDecode = 0;
+constexpr int kStageProcess = 1;
+constexpr int kStageRender = 2;
+constexpr int kStagePresent = 3;
+constexpr int kStageCount = 4;
+
+double msBetween(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+} // namespace
+
+struct GridLatency {
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+
+    std::mutex mutex;
+
+    /* Armed probe */
+    bool armed = false;
+    uint32_t cellIndex = 0;
+    uint16_t value = 0;
+    Clock::time_point armTime;
+    bool stamped[kStageCount] = {};
+    Clock::time_point stageTime[kStageCount];
+    uint32_t fwInjectMs = 0;
+    uint32_t fwScanMs = 0;
+
+    /* Completed probe awaiting collection */
+    bool done = false;
+    GridLatencyReport pending = {};
+
+    /* Log line reassembly for the "latinj" tick */
+    std::string logTail;
+
+    bool marker(const uint16_t *cells) const
+    {
+        return (cells[cellIndex] >> 4) == (value >> 4);
+    }
+};
+
+GridLatency *grid_latency_create(uint32_t rows, uint32_t cols)
+{
+    if (rows == 0 || cols == 0) {
+        return nullptr;
+    }
+    auto *lat = new (std::nothrow) GridLatency();
+    if (lat == nullptr) {
+        return nullptr;
+    }
+    lat->rows = rows;
+    lat->cols = cols;
+    return lat;
+}
+
+void grid_latency_destroy(GridLatency *lat)
+{
+    delete lat;
+}
+
+void grid_latency_arm(GridLatency *lat, uint32_t row, uint32_t col,
+                      uint16_t value)
+{
+    if (lat == nullptr || row >= lat->rows || col >= lat->cols) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(lat->mutex);
+    lat->armed = true;
+    lat->cellIndex = row * lat->cols + col;
+    lat->value = value;
+    lat->armTime = Clock::now();
+    std::memset(lat->stamped, 0, sizeof(lat->stamped));
+    lat->fwInjectMs = 0;
+    lat->fwScanMs = 0;
+    lat->done = false;
+    lat->logTail.clear();
+}
+
+namespace {
+
+/* Stamp one stage the first time the marker shows up there */
+void markStage(GridLatency *lat, int stage, const uint16_t *cells,
+               const uint8_t *meta)
+{
+    if (lat == nullptr || cells == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(lat->mutex);
+    if (!lat->armed || lat->stamped[stage] || !lat->marker(cells)) {
+        return;
+    }
+    lat->stamped[stage] = true;
+    lat->stageTime[stage] = Clock::now();
+    if (stage == kStageDecode && meta != nullptr) {
+        uint32_t ms = 0;
+        std::memcpy(&ms, meta + kMetaScanMsOffset, sizeof(ms));
+        lat->fwScanMs = ms;
+    }
+}
+
+} // namespace
+
+void grid_latency_mark_decode(GridLatency *lat, const uint16_t *cells,
+                              const uint8_t *meta)
+{
+    markStage(lat, kStageDecode, cells, meta);
+}
+
+void grid_latency_mark_process(GridLatency *lat, const uint16_t *cells)
+{
+    markStage(lat, kStageProcess, cells, nullptr);
+}
+
+void grid_latency_mark_render(GridLatency *lat, const uint16_t *cells)
+{
+    markStage(lat, kStageRender, cells, nullptr);
+}
+
+void grid_latency_mark_present(GridLatency *lat)
+{
+    if (lat == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(lat->mutex);
+    if (!lat->armed || !lat->stamped[kStageRender]) {
+        return;
+    }
+    lat->stamped[kStagePresent] = true;
+    lat->stageTime[kStagePresent] = Clock::now();
+
+    /* Fold the probe into a report. Stages never marked (a consumer
+     * without that tap) inherit the previous timestamp, so their
+     * segment reads as zero instead of poisoning the neighbours */
+    Clock::time_point prev = lat->armTime;
+    Clock::time_point at[kStageCount];
+    for (int s = 0; s < kStageCount; s++) {
+        at[s] = lat->stamped[s] ? lat->stageTime[s] : prev;
+        prev = at[s];
+    }
+
+    lat->pending.armToDecodeMs = msBetween(lat->armTime, at[kStageDecode]);
+    lat->pending.decodeToProcessMs =
+        msBetween(at[kStageDecode], at[kStageProcess]);
+    lat->pending.processToRenderMs =
+        msBetween(at[kStageProcess], at[kStageRender]);
+    lat->pending.renderToPresentMs =
+        msBetween(at[kStageRender], at[kStagePresent]);
+    lat->pending.totalMs = msBetween(lat->armTime, at[kStagePresent]);
+    lat->pending.fwInjectMs = lat->fwInjectMs;
+    lat->pending.fwScanMs = lat->fwScanMs;
+
+    lat->armed = false;
+    lat->done = true;
+}
+
+void grid_latency_note_log(GridLatency *lat, const char *text, size_t len)
+{
+    if (lat == nullptr || text == nullptr || len == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(lat->mutex);
+    if (!lat->armed && !lat->done) {
+        return;
+    }
+    lat->logTail.append(text, len);
+
+    size_t nl;
+    while ((nl = lat->logTail.find('\n')) != std::string::npos) {
+        std::string line = lat->logTail.substr(0, nl);
+        lat->logTail.erase(0, nl + 1);
+
+        size_t pos = line.find("latinj t=");
+        if (pos == std::string::npos) {
+            continue;
+        }
+        uint32_t ms = static_cast<uint32_t>(
+            std::strtoul(line.c_str() + pos + 9, nullptr, 16));
+        if (lat->armed) {
+            lat->fwInjectMs = ms;
+        } else {
+            /* The line outran nothing: the probe already completed
+             * before the log packet drained - patch the report */
+            lat->pending.fwInjectMs = ms;
+        }
+    }
+
+    /* A fragment with no newline yet: cap the tail so a chatty log
+     * stream cannot grow it without bound */
+    if (lat->logTail.size() > 256) {
+        lat->logTail.erase(0, lat->logTail.size() - 256);
+    }
+}
+
+int grid_latency_report(GridLatency *lat, GridLatencyReport *out)
+{
+    if (lat == nullptr || out == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(lat->mutex);
+    if (!lat->done) {
+        return 0;
+    }
+    *out = lat->pending;
+    lat->done = false;
+    return 1;
+}
@@ -0,0 +1,607 @@
+/**
+ ******************************************************************************
+ * @file           : grid_pipeline.cpp
+ * @brief          : Threaded decode/process pipeline implementation
+ ******************************************************************************
+ *
+ * Stage wiring (one SPSC queue per arrow, see grid_pipeline.h):
+ *
+ *   caller feed/reserve -> [decoder ring] -> decode thread
+ *     decode -> process : frame queue, waits when full (no frame loss)
+ *     process -> caller : analysis queue (every frame, waits when full)
+ *                         render mailbox (freshest only, drops counted)
+ *                         aux queue (stats/log/bench, 1 Hz traffic)
+ *
+ * The threads spin on short sleeps instead of condition variables: at
+ * wire rate a frame lands every few milliseconds anyway, a 500 us nap
+ * adds no perceptible latency, and the queues stay genuinely lock-free
+ * - a stalled consumer can never wedge a producer behind a mutex.
+ *
+ * The render mailbox is a seqlock: the writer bumps the sequence to odd,
+ * copies, bumps to even; the reader retries while it observes an odd or
+ * changed sequence. The renderer therefore never blocks the process
+ * thread, no matter how slow the display is.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_pipeline.h"
+#include "grid_kernels.h"
+#include "grid_latency.h"
+#include "session_writer.h"
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/* Queue depths: analysis rides out ~2 s of GUI stalls at wire rate
+ * before the pipeline starts waiting; aux traffic is ~1 Hz */
+constexpr size_t kFrameQueueDepth = 64;
+constexpr size_t kAnalysisQueueDepth = 128;
+constexpr size_t kAuxQueueDepth = 32;
+constexpr size_t kAuxPayloadMax = 256;
+
+constexpr auto kIdleNap = std::chrono::microseconds(500);
+
+struct FrameSlot {
+    std::vector<uint16_t> cells;
+    GridPipelineFrameInfo info;
+};
+
+struct AuxSlot {
+    int32_t type;
+    uint32_t len;
+    uint8_t data[kAuxPayloadMax];
+};
+
+} // namespace
+
+struct GridPipeline {
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    uint32_t total = 0;
+
+    GridDecoder *dec = nullptr;
+
+    SpscQueue<FrameSlot> frameQueue{kFrameQueueDepth};
+    SpscQueue<FrameSlot> analysisQueue{kAnalysisQueueDepth};
+    SpscQueue<AuxSlot> auxQueue{kAuxQueueDepth};
+
+    /* Render mailbox (seqlock) */
+    std::vector<uint16_t> renderCells;
+    GridPipelineFrameInfo renderInfo{};
+    std::atomic<uint32_t> renderSeqlock{0};
+    uint32_t renderLastFetched = 0;     /* Caller-side, render thread only */
+    std::atomic<uint32_t> renderDrops{0};
+    std::atomic<bool> renderFresh{false};
+
+    /* Metrics mailbox (seqlock): written on the decode thread ahead of
+     * the frame queue, so feedback scalars go out even while the
+     * process stage is busy or backed up */
+    GridPipelineMetrics metrics{};
+    std::atomic<uint32_t> metricsSeqlock{0};
+    uint32_t metricsLastFetched = 0;    /* Caller-side, one reader */
+
+    std::atomic<GridPipelineHook> hook{nullptr};
+    std::atomic<void *> hookUser{nullptr};
+
+    /* Latency harness tap (see grid_latency.h); marks are one cell
+     * compare when no probe is armed */
+    std::atomic<GridLatency *> latency{nullptr};
+
+    /* Session recording tap. The mutex only serializes the process
+     * thread's append against start/stop swaps - appends themselves
+     * never contend with each other */
+    std::mutex recorderMutex;
+    SessionWriter *recorder = nullptr;
+    std::chrono::steady_clock::time_point recordStart;
+    std::atomic<uint64_t> recorderDrops{0};
+    std::string recordPath;             /* For the link sidecar */
+    GridLinkStats recordBaseline{};     /* Counters at recording start */
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> resetPending{false};
+    uint32_t nextSeq = 0;               /* Decode thread only */
+
+    std::thread decodeThread;
+    std::thread processThread;
+
+    void decodeLoop();
+    void processLoop();
+};
+
+namespace {
+
+/* Decode thread: drain the decoder, fan events out to the frame and
+ * aux queues. Waiting (not dropping) when the frame queue is full is
+ * what guarantees analysis sees every frame - backpressure propagates
+ * into the byte ring, whose several-second depth absorbs the stall. */
+/* Fast-path feedback scalars: firmware meta when the frame carries
+ * one (free), else one SIMD reduce sweep. Published before the frame
+ * queue so a full process stage never delays them. */
+void publishMetrics(GridPipeline *p, const GridDecoderEvent &ev)
+{
+    GridPipelineMetrics m;
+    m.seq = p->nextSeq;
+    if (ev.meta != nullptr) {
+        m.peak = static_cast<uint16_t>(ev.meta[0] | (ev.meta[1] << 8));
+        m.peakRow = ev.meta[2];
+        m.peakCol = ev.meta[3];
+        m.totalForce = static_cast<uint32_t>(ev.meta[4])
+                       | (static_cast<uint32_t>(ev.meta[5]) << 8)
+                       | (static_cast<uint32_t>(ev.meta[6]) << 16)
+                       | (static_cast<uint32_t>(ev.meta[7]) << 24);
+        m.centroidRow =
+            static_cast<float>(ev.meta[8] | (ev.meta[9] << 8)) / 256.0f;
+        m.centroidCol =
+            static_cast<float>(ev.meta[10] | (ev.meta[11] << 8)) / 256.0f;
+    } else {
+        GridKernelsReduce red;
+        grid_kernels_reduce(ev.cells, ev.rows, ev.cols, &red);
+        m.peak = red.maxVal;
+        m.peakRow = static_cast<uint8_t>(red.maxIdx / ev.cols);
+        m.peakCol = static_cast<uint8_t>(red.maxIdx % ev.cols);
+        m.totalForce = static_cast<uint32_t>(red.sum);
+        m.centroidRow = red.centroidRow;
+        m.centroidCol = red.centroidCol;
+    }
+    uint32_t s = p->metricsSeqlock.load(std::memory_order_relaxed);
+    p->metricsSeqlock.store(s + 1, std::memory_order_release);
+    p->metrics = m;
+    p->metricsSeqlock.store(s + 2, std::memory_order_release);
+}
+
+void decodeEvent(GridPipeline *p, const GridDecoderEvent &ev)
+{
+    GridLatency *lat = p->latency.load(std::memory_order_acquire);
+
+    if (ev.type == GRID_DEC_EV_FRAME || ev.type == GRID_DEC_EV_PREVIEW) {
+        publishMetrics(p, ev);
+        if (lat != nullptr) {
+            grid_latency_mark_decode(lat, ev.cells, ev.meta);
+        }
+        FrameSlot *slot;
+        while ((slot = p->frameQueue.claim()) == nullptr) {
+            if (!p->running.load(std::memory_order_relaxed)) {
+                return;
+            }
+            std::this_thread::sleep_for(kIdleNap);
+        }
+        std::memcpy(slot->cells.data(), ev.cells,
+                    p->total * sizeof(uint16_t));
+        slot->info.seq = p->nextSeq++;
+        slot->info.type = ev.type;
+        if (ev.meta != nullptr) {
+            std::memcpy(slot->info.meta, ev.meta, GRID_DEC_META_SIZE);
+        } else {
+            std::memset(slot->info.meta, 0, GRID_DEC_META_SIZE);
+        }
+        p->frameQueue.publish();
+        return;
+    }
+
+    /* The injection tick rides a log line; feed it through */
+    if (ev.type == GRID_DEC_EV_LOG && lat != nullptr) {
+        grid_latency_note_log(lat,
+                              reinterpret_cast<const char *>(ev.aux),
+                              ev.aux_len);
+    }
+
+    /* Stats/log/bench: low-rate, drop silently if the GUI is gone */
+    AuxSlot *aux = p->auxQueue.claim();
+    if (aux != nullptr) {
+        aux->type = ev.type;
+        aux->len = (ev.aux_len < kAuxPayloadMax) ? ev.aux_len
+                                                 : kAuxPayloadMax;
+        std::memcpy(aux->data, ev.aux, aux->len);
+        p->auxQueue.publish();
+    }
+}
+
+} // namespace
+
+void GridPipeline::decodeLoop()
+{
+    GridDecoderEvent ev;
+    while (running.load(std::memory_order_relaxed)) {
+        if (resetPending.exchange(false)) {
+            /* Performed here so it never races the poll below */
+            grid_decoder_reset(dec);
+        }
+        if (grid_decoder_poll(dec, &ev)) {
+            decodeEvent(this, ev);
+        } else {
+            std::this_thread::sleep_for(kIdleNap);
+        }
+    }
+}
+
+void GridPipeline::processLoop()
+{
+    while (running.load(std::memory_order_relaxed)) {
+        FrameSlot *in = frameQueue.front();
+        if (in == nullptr) {
+            std::this_thread::sleep_for(kIdleNap);
+            continue;
+        }
+
+        GridPipelineHook fn = hook.load(std::memory_order_acquire);
+        if (fn != nullptr) {
+            fn(in->cells.data(), rows, cols,
+               hookUser.load(std::memory_order_acquire));
+        }
+
+        /* Analysis: every frame, in order - wait rather than drop */
+        FrameSlot *out;
+        while ((out = analysisQueue.claim()) == nullptr) {
+            if (!running.load(std::memory_order_relaxed)) {
+                return;
+            }
+            std::this_thread::sleep_for(kIdleNap);
+        }
+        std::memcpy(out->cells.data(), in->cells.data(),
+                    total * sizeof(uint16_t));
+        out->info = in->info;
+        analysisQueue.publish();
+
+        /* Recording tap: hand the frame to the writer's thread. Full
+         * queue drops the record, never stalls this thread */
+        {
+            std::lock_guard<std::mutex> lock(recorderMutex);
+            if (recorder != nullptr &&
+                in->info.type == GRID_DEC_EV_FRAME) {
+                uint64_t stampUs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - recordStart)
+                        .count());
+                if (!session_writer_append(recorder, in->cells.data(),
+                                           in->info.meta, stampUs,
+                                           in->info.seq,
+                                           in->info.type)) {
+                    recorderDrops.fetch_add(1,
+                                            std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /* Render mailbox: overwrite, count what the display never saw */
+        if (renderFresh.exchange(true, std::memory_order_acq_rel)) {
+            renderDrops.fetch_add(1, std::memory_order_relaxed);
+        }
+        uint32_t s = renderSeqlock.load(std::memory_order_relaxed);
+        renderSeqlock.store(s + 1, std::memory_order_release);
+        std::memcpy(renderCells.data(), in->cells.data(),
+                    total * sizeof(uint16_t));
+        renderInfo = in->info;
+        renderSeqlock.store(s + 2, std::memory_order_release);
+
+        /* The frame is fully published: that is the process stage */
+        GridLatency *lat = latency.load(std::memory_order_acquire);
+        if (lat != nullptr) {
+            grid_latency_mark_process(lat, in->cells.data());
+        }
+
+        frameQueue.pop();
+    }
+}
+
+GridPipeline *grid_pipeline_create(uint32_t rows, uint32_t cols, int cobs)
+{
+    auto *p = new (std::nothrow) GridPipeline();
+    if (p == nullptr) {
+        return nullptr;
+    }
+    p->dec = grid_decoder_create(rows, cols);
+    if (p->dec == nullptr) {
+        delete p;
+        return nullptr;
+    }
+    grid_decoder_set_cobs(p->dec, cobs);
+    p->rows = rows;
+    p->cols = cols;
+    p->total = rows * cols;
+    p->renderCells.assign(p->total, 0);
+
+    auto sizeSlot = [p](FrameSlot &slot) {
+        slot.cells.assign(p->total, 0);
+    };
+    p->frameQueue.forEachSlot(sizeSlot);
+    p->analysisQueue.forEachSlot(sizeSlot);
+
+    p->running.store(true);
+    p->decodeThread = std::thread(&GridPipeline::decodeLoop, p);
+    p->processThread = std::thread(&GridPipeline::processLoop, p);
+    return p;
+}
+
+void grid_pipeline_destroy(GridPipeline *pipe)
+{
+    if (pipe == nullptr) {
+        return;
+    }
+    grid_pipeline_stop_recording(pipe);
+    pipe->running.store(false);
+    pipe->decodeThread.join();
+    pipe->processThread.join();
+    grid_decoder_destroy(pipe->dec);
+    delete pipe;
+}
+
+void grid_pipeline_reset(GridPipeline *pipe)
+{
+    if (pipe != nullptr) {
+        pipe->resetPending.store(true);
+    }
+}
+
+void grid_pipeline_set_hook(GridPipeline *pipe, GridPipelineHook hook,
+                            void *user)
+{
+    if (pipe != nullptr) {
+        pipe->hookUser.store(user, std::memory_order_release);
+        pipe->hook.store(hook, std::memory_order_release);
+    }
+}
+
+void grid_pipeline_set_latency(GridPipeline *pipe, GridLatency *lat)
+{
+    if (pipe != nullptr) {
+        pipe->latency.store(lat, std::memory_order_release);
+    }
+}
+
+size_t grid_pipeline_feed(GridPipeline *pipe, const uint8_t *data,
+                          size_t len)
+{
+    return (pipe != nullptr) ? grid_decoder_feed(pipe->dec, data, len) : 0;
+}
+
+uint8_t *grid_pipeline_reserve(GridPipeline *pipe, size_t *avail)
+{
+    return (pipe != nullptr) ? grid_decoder_reserve(pipe->dec, avail)
+                             : nullptr;
+}
+
+void grid_pipeline_commit(GridPipeline *pipe, size_t len)
+{
+    if (pipe != nullptr) {
+        grid_decoder_commit(pipe->dec, len);
+    }
+}
+
+int grid_pipeline_next_analysis(GridPipeline *pipe, uint16_t *cells,
+                                GridPipelineFrameInfo *info,
+                                uint32_t timeout_ms)
+{
+    if (pipe == nullptr || cells == nullptr) {
+        return 0;
+    }
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(timeout_ms);
+    FrameSlot *slot;
+    while ((slot = pipe->analysisQueue.front()) == nullptr) {
+        if (timeout_ms == 0 ||
+            std::chrono::steady_clock::now() >= deadline) {
+            return 0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::memcpy(cells, slot->cells.data(),
+                pipe->total * sizeof(uint16_t));
+    if (info != nullptr) {
+        *info = slot->info;
+    }
+    pipe->analysisQueue.pop();
+    return 1;
+}
+
+int grid_pipeline_latest_render(GridPipeline *pipe, uint16_t *cells,
+                                GridPipelineFrameInfo *info)
+{
+    if (pipe == nullptr || cells == nullptr) {
+        return 0;
+    }
+    if (!pipe->renderFresh.exchange(false, std::memory_order_acq_rel)) {
+        return 0;
+    }
+    GridPipelineFrameInfo localInfo;
+    for (;;) {
+        uint32_t before =
+            pipe->renderSeqlock.load(std::memory_order_acquire);
+        if (before & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(cells, pipe->renderCells.data(),
+                    pipe->total * sizeof(uint16_t));
+        localInfo = pipe->renderInfo;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (pipe->renderSeqlock.load(std::memory_order_relaxed) ==
+            before) {
+            break;              /* Copy was not torn by the writer */
+        }
+    }
+    if (info != nullptr) {
+        *info = localInfo;
+    }
+    GridLatency *lat = pipe->latency.load(std::memory_order_acquire);
+    if (lat != nullptr) {
+        grid_latency_mark_render(lat, cells);
+    }
+    return 1;
+}
+
+int grid_pipeline_latest_metrics(GridPipeline *pipe,
+                                 GridPipelineMetrics *out)
+{
+    if (pipe == nullptr || out == nullptr) {
+        return 0;
+    }
+    GridPipelineMetrics local;
+    uint32_t gen;
+    for (;;) {
+        gen = pipe->metricsSeqlock.load(std::memory_order_acquire);
+        if (gen & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        local = pipe->metrics;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (pipe->metricsSeqlock.load(std::memory_order_relaxed) ==
+            gen) {
+            break;              /* Copy was not torn by the writer */
+        }
+    }
+    /* Freshness by seqlock generation: each publish advances it by 2 */
+    if (gen == pipe->metricsLastFetched) {
+        return 0;
+    }
+    pipe->metricsLastFetched = gen;
+    *out = local;
+    return 1;
+}
+
+int grid_pipeline_next_aux(GridPipeline *pipe, int32_t *type,
+                           uint8_t *buf, size_t cap, uint32_t *len)
+{
+    if (pipe == nullptr || type == nullptr || buf == nullptr ||
+        len == nullptr) {
+        return 0;
+    }
+    AuxSlot *slot = pipe->auxQueue.front();
+    if (slot == nullptr) {
+        return 0;
+    }
+    *type = slot->type;
+    *len = (slot->len < cap) ? slot->len : static_cast<uint32_t>(cap);
+    std::memcpy(buf, slot->data, *len);
+    pipe->auxQueue.pop();
+    return 1;
+}
+
+int grid_pipeline_start_recording(GridPipeline *pipe, const char *path)
+{
+    if (pipe == nullptr || path == nullptr) {
+        return 0;
+    }
+    SessionWriter *w = session_writer_open(path, pipe->rows, pipe->cols);
+    if (w == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pipe->recorderMutex);
+    if (pipe->recorder != nullptr) {
+        /* Already recording: the new file stays unused */
+        session_writer_close(w);
+        return 0;
+    }
+    pipe->recorder = w;
+    pipe->recordStart = std::chrono::steady_clock::now();
+    pipe->recorderDrops.store(0, std::memory_order_relaxed);
+    pipe->recordPath = path;
+    grid_decoder_link_stats(pipe->dec, &pipe->recordBaseline);
+    return 1;
+}
+
+namespace {
+
+/* Machine-readable link-quality sidecar beside the session file, so
+ * "it felt laggy during that recording" has numbers attached. Counter
+ * fields are deltas over the recording; the percentiles are process
+ * lifetime (the histogram has no windowed form) */
+void writeLinkSidecar(GridPipeline *pipe)
+{
+    GridLinkStats now;
+    grid_decoder_link_stats(pipe->dec, &now);
+    const GridLinkStats &b = pipe->recordBaseline;
+
+    std::string path = pipe->recordPath + ".link.json";
+    std::FILE *f = std::fopen(path.c_str(), "w");
+    if (f == nullptr) {
+        return;
+    }
+    std::fprintf(
+        f,
+        "{\n"
+        "  \"frames\": %u,\n"
+        "  \"crc_errors\": %u,\n"
+        "  \"resyncs\": %u,\n"
+        "  \"recovered_frames\": %u,\n"
+        "  \"seq_gaps\": %u,\n"
+        "  \"frames_missed\": %u,\n"
+        "  \"arrival_ms\": {\"p50\": %.1f, \"p90\": %.1f, "
+        "\"p99\": %.1f},\n"
+        "  \"render_drops\": %u,\n"
+        "  \"recording_drops\": %llu\n"
+        "}\n",
+        now.frames - b.frames, now.crcErrors - b.crcErrors,
+        now.resyncs - b.resyncs, now.recoveredFrames - b.recoveredFrames,
+        now.seqGaps - b.seqGaps, now.framesMissed - b.framesMissed,
+        static_cast<double>(now.arrivalP50Ms),
+        static_cast<double>(now.arrivalP90Ms),
+        static_cast<double>(now.arrivalP99Ms),
+        pipe->renderDrops.load(std::memory_order_relaxed),
+        static_cast<unsigned long long>(
+            pipe->recorderDrops.load(std::memory_order_relaxed)));
+    std::fclose(f);
+}
+
+} // namespace
+
+void grid_pipeline_stop_recording(GridPipeline *pipe)
+{
+    if (pipe == nullptr) {
+        return;
+    }
+    SessionWriter *w = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pipe->recorderMutex);
+        w = pipe->recorder;
+        pipe->recorder = nullptr;
+    }
+    if (w != nullptr) {
+        /* Close outside the lock: draining the queue takes a moment
+         * and must not stall the process thread */
+        session_writer_close(w);
+        writeLinkSidecar(pipe);
+    }
+}
+
+uint64_t grid_pipeline_recording_drops(const GridPipeline *pipe)
+{
+    return (pipe != nullptr)
+               ? pipe->recorderDrops.load(std::memory_order_relaxed)
+               : 0;
+}
+
+uint32_t grid_pipeline_render_drops(const GridPipeline *pipe)
+{
+    return (pipe != nullptr)
+               ? pipe->renderDrops.load(std::memory_order_relaxed)
+               : 0;
+}
+
+uint32_t grid_pipeline_crc_errors(const GridPipeline *pipe)
+{
+    return (pipe != nullptr) ? grid_decoder_crc_errors(pipe->dec) : 0;
+}
+
+uint32_t grid_pipeline_resyncs(const GridPipeline *pipe)
+{
+    return (pipe != nullptr) ? grid_decoder_resyncs(pipe->dec) : 0;
+}
+
+void grid_pipeline_link_stats(const GridPipeline *pipe,
+                              GridLinkStats *out)
+{
+    grid_decoder_link_stats((pipe != nullptr) ? pipe->dec : nullptr,
+                            out);
+}
@@ -0,0 +1,470 @@
+/**
+ ******************************************************************************
+ * @file           : grid_virtual.cpp
+ * @brief          : Virtual grid device for hardware-free load testing
+ ******************************************************************************
+ *
+ * See grid_virtual.h. Frame packets are built to the exact layout in
+ * Core/Inc/grid_scan.h so decoders cannot tell them from board output:
+ * 0xAA 0x55, rows*cols little-endian uint16 cells, the 24-byte meta
+ * block (peak, total, centroid x256, sequence, timestamp, dead mask),
+ * CRC-32 over cells+meta, CR LF. Scenes run on simulated time advanced
+ * by one frame period per packet, so a pull-path soak at 10000 fps sees
+ * the same motion a 25 fps pty run does, just faster.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_virtual.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t kHeaderSize = 2;
+constexpr size_t kMetaSize = 24;
+constexpr size_t kFooterSize = 6;
+
+constexpr uint16_t kIdleNoiseMax = 8;     /* Sensor floor, counts */
+constexpr float kBlobPeak = 2500.0f;      /* Firm press */
+constexpr float kBlobSigma = 2.2f;        /* Fingertip-sized */
+constexpr float kRidgePeak = 1200.0f;     /* Resting spine contact */
+constexpr float kRidgeSigma = 1.1f;
+constexpr float kPalpPeak = 2200.0f;
+constexpr float kPalpSigma = 1.8f;
+
+/* Same polynomial and reflection as the decoder's check (and the MCU's
+ * hardware unit) - the stream must verify, not merely look right */
+uint32_t crc32(const uint8_t *data, size_t len)
+{
+    static uint32_t table[256];
+    static bool init = false;
+    if (!init) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[n] = c;
+        }
+        init = true;
+    }
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        c = table[(c ^ data[i]) & 0xFFu] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+void writeU32(uint8_t *p, uint32_t v)
+{
+    p[0] = static_cast<uint8_t>(v & 0xFF);
+    p[1] = static_cast<uint8_t>((v >> 8) & 0xFF);
+    p[2] = static_cast<uint8_t>((v >> 16) & 0xFF);
+    p[3] = static_cast<uint8_t>((v >> 24) & 0xFF);
+}
+
+void writeU16(uint8_t *p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v & 0xFF);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+} // namespace
+
+struct GridVirtualDevice {
+    uint32_t rows;
+    uint32_t cols;
+    int scene;
+    double fps;
+    double corruption;
+    uint64_t rng;
+    uint32_t seq;
+    double simTime;            /* Scene clock, seconds */
+    uint16_t *cells;
+    std::atomic<uint64_t> frames;
+    std::atomic<uint64_t> corrupted;
+    std::mutex mtx;            /* One packet builder at a time */
+
+    /* pty path */
+    std::thread thread;
+    std::atomic<bool> running;
+    int masterFd;
+};
+
+namespace {
+
+/* xorshift64*: cheap, seedable, good enough for noise and fault dice */
+uint32_t nextRand(GridVirtualDevice *dev)
+{
+    uint64_t x = dev->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    dev->rng = x;
+    return static_cast<uint32_t>((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+double randUnit(GridVirtualDevice *dev)
+{
+    return nextRand(dev) / 4294967296.0;
+}
+
+void addBlob(GridVirtualDevice *dev, float cr, float cc, float peak,
+             float sigma)
+{
+    /* Clip to a +-3 sigma window; the tails are below the noise floor */
+    float inv = 1.0f / (2.0f * sigma * sigma);
+    int r0 = static_cast<int>(cr - 3.0f * sigma);
+    int r1 = static_cast<int>(cr + 3.0f * sigma) + 1;
+    int c0 = static_cast<int>(cc - 3.0f * sigma);
+    int c1 = static_cast<int>(cc + 3.0f * sigma) + 1;
+    for (int r = r0; r <= r1; r++) {
+        if (r < 0 || r >= static_cast<int>(dev->rows)) {
+            continue;
+        }
+        for (int c = c0; c <= c1; c++) {
+            if (c < 0 || c >= static_cast<int>(dev->cols)) {
+                continue;
+            }
+            float dr = static_cast<float>(r) - cr;
+            float dc = static_cast<float>(c) - cc;
+            float v = peak * std::exp(-(dr * dr + dc * dc) * inv);
+            uint32_t sum = dev->cells[r * dev->cols + c]
+                           + static_cast<uint32_t>(v);
+            dev->cells[r * dev->cols + c] =
+                static_cast<uint16_t>(sum > 4095 ? 4095 : sum);
+        }
+    }
+}
+
+void renderScene(GridVirtualDevice *dev)
+{
+    size_t total = static_cast<size_t>(dev->rows) * dev->cols;
+    for (size_t i = 0; i < total; i++) {
+        dev->cells[i] =
+            static_cast<uint16_t>(nextRand(dev) % (kIdleNoiseMax + 1));
+    }
+    double t = dev->simTime;
+    float midR = dev->rows / 2.0f;
+    float midC = dev->cols / 2.0f;
+    switch (dev->scene) {
+    case GRID_VIRT_SCENE_BLOB:
+        /* Lissajous orbit covering most of the surface */
+        addBlob(dev,
+                midR + (midR - 2.5f)
+                    * static_cast<float>(std::sin(0.7 * t)),
+                midC + (midC - 3.5f)
+                    * static_cast<float>(std::sin(1.1 * t + 1.0)),
+                kBlobPeak, kBlobSigma);
+        break;
+    case GRID_VIRT_SCENE_SPINE: {
+        /* Static ridge down the rows with a gentle lateral curve, the
+         * shape SpineDetector calibrates against; one blob palpates
+         * along it at roughly clinician speed */
+        for (uint32_t r = 0; r < dev->rows; r++) {
+            float ridgeC = midC
+                + 1.5f * static_cast<float>(
+                             std::sin(0.35 * static_cast<double>(r)));
+            addBlob(dev, static_cast<float>(r), ridgeC, kRidgePeak,
+                    kRidgeSigma);
+        }
+        float sweep = static_cast<float>(
+            0.5 - 0.5 * std::cos(0.8 * t));    /* 0..1 and back */
+        float pr = sweep * (dev->rows - 1);
+        addBlob(dev, pr,
+                midC + 1.5f * static_cast<float>(
+                                  std::sin(0.35 * static_cast<double>(pr))),
+                kPalpPeak, kPalpSigma);
+        break;
+    }
+    default:
+        break;                                 /* Idle: noise only */
+    }
+}
+
+void buildMeta(GridVirtualDevice *dev, uint8_t *meta)
+{
+    uint32_t peak = 0;
+    uint8_t peakRow = 0;
+    uint8_t peakCol = 0;
+    uint64_t sum = 0;
+    uint64_t momR = 0;
+    uint64_t momC = 0;
+    for (uint32_t r = 0; r < dev->rows; r++) {
+        for (uint32_t c = 0; c < dev->cols; c++) {
+            uint32_t v = dev->cells[r * dev->cols + c];
+            sum += v;
+            momR += static_cast<uint64_t>(v) * r;
+            momC += static_cast<uint64_t>(v) * c;
+            if (v > peak) {
+                peak = v;
+                peakRow = static_cast<uint8_t>(r);
+                peakCol = static_cast<uint8_t>(c);
+            }
+        }
+    }
+    uint16_t centR = 0;
+    uint16_t centC = 0;
+    if (sum != 0) {
+        centR = static_cast<uint16_t>(momR * 256 / sum);
+        centC = static_cast<uint16_t>(momC * 256 / sum);
+    }
+    writeU16(meta + 0, static_cast<uint16_t>(peak));
+    meta[2] = peakRow;
+    meta[3] = peakCol;
+    writeU32(meta + 4, static_cast<uint32_t>(sum));
+    writeU16(meta + 8, centR);
+    writeU16(meta + 10, centC);
+    writeU32(meta + 12, dev->seq);
+    writeU32(meta + 16, static_cast<uint32_t>(dev->simTime * 1000.0));
+    writeU32(meta + 20, 0);                    /* No dead columns */
+}
+
+size_t buildPacket(GridVirtualDevice *dev, uint8_t *buf)
+{
+    size_t payload = static_cast<size_t>(dev->rows) * dev->cols * 2;
+    renderScene(dev);
+    buf[0] = 0xAA;
+    buf[1] = 0x55;
+    for (size_t i = 0; i < payload / 2; i++) {
+        writeU16(buf + kHeaderSize + i * 2, dev->cells[i]);
+    }
+    buildMeta(dev, buf + kHeaderSize + payload);
+    uint32_t crc = crc32(buf + kHeaderSize, payload + kMetaSize);
+    uint8_t *foot = buf + kHeaderSize + payload + kMetaSize;
+    writeU32(foot, crc);
+    foot[4] = '\r';
+    foot[5] = '\n';
+
+    if (dev->corruption > 0.0 && randUnit(dev) < dev->corruption) {
+        dev->corrupted.fetch_add(1, std::memory_order_relaxed);
+        if ((nextRand(dev) & 3u) == 0) {
+            /* Shear the sync pair: resync path */
+            buf[1] = static_cast<uint8_t>(buf[1] ^ 0xFF);
+        } else {
+            /* Flip a body byte: CRC drop path */
+            size_t at = kHeaderSize
+                        + nextRand(dev) % (payload + kMetaSize);
+            buf[at] = static_cast<uint8_t>(buf[at] ^ 0x40);
+        }
+    }
+
+    dev->seq++;
+    dev->simTime += (dev->fps > 0.0) ? 1.0 / dev->fps : 0.04;
+    dev->frames.fetch_add(1, std::memory_order_relaxed);
+    return kHeaderSize + payload + kMetaSize + kFooterSize;
+}
+
+#ifndef _WIN32
+void ptyLoop(GridVirtualDevice *dev)
+{
+    size_t cap = kHeaderSize
+                 + static_cast<size_t>(dev->rows) * dev->cols * 2
+                 + kMetaSize + kFooterSize;
+    uint8_t *buf = new (std::nothrow) uint8_t[cap];
+    if (buf == nullptr) {
+        return;
+    }
+    auto next = std::chrono::steady_clock::now();
+    while (dev->running.load(std::memory_order_acquire)) {
+        size_t len;
+        {
+            std::lock_guard<std::mutex> lock(dev->mtx);
+            len = buildPacket(dev, buf);
+        }
+        size_t off = 0;
+        while (off < len && dev->running.load(std::memory_order_acquire)) {
+            ssize_t n = write(dev->masterFd, buf + off, len - off);
+            if (n < 0) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    continue;
+                }
+                break;                         /* Reader side gone */
+            }
+            off += static_cast<size_t>(n);
+        }
+        double fps = (dev->fps > 0.0) ? dev->fps : 25.0;
+        next += std::chrono::nanoseconds(
+            static_cast<int64_t>(1e9 / fps));
+        std::this_thread::sleep_until(next);
+    }
+    delete[] buf;
+}
+#endif
+
+} // namespace
+
+extern "C" {
+
+GridVirtualDevice *grid_virtual_create(uint32_t rows, uint32_t cols)
+{
+    if (rows == 0 || cols == 0 || rows > 255 || cols > 255) {
+        return nullptr;
+    }
+    GridVirtualDevice *dev = new (std::nothrow) GridVirtualDevice();
+    if (dev == nullptr) {
+        return nullptr;
+    }
+    dev->rows = rows;
+    dev->cols = cols;
+    dev->scene = GRID_VIRT_SCENE_BLOB;
+    dev->fps = 25.0;
+    dev->corruption = 0.0;
+    dev->rng = 0x9E3779B97F4A7C15ull;
+    dev->seq = 0;
+    dev->simTime = 0.0;
+    dev->frames.store(0);
+    dev->corrupted.store(0);
+    dev->running.store(false);
+    dev->masterFd = -1;
+    dev->cells = new (std::nothrow) uint16_t[
+        static_cast<size_t>(rows) * cols];
+    if (dev->cells == nullptr) {
+        delete dev;
+        return nullptr;
+    }
+    return dev;
+}
+
+void grid_virtual_destroy(GridVirtualDevice *dev)
+{
+    if (dev == nullptr) {
+        return;
+    }
+    grid_virtual_stop(dev);
+    delete[] dev->cells;
+    delete dev;
+}
+
+void grid_virtual_set_scene(GridVirtualDevice *dev, int scene)
+{
+    if (dev != nullptr && scene >= GRID_VIRT_SCENE_IDLE
+        && scene <= GRID_VIRT_SCENE_SPINE) {
+        std::lock_guard<std::mutex> lock(dev->mtx);
+        dev->scene = scene;
+    }
+}
+
+void grid_virtual_set_fps(GridVirtualDevice *dev, double fps)
+{
+    if (dev != nullptr && fps > 0.0) {
+        std::lock_guard<std::mutex> lock(dev->mtx);
+        dev->fps = fps;
+    }
+}
+
+void grid_virtual_set_corruption(GridVirtualDevice *dev, double rate)
+{
+    if (dev != nullptr && rate >= 0.0 && rate <= 1.0) {
+        std::lock_guard<std::mutex> lock(dev->mtx);
+        dev->corruption = rate;
+    }
+}
+
+void grid_virtual_set_seed(GridVirtualDevice *dev, uint64_t seed)
+{
+    if (dev != nullptr) {
+        std::lock_guard<std::mutex> lock(dev->mtx);
+        dev->rng = (seed != 0) ? seed : 0x9E3779B97F4A7C15ull;
+    }
+}
+
+size_t grid_virtual_next_packet(GridVirtualDevice *dev, uint8_t *buf,
+                                size_t cap)
+{
+    if (dev == nullptr || buf == nullptr) {
+        return 0;
+    }
+    size_t need = kHeaderSize
+                  + static_cast<size_t>(dev->rows) * dev->cols * 2
+                  + kMetaSize + kFooterSize;
+    if (cap < need) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(dev->mtx);
+    return buildPacket(dev, buf);
+}
+
+int grid_virtual_start(GridVirtualDevice *dev, char *path, size_t cap)
+{
+#ifndef _WIN32
+    if (dev == nullptr || path == nullptr
+        || dev->running.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        return 0;
+    }
+    if (grantpt(fd) != 0 || unlockpt(fd) != 0
+        || ptsname_r(fd, path, cap) != 0) {
+        close(fd);
+        return 0;
+    }
+    /* Raw on the master side so the line discipline neither echoes the
+     * reader's command bytes back nor mangles 0x0D in the stream */
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    dev->masterFd = fd;
+    dev->running.store(true, std::memory_order_release);
+    dev->thread = std::thread(ptyLoop, dev);
+    return 1;
+#else
+    (void)dev;
+    (void)path;
+    (void)cap;
+    return 0;                                  /* No pty on Windows */
+#endif
+}
+
+void grid_virtual_stop(GridVirtualDevice *dev)
+{
+    if (dev == nullptr
+        || !dev->running.load(std::memory_order_acquire)) {
+        return;
+    }
+    dev->running.store(false, std::memory_order_release);
+    if (dev->thread.joinable()) {
+        dev->thread.join();
+    }
+#ifndef _WIN32
+    if (dev->masterFd >= 0) {
+        close(dev->masterFd);
+        dev->masterFd = -1;
+    }
+#endif
+}
+
+uint64_t grid_virtual_frames(const GridVirtualDevice *dev)
+{
+    return (dev != nullptr)
+               ? dev->frames.load(std::memory_order_relaxed)
+               : 0;
+}
+
+uint64_t grid_virtual_corrupted(const GridVirtualDevice *dev)
+{
+    return (dev != nullptr)
+               ? dev->corrupted.load(std::memory_order_relaxed)
+               : 0;
+}
+
+} // extern "C"
@@ -0,0 +1,233 @@
+/**
+ ******************************************************************************
+ * @file           : grid_zones.cpp
+ * @brief          : Palpation zone classifier implementation
+ ******************************************************************************
+ *
+ * One 64 K uint8 table per zone a channel can be in: sticky[c][v] is
+ * the zone a channel currently in zone c moves to when it reads value
+ * v. The tables are the plain threshold classification with each
+ * zone's own band widened by the neighbouring boundaries' hysteresis
+ * margins, so values dithering across a boundary keep mapping back to
+ * the zone the channel is already in, while a jump that clears the
+ * margin (or skips a zone entirely) transitions at once. Rebuilt only
+ * when thresholds change; the update path is one load and one compare.
+ *
+ * Thresholds are "first value of the upper zone". The defaults encode
+ * the exact comparison chain of PalpationZones.get_zone, including its
+ * mixed < / <= boundaries (optimal ends at 2000 inclusive, firm at
+ * 2800 inclusive).
+ *
+ * Transitions land in a fixed ring; when the consumer falls behind the
+ * oldest event is dropped and counted, matching how the pipeline's
+ * render mailbox treats a slow renderer.
+ *
+ ******************************************************************************
+ */
+
+#include "grid_zones.h"
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace {
+
+/* First value of each upper zone, from PalpationZones: light starts at
+ * MIN_CONTACT, warming at LIGHT_TOUCH, optimal at OPTIMAL_MIN, firm
+ * just above OPTIMAL_MAX, excessive just above TOO_HARD */
+constexpr uint16_t kDefaultThresholds[GRID_ZONE_BOUNDARIES] = {
+    100, 500, 800, 2001, 2801};
+
+constexpr uint16_t kDefaultHysteresis = 32;
+
+constexpr size_t kEventRing = 256;
+
+constexpr const char *kZoneNames[GRID_ZONE_COUNT] = {
+    "no_contact", "light", "warming", "optimal", "firm", "excessive"};
+
+struct ChannelState {
+    uint8_t zone = GRID_ZONE_NO_CONTACT;
+    double enteredAt = 0;
+    bool seen = false;          /* First update never emits an event */
+};
+
+} // namespace
+
+struct GridZones {
+    uint32_t channelCount = 0;
+    uint16_t thresholds[GRID_ZONE_BOUNDARIES];
+    uint16_t hysteresis[GRID_ZONE_BOUNDARIES];
+
+    /* sticky[zone][value] -> next zone */
+    std::vector<uint8_t> sticky[GRID_ZONE_COUNT];
+
+    std::vector<ChannelState> channels;
+
+    GridZoneEvent events[kEventRing];
+    size_t evHead = 0, evTail = 0;  /* Pop at head, push at tail */
+    uint32_t evDrops = 0;
+};
+
+namespace {
+
+/* Plain (hysteresis-free) zone of a value */
+uint8_t classify(const GridZones *z, uint16_t v)
+{
+    uint8_t zone = 0;
+    while (zone < GRID_ZONE_BOUNDARIES && v >= z->thresholds[zone]) {
+        zone++;
+    }
+    return zone;
+}
+
+void rebuildTables(GridZones *z)
+{
+    for (uint8_t cur = 0; cur < GRID_ZONE_COUNT; cur++) {
+        /* Zone cur's band, widened by the adjacent margins */
+        int32_t lo = (cur == 0) ? 0
+                                : static_cast<int32_t>(z->thresholds[cur - 1]) -
+                                      z->hysteresis[cur - 1];
+        int32_t hi = (cur == GRID_ZONE_BOUNDARIES)
+                         ? 0x10000
+                         : static_cast<int32_t>(z->thresholds[cur]) +
+                               z->hysteresis[cur];
+        uint8_t *tab = z->sticky[cur].data();
+        for (int32_t v = 0; v < 0x10000; v++) {
+            uint8_t plain = classify(z, static_cast<uint16_t>(v));
+            tab[v] = (plain != cur && v >= lo && v < hi) ? cur : plain;
+        }
+    }
+}
+
+void pushEvent(GridZones *z, const GridZoneEvent &ev)
+{
+    size_t next = (z->evTail + 1) % kEventRing;
+    if (next == z->evHead) {
+        z->evHead = (z->evHead + 1) % kEventRing;
+        z->evDrops++;
+    }
+    z->events[z->evTail] = ev;
+    z->evTail = next;
+}
+
+} // namespace
+
+extern "C" GridZones *grid_zones_create(uint32_t channelCount)
+{
+    if (channelCount == 0) {
+        return nullptr;
+    }
+    auto *z = new (std::nothrow) GridZones();
+    if (z == nullptr) {
+        return nullptr;
+    }
+    try {
+        z->channelCount = channelCount;
+        z->channels.resize(channelCount);
+        for (uint8_t c = 0; c < GRID_ZONE_COUNT; c++) {
+            z->sticky[c].resize(0x10000);
+        }
+    } catch (const std::bad_alloc &) {
+        delete z;
+        return nullptr;
+    }
+    std::memcpy(z->thresholds, kDefaultThresholds, sizeof(z->thresholds));
+    for (int i = 0; i < GRID_ZONE_BOUNDARIES; i++) {
+        z->hysteresis[i] = kDefaultHysteresis;
+    }
+    rebuildTables(z);
+    return z;
+}
+
+extern "C" void grid_zones_destroy(GridZones *z)
+{
+    delete z;
+}
+
+extern "C" int grid_zones_set_thresholds(
+    GridZones *z, const uint16_t thresholds[GRID_ZONE_BOUNDARIES],
+    const uint16_t hysteresis[GRID_ZONE_BOUNDARIES])
+{
+    if (z == nullptr || thresholds == nullptr) {
+        return 0;
+    }
+    uint16_t hyst[GRID_ZONE_BOUNDARIES];
+    for (int i = 0; i < GRID_ZONE_BOUNDARIES; i++) {
+        hyst[i] = (hysteresis != nullptr) ? hysteresis[i]
+                                          : kDefaultHysteresis;
+    }
+    /* Ascending, no underflow at the bottom, and no two boundaries'
+     * widened bands overlapping (that would make the zone between them
+     * unreachable) */
+    if (thresholds[0] < hyst[0]) {
+        return 0;
+    }
+    for (int i = 1; i < GRID_ZONE_BOUNDARIES; i++) {
+        if (static_cast<int32_t>(thresholds[i]) - hyst[i] <=
+            static_cast<int32_t>(thresholds[i - 1]) + hyst[i - 1]) {
+            return 0;
+        }
+    }
+    std::memcpy(z->thresholds, thresholds, sizeof(z->thresholds));
+    std::memcpy(z->hysteresis, hyst, sizeof(z->hysteresis));
+    rebuildTables(z);
+    return 1;
+}
+
+extern "C" void grid_zones_update(GridZones *z, uint32_t channel,
+                                  uint16_t value, double timestamp)
+{
+    if (z == nullptr || channel >= z->channelCount) {
+        return;
+    }
+    ChannelState &ch = z->channels[channel];
+    uint8_t next = z->sticky[ch.zone][value];
+    if (!ch.seen) {
+        ch.seen = true;
+        ch.zone = next;
+        ch.enteredAt = timestamp;
+        return;
+    }
+    if (next == ch.zone) {
+        return;
+    }
+    GridZoneEvent ev;
+    ev.channel = channel;
+    ev.fromZone = ch.zone;
+    ev.toZone = next;
+    ev.value = value;
+    ev.timestamp = timestamp;
+    ev.dwellSec = timestamp - ch.enteredAt;
+    pushEvent(z, ev);
+    ch.zone = next;
+    ch.enteredAt = timestamp;
+}
+
+extern "C" uint8_t grid_zones_state(const GridZones *z, uint32_t channel)
+{
+    if (z == nullptr || channel >= z->channelCount) {
+        return GRID_ZONE_NO_CONTACT;
+    }
+    return z->channels[channel].zone;
+}
+
+extern "C" int grid_zones_next_event(GridZones *z, GridZoneEvent *ev)
+{
+    if (z == nullptr || ev == nullptr || z->evHead == z->evTail) {
+        return 0;
+    }
+    *ev = z->events[z->evHead];
+    z->evHead = (z->evHead + 1) % kEventRing;
+    return 1;
+}
+
+extern "C" uint32_t grid_zones_event_drops(const GridZones *z)
+{
+    return (z != nullptr) ? z->evDrops : 0;
+}
+
+extern "C" const char *grid_zones_name(uint8_t zone)
+{
+    return (zone < GRID_ZONE_COUNT) ? kZoneNames[zone] : "?";
+}
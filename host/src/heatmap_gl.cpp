@@ -0,0 +1,580 @@
+/**
+ ******************************************************************************
+ * @file           : heatmap_gl.cpp
+ * @brief          : OpenGL heatmap renderer implementation
+ ******************************************************************************
+ *
+ * Deliberately self-contained: the GL types, enums and entry points
+ * used here are declared locally and resolved at runtime from the
+ * system GL library (glXGetProcAddress / dlsym), so the build needs no
+ * GL headers or link-time dependency and the shared library still
+ * loads on headless machines. Everything targets desktop GL 2.1 with
+ * shaders - the floor for the clinic laptops' integrated graphics -
+ * and heatmap_gl_create fails cleanly on anything older.
+ *
+ * The cell texture is GL_LUMINANCE16 with linear filtering, so the
+ * GPU's bilinear interpolation replaces the CPU-side upsample for
+ * display purposes; the colormap is a 256x1 RGB texture sampled by the
+ * fragment shader after range normalization. Overlays draw from two
+ * small dynamic VBOs (GL_LINES segments and GL_POINTS markers) in grid
+ * coordinates through the same letterbox transform as the quad.
+ *
+ ******************************************************************************
+ */
+
+#include "heatmap_gl.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#if defined(_WIN32)
+
+/* The clinic deployment is Linux; keep the symbol present so the GUI's
+ * feature probe works, but report GL as unavailable */
+extern "C" HeatmapGL *heatmap_gl_create(uint32_t, uint32_t)
+{
+    return nullptr;
+}
+extern "C" void heatmap_gl_destroy(HeatmapGL *) {}
+extern "C" void heatmap_gl_set_colormap(HeatmapGL *, const uint8_t *,
+                                        uint32_t) {}
+extern "C" void heatmap_gl_set_range(HeatmapGL *, float) {}
+extern "C" void heatmap_gl_upload(HeatmapGL *, const uint16_t *) {}
+extern "C" void heatmap_gl_set_lines(HeatmapGL *, const float *, uint32_t) {}
+extern "C" void heatmap_gl_set_markers(HeatmapGL *, const float *, uint32_t,
+                                       float) {}
+extern "C" int heatmap_gl_render(HeatmapGL *, int, int) { return -1; }
+
+#else /* POSIX */
+
+#include <dlfcn.h>
+
+namespace {
+
+/* ---- Minimal GL declarations (desktop GL 2.1 subset) ------------------- */
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned char GLboolean;
+typedef unsigned char GLubyte;
+typedef float GLfloat;
+typedef float GLclampf;
+typedef unsigned int GLbitfield;
+typedef char GLchar;
+typedef ptrdiff_t GLsizeiptr;
+
+constexpr GLenum GL_NO_ERROR = 0;
+constexpr GLenum GL_TRIANGLES = 0x0004;
+constexpr GLenum GL_LINES = 0x0001;
+constexpr GLenum GL_POINTS = 0x0000;
+constexpr GLenum GL_FLOAT = 0x1406;
+constexpr GLenum GL_UNSIGNED_SHORT = 0x1403;
+constexpr GLenum GL_UNSIGNED_BYTE = 0x1401;
+constexpr GLenum GL_RGB = 0x1907;
+constexpr GLenum GL_LUMINANCE = 0x1909;
+constexpr GLenum GL_LUMINANCE16 = 0x8042;
+constexpr GLenum GL_TEXTURE_2D = 0x0DE1;
+constexpr GLenum GL_TEXTURE0 = 0x84C0;
+constexpr GLenum GL_TEXTURE_MIN_FILTER = 0x2801;
+constexpr GLenum GL_TEXTURE_MAG_FILTER = 0x2800;
+constexpr GLenum GL_TEXTURE_WRAP_S = 0x2802;
+constexpr GLenum GL_TEXTURE_WRAP_T = 0x2803;
+constexpr GLenum GL_LINEAR = 0x2601;
+constexpr GLenum GL_CLAMP_TO_EDGE = 0x812F;
+constexpr GLenum GL_UNPACK_ALIGNMENT = 0x0CF5;
+constexpr GLenum GL_ARRAY_BUFFER = 0x8892;
+constexpr GLenum GL_STATIC_DRAW = 0x88E4;
+constexpr GLenum GL_DYNAMIC_DRAW = 0x88E8;
+constexpr GLenum GL_FRAGMENT_SHADER = 0x8B30;
+constexpr GLenum GL_VERTEX_SHADER = 0x8B31;
+constexpr GLenum GL_COMPILE_STATUS = 0x8B81;
+constexpr GLenum GL_LINK_STATUS = 0x8B82;
+constexpr GLenum GL_COLOR_BUFFER_BIT = 0x4000;
+constexpr GLenum GL_BLEND = 0x0BE2;
+constexpr GLenum GL_SRC_ALPHA = 0x0302;
+constexpr GLenum GL_ONE_MINUS_SRC_ALPHA = 0x0303;
+constexpr GLenum GL_VERTEX_PROGRAM_POINT_SIZE = 0x8642;
+constexpr GLenum GL_VERSION = 0x1F02;
+
+#define HEATMAP_GL_FUNCS(X)                                                  \
+    X(GLenum, glGetError, (void))                                            \
+    X(const GLubyte *, glGetString, (GLenum))                                \
+    X(void, glViewport, (GLint, GLint, GLsizei, GLsizei))                    \
+    X(void, glClearColor, (GLclampf, GLclampf, GLclampf, GLclampf))          \
+    X(void, glClear, (GLbitfield))                                           \
+    X(void, glEnable, (GLenum))                                              \
+    X(void, glDisable, (GLenum))                                             \
+    X(void, glBlendFunc, (GLenum, GLenum))                                   \
+    X(void, glPixelStorei, (GLenum, GLint))                                  \
+    X(void, glGenTextures, (GLsizei, GLuint *))                              \
+    X(void, glDeleteTextures, (GLsizei, const GLuint *))                     \
+    X(void, glBindTexture, (GLenum, GLuint))                                 \
+    X(void, glActiveTexture, (GLenum))                                       \
+    X(void, glTexParameteri, (GLenum, GLenum, GLint))                        \
+    X(void, glTexImage2D, (GLenum, GLint, GLint, GLsizei, GLsizei, GLint,    \
+                           GLenum, GLenum, const void *))                    \
+    X(void, glTexSubImage2D, (GLenum, GLint, GLint, GLint, GLsizei, GLsizei, \
+                              GLenum, GLenum, const void *))                 \
+    X(GLuint, glCreateShader, (GLenum))                                      \
+    X(void, glDeleteShader, (GLuint))                                        \
+    X(void, glShaderSource, (GLuint, GLsizei, const GLchar *const *,         \
+                             const GLint *))                                 \
+    X(void, glCompileShader, (GLuint))                                       \
+    X(void, glGetShaderiv, (GLuint, GLenum, GLint *))                        \
+    X(GLuint, glCreateProgram, (void))                                       \
+    X(void, glDeleteProgram, (GLuint))                                       \
+    X(void, glAttachShader, (GLuint, GLuint))                                \
+    X(void, glLinkProgram, (GLuint))                                         \
+    X(void, glGetProgramiv, (GLuint, GLenum, GLint *))                       \
+    X(void, glUseProgram, (GLuint))                                          \
+    X(GLint, glGetUniformLocation, (GLuint, const GLchar *))                 \
+    X(GLint, glGetAttribLocation, (GLuint, const GLchar *))                  \
+    X(void, glUniform1i, (GLint, GLint))                                     \
+    X(void, glUniform1f, (GLint, GLfloat))                                   \
+    X(void, glUniform2f, (GLint, GLfloat, GLfloat))                          \
+    X(void, glGenBuffers, (GLsizei, GLuint *))                               \
+    X(void, glDeleteBuffers, (GLsizei, const GLuint *))                      \
+    X(void, glBindBuffer, (GLenum, GLuint))                                  \
+    X(void, glBufferData, (GLenum, GLsizeiptr, const void *, GLenum))        \
+    X(void, glEnableVertexAttribArray, (GLuint))                             \
+    X(void, glDisableVertexAttribArray, (GLuint))                            \
+    X(void, glVertexAttribPointer, (GLuint, GLint, GLenum, GLboolean,        \
+                                    GLsizei, const void *))                  \
+    X(void, glVertexAttrib4f, (GLuint, GLfloat, GLfloat, GLfloat, GLfloat))  \
+    X(void, glDrawArrays, (GLenum, GLint, GLsizei))                          \
+    X(void, glLineWidth, (GLfloat))
+
+struct GlApi {
+#define HEATMAP_GL_DECLARE(ret, name, args) ret(*name) args = nullptr;
+    HEATMAP_GL_FUNCS(HEATMAP_GL_DECLARE)
+#undef HEATMAP_GL_DECLARE
+    bool loaded = false;
+};
+
+/* Resolve the GL entry points once per process. The library handle is
+ * kept for the process lifetime, like any GL-using application */
+GlApi *glApi()
+{
+    static GlApi api;
+    static bool attempted = false;
+    if (attempted) {
+        return api.loaded ? &api : nullptr;
+    }
+    attempted = true;
+
+    const char *candidates[] = {
+#if defined(__APPLE__)
+        "/System/Library/Frameworks/OpenGL.framework/OpenGL",
+#else
+        "libOpenGL.so.0", "libGL.so.1", "libGL.so",
+#endif
+    };
+    void *lib = nullptr;
+    for (const char *name : candidates) {
+        lib = dlopen(name, RTLD_LAZY | RTLD_GLOBAL);
+        if (lib != nullptr) {
+            break;
+        }
+    }
+    if (lib == nullptr) {
+        return nullptr;
+    }
+
+    /* Prefer the context-aware resolver where the platform has one;
+     * extension entry points are not guaranteed to be dlsym-visible */
+    using Resolver = void *(*)(const GLubyte *);
+    auto resolver = reinterpret_cast<Resolver>(
+        dlsym(lib, "glXGetProcAddressARB"));
+    if (resolver == nullptr) {
+        resolver = reinterpret_cast<Resolver>(
+            dlsym(lib, "glXGetProcAddress"));
+    }
+
+    auto resolve = [&](const char *name) -> void * {
+        void *p = dlsym(lib, name);
+        if (p == nullptr && resolver != nullptr) {
+            p = reinterpret_cast<void *>(
+                resolver(reinterpret_cast<const GLubyte *>(name)));
+        }
+        return p;
+    };
+
+    bool ok = true;
+#define HEATMAP_GL_RESOLVE(ret, name, args)                                  \
+    api.name = reinterpret_cast<ret(*) args>(resolve(#name));                \
+    ok = ok && api.name != nullptr;
+    HEATMAP_GL_FUNCS(HEATMAP_GL_RESOLVE)
+#undef HEATMAP_GL_RESOLVE
+
+    api.loaded = ok;
+    return ok ? &api : nullptr;
+}
+
+const char *kVertexHeat = R"(#version 120
+attribute vec2 a_pos;
+varying vec2 v_uv;
+uniform vec2 u_scale;
+uniform vec2 u_offset;
+uniform vec2 u_grid;
+void main() {
+    v_uv = a_pos / u_grid;
+    gl_Position = vec4(a_pos * u_scale + u_offset, 0.0, 1.0);
+}
+)";
+
+const char *kFragmentHeat = R"(#version 120
+varying vec2 v_uv;
+uniform sampler2D u_cells;
+uniform sampler2D u_lut;
+uniform float u_gain;
+void main() {
+    float v = clamp(texture2D(u_cells, v_uv).r * u_gain, 0.0, 1.0);
+    gl_FragColor = vec4(texture2D(u_lut, vec2(v, 0.5)).rgb, 1.0);
+}
+)";
+
+const char *kVertexOverlay = R"(#version 120
+attribute vec2 a_pos;
+attribute vec4 a_color;
+varying vec4 v_color;
+uniform vec2 u_scale;
+uniform vec2 u_offset;
+uniform float u_pointSize;
+void main() {
+    v_color = a_color;
+    gl_PointSize = u_pointSize;
+    gl_Position = vec4(a_pos * u_scale + u_offset, 0.0, 1.0);
+}
+)";
+
+const char *kFragmentOverlay = R"(#version 120
+varying vec4 v_color;
+void main() {
+    gl_FragColor = v_color;
+}
+)";
+
+GLuint compileShader(GlApi *gl, GLenum type, const char *src)
+{
+    GLuint shader = gl->glCreateShader(type);
+    if (shader == 0) {
+        return 0;
+    }
+    gl->glShaderSource(shader, 1, &src, nullptr);
+    gl->glCompileShader(shader);
+    GLint status = 0;
+    gl->glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status == 0) {
+        gl->glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint linkProgram(GlApi *gl, const char *vsSrc, const char *fsSrc)
+{
+    GLuint vs = compileShader(gl, GL_VERTEX_SHADER, vsSrc);
+    GLuint fs = compileShader(gl, GL_FRAGMENT_SHADER, fsSrc);
+    GLuint prog = 0;
+    if (vs != 0 && fs != 0) {
+        prog = gl->glCreateProgram();
+        gl->glAttachShader(prog, vs);
+        gl->glAttachShader(prog, fs);
+        gl->glLinkProgram(prog);
+        GLint status = 0;
+        gl->glGetProgramiv(prog, GL_LINK_STATUS, &status);
+        if (status == 0) {
+            gl->glDeleteProgram(prog);
+            prog = 0;
+        }
+    }
+    if (vs != 0) gl->glDeleteShader(vs);
+    if (fs != 0) gl->glDeleteShader(fs);
+    return prog;
+}
+
+/* Default colormap: the GUI's seven-stop blue-to-red ramp */
+const uint8_t kDefaultMap[7][3] = {
+    {0, 0, 128}, {0, 0, 255},   {0, 255, 255}, {0, 255, 0},
+    {255, 255, 0}, {255, 128, 0}, {255, 0, 0},
+};
+
+} // namespace
+
+struct HeatmapGL {
+    GlApi *gl = nullptr;
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+
+    GLuint heatProg = 0;
+    GLuint overlayProg = 0;
+    GLuint cellTex = 0;
+    GLuint lutTex = 0;
+    GLuint quadVbo = 0;
+    GLuint lineVbo = 0;
+    GLuint markerVbo = 0;
+
+    GLint heatScaleLoc = -1, heatOffsetLoc = -1, heatGridLoc = -1;
+    GLint heatGainLoc = -1, heatCellsLoc = -1, heatLutLoc = -1;
+    GLint heatPosAttr = -1;
+    GLint ovScaleLoc = -1, ovOffsetLoc = -1, ovPointLoc = -1;
+    GLint ovPosAttr = -1, ovColorAttr = -1;
+
+    float gain = 65535.0f / 4095.0f;
+    uint32_t lineVerts = 0;
+    uint32_t markerVerts = 0;
+    float markerSize = 6.0f;
+};
+
+extern "C" HeatmapGL *heatmap_gl_create(uint32_t rows, uint32_t cols)
+{
+    GlApi *gl = glApi();
+    if (gl == nullptr || rows == 0 || cols == 0) {
+        return nullptr;
+    }
+    /* No current context (or a pre-shader one): glGetString(GL_VERSION)
+     * returning NULL is the reliable cross-driver probe */
+    if (gl->glGetString(GL_VERSION) == nullptr) {
+        return nullptr;
+    }
+
+    auto *h = new (std::nothrow) HeatmapGL();
+    if (h == nullptr) {
+        return nullptr;
+    }
+    h->gl = gl;
+    h->rows = rows;
+    h->cols = cols;
+
+    h->heatProg = linkProgram(gl, kVertexHeat, kFragmentHeat);
+    h->overlayProg = linkProgram(gl, kVertexOverlay, kFragmentOverlay);
+    if (h->heatProg == 0 || h->overlayProg == 0) {
+        heatmap_gl_destroy(h);
+        return nullptr;
+    }
+
+    h->heatScaleLoc = gl->glGetUniformLocation(h->heatProg, "u_scale");
+    h->heatOffsetLoc = gl->glGetUniformLocation(h->heatProg, "u_offset");
+    h->heatGridLoc = gl->glGetUniformLocation(h->heatProg, "u_grid");
+    h->heatGainLoc = gl->glGetUniformLocation(h->heatProg, "u_gain");
+    h->heatCellsLoc = gl->glGetUniformLocation(h->heatProg, "u_cells");
+    h->heatLutLoc = gl->glGetUniformLocation(h->heatProg, "u_lut");
+    h->heatPosAttr = gl->glGetAttribLocation(h->heatProg, "a_pos");
+    h->ovScaleLoc = gl->glGetUniformLocation(h->overlayProg, "u_scale");
+    h->ovOffsetLoc = gl->glGetUniformLocation(h->overlayProg, "u_offset");
+    h->ovPointLoc = gl->glGetUniformLocation(h->overlayProg, "u_pointSize");
+    h->ovPosAttr = gl->glGetAttribLocation(h->overlayProg, "a_pos");
+    h->ovColorAttr = gl->glGetAttribLocation(h->overlayProg, "a_color");
+
+    /* Cell texture: 16-bit single channel, linear filtered so the GPU
+     * does the display interpolation */
+    gl->glGenTextures(1, &h->cellTex);
+    gl->glBindTexture(GL_TEXTURE_2D, h->cellTex);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE16,
+                     static_cast<GLsizei>(cols), static_cast<GLsizei>(rows),
+                     0, GL_LUMINANCE, GL_UNSIGNED_SHORT, nullptr);
+
+    gl->glGenTextures(1, &h->lutTex);
+    gl->glBindTexture(GL_TEXTURE_2D, h->lutTex);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    heatmap_gl_set_colormap(h, &kDefaultMap[0][0],
+                            sizeof(kDefaultMap) / sizeof(kDefaultMap[0]));
+
+    /* Quad spanning the grid in cell coordinates */
+    const float c = static_cast<float>(cols);
+    const float r = static_cast<float>(rows);
+    const float quad[12] = {0, 0, c, 0, c, r, 0, 0, c, r, 0, r};
+    gl->glGenBuffers(1, &h->quadVbo);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, h->quadVbo);
+    gl->glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    gl->glGenBuffers(1, &h->lineVbo);
+    gl->glGenBuffers(1, &h->markerVbo);
+
+    if (gl->glGetError() != GL_NO_ERROR) {
+        heatmap_gl_destroy(h);
+        return nullptr;
+    }
+    return h;
+}
+
+extern "C" void heatmap_gl_destroy(HeatmapGL *h)
+{
+    if (h == nullptr) {
+        return;
+    }
+    GlApi *gl = h->gl;
+    if (h->heatProg != 0) gl->glDeleteProgram(h->heatProg);
+    if (h->overlayProg != 0) gl->glDeleteProgram(h->overlayProg);
+    if (h->cellTex != 0) gl->glDeleteTextures(1, &h->cellTex);
+    if (h->lutTex != 0) gl->glDeleteTextures(1, &h->lutTex);
+    if (h->quadVbo != 0) gl->glDeleteBuffers(1, &h->quadVbo);
+    if (h->lineVbo != 0) gl->glDeleteBuffers(1, &h->lineVbo);
+    if (h->markerVbo != 0) gl->glDeleteBuffers(1, &h->markerVbo);
+    delete h;
+}
+
+extern "C" void heatmap_gl_set_colormap(HeatmapGL *h, const uint8_t *rgb,
+                                        uint32_t count)
+{
+    if (h == nullptr || rgb == nullptr) {
+        return;
+    }
+    if (count < 2) count = 2;
+    if (count > 256) count = 256;
+    h->gl->glBindTexture(GL_TEXTURE_2D, h->lutTex);
+    h->gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    h->gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
+                        static_cast<GLsizei>(count), 1, 0, GL_RGB,
+                        GL_UNSIGNED_BYTE, rgb);
+}
+
+extern "C" void heatmap_gl_set_range(HeatmapGL *h, float maxValue)
+{
+    if (h != nullptr && maxValue > 0.0f) {
+        h->gain = 65535.0f / maxValue;
+    }
+}
+
+extern "C" void heatmap_gl_upload(HeatmapGL *h, const uint16_t *cells)
+{
+    if (h == nullptr || cells == nullptr) {
+        return;
+    }
+    h->gl->glBindTexture(GL_TEXTURE_2D, h->cellTex);
+    h->gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    h->gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+                           static_cast<GLsizei>(h->cols),
+                           static_cast<GLsizei>(h->rows), GL_LUMINANCE,
+                           GL_UNSIGNED_SHORT, cells);
+}
+
+extern "C" void heatmap_gl_set_lines(HeatmapGL *h, const float *verts,
+                                     uint32_t vertexCount)
+{
+    if (h == nullptr) {
+        return;
+    }
+    vertexCount &= ~1u;             /* Whole segments only */
+    h->lineVerts = vertexCount;
+    if (vertexCount != 0) {
+        h->gl->glBindBuffer(GL_ARRAY_BUFFER, h->lineVbo);
+        h->gl->glBufferData(GL_ARRAY_BUFFER,
+                            static_cast<GLsizeiptr>(vertexCount) * 6 *
+                                sizeof(float),
+                            verts, GL_DYNAMIC_DRAW);
+    }
+}
+
+extern "C" void heatmap_gl_set_markers(HeatmapGL *h, const float *verts,
+                                       uint32_t vertexCount, float pxSize)
+{
+    if (h == nullptr) {
+        return;
+    }
+    h->markerVerts = vertexCount;
+    h->markerSize = (pxSize > 1.0f) ? pxSize : 1.0f;
+    if (vertexCount != 0) {
+        h->gl->glBindBuffer(GL_ARRAY_BUFFER, h->markerVbo);
+        h->gl->glBufferData(GL_ARRAY_BUFFER,
+                            static_cast<GLsizeiptr>(vertexCount) * 6 *
+                                sizeof(float),
+                            verts, GL_DYNAMIC_DRAW);
+    }
+}
+
+extern "C" int heatmap_gl_render(HeatmapGL *h, int fbWidth, int fbHeight)
+{
+    if (h == nullptr || fbWidth <= 0 || fbHeight <= 0) {
+        return -1;
+    }
+    GlApi *gl = h->gl;
+
+    /* Letterbox the grid into the viewport: cell coordinates map to
+     * NDC via one scale + offset, y down like the detectors expect */
+    const float cellPx =
+        std::min(static_cast<float>(fbWidth) / static_cast<float>(h->cols),
+                 static_cast<float>(fbHeight) / static_cast<float>(h->rows));
+    const float sx = 2.0f * cellPx / static_cast<float>(fbWidth);
+    const float sy = -2.0f * cellPx / static_cast<float>(fbHeight);
+    const float ox = -0.5f * sx * static_cast<float>(h->cols);
+    const float oy = -0.5f * sy * static_cast<float>(h->rows);
+
+    gl->glViewport(0, 0, fbWidth, fbHeight);
+    gl->glClearColor(0.118f, 0.118f, 0.180f, 1.0f); /* GUI dark theme */
+    gl->glClear(GL_COLOR_BUFFER_BIT);
+
+    gl->glUseProgram(h->heatProg);
+    gl->glUniform2f(h->heatScaleLoc, sx, sy);
+    gl->glUniform2f(h->heatOffsetLoc, ox, oy);
+    gl->glUniform2f(h->heatGridLoc, static_cast<float>(h->cols),
+                    static_cast<float>(h->rows));
+    gl->glUniform1f(h->heatGainLoc, h->gain);
+    gl->glActiveTexture(GL_TEXTURE0);
+    gl->glBindTexture(GL_TEXTURE_2D, h->cellTex);
+    gl->glUniform1i(h->heatCellsLoc, 0);
+    gl->glActiveTexture(GL_TEXTURE0 + 1);
+    gl->glBindTexture(GL_TEXTURE_2D, h->lutTex);
+    gl->glUniform1i(h->heatLutLoc, 1);
+    gl->glActiveTexture(GL_TEXTURE0);
+
+    gl->glBindBuffer(GL_ARRAY_BUFFER, h->quadVbo);
+    gl->glEnableVertexAttribArray(static_cast<GLuint>(h->heatPosAttr));
+    gl->glVertexAttribPointer(static_cast<GLuint>(h->heatPosAttr), 2,
+                              GL_FLOAT, 0, 0, nullptr);
+    gl->glDrawArrays(GL_TRIANGLES, 0, 6);
+    gl->glDisableVertexAttribArray(static_cast<GLuint>(h->heatPosAttr));
+
+    if (h->lineVerts != 0 || h->markerVerts != 0) {
+        gl->glUseProgram(h->overlayProg);
+        gl->glUniform2f(h->ovScaleLoc, sx, sy);
+        gl->glUniform2f(h->ovOffsetLoc, ox, oy);
+        gl->glUniform1f(h->ovPointLoc, h->markerSize);
+        gl->glEnable(GL_BLEND);
+        gl->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gl->glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+
+        const GLsizei stride = 6 * sizeof(float);
+        auto drawOverlay = [&](GLuint vbo, GLenum mode, uint32_t count) {
+            gl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            gl->glEnableVertexAttribArray(static_cast<GLuint>(h->ovPosAttr));
+            gl->glEnableVertexAttribArray(
+                static_cast<GLuint>(h->ovColorAttr));
+            gl->glVertexAttribPointer(static_cast<GLuint>(h->ovPosAttr), 2,
+                                      GL_FLOAT, 0, stride, nullptr);
+            gl->glVertexAttribPointer(
+                static_cast<GLuint>(h->ovColorAttr), 4, GL_FLOAT, 0, stride,
+                reinterpret_cast<const void *>(2 * sizeof(float)));
+            gl->glDrawArrays(mode, 0, static_cast<GLsizei>(count));
+            gl->glDisableVertexAttribArray(
+                static_cast<GLuint>(h->ovPosAttr));
+            gl->glDisableVertexAttribArray(
+                static_cast<GLuint>(h->ovColorAttr));
+        };
+
+        if (h->lineVerts != 0) {
+            gl->glLineWidth(2.0f);
+            drawOverlay(h->lineVbo, GL_LINES, h->lineVerts);
+        }
+        if (h->markerVerts != 0) {
+            drawOverlay(h->markerVbo, GL_POINTS, h->markerVerts);
+        }
+        gl->glDisable(GL_BLEND);
+    }
+
+    gl->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    gl->glUseProgram(0);
+    return (gl->glGetError() == GL_NO_ERROR) ? 0 : -1;
+}
+
+#endif /* POSIX */
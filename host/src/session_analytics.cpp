@@ -0,0 +1,383 @@
+/**
+ ******************************************************************************
+ * @file           : session_analytics.cpp
+ * @brief          : Offline session analytics implementation
+ ******************************************************************************
+ *
+ * Parallel phase: the record range is cut into one contiguous chunk
+ * per worker, and each worker walks its chunk through the replay's
+ * read-only record accessor, filling disjoint slices of preallocated
+ * per-frame arrays - frame reductions via grid_kernels_reduce, and for
+ * each landmark the summed pressure and peak over the cells within
+ * kLandmarkRadius of it (those cell lists are computed once up
+ * front). No locks, no false sharing beyond chunk edges, and the mmap
+ * means a cold file streams from disk at readahead speed.
+ *
+ * Serial phase: a single ordered pass chains the per-frame values -
+ * trapezoidal integration of each landmark region's pressure over
+ * time, centroid-to-centroid speeds over consecutive contact frames
+ * (a contact gap longer than kMaxSpeedGapS breaks the chain rather
+ * than manufacture a huge teleport speed), dwell time per SpeedZones
+ * band, and the packed center-of-pressure trajectory. This pass is a
+ * few adds per frame and does not merit threads.
+ *
+ ******************************************************************************
+ */
+
+#include "session_analytics.h"
+
+#include "grid_kernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/* Cells within this distance of a landmark form its region (the same
+ * 3-cell neighbourhood the on-target metric uses) */
+constexpr float kLandmarkRadius = 3.0f;
+
+/* Frame cell-sum below this is no contact (kMinTrackTotal in the
+ * replay engine and spine tracker) */
+constexpr uint64_t kMinContactTotal = 100;
+
+/* A contact gap longer than this breaks the speed chain */
+constexpr double kMaxSpeedGapS = 0.5;
+
+/* SpeedZones.get_zone defaults: STATIONARY, SLOW, OPTIMAL_MIN,
+ * OPTIMAL_MAX, FAST in cells/second */
+constexpr float kDefaultSpeedZones[5] = {1.0f, 3.0f, 5.0f, 12.0f, 18.0f};
+
+struct PerFrame {
+    double stampS = 0;
+    double sum = 0;
+    float row = 0, col = 0;
+    uint8_t contact = 0;
+};
+
+struct LandmarkRegion {
+    SpineEngineLandmark lm;
+    std::vector<uint32_t> cells;   /* Flat indices within the radius */
+};
+
+/* Band index per the comparison chain of SpeedZones.get_zone (note it
+ * never reads OPTIMAL_MIN: slow runs up to OPTIMAL_MAX) */
+int speedBand(float speed, const float z[5])
+{
+    if (speed < z[0]) {
+        return SESSION_SPEED_STATIONARY;
+    }
+    if (speed < z[1]) {
+        return SESSION_SPEED_SLOW;
+    }
+    if (speed <= z[3]) {
+        return SESSION_SPEED_OPTIMAL;
+    }
+    if (speed <= z[4]) {
+        return SESSION_SPEED_FAST;
+    }
+    return SESSION_SPEED_TOO_FAST;
+}
+
+} // namespace
+
+struct SessionAnalyticsReport {
+    /* Center-of-pressure trajectory, contact frames only */
+    std::vector<double> copTime;
+    std::vector<float> copRow, copCol, copPressure;
+
+    std::vector<SessionLandmarkMetrics> landmarks;
+
+    double speedSeconds[SESSION_SPEED_BANDS] = {0};
+    double meanSpeed = 0;
+    double maxSpeed = 0;
+    double elapsedS = 0;
+};
+
+extern "C" SessionAnalyticsReport *
+session_analytics_run(const SessionReplay *rep, const SpineEngine *eng,
+                      const float speedZones[5], uint32_t threads)
+{
+    if (rep == nullptr) {
+        return nullptr;
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    const uint64_t count = session_replay_count(rep);
+    const uint32_t rows = session_replay_rows(rep);
+    const uint32_t cols = session_replay_cols(rep);
+
+    float zones[5];
+    std::memcpy(zones, (speedZones != nullptr) ? speedZones
+                                               : kDefaultSpeedZones,
+                sizeof(zones));
+
+    auto *r = new (std::nothrow) SessionAnalyticsReport();
+    if (r == nullptr) {
+        return nullptr;
+    }
+
+    /* Landmark regions from the engine's current calibration */
+    std::vector<LandmarkRegion> regions;
+    if (eng != nullptr && spine_engine_is_calibrated(eng)) {
+        SpineEngineLandmark lms[15];
+        int n = spine_engine_get_landmarks(eng, lms, 15);
+        regions.resize(static_cast<size_t>(n));
+        for (int i = 0; i < n; i++) {
+            regions[i].lm = lms[i];
+            for (uint32_t rr = 0; rr < rows; rr++) {
+                for (uint32_t cc = 0; cc < cols; cc++) {
+                    float dr = static_cast<float>(rr) - lms[i].row;
+                    float dc = static_cast<float>(cc) - lms[i].col;
+                    if (std::sqrt(dr * dr + dc * dc) <= kLandmarkRadius) {
+                        regions[i].cells.push_back(rr * cols + cc);
+                    }
+                }
+            }
+        }
+    }
+    const size_t nRegions = regions.size();
+
+    try {
+        std::vector<PerFrame> frames(count);
+        /* Frame-major region sums and peaks; disjoint writes only */
+        std::vector<float> regSum(count * nRegions);
+        std::vector<uint16_t> regPeak(count * nRegions);
+
+        uint32_t nThreads = threads;
+        if (nThreads == 0) {
+            nThreads = std::thread::hardware_concurrency();
+            if (nThreads == 0) {
+                nThreads = 1;
+            }
+        }
+        if (nThreads > count && count > 0) {
+            nThreads = static_cast<uint32_t>(count);
+        }
+
+        auto worker = [&](uint64_t i0, uint64_t i1) {
+            for (uint64_t i = i0; i < i1; i++) {
+                const uint16_t *cells = nullptr;
+                uint64_t stampUs = 0;
+                if (!session_replay_record(rep, i, &cells, nullptr,
+                                           &stampUs, nullptr, nullptr)) {
+                    continue;
+                }
+                GridKernelsReduce red;
+                grid_kernels_reduce(cells, rows, cols, &red);
+                PerFrame &pf = frames[i];
+                pf.stampS = static_cast<double>(stampUs) / 1e6;
+                pf.sum = static_cast<double>(red.sum);
+                pf.row = red.centroidRow;
+                pf.col = red.centroidCol;
+                pf.contact = (red.sum >= kMinContactTotal) ? 1 : 0;
+
+                for (size_t g = 0; g < nRegions; g++) {
+                    uint32_t sum = 0;
+                    uint16_t peak = 0;
+                    for (uint32_t idx : regions[g].cells) {
+                        uint16_t v = cells[idx];
+                        sum += v;
+                        if (v > peak) {
+                            peak = v;
+                        }
+                    }
+                    regSum[i * nRegions + g] = static_cast<float>(sum);
+                    regPeak[i * nRegions + g] = peak;
+                }
+            }
+        };
+
+        if (nThreads <= 1 || count < 2) {
+            worker(0, count);
+        } else {
+            std::vector<std::thread> pool;
+            pool.reserve(nThreads);
+            uint64_t chunk = (count + nThreads - 1) / nThreads;
+            for (uint32_t t = 0; t < nThreads; t++) {
+                uint64_t i0 = static_cast<uint64_t>(t) * chunk;
+                uint64_t i1 = i0 + chunk;
+                if (i1 > count) {
+                    i1 = count;
+                }
+                if (i0 >= i1) {
+                    break;
+                }
+                pool.emplace_back(worker, i0, i1);
+            }
+            for (std::thread &th : pool) {
+                th.join();
+            }
+        }
+
+        /* Serial chaining pass */
+        r->landmarks.resize(nRegions);
+        for (size_t g = 0; g < nRegions; g++) {
+            SessionLandmarkMetrics &m = r->landmarks[g];
+            std::memset(&m, 0, sizeof(m));
+            /* Same fixed-width fields as SpineEngineLandmark */
+            std::memcpy(m.level, regions[g].lm.level, sizeof(m.level));
+            std::memcpy(m.type, regions[g].lm.type, sizeof(m.type));
+        }
+
+        double speedTimeSum = 0;
+        double speedWeighted = 0;
+        bool havePrevContact = false;
+        double prevContactT = 0;
+        float prevRow = 0, prevCol = 0;
+
+        for (uint64_t i = 0; i < count; i++) {
+            const PerFrame &pf = frames[i];
+
+            if (i > 0) {
+                double dt = pf.stampS - frames[i - 1].stampS;
+                if (dt > 0) {
+                    for (size_t g = 0; g < nRegions; g++) {
+                        SessionLandmarkMetrics &m = r->landmarks[g];
+                        float p0 = regSum[(i - 1) * nRegions + g];
+                        float p1 = regSum[i * nRegions + g];
+                        m.forceTimeIntegral += 0.5 * (p0 + p1) * dt;
+                        if (p1 >= static_cast<float>(kMinContactTotal)) {
+                            m.contactSec += dt;
+                        }
+                    }
+                }
+            }
+            for (size_t g = 0; g < nRegions; g++) {
+                if (regPeak[i * nRegions + g] > r->landmarks[g].peak) {
+                    r->landmarks[g].peak = regPeak[i * nRegions + g];
+                }
+            }
+
+            if (!pf.contact) {
+                continue;
+            }
+            r->copTime.push_back(pf.stampS);
+            r->copRow.push_back(pf.row);
+            r->copCol.push_back(pf.col);
+            r->copPressure.push_back(static_cast<float>(pf.sum));
+
+            if (havePrevContact) {
+                double dt = pf.stampS - prevContactT;
+                if (dt > 0 && dt <= kMaxSpeedGapS) {
+                    float dr = pf.row - prevRow;
+                    float dc = pf.col - prevCol;
+                    float speed = static_cast<float>(
+                        std::sqrt(dr * dr + dc * dc) / dt);
+                    r->speedSeconds[speedBand(speed, zones)] += dt;
+                    speedWeighted += speed * dt;
+                    speedTimeSum += dt;
+                    if (speed > r->maxSpeed) {
+                        r->maxSpeed = speed;
+                    }
+                }
+            }
+            havePrevContact = true;
+            prevContactT = pf.stampS;
+            prevRow = pf.row;
+            prevCol = pf.col;
+        }
+
+        if (speedTimeSum > 0) {
+            r->meanSpeed = speedWeighted / speedTimeSum;
+        }
+    } catch (const std::bad_alloc &) {
+        delete r;
+        return nullptr;
+    }
+
+    r->elapsedS = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - t0)
+                      .count();
+    return r;
+}
+
+extern "C" void session_analytics_free(SessionAnalyticsReport *r)
+{
+    delete r;
+}
+
+extern "C" uint64_t
+session_analytics_cop_points(const SessionAnalyticsReport *r)
+{
+    return (r != nullptr) ? r->copTime.size() : 0;
+}
+
+extern "C" uint32_t session_analytics_cop(const SessionAnalyticsReport *r,
+                                          uint64_t start, uint32_t count,
+                                          double *timeS, float *row,
+                                          float *col, float *pressure)
+{
+    if (r == nullptr || start >= r->copTime.size()) {
+        return 0;
+    }
+    uint64_t avail = r->copTime.size() - start;
+    uint32_t n = (count < avail) ? count
+                                 : static_cast<uint32_t>(avail);
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t s = start + i;
+        if (timeS != nullptr) {
+            timeS[i] = r->copTime[s];
+        }
+        if (row != nullptr) {
+            row[i] = r->copRow[s];
+        }
+        if (col != nullptr) {
+            col[i] = r->copCol[s];
+        }
+        if (pressure != nullptr) {
+            pressure[i] = r->copPressure[s];
+        }
+    }
+    return n;
+}
+
+extern "C" int session_analytics_landmarks(const SessionAnalyticsReport *r,
+                                           SessionLandmarkMetrics *out,
+                                           int cap)
+{
+    if (r == nullptr || out == nullptr || cap <= 0) {
+        return 0;
+    }
+    int n = static_cast<int>(r->landmarks.size());
+    if (n > cap) {
+        n = cap;
+    }
+    for (int i = 0; i < n; i++) {
+        out[i] = r->landmarks[i];
+    }
+    return n;
+}
+
+extern "C" void
+session_analytics_speed_seconds(const SessionAnalyticsReport *r,
+                                double out[SESSION_SPEED_BANDS])
+{
+    if (out == nullptr) {
+        return;
+    }
+    for (int i = 0; i < SESSION_SPEED_BANDS; i++) {
+        out[i] = (r != nullptr) ? r->speedSeconds[i] : 0;
+    }
+}
+
+extern "C" double
+session_analytics_mean_speed(const SessionAnalyticsReport *r)
+{
+    return (r != nullptr) ? r->meanSpeed : 0;
+}
+
+extern "C" double
+session_analytics_max_speed(const SessionAnalyticsReport *r)
+{
+    return (r != nullptr) ? r->maxSpeed : 0;
+}
+
+extern "C" double
+session_analytics_elapsed(const SessionAnalyticsReport *r)
+{
+    return (r != nullptr) ? r->elapsedS : 0;
+}
@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file           : session_codec.h
+ * @brief          : Chunk payload codecs for .gsf sessions (internal)
+ ******************************************************************************
+ *
+ * The delta preconditioning and the built-in zero-run byte codec used
+ * by SESSION_FLAG_COMPRESSED files, shared between the writer and the
+ * replay engine. The preconditioning subtracts each record's cells
+ * from the previous record's (mod 2^16) - the same change-sparsity the
+ * wire delta mode exploits - which turns a palpation stream into long
+ * zero runs that any byte codec collapses. The zero-run encoding is
+ * the floor codec for machines without zstd: a 0x00 byte is always
+ * followed by a run length, every other byte stands for itself, so
+ * worst case is 2x (all isolated zeros) and the writer falls back to
+ * verbatim storage whenever encoding does not shrink a chunk.
+ *
+ ******************************************************************************
+ */
+
+#ifndef SESSION_CODEC_H
+#define SESSION_CODEC_H
+
+#include "session_file.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Largest zero-run encoded size for n input bytes */
+inline size_t sessionRle0Bound(size_t n)
+{
+    return 2 * n + 16;
+}
+
+/** Encode n bytes; dst must hold sessionRle0Bound(n). Returns bytes
+ *  written */
+inline size_t sessionRle0Encode(const uint8_t *src, size_t n,
+                                uint8_t *dst)
+{
+    size_t o = 0;
+    for (size_t i = 0; i < n;) {
+        uint8_t b = src[i];
+        if (b == 0) {
+            size_t run = 1;
+            while (run < 255 && i + run < n && src[i + run] == 0) {
+                run++;
+            }
+            dst[o++] = 0;
+            dst[o++] = static_cast<uint8_t>(run);
+            i += run;
+        } else {
+            dst[o++] = b;
+            i++;
+        }
+    }
+    return o;
+}
+
+/** Decode into exactly rawLen bytes. Returns 1 on success, 0 on a
+ *  corrupt payload */
+inline int sessionRle0Decode(const uint8_t *src, size_t n, uint8_t *dst,
+                             size_t rawLen)
+{
+    size_t o = 0;
+    for (size_t i = 0; i < n;) {
+        uint8_t b = src[i++];
+        if (b == 0) {
+            if (i >= n) {
+                return 0;
+            }
+            size_t run = src[i++];
+            if (run == 0 || o + run > rawLen) {
+                return 0;
+            }
+            memset(dst + o, 0, run);
+            o += run;
+        } else {
+            if (o >= rawLen) {
+                return 0;
+            }
+            dst[o++] = b;
+        }
+    }
+    return o == rawLen ? 1 : 0;
+}
+
+/** Rebuild a decoded chunk's cells in place: record i's cells were
+ *  stored as deltas against record i-1 (the first record is verbatim) */
+inline void sessionDeltaUndo(uint8_t *chunk, uint32_t records,
+                             size_t recordSize, size_t cellCount)
+{
+    for (uint32_t i = 1; i < records; i++) {
+        uint16_t *cur = reinterpret_cast<uint16_t *>(
+            chunk + i * recordSize + sizeof(SessionRecordHeader));
+        const uint16_t *prev = reinterpret_cast<const uint16_t *>(
+            chunk + (i - 1) * recordSize + sizeof(SessionRecordHeader));
+        for (size_t c = 0; c < cellCount; c++) {
+            cur[c] = static_cast<uint16_t>(cur[c] + prev[c]);
+        }
+    }
+}
+
+#endif /* SESSION_CODEC_H */
@@ -0,0 +1,569 @@
+/**
+ ******************************************************************************
+ * @file           : session_replay.cpp
+ * @brief          : Session replay engine implementation
+ ******************************************************************************
+ *
+ * The whole file is mapped read-only (falling back to one read into
+ * memory on platforms without mmap - the API is identical either way)
+ * and every accessor computes offsets into it; nothing is parsed ahead
+ * of time except the seek index, which is either taken from the file
+ * or rebuilt from record headers when the recording crashed before its
+ * clean close.
+ *
+ * Compressed sessions (SESSION_FLAG_COMPRESSED) decode lazily per
+ * chunk: record N's chunk is a division plus a chunk-directory lookup
+ * (the directory is rebuilt by walking chunk headers after a crash,
+ * losing only the chunk that was being staged). Decoded chunks are
+ * cached for the life of the instance - never evicted, because record
+ * pointers are promised valid until close - so a fully-scanned
+ * compressed session costs its raw size in memory, same as the
+ * no-mmap fallback always did. The cache is mutex-guarded; concurrent
+ * readers (the analytics worker pool) each decode distinct chunks and
+ * only contend on the lookup.
+ *
+ * Seek-by-time binary-searches the sparse index (one entry per second)
+ * and walks at most one second of records from there, so scrubbing
+ * cost is independent of session length. The playback cursor is just a
+ * position in session time advanced by rate-scaled wall deltas; at
+ * 16x the seek lands past intermediate records and they are skipped
+ * without ever being touched.
+ *
+ ******************************************************************************
+ */
+
+#include "session_replay.h"
+#include "session_file.h"
+#include "grid_decoder.h"
+#include "grid_kernels.h"
+#include "session_codec.h"
+#include "zstd_dyn.h"
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SESSION_REPLAY_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define SESSION_REPLAY_HAVE_MMAP 0
+#endif
+
+namespace {
+
+constexpr uint64_t kMinTrackTotal = 100;   /* Matches spine engine */
+constexpr float kOnTargetCells = 3.0f;
+
+} // namespace
+
+struct SessionReplay {
+    const uint8_t *base = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::vector<uint8_t> owned;        /* Fallback storage */
+
+    SessionFileHeader header{};
+    uint64_t count = 0;
+    uint64_t durationUs = 0;
+    std::vector<SessionIndexEntry> index;
+
+    /* Playback cursor */
+    double positionUs = 0.0;
+    double rate = 1.0;
+    uint64_t lastShown = UINT64_MAX;   /* Sentinel: nothing shown yet */
+
+    /* Compressed form: chunk file offsets and the decoded-chunk cache
+     * (grow-only - handed-out record pointers stay valid until close) */
+    bool compressed = false;
+    std::vector<uint64_t> chunkOffsets;
+    mutable std::vector<std::vector<uint8_t>> chunkCache;
+    mutable std::mutex cacheMtx;
+
+    const uint8_t *chunkPtr(uint64_t chunkIdx) const;
+
+    const uint8_t *recordPtr(uint64_t idx) const
+    {
+        if (!compressed) {
+            return base + sizeof(SessionFileHeader) +
+                   idx * header.recordSize;
+        }
+        return chunkPtr(idx / header.chunkRecords) +
+               (idx % header.chunkRecords) * header.recordSize;
+    }
+
+    const SessionRecordHeader *recordHeader(uint64_t idx) const
+    {
+        return reinterpret_cast<const SessionRecordHeader *>(
+            recordPtr(idx));
+    }
+};
+
+/* Decode a chunk on first touch. A chunk that cannot decode (a zstd
+ * chunk on a machine without the library, or corruption) caches as
+ * zeroes - no-contact frames - rather than hand out a bad pointer */
+const uint8_t *SessionReplay::chunkPtr(uint64_t chunkIdx) const
+{
+    std::lock_guard<std::mutex> lock(cacheMtx);
+    std::vector<uint8_t> &slot = chunkCache[chunkIdx];
+    if (!slot.empty()) {
+        return slot.data();
+    }
+
+    const uint8_t *p = base + chunkOffsets[chunkIdx];
+    SessionChunkHeader ch;
+    std::memcpy(&ch, p, sizeof(ch));
+    slot.assign(ch.rawBytes, 0);
+    const uint8_t *payload = p + sizeof(ch);
+
+    bool ok = false;
+    switch (ch.codec) {
+    case SESSION_CODEC_STORE:
+        if (ch.compBytes == ch.rawBytes) {
+            std::memcpy(slot.data(), payload, ch.rawBytes);
+            ok = true;
+        }
+        break;
+    case SESSION_CODEC_DELTA_RLE:
+        ok = sessionRle0Decode(payload, ch.compBytes, slot.data(),
+                               ch.rawBytes) != 0;
+        break;
+    case SESSION_CODEC_DELTA_ZSTD: {
+        const ZstdDyn *z = zstdDynGet();
+        if (z != nullptr) {
+            size_t r = z->decompress(slot.data(), slot.size(), payload,
+                                     ch.compBytes);
+            ok = !z->isError(r) && r == ch.rawBytes;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    if (ok) {
+        sessionDeltaUndo(slot.data(), ch.records, header.recordSize,
+                         static_cast<size_t>(header.rows) * header.cols);
+    } else {
+        std::memset(slot.data(), 0, slot.size());
+    }
+    return slot.data();
+}
+
+namespace {
+
+bool mapFile(SessionReplay *r, const char *path)
+{
+#if SESSION_REPLAY_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *m = mmap(nullptr, static_cast<size_t>(st.st_size),
+                           PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                close(fd);
+                r->base = static_cast<const uint8_t *>(m);
+                r->size = static_cast<size_t>(st.st_size);
+                r->mapped = true;
+                return true;
+            }
+        }
+        close(fd);
+    }
+#endif
+    /* Fallback: one bulk read */
+    std::FILE *f = std::fopen(path, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    std::fseek(f, 0, SEEK_END);
+    long sz = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    if (sz <= 0) {
+        std::fclose(f);
+        return false;
+    }
+    r->owned.resize(static_cast<size_t>(sz));
+    size_t got = std::fread(r->owned.data(), 1, r->owned.size(), f);
+    std::fclose(f);
+    if (got != r->owned.size()) {
+        return false;
+    }
+    r->base = r->owned.data();
+    r->size = r->owned.size();
+    return true;
+}
+
+bool validate(SessionReplay *r)
+{
+    if (r->size < sizeof(SessionFileHeader)) {
+        return false;
+    }
+    std::memcpy(&r->header, r->base, sizeof(r->header));
+    const SessionFileHeader &h = r->header;
+    if (h.magic != SESSION_FILE_MAGIC ||
+        h.version != SESSION_FILE_VERSION ||
+        h.headerSize != sizeof(SessionFileHeader) || h.rows == 0 ||
+        h.cols == 0 || h.metaSize != GRID_DEC_META_SIZE) {
+        return false;
+    }
+    size_t expect = sizeof(SessionRecordHeader) +
+                    static_cast<size_t>(h.rows) * h.cols *
+                        sizeof(uint16_t) +
+                    h.metaSize;
+    expect = (expect + 7u) & ~size_t{7};
+    if (h.recordSize != expect) {
+        return false;
+    }
+
+    r->compressed = (h.flags & SESSION_FLAG_COMPRESSED) != 0;
+    if (r->compressed) {
+        if (h.chunkRecords == 0) {
+            return false;
+        }
+        if (h.recordCount != 0 && h.chunkDirOffset != 0 &&
+            h.chunkDirOffset + sizeof(uint64_t) <= r->size) {
+            uint64_t n;
+            std::memcpy(&n, r->base + h.chunkDirOffset, sizeof(n));
+            if (n == 0 ||
+                h.chunkDirOffset + (n + 1) * sizeof(uint64_t) >
+                    r->size) {
+                return false;
+            }
+            r->chunkOffsets.resize(n);
+            std::memcpy(r->chunkOffsets.data(),
+                        r->base + h.chunkDirOffset + sizeof(uint64_t),
+                        n * sizeof(uint64_t));
+        } else {
+            /* Crashed recording: rebuild the directory by walking
+             * chunk headers; an incomplete trailing chunk is cut */
+            uint64_t off = sizeof(SessionFileHeader);
+            while (off + sizeof(SessionChunkHeader) <= r->size) {
+                SessionChunkHeader ch;
+                std::memcpy(&ch, r->base + off, sizeof(ch));
+                if (ch.records == 0 ||
+                    ch.rawBytes != static_cast<uint64_t>(ch.records) *
+                                       h.recordSize ||
+                    off + sizeof(ch) + ch.compBytes > r->size) {
+                    break;
+                }
+                r->chunkOffsets.push_back(off);
+                off += sizeof(ch) + ch.compBytes;
+            }
+        }
+        /* Each chunk must check out, and all but the last must be full
+         * so that record->chunk stays a plain division */
+        r->count = 0;
+        for (size_t i = 0; i < r->chunkOffsets.size(); i++) {
+            uint64_t off = r->chunkOffsets[i];
+            if (off + sizeof(SessionChunkHeader) > r->size) {
+                return false;
+            }
+            SessionChunkHeader ch;
+            std::memcpy(&ch, r->base + off, sizeof(ch));
+            if (ch.records == 0 ||
+                ch.rawBytes != static_cast<uint64_t>(ch.records) *
+                                   h.recordSize ||
+                off + sizeof(ch) + ch.compBytes > r->size ||
+                (i + 1 < r->chunkOffsets.size() &&
+                 ch.records != h.chunkRecords)) {
+                return false;
+            }
+            r->count += ch.records;
+        }
+        if (r->count == 0) {
+            return false;
+        }
+        r->chunkCache.resize(r->chunkOffsets.size());
+    } else if (h.recordCount != 0) {
+        uint64_t bodyBytes = h.recordCount * h.recordSize;
+        if (sizeof(SessionFileHeader) + bodyBytes > r->size) {
+            return false;
+        }
+        r->count = h.recordCount;
+    } else {
+        /* Crashed recording: every complete record before the cut */
+        r->count = (r->size - sizeof(SessionFileHeader)) / h.recordSize;
+    }
+    if (r->count == 0) {
+        return false;
+    }
+    r->durationUs = r->recordHeader(r->count - 1)->stampUs;
+
+    if ((h.flags & SESSION_FLAG_INDEXED) != 0 && h.indexCount != 0 &&
+        h.indexOffset + h.indexCount * sizeof(SessionIndexEntry) <=
+            r->size) {
+        r->index.resize(h.indexCount);
+        std::memcpy(r->index.data(), r->base + h.indexOffset,
+                    h.indexCount * sizeof(SessionIndexEntry));
+    } else {
+        /* Rebuild: headers only, one touch per record */
+        uint64_t nextUs = 0;
+        for (uint64_t i = 0; i < r->count; i++) {
+            uint64_t ts = r->recordHeader(i)->stampUs;
+            if (ts >= nextUs) {
+                r->index.push_back(SessionIndexEntry{ts, i});
+                nextUs = ts + 1000000;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SessionReplay *session_replay_open(const char *path)
+{
+    if (path == nullptr) {
+        return nullptr;
+    }
+    auto *r = new (std::nothrow) SessionReplay();
+    if (r == nullptr) {
+        return nullptr;
+    }
+    if (!mapFile(r, path) || !validate(r)) {
+        session_replay_close(r);
+        return nullptr;
+    }
+    return r;
+}
+
+void session_replay_close(SessionReplay *rep)
+{
+    if (rep == nullptr) {
+        return;
+    }
+#if SESSION_REPLAY_HAVE_MMAP
+    if (rep->mapped) {
+        munmap(const_cast<uint8_t *>(rep->base), rep->size);
+    }
+#endif
+    delete rep;
+}
+
+uint32_t session_replay_rows(const SessionReplay *rep)
+{
+    return (rep != nullptr) ? rep->header.rows : 0;
+}
+
+uint32_t session_replay_cols(const SessionReplay *rep)
+{
+    return (rep != nullptr) ? rep->header.cols : 0;
+}
+
+uint64_t session_replay_count(const SessionReplay *rep)
+{
+    return (rep != nullptr) ? rep->count : 0;
+}
+
+uint64_t session_replay_duration_us(const SessionReplay *rep)
+{
+    return (rep != nullptr) ? rep->durationUs : 0;
+}
+
+int session_replay_record(const SessionReplay *rep, uint64_t idx,
+                          const uint16_t **cells, const uint8_t **meta,
+                          uint64_t *stampUs, uint32_t *seq,
+                          int32_t *type)
+{
+    if (rep == nullptr || idx >= rep->count) {
+        return 0;
+    }
+    const uint8_t *rec = rep->recordPtr(idx);
+    const auto *hdr = reinterpret_cast<const SessionRecordHeader *>(rec);
+    if (cells != nullptr) {
+        *cells = reinterpret_cast<const uint16_t *>(
+            rec + sizeof(SessionRecordHeader));
+    }
+    if (meta != nullptr) {
+        *meta = rec + sizeof(SessionRecordHeader) +
+                static_cast<size_t>(rep->header.rows) *
+                    rep->header.cols * sizeof(uint16_t);
+    }
+    if (stampUs != nullptr) {
+        *stampUs = hdr->stampUs;
+    }
+    if (seq != nullptr) {
+        *seq = hdr->seq;
+    }
+    if (type != nullptr) {
+        *type = hdr->type;
+    }
+    return 1;
+}
+
+uint64_t session_replay_seek_time(const SessionReplay *rep,
+                                  uint64_t stampUs)
+{
+    if (rep == nullptr || rep->count == 0) {
+        return 0;
+    }
+    /* Largest index entry at or before the target */
+    uint64_t start = 0;
+    size_t lo = 0;
+    size_t hi = rep->index.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (rep->index[mid].stampUs <= stampUs) {
+            start = rep->index[mid].recordIdx;
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    /* Walk the at-most-one-second gap to the first record >= target */
+    uint64_t idx = start;
+    while (idx < rep->count && rep->recordHeader(idx)->stampUs < stampUs) {
+        idx++;
+    }
+    return (idx < rep->count) ? idx : rep->count - 1;
+}
+
+void session_replay_set_position(SessionReplay *rep, uint64_t stampUs)
+{
+    if (rep != nullptr) {
+        rep->positionUs = static_cast<double>(stampUs);
+        rep->lastShown = UINT64_MAX;
+    }
+}
+
+void session_replay_set_rate(SessionReplay *rep, double rate)
+{
+    if (rep != nullptr && rate > 0.0) {
+        rep->rate = rate;
+    }
+}
+
+int session_replay_tick(SessionReplay *rep, double wallDeltaS,
+                        uint64_t *recordIdx)
+{
+    if (rep == nullptr || recordIdx == nullptr || rep->count == 0) {
+        return 0;
+    }
+    /* Show what the cursor has reached, then advance - so playback
+     * from t=0 starts with record 0, not one frame in */
+    uint64_t pos = (rep->positionUs < 0.0)
+                       ? 0
+                       : static_cast<uint64_t>(rep->positionUs);
+    uint64_t due = session_replay_seek_time(rep, pos);
+    bool reached = true;
+    if (rep->recordHeader(due)->stampUs > pos) {
+        if (due == 0) {
+            reached = false;    /* Before the first record */
+        } else {
+            due--;
+        }
+    }
+    if (wallDeltaS > 0.0) {
+        rep->positionUs += wallDeltaS * rep->rate * 1e6;
+    }
+    if (!reached ||
+        (rep->lastShown != UINT64_MAX && due <= rep->lastShown)) {
+        return 0;
+    }
+    rep->lastShown = due;
+    *recordIdx = due;
+    return 1;
+}
+
+int session_replay_at_end(const SessionReplay *rep)
+{
+    if (rep == nullptr || rep->count == 0) {
+        return 1;
+    }
+    return (rep->positionUs >= static_cast<double>(rep->durationUs) &&
+            rep->lastShown == rep->count - 1)
+               ? 1
+               : 0;
+}
+
+int session_replay_analyze(const SessionReplay *rep, SpineEngine *eng,
+                           const uint16_t zones[5], SessionAnalysis *out)
+{
+    if (rep == nullptr || zones == nullptr || out == nullptr) {
+        return 0;
+    }
+    std::memset(out, 0, sizeof(*out));
+    out->frames = rep->count;
+    out->durationS = static_cast<double>(rep->durationUs) / 1e6;
+
+    uint64_t contact = 0;
+    uint64_t optimal = 0;
+    uint64_t onTarget = 0;
+    uint64_t speedSamples = 0;
+    double peakSum = 0.0;
+    double speedSum = 0.0;
+    uint16_t maxPeak = 0;
+    int calibrated =
+        (eng != nullptr) ? spine_engine_is_calibrated(eng) : 0;
+
+    for (uint64_t i = 0; i < rep->count; i++) {
+        const uint8_t *rec = rep->recordPtr(i);
+        const auto *hdr =
+            reinterpret_cast<const SessionRecordHeader *>(rec);
+        const auto *cells = reinterpret_cast<const uint16_t *>(
+            rec + sizeof(SessionRecordHeader));
+
+        GridKernelsReduce red;
+        grid_kernels_reduce(cells, rep->header.rows, rep->header.cols,
+                            &red);
+        if (red.maxVal > maxPeak) {
+            maxPeak = red.maxVal;
+        }
+        if (red.sum < kMinTrackTotal) {
+            continue;
+        }
+        contact++;
+        peakSum += red.maxVal;
+        /* Zone semantics follow PalpationZones.get_zone */
+        if (red.maxVal >= zones[2] && red.maxVal <= zones[3]) {
+            optimal++;
+        }
+
+        if (eng != nullptr) {
+            float row;
+            float col;
+            float speed = 0.0f;
+            if (spine_engine_track(eng, cells,
+                                   static_cast<double>(hdr->stampUs) /
+                                       1e6,
+                                   &row, &col, &speed)) {
+                if (speed > 0.0f) {
+                    speedSum += speed;
+                    speedSamples++;
+                }
+                if (calibrated) {
+                    SpineEngineLandmark lm;
+                    float dist = 0.0f;
+                    if (spine_engine_nearest_landmark(eng, row, col,
+                                                      &lm, &dist) &&
+                        dist <= kOnTargetCells) {
+                        onTarget++;
+                    }
+                }
+            }
+        }
+    }
+
+    out->contactFrames = contact;
+    if (contact != 0) {
+        out->meanPeak = peakSum / static_cast<double>(contact);
+        out->optimalPressurePct =
+            100.0 * static_cast<double>(optimal) /
+            static_cast<double>(contact);
+        if (calibrated) {
+            out->onTargetPct = 100.0 * static_cast<double>(onTarget) /
+                               static_cast<double>(contact);
+        }
+    }
+    out->maxPeak = maxPeak;
+    if (speedSamples != 0) {
+        out->meanSpeed = speedSum / static_cast<double>(speedSamples);
+    }
+    return 1;
+}
@@ -0,0 +1,393 @@
+/**
+ ******************************************************************************
+ * @file           : session_writer.cpp
+ * @brief          : Append-only session recording writer implementation
+ ******************************************************************************
+ *
+ * One SPSC queue between the appending thread and a writer thread that
+ * owns the FILE*. Records are staged into a flat buffer slot (header,
+ * cells, meta, pad), so the appending thread's cost never grows beyond
+ * that one copy no matter what the writer thread is doing.
+ *
+ * In compressed mode (the default) the writer thread accumulates
+ * records into a chunk staging buffer, delta-preconditioning each
+ * record's cells against the previous record as it lands, and encodes
+ * the chunk when it fills - zstd when the system library resolves,
+ * the built-in zero-run codec otherwise, verbatim storage when
+ * neither shrinks it (see session_codec.h). Compression therefore
+ * runs entirely on this background thread; at 25 Hz a 64-record chunk
+ * is ~2.5 s of session and encodes in well under a millisecond, so
+ * the queue never backs up on its account and no frame is dropped for
+ * compression's sake.
+ *
+ * The sparse index and the chunk directory accumulate in memory (a
+ * 40-minute session is under 50 KB of both) and land at EOF on close,
+ * after which recordCount / indexOffset / chunkDirOffset / flags are
+ * patched into the header in one final update. Until that patch the
+ * header says recordCount 0, which is exactly the "crashed
+ * mid-recording" signature readers recover from - completed chunks
+ * decode independently, so a crash loses at most the chunk being
+ * staged.
+ *
+ ******************************************************************************
+ */
+
+#include "session_writer.h"
+#include "session_file.h"
+#include "grid_decoder.h"
+#include "session_codec.h"
+#include "spsc_queue.h"
+#include "zstd_dyn.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kQueueDepth = 256;
+constexpr uint64_t kIndexStrideUs = 1000000;   /* One entry per second */
+constexpr auto kIdleNap = std::chrono::microseconds(500);
+constexpr uint32_t kChunkRecords = 64;         /* ~2.5 s at 25 Hz */
+constexpr int kZstdLevel = 3;
+
+struct RecordSlot {
+    std::vector<uint8_t> bytes;    /* One complete on-disk record */
+};
+
+inline size_t recordSizeFor(uint32_t rows, uint32_t cols)
+{
+    size_t raw = sizeof(SessionRecordHeader) +
+                 static_cast<size_t>(rows) * cols * sizeof(uint16_t) +
+                 GRID_DEC_META_SIZE;
+    return (raw + 7u) & ~size_t{7};
+}
+
+} // namespace
+
+struct SessionWriter {
+    std::FILE *file = nullptr;
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    size_t recordSize = 0;
+
+    SpscQueue<RecordSlot> queue{kQueueDepth};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> dropped{0};
+
+    SessionFileHeader header{};
+    std::vector<SessionIndexEntry> index;
+    uint64_t nextIndexUs = 0;
+    uint64_t written = 0;
+    std::atomic<uint64_t> diskBytes{sizeof(SessionFileHeader)};
+    bool ioError = false;
+
+    /* Compressed mode (writer-thread state) */
+    bool compress = false;
+    std::vector<uint8_t> chunkRaw;     /* Staged, delta-preconditioned */
+    std::vector<uint8_t> chunkEnc;     /* Encode destination */
+    std::vector<uint16_t> prevCells;   /* Last record's original cells */
+    uint32_t chunkCount = 0;           /* Records staged */
+    uint64_t chunkFirstStampUs = 0;
+    std::vector<uint64_t> chunkDir;    /* File offset per chunk */
+    uint64_t fileOffset = sizeof(SessionFileHeader);
+
+    std::atomic<bool> running{false};
+    std::thread thread;
+
+    void stageRecord(const uint8_t *record);
+    void flushChunk();
+    void writeLoop();
+};
+
+/* Append one record to the chunk staging buffer, delta-preconditioning
+ * its cells against the previous record (first record stays verbatim
+ * so the chunk decodes on its own) */
+void SessionWriter::stageRecord(const uint8_t *record)
+{
+    const auto *hdr =
+        reinterpret_cast<const SessionRecordHeader *>(record);
+    if (chunkCount == 0) {
+        chunkFirstStampUs = hdr->stampUs;
+    }
+    size_t off = chunkRaw.size();
+    chunkRaw.insert(chunkRaw.end(), record, record + recordSize);
+
+    size_t cellCount = static_cast<size_t>(rows) * cols;
+    auto *cells = reinterpret_cast<uint16_t *>(
+        chunkRaw.data() + off + sizeof(SessionRecordHeader));
+    if (chunkCount != 0) {
+        for (size_t c = 0; c < cellCount; c++) {
+            uint16_t orig = cells[c];
+            cells[c] = static_cast<uint16_t>(orig - prevCells[c]);
+            prevCells[c] = orig;
+        }
+    } else {
+        std::memcpy(prevCells.data(), cells,
+                    cellCount * sizeof(uint16_t));
+    }
+    if (++chunkCount == kChunkRecords) {
+        flushChunk();
+    }
+}
+
+void SessionWriter::flushChunk()
+{
+    if (chunkCount == 0) {
+        return;
+    }
+    SessionChunkHeader ch{};
+    ch.firstStampUs = chunkFirstStampUs;
+    ch.records = chunkCount;
+    ch.rawBytes = static_cast<uint32_t>(chunkRaw.size());
+
+    const uint8_t *payload = chunkRaw.data();
+    size_t payloadLen = chunkRaw.size();
+    ch.codec = SESSION_CODEC_STORE;
+
+    const ZstdDyn *z = zstdDynGet();
+    if (z != nullptr) {
+        chunkEnc.resize(z->compressBound(chunkRaw.size()));
+        size_t r = z->compress(chunkEnc.data(), chunkEnc.size(),
+                               chunkRaw.data(), chunkRaw.size(),
+                               kZstdLevel);
+        if (!z->isError(r) && r < chunkRaw.size()) {
+            payload = chunkEnc.data();
+            payloadLen = r;
+            ch.codec = SESSION_CODEC_DELTA_ZSTD;
+        }
+    }
+    if (ch.codec == SESSION_CODEC_STORE) {
+        chunkEnc.resize(sessionRle0Bound(chunkRaw.size()));
+        size_t r = sessionRle0Encode(chunkRaw.data(), chunkRaw.size(),
+                                     chunkEnc.data());
+        if (r < chunkRaw.size()) {
+            payload = chunkEnc.data();
+            payloadLen = r;
+            ch.codec = SESSION_CODEC_DELTA_RLE;
+        }
+    }
+    /* STORE chunks keep the preconditioning too - the decoder's
+     * un-delta pass is unconditional */
+    ch.compBytes = static_cast<uint32_t>(payloadLen);
+
+    chunkDir.push_back(fileOffset);
+    if (std::fwrite(&ch, 1, sizeof(ch), file) != sizeof(ch) ||
+        std::fwrite(payload, 1, payloadLen, file) != payloadLen) {
+        ioError = true;
+    }
+    fileOffset += sizeof(ch) + payloadLen;
+    diskBytes.store(fileOffset, std::memory_order_relaxed);
+    chunkRaw.clear();
+    chunkCount = 0;
+}
+
+void SessionWriter::writeLoop()
+{
+    for (;;) {
+        RecordSlot *slot = queue.front();
+        if (slot == nullptr) {
+            if (!running.load(std::memory_order_acquire)) {
+                return;         /* Stopped and fully drained */
+            }
+            std::this_thread::sleep_for(kIdleNap);
+            continue;
+        }
+
+        const auto *hdr = reinterpret_cast<const SessionRecordHeader *>(
+            slot->bytes.data());
+        if (hdr->stampUs >= nextIndexUs) {
+            index.push_back(SessionIndexEntry{hdr->stampUs, written});
+            nextIndexUs = hdr->stampUs + kIndexStrideUs;
+        }
+        if (compress) {
+            stageRecord(slot->bytes.data());
+        } else {
+            if (std::fwrite(slot->bytes.data(), 1, recordSize, file) !=
+                recordSize) {
+                ioError = true;
+            }
+            fileOffset += recordSize;
+            diskBytes.store(fileOffset, std::memory_order_relaxed);
+        }
+        written++;
+        queue.pop();
+    }
+}
+
+SessionWriter *session_writer_open(const char *path, uint32_t rows,
+                                   uint32_t cols)
+{
+    return session_writer_open_ex(path, rows, cols, 1);
+}
+
+SessionWriter *session_writer_open_ex(const char *path, uint32_t rows,
+                                      uint32_t cols, int compress)
+{
+    if (path == nullptr || rows == 0 || cols == 0) {
+        return nullptr;
+    }
+    std::FILE *f = std::fopen(path, "wb");
+    if (f == nullptr) {
+        return nullptr;
+    }
+
+    auto *w = new (std::nothrow) SessionWriter();
+    if (w == nullptr) {
+        std::fclose(f);
+        return nullptr;
+    }
+    w->file = f;
+    w->rows = rows;
+    w->cols = cols;
+    w->recordSize = recordSizeFor(rows, cols);
+    w->queue.forEachSlot([w](RecordSlot &slot) {
+        slot.bytes.assign(w->recordSize, 0);
+    });
+    w->compress = (compress != 0);
+    if (w->compress) {
+        w->chunkRaw.reserve(static_cast<size_t>(kChunkRecords) *
+                            w->recordSize);
+        w->prevCells.assign(static_cast<size_t>(rows) * cols, 0);
+    }
+
+    SessionFileHeader &hdr = w->header;
+    hdr.magic = SESSION_FILE_MAGIC;
+    hdr.version = SESSION_FILE_VERSION;
+    hdr.headerSize = sizeof(SessionFileHeader);
+    hdr.rows = static_cast<uint16_t>(rows);
+    hdr.cols = static_cast<uint16_t>(cols);
+    hdr.recordSize = static_cast<uint32_t>(w->recordSize);
+    hdr.metaSize = GRID_DEC_META_SIZE;
+    if (w->compress) {
+        hdr.flags |= SESSION_FLAG_COMPRESSED;
+        hdr.chunkRecords = kChunkRecords;
+    }
+    hdr.startWallUs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    if (std::fwrite(&hdr, 1, sizeof(hdr), f) != sizeof(hdr)) {
+        std::fclose(f);
+        delete w;
+        return nullptr;
+    }
+
+    w->running.store(true);
+    w->thread = std::thread(&SessionWriter::writeLoop, w);
+    return w;
+}
+
+int session_writer_append(SessionWriter *w, const uint16_t *cells,
+                          const uint8_t *meta, uint64_t stampUs,
+                          uint32_t seq, int32_t type)
+{
+    if (w == nullptr || cells == nullptr) {
+        return 0;
+    }
+    RecordSlot *slot = w->queue.claim();
+    if (slot == nullptr) {
+        w->dropped.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    auto *hdr = reinterpret_cast<SessionRecordHeader *>(slot->bytes.data());
+    hdr->stampUs = stampUs;
+    hdr->seq = seq;
+    hdr->type = static_cast<uint16_t>(type);
+    hdr->flags = 0;
+
+    size_t cellBytes = static_cast<size_t>(w->rows) * w->cols *
+                       sizeof(uint16_t);
+    uint8_t *p = slot->bytes.data() + sizeof(SessionRecordHeader);
+    std::memcpy(p, cells, cellBytes);
+    if (meta != nullptr) {
+        std::memcpy(p + cellBytes, meta, GRID_DEC_META_SIZE);
+    } else {
+        std::memset(p + cellBytes, 0, GRID_DEC_META_SIZE);
+    }
+
+    w->queue.publish();
+    w->accepted.fetch_add(1, std::memory_order_relaxed);
+    return 1;
+}
+
+uint64_t session_writer_dropped(const SessionWriter *w)
+{
+    return (w != nullptr) ? w->dropped.load(std::memory_order_relaxed)
+                          : 0;
+}
+
+uint64_t session_writer_count(const SessionWriter *w)
+{
+    return (w != nullptr) ? w->accepted.load(std::memory_order_relaxed)
+                          : 0;
+}
+
+uint64_t session_writer_disk_bytes(const SessionWriter *w)
+{
+    return (w != nullptr)
+               ? w->diskBytes.load(std::memory_order_relaxed)
+               : 0;
+}
+
+int session_writer_close(SessionWriter *w)
+{
+    if (w == nullptr) {
+        return 0;
+    }
+    /* Writer thread exits only once the queue is empty */
+    w->running.store(false, std::memory_order_release);
+    w->thread.join();
+
+    if (w->compress) {
+        w->flushChunk();           /* Writer thread has exited */
+    }
+
+    bool ok = !w->ioError;
+    if (ok) {
+        uint64_t chunkDirOffset = 0;
+        if (w->compress && !w->chunkDir.empty()) {
+            chunkDirOffset = w->fileOffset;
+            uint64_t n = w->chunkDir.size();
+            if (std::fwrite(&n, sizeof(n), 1, w->file) != 1 ||
+                std::fwrite(w->chunkDir.data(), sizeof(uint64_t), n,
+                            w->file) != n) {
+                ok = false;
+            }
+            w->fileOffset += sizeof(n) + n * sizeof(uint64_t);
+        }
+        uint64_t indexOffset = w->fileOffset;
+        if (ok && !w->index.empty() &&
+            std::fwrite(w->index.data(), sizeof(SessionIndexEntry),
+                        w->index.size(),
+                        w->file) != w->index.size()) {
+            ok = false;
+        }
+        if (ok) {
+            /* Patch the counts in last: a header with recordCount set
+             * guarantees the records, chunk directory and index before
+             * it are complete */
+            SessionFileHeader hdr = w->header;
+            hdr.recordCount = w->written;
+            hdr.indexOffset = w->index.empty() ? 0 : indexOffset;
+            hdr.indexCount = w->index.size();
+            hdr.flags |= w->index.empty() ? 0 : SESSION_FLAG_INDEXED;
+            hdr.chunkDirOffset = chunkDirOffset;
+            std::fflush(w->file);
+            ok = std::fseek(w->file, 0, SEEK_SET) == 0 &&
+                 std::fwrite(&hdr, 1, sizeof(hdr), w->file) ==
+                     sizeof(hdr);
+        }
+    }
+    if (std::fclose(w->file) != 0) {
+        ok = false;
+    }
+    delete w;
+    return ok ? 1 : 0;
+}
@@ -0,0 +1,816 @@
+/**
+ ******************************************************************************
+ * @file           : spine_engine.cpp
+ * @brief          : Native spine detection engine implementation
+ ******************************************************************************
+ *
+ * Faithful port of gui/spine_detector.py - the algorithm constants,
+ * the landmark placement arithmetic and the filter tuning all mirror
+ * the Python module so the two produce the same results from the same
+ * input. Where the Python leans on NumPy (combined-max calibration
+ * image, per-row centroids, frame centroid for tracking) this uses the
+ * grid_kernels reductions or a single explicit pass.
+ *
+ * Because process noise, measurement noise and the initial covariance
+ * are all isotropic diagonals, the 2D landmark Kalman filter decomposes
+ * exactly into two independent scalar filters; the implementation
+ * exploits that instead of carrying 2x2 matrices.
+ *
+ * The JSON calibration files are read with a small schema-directed
+ * parser (key order independent, unknown keys skipped) and written in
+ * the same shape the Python side emits, so files round-trip freely
+ * between the two implementations.
+ *
+ ******************************************************************************
+ */
+
+#include "spine_engine.h"
+#include "grid_kernels.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+/* Calibration parameters (SpineDetector class constants) */
+constexpr size_t kMinCalibrationFrames = 20;
+constexpr uint16_t kMinCalibrationPressure = 300;
+constexpr int kMinSpineLengthRows = 15;
+constexpr int kMinTrailPoints = 10;
+constexpr int kLateralOffset = 6;      /* ~30 mm at 5 mm/cell */
+
+/* Landmark Kalman tuning (LandmarkKalman) */
+constexpr double kProcessNoise = 0.01;
+constexpr double kMeasurementNoise = 2.0;
+constexpr double kInitialUncertainty = 2.0;
+
+/* Movement tracker (MovementTracker) */
+constexpr size_t kTrackerHistory = 10;
+constexpr uint64_t kMinTrackTotal = 100;
+constexpr double kMinSpeedDt = 0.01;
+
+const char *const kLevels[5] = {"L1", "L2", "L3", "L4", "L5"};
+const char *const kTypes[3] = {"spinous", "transverse_left",
+                               "transverse_right"};
+
+struct Landmark {
+    std::string level;
+    std::string type;
+    double row = 0.0;
+    double col = 0.0;
+    double uncertainty = kInitialUncertainty;
+
+    /* Per-axis scalar Kalman state (see file header) */
+    double pRow = kInitialUncertainty * kInitialUncertainty;
+    double pCol = kInitialUncertainty * kInitialUncertainty;
+    uint32_t updates = 0;
+};
+
+struct TrackSample {
+    double row;
+    double col;
+    double t;
+};
+
+} // namespace
+
+struct SpineEngine {
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    uint16_t minPressure = kMinCalibrationPressure;
+
+    /* Calibration drag: per-cell maximum over all frames seen */
+    std::vector<uint16_t> combined;
+    size_t calibFrames = 0;
+    bool calibrating = false;
+
+    bool hasLine = false;
+    int startRow = 0;
+    int endRow = 0;
+    double slope = 0.0;
+    double intercept = 0.0;
+    std::vector<Landmark> landmarks;
+    std::string createdAt;
+    std::string notes;
+
+    /* Movement tracker ring (oldest .. newest) */
+    TrackSample history[kTrackerHistory];
+    size_t histCount = 0;
+    size_t histNext = 0;
+};
+
+namespace {
+
+void initLandmarkFilters(SpineEngine *e)
+{
+    for (Landmark &lm : e->landmarks) {
+        lm.pRow = lm.uncertainty * lm.uncertainty;
+        lm.pCol = lm.pRow;
+        lm.updates = 0;
+    }
+}
+
+void generateLandmarks(SpineEngine *e)
+{
+    e->landmarks.clear();
+    double totalRows = e->endRow - e->startRow;
+    for (int i = 0; i < 5; i++) {
+        /* L1 at 10 %, L2 at 30 % ... L5 at 90 % of the drag extent */
+        double row = e->startRow +
+                     static_cast<int>(totalRows * (0.1 + i * 0.2));
+        double col = e->slope * row + e->intercept;
+        double offsets[3] = {0.0, -kLateralOffset, kLateralOffset};
+        for (int k = 0; k < 3; k++) {
+            Landmark lm;
+            lm.level = kLevels[i];
+            lm.type = kTypes[k];
+            lm.row = row;
+            lm.col = col + offsets[k];
+            e->landmarks.push_back(lm);
+        }
+    }
+    initLandmarkFilters(e);
+}
+
+std::string isoTimestamp()
+{
+    char buf[32];
+    std::time_t now = std::time(nullptr);
+    std::tm tmv{};
+#if defined(_WIN32)
+    localtime_s(&tmv, &now);
+#else
+    localtime_r(&now, &tmv);
+#endif
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tmv);
+    return buf;
+}
+
+void copyLandmark(const Landmark &lm, SpineEngineLandmark *out)
+{
+    std::snprintf(out->level, sizeof(out->level), "%s", lm.level.c_str());
+    std::snprintf(out->type, sizeof(out->type), "%s", lm.type.c_str());
+    out->row = static_cast<float>(lm.row);
+    out->col = static_cast<float>(lm.col);
+    out->uncertainty = static_cast<float>(lm.uncertainty);
+}
+
+/* ------------------------------------------------------------------ */
+/* Minimal JSON reader: just enough for the calibration schema, key
+ * order independent, unknown keys skipped                             */
+/* ------------------------------------------------------------------ */
+
+struct JsonCursor {
+    const char *p;
+    const char *end;
+};
+
+void jsonSkipWs(JsonCursor *c)
+{
+    while (c->p < c->end &&
+           (*c->p == ' ' || *c->p == '\t' || *c->p == '\n' ||
+            *c->p == '\r')) {
+        c->p++;
+    }
+}
+
+bool jsonMatch(JsonCursor *c, char ch)
+{
+    jsonSkipWs(c);
+    if (c->p < c->end && *c->p == ch) {
+        c->p++;
+        return true;
+    }
+    return false;
+}
+
+bool jsonString(JsonCursor *c, std::string *out)
+{
+    if (!jsonMatch(c, '"')) {
+        return false;
+    }
+    out->clear();
+    while (c->p < c->end && *c->p != '"') {
+        char ch = *c->p++;
+        if (ch == '\\' && c->p < c->end) {
+            char esc = *c->p++;
+            switch (esc) {
+            case 'n': ch = '\n'; break;
+            case 't': ch = '\t'; break;
+            case 'r': ch = '\r'; break;
+            default: ch = esc; break;     /* \" \\ \/ and the rest */
+            }
+        }
+        out->push_back(ch);
+    }
+    return jsonMatch(c, '"');
+}
+
+bool jsonNumber(JsonCursor *c, double *out)
+{
+    jsonSkipWs(c);
+    char *after = nullptr;
+    *out = std::strtod(c->p, &after);
+    if (after == c->p) {
+        return false;
+    }
+    c->p = after;
+    return true;
+}
+
+bool jsonLiteral(JsonCursor *c, const char *word)
+{
+    jsonSkipWs(c);
+    size_t n = std::strlen(word);
+    if (static_cast<size_t>(c->end - c->p) >= n &&
+        std::memcmp(c->p, word, n) == 0) {
+        c->p += n;
+        return true;
+    }
+    return false;
+}
+
+bool jsonSkipValue(JsonCursor *c)
+{
+    jsonSkipWs(c);
+    if (c->p >= c->end) {
+        return false;
+    }
+    if (*c->p == '"') {
+        std::string tmp;
+        return jsonString(c, &tmp);
+    }
+    if (*c->p == '{' || *c->p == '[') {
+        char open = *c->p;
+        char close = (open == '{') ? '}' : ']';
+        c->p++;
+        jsonSkipWs(c);
+        if (jsonMatch(c, close)) {
+            return true;
+        }
+        for (;;) {
+            if (open == '{') {
+                std::string key;
+                if (!jsonString(c, &key) || !jsonMatch(c, ':')) {
+                    return false;
+                }
+            }
+            if (!jsonSkipValue(c)) {
+                return false;
+            }
+            if (jsonMatch(c, close)) {
+                return true;
+            }
+            if (!jsonMatch(c, ',')) {
+                return false;
+            }
+        }
+    }
+    if (jsonLiteral(c, "null") || jsonLiteral(c, "true") ||
+        jsonLiteral(c, "false")) {
+        return true;
+    }
+    double d;
+    return jsonNumber(c, &d);
+}
+
+bool parseSpineLine(JsonCursor *c, SpineEngine *e)
+{
+    if (jsonLiteral(c, "null")) {
+        e->hasLine = false;
+        return true;
+    }
+    if (!jsonMatch(c, '{')) {
+        return false;
+    }
+    if (jsonMatch(c, '}')) {
+        return false;
+    }
+    for (;;) {
+        std::string key;
+        if (!jsonString(c, &key) || !jsonMatch(c, ':')) {
+            return false;
+        }
+        if (key == "start_row" || key == "end_row") {
+            double v;
+            if (!jsonNumber(c, &v)) {
+                return false;
+            }
+            (key == "start_row" ? e->startRow : e->endRow) =
+                static_cast<int>(v);
+        } else if (key == "coefficients") {
+            if (!jsonMatch(c, '[') || !jsonNumber(c, &e->slope) ||
+                !jsonMatch(c, ',') || !jsonNumber(c, &e->intercept) ||
+                !jsonMatch(c, ']')) {
+                return false;
+            }
+        } else if (!jsonSkipValue(c)) {
+            return false;
+        }
+        if (jsonMatch(c, '}')) {
+            e->hasLine = true;
+            return true;
+        }
+        if (!jsonMatch(c, ',')) {
+            return false;
+        }
+    }
+}
+
+bool parseLandmarks(JsonCursor *c, SpineEngine *e)
+{
+    if (!jsonMatch(c, '[')) {
+        return false;
+    }
+    e->landmarks.clear();
+    if (jsonMatch(c, ']')) {
+        return true;
+    }
+    for (;;) {
+        if (!jsonMatch(c, '{')) {
+            return false;
+        }
+        Landmark lm;
+        for (;;) {
+            std::string key;
+            if (!jsonString(c, &key) || !jsonMatch(c, ':')) {
+                return false;
+            }
+            if (key == "level") {
+                if (!jsonString(c, &lm.level)) {
+                    return false;
+                }
+            } else if (key == "type") {
+                if (!jsonString(c, &lm.type)) {
+                    return false;
+                }
+            } else if (key == "row" || key == "col" ||
+                       key == "uncertainty") {
+                double v;
+                if (!jsonNumber(c, &v)) {
+                    return false;
+                }
+                if (key == "row") {
+                    lm.row = v;
+                } else if (key == "col") {
+                    lm.col = v;
+                } else {
+                    lm.uncertainty = v;
+                }
+            } else if (!jsonSkipValue(c)) {
+                return false;
+            }
+            if (jsonMatch(c, '}')) {
+                break;
+            }
+            if (!jsonMatch(c, ',')) {
+                return false;
+            }
+        }
+        e->landmarks.push_back(lm);
+        if (jsonMatch(c, ']')) {
+            return true;
+        }
+        if (!jsonMatch(c, ',')) {
+            return false;
+        }
+    }
+}
+
+void jsonAppendEscaped(std::string *out, const std::string &s)
+{
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out->push_back('\\');
+        }
+        out->push_back(ch);
+    }
+}
+
+} // namespace
+
+SpineEngine *spine_engine_create(uint32_t rows, uint32_t cols)
+{
+    if (rows == 0 || cols == 0) {
+        return nullptr;
+    }
+    auto *e = new (std::nothrow) SpineEngine();
+    if (e == nullptr) {
+        return nullptr;
+    }
+    e->rows = rows;
+    e->cols = cols;
+    e->combined.assign(static_cast<size_t>(rows) * cols, 0);
+    return e;
+}
+
+void spine_engine_destroy(SpineEngine *eng)
+{
+    delete eng;
+}
+
+void spine_engine_set_min_pressure(SpineEngine *eng, uint16_t threshold)
+{
+    if (eng != nullptr) {
+        eng->minPressure = threshold;
+    }
+}
+
+void spine_engine_start_calibration(SpineEngine *eng)
+{
+    if (eng == nullptr) {
+        return;
+    }
+    std::memset(eng->combined.data(), 0,
+                eng->combined.size() * sizeof(uint16_t));
+    eng->calibFrames = 0;
+    eng->calibrating = true;
+    eng->hasLine = false;
+    eng->landmarks.clear();
+}
+
+void spine_engine_add_calibration_frame(SpineEngine *eng,
+                                        const uint16_t *cells)
+{
+    if (eng == nullptr || cells == nullptr || !eng->calibrating) {
+        return;
+    }
+    /* Fold into the running per-cell maximum - no frame list needed */
+    size_t n = eng->combined.size();
+    for (size_t i = 0; i < n; i++) {
+        if (cells[i] > eng->combined[i]) {
+            eng->combined[i] = cells[i];
+        }
+    }
+    eng->calibFrames++;
+}
+
+int spine_engine_finalize_calibration(SpineEngine *eng, char *msg,
+                                      size_t msgCap)
+{
+    if (eng == nullptr) {
+        return 0;
+    }
+    eng->calibrating = false;
+    if (msg == nullptr || msgCap == 0) {
+        static char dummy;
+        msg = &dummy;
+        msgCap = 1;
+    }
+
+    if (eng->calibFrames < kMinCalibrationFrames) {
+        std::snprintf(msg, msgCap, "Not enough frames (%zu < %zu)",
+                      eng->calibFrames, kMinCalibrationFrames);
+        return 0;
+    }
+
+    /* Pressure-weighted column centroid of every row the drag touched */
+    std::vector<double> rowsPts;
+    std::vector<double> colsPts;
+    for (uint32_t r = 0; r < eng->rows; r++) {
+        const uint16_t *rowp = eng->combined.data() +
+                               static_cast<size_t>(r) * eng->cols;
+        uint16_t rowMax = 0;
+        double total = 0.0;
+        double weighted = 0.0;
+        for (uint32_t cIdx = 0; cIdx < eng->cols; cIdx++) {
+            uint16_t v = rowp[cIdx];
+            if (v > rowMax) {
+                rowMax = v;
+            }
+            total += v;
+            weighted += static_cast<double>(v) * cIdx;
+        }
+        if (rowMax > eng->minPressure && total > 0.0) {
+            rowsPts.push_back(r);
+            colsPts.push_back(weighted / total);
+        }
+    }
+
+    if (rowsPts.size() < static_cast<size_t>(kMinTrailPoints)) {
+        std::snprintf(msg, msgCap,
+                      "Could not detect spine line - "
+                      "try again with more pressure");
+        return 0;
+    }
+
+    /* Least-squares line col = slope * row + intercept */
+    double n = static_cast<double>(rowsPts.size());
+    double sx = 0.0;
+    double sy = 0.0;
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (size_t i = 0; i < rowsPts.size(); i++) {
+        sx += rowsPts[i];
+        sy += colsPts[i];
+        sxx += rowsPts[i] * rowsPts[i];
+        sxy += rowsPts[i] * colsPts[i];
+    }
+    double denom = n * sxx - sx * sx;
+    if (denom == 0.0) {
+        std::snprintf(msg, msgCap,
+                      "Could not detect spine line - "
+                      "try again with more pressure");
+        return 0;
+    }
+
+    int start = static_cast<int>(rowsPts.front());
+    int end = static_cast<int>(rowsPts.back());
+    if (end - start < kMinSpineLengthRows) {
+        std::snprintf(msg, msgCap,
+                      "Spine line too short - drag from top to bottom");
+        return 0;
+    }
+
+    eng->slope = (n * sxy - sx * sy) / denom;
+    eng->intercept = (sy - eng->slope * sx) / n;
+    eng->startRow = start;
+    eng->endRow = end;
+    eng->hasLine = true;
+    eng->createdAt = isoTimestamp();
+    generateLandmarks(eng);
+
+    std::snprintf(msg, msgCap,
+                  "Calibration complete! "
+                  "Detected L1-L5 across rows %d-%d",
+                  start, end);
+    return 1;
+}
+
+int spine_engine_is_calibrated(const SpineEngine *eng)
+{
+    return (eng != nullptr && eng->hasLine &&
+            eng->landmarks.size() == 15)
+               ? 1
+               : 0;
+}
+
+int spine_engine_get_landmarks(const SpineEngine *eng,
+                               SpineEngineLandmark *out, int cap)
+{
+    if (eng == nullptr || out == nullptr || cap <= 0) {
+        return 0;
+    }
+    int count = 0;
+    for (const Landmark &lm : eng->landmarks) {
+        if (count >= cap) {
+            break;
+        }
+        copyLandmark(lm, &out[count++]);
+    }
+    return count;
+}
+
+int spine_engine_get_spine_line(const SpineEngine *eng, int32_t *startRow,
+                                int32_t *endRow, float coeff[2])
+{
+    if (eng == nullptr || !eng->hasLine) {
+        return 0;
+    }
+    if (startRow != nullptr) {
+        *startRow = eng->startRow;
+    }
+    if (endRow != nullptr) {
+        *endRow = eng->endRow;
+    }
+    if (coeff != nullptr) {
+        coeff[0] = static_cast<float>(eng->slope);
+        coeff[1] = static_cast<float>(eng->intercept);
+    }
+    return 1;
+}
+
+void spine_engine_update_landmark(SpineEngine *eng, const char *level,
+                                  const char *type, float measuredRow,
+                                  float measuredCol)
+{
+    if (eng == nullptr || level == nullptr || type == nullptr) {
+        return;
+    }
+    for (Landmark &lm : eng->landmarks) {
+        if (lm.level != level || lm.type != type) {
+            continue;
+        }
+        /* Predict (static target: covariance grows by Q), then update
+         * with measurement noise annealed by confidence */
+        lm.pRow += kProcessNoise;
+        lm.pCol += kProcessNoise;
+        double anneal = std::pow(0.95, lm.updates);
+        double r = kMeasurementNoise * ((anneal > 0.5) ? anneal : 0.5);
+
+        double kRow = lm.pRow / (lm.pRow + r);
+        double kCol = lm.pCol / (lm.pCol + r);
+        lm.row += kRow * (measuredRow - lm.row);
+        lm.col += kCol * (measuredCol - lm.col);
+        lm.pRow *= (1.0 - kRow);
+        lm.pCol *= (1.0 - kCol);
+        lm.updates++;
+
+        lm.uncertainty = (std::sqrt(lm.pRow) + std::sqrt(lm.pCol)) / 2.0;
+        return;
+    }
+}
+
+int spine_engine_nearest_landmark(const SpineEngine *eng, float row,
+                                  float col, SpineEngineLandmark *out,
+                                  float *dist)
+{
+    if (eng == nullptr || out == nullptr ||
+        !spine_engine_is_calibrated(eng)) {
+        return 0;
+    }
+    const Landmark *nearest = nullptr;
+    double best = 0.0;
+    for (const Landmark &lm : eng->landmarks) {
+        double dr = lm.row - row;
+        double dc = lm.col - col;
+        double d = dr * dr + dc * dc;
+        if (nearest == nullptr || d < best) {
+            nearest = &lm;
+            best = d;
+        }
+    }
+    copyLandmark(*nearest, out);
+    if (dist != nullptr) {
+        *dist = static_cast<float>(std::sqrt(best));
+    }
+    return 1;
+}
+
+int spine_engine_track(SpineEngine *eng, const uint16_t *cells,
+                       double timestamp, float *row, float *col,
+                       float *speed)
+{
+    if (eng == nullptr || cells == nullptr) {
+        return 0;
+    }
+    if (speed != nullptr) {
+        *speed = 0.0f;
+    }
+
+    GridKernelsReduce red;
+    grid_kernels_reduce(cells, eng->rows, eng->cols, &red);
+    if (red.sum < kMinTrackTotal) {
+        return 0;               /* No significant pressure */
+    }
+
+    TrackSample sample{red.centroidRow, red.centroidCol, timestamp};
+    eng->history[eng->histNext] = sample;
+    eng->histNext = (eng->histNext + 1) % kTrackerHistory;
+    if (eng->histCount < kTrackerHistory) {
+        eng->histCount++;
+    }
+
+    if (row != nullptr) {
+        *row = red.centroidRow;
+    }
+    if (col != nullptr) {
+        *col = red.centroidCol;
+    }
+
+    if (eng->histCount >= 2 && speed != nullptr) {
+        /* Oldest sample in the ring to the one just written */
+        size_t oldest = (eng->histCount < kTrackerHistory)
+                            ? 0
+                            : eng->histNext;
+        const TrackSample &a = eng->history[oldest];
+        double dt = sample.t - a.t;
+        if (dt > kMinSpeedDt) {
+            double dr = sample.row - a.row;
+            double dc = sample.col - a.col;
+            *speed =
+                static_cast<float>(std::sqrt(dr * dr + dc * dc) / dt);
+        }
+    }
+    return 1;
+}
+
+int spine_engine_save_calibration(const SpineEngine *eng,
+                                  const char *path)
+{
+    if (eng == nullptr || path == nullptr) {
+        return 0;
+    }
+    std::string out;
+    out += "{\n";
+    if (eng->hasLine) {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf),
+                      "  \"spine_line\": {\n"
+                      "    \"start_row\": %d,\n"
+                      "    \"end_row\": %d,\n"
+                      "    \"coefficients\": [%.10g, %.10g]\n"
+                      "  },\n",
+                      eng->startRow, eng->endRow, eng->slope,
+                      eng->intercept);
+        out += buf;
+    } else {
+        out += "  \"spine_line\": null,\n";
+    }
+    out += "  \"landmarks\": [";
+    for (size_t i = 0; i < eng->landmarks.size(); i++) {
+        const Landmark &lm = eng->landmarks[i];
+        char buf[256];
+        std::snprintf(buf, sizeof(buf),
+                      "%s\n    {\n"
+                      "      \"level\": \"%s\",\n"
+                      "      \"type\": \"%s\",\n"
+                      "      \"row\": %.10g,\n"
+                      "      \"col\": %.10g,\n"
+                      "      \"uncertainty\": %.10g\n"
+                      "    }",
+                      (i == 0) ? "" : ",", lm.level.c_str(),
+                      lm.type.c_str(), lm.row, lm.col, lm.uncertainty);
+        out += buf;
+    }
+    out += "\n  ],\n";
+    out += "  \"created_at\": \"";
+    jsonAppendEscaped(&out, eng->createdAt);
+    out += "\",\n  \"notes\": \"";
+    jsonAppendEscaped(&out, eng->notes);
+    out += "\"\n}\n";
+
+    std::FILE *f = std::fopen(path, "w");
+    if (f == nullptr) {
+        return 0;
+    }
+    size_t written = std::fwrite(out.data(), 1, out.size(), f);
+    std::fclose(f);
+    return (written == out.size()) ? 1 : 0;
+}
+
+int spine_engine_load_calibration(SpineEngine *eng, const char *path)
+{
+    if (eng == nullptr || path == nullptr) {
+        return 0;
+    }
+    std::FILE *f = std::fopen(path, "r");
+    if (f == nullptr) {
+        return 0;
+    }
+    std::string text;
+    char chunk[4096];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        text.append(chunk, got);
+    }
+    std::fclose(f);
+
+    SpineEngine fresh;
+    fresh.rows = eng->rows;
+    fresh.cols = eng->cols;
+
+    JsonCursor c{text.data(), text.data() + text.size()};
+    if (!jsonMatch(&c, '{')) {
+        return 0;
+    }
+    if (!jsonMatch(&c, '}')) {
+        for (;;) {
+            std::string key;
+            if (!jsonString(&c, &key) || !jsonMatch(&c, ':')) {
+                return 0;
+            }
+            bool ok;
+            if (key == "spine_line") {
+                ok = parseSpineLine(&c, &fresh);
+            } else if (key == "landmarks") {
+                ok = parseLandmarks(&c, &fresh);
+            } else if (key == "created_at") {
+                ok = jsonString(&c, &fresh.createdAt);
+            } else if (key == "notes") {
+                ok = jsonString(&c, &fresh.notes);
+            } else {
+                ok = jsonSkipValue(&c);
+            }
+            if (!ok) {
+                return 0;
+            }
+            if (jsonMatch(&c, '}')) {
+                break;
+            }
+            if (!jsonMatch(&c, ',')) {
+                return 0;
+            }
+        }
+    }
+
+    eng->hasLine = fresh.hasLine;
+    eng->startRow = fresh.startRow;
+    eng->endRow = fresh.endRow;
+    eng->slope = fresh.slope;
+    eng->intercept = fresh.intercept;
+    eng->landmarks = fresh.landmarks;
+    eng->createdAt = fresh.createdAt;
+    eng->notes = fresh.notes;
+    eng->calibrating = false;
+    if (spine_engine_is_calibrated(eng)) {
+        initLandmarkFilters(eng);
+    }
+    return 1;
+}
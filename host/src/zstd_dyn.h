@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file           : zstd_dyn.h
+ * @brief          : Runtime-resolved zstd entry points (internal)
+ ******************************************************************************
+ *
+ * The session writer and replay engine use zstd when the system has
+ * it, resolved at runtime the same way heatmap_gl resolves GL - no
+ * development package or link dependency, and machines without the
+ * library fall back to the built-in zero-run codec transparently.
+ * Internal to the library; not installed with the public headers.
+ *
+ ******************************************************************************
+ */
+
+#ifndef ZSTD_DYN_H
+#define ZSTD_DYN_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+struct ZstdDyn {
+    size_t (*compressBound)(size_t srcSize);
+    size_t (*compress)(void *dst, size_t dstCap, const void *src,
+                       size_t srcSize, int level);
+    size_t (*decompress)(void *dst, size_t dstCap, const void *src,
+                         size_t srcSize);
+    unsigned (*isError)(size_t code);
+};
+
+/** Resolve once per process; NULL when no zstd library is present */
+inline const ZstdDyn *zstdDynGet()
+{
+    static ZstdDyn fns;
+    static int state = 0;          /* 0 untried, 1 loaded, -1 absent */
+    if (state == 0) {
+        void *lib = nullptr;
+#if defined(_WIN32)
+        const char *names[] = {"libzstd.dll", "zstd.dll"};
+        for (const char *name : names) {
+            lib = reinterpret_cast<void *>(LoadLibraryA(name));
+            if (lib != nullptr) {
+                break;
+            }
+        }
+#define ZSTD_DYN_SYM(l, n) \
+    reinterpret_cast<void *>( \
+        GetProcAddress(reinterpret_cast<HMODULE>(l), n))
+#else
+        const char *names[] = {"libzstd.so.1", "libzstd.so",
+                               "libzstd.dylib"};
+        for (const char *name : names) {
+            lib = dlopen(name, RTLD_LAZY);
+            if (lib != nullptr) {
+                break;
+            }
+        }
+#define ZSTD_DYN_SYM(l, n) dlsym(l, n)
+#endif
+        if (lib != nullptr) {
+            fns.compressBound = reinterpret_cast<size_t (*)(size_t)>(
+                ZSTD_DYN_SYM(lib, "ZSTD_compressBound"));
+            fns.compress = reinterpret_cast<size_t (*)(
+                void *, size_t, const void *, size_t, int)>(
+                ZSTD_DYN_SYM(lib, "ZSTD_compress"));
+            fns.decompress = reinterpret_cast<size_t (*)(
+                void *, size_t, const void *, size_t)>(
+                ZSTD_DYN_SYM(lib, "ZSTD_decompress"));
+            fns.isError = reinterpret_cast<unsigned (*)(size_t)>(
+                ZSTD_DYN_SYM(lib, "ZSTD_isError"));
+        }
+#undef ZSTD_DYN_SYM
+        state = (fns.compressBound != nullptr && fns.compress != nullptr &&
+                 fns.decompress != nullptr && fns.isError != nullptr)
+                    ? 1
+                    : -1;
+    }
+    return (state == 1) ? &fns : nullptr;
+}
+
+#endif /* ZSTD_DYN_H */